@@ -35,7 +35,7 @@ DEFINES       += MANUAL_PATH="\\\"$$replace(manual.path," ","\\ ")\\\""
      win32:DEFINES += QT_DLL QT_THREAD_SUPPORT
 }
 
-QT            += opengl network svg xml
+QT            += opengl network svg xml concurrent
 equals(QT_MAJOR_VERSION, 5) { QT += printsupport }
 
 MOC_DIR        = ../tmp/scidavis
@@ -36,24 +36,32 @@ HEADERS  += src/ApplicationWindow.h \
             src/ImageMarker.h \
             src/ImageDialog.h \
             src/fit_gsl.h \
+            src/fit_models.h \
             src/MultiLayer.h\
+            src/GraphExporter.h \
             src/LayerDialog.h \
             src/IntDialog.h \
             src/Bar.h \
             src/Cone3D.h \
+            src/Dot3D.h \
             src/ConfigDialog.h \
             src/QwtBarCurve.h \
             src/BoxCurve.h \
             src/QwtHistogram.h \
+            src/ColumnAggregation.h \
             src/VectorCurve.h \
             src/ScaleDraw.h \
             src/Matrix.h \
+            src/MatrixRaster.h \
             src/DataSetDialog.h \
             src/MyParser.h \
+            src/CompiledFormula.h \
+            src/RowPredicate.h \
             src/SymbolBox.h \
             src/PatternBox.h \
             src/SymbolDialog.h \
             src/Plot.h \
+            src/CanvasRenderer.h \
             src/ColorButton.h \
             src/AssociationsDialog.h \
             src/RenameWindowDialog.h \
@@ -67,6 +75,7 @@ HEADERS  += src/ApplicationWindow.h \
             src/Note.h\
             src/Folder.h\
             src/FindDialog.h\
+            src/ProjectSearch.h \
             src/ScriptingEnv.h\
             src/Script.h\
             src/ScriptEdit.h\
@@ -82,6 +91,10 @@ HEADERS  += src/ApplicationWindow.h \
             src/ScriptingLangDialog.h\
             src/TextFormatButtons.h\
             src/TableStatistics.h\
+            src/FilteredTable.h\
+            src/GroupedTable.h\
+            src/GroupRowsDialog.h\
+            src/JoinTablesDialog.h\
             src/Spectrogram.h\
             src/ColorMapEditor.h\
             src/SelectionMoveResizer.h\
@@ -145,22 +158,29 @@ SOURCES  += src/ApplicationWindow.cpp \
             src/ImageMarker.cpp \
             src/ImageDialog.cpp \
             src/MultiLayer.cpp\
+            src/GraphExporter.cpp \
             src/LayerDialog.cpp \
             src/IntDialog.cpp \
             src/Bar.cpp \
             src/Cone3D.cpp \
+            src/Dot3D.cpp \
             src/DataSetDialog.cpp \
             src/ConfigDialog.cpp \
             src/QwtBarCurve.cpp \
             src/BoxCurve.cpp \
             src/QwtHistogram.cpp \
+            src/ColumnAggregation.cpp \
             src/VectorCurve.cpp \
             src/Matrix.cpp \
+            src/MatrixRaster.cpp \
             src/MyParser.cpp\
+            src/CompiledFormula.cpp\
+            src/RowPredicate.cpp\
             src/SymbolBox.cpp \
             src/PatternBox.cpp \
             src/SymbolDialog.cpp \
             src/Plot.cpp \
+            src/CanvasRenderer.cpp \
             src/ColorButton.cpp \
             src/AssociationsDialog.cpp \
             src/RenameWindowDialog.cpp \
@@ -173,6 +193,7 @@ SOURCES  += src/ApplicationWindow.cpp \
             src/Note.cpp\
             src/Folder.cpp\
             src/FindDialog.cpp\
+            src/ProjectSearch.cpp \
             src/TextFormatButtons.cpp\
             src/ScriptEdit.cpp\
             src/ImportASCIIDialog.cpp\
@@ -190,6 +211,10 @@ SOURCES  += src/ApplicationWindow.cpp \
             src/Script.cpp\
             src/ScriptingLangDialog.cpp\
             src/TableStatistics.cpp\
+            src/FilteredTable.cpp\
+            src/GroupedTable.cpp\
+            src/GroupRowsDialog.cpp\
+            src/JoinTablesDialog.cpp\
             src/Spectrogram.cpp\
             src/ColorMapEditor.cpp\
             src/SelectionMoveResizer.cpp\
@@ -240,6 +265,7 @@ HEADERS += src/future/core/AbstractAspect.h \
            src/future/core/aspectcommands.h \
            src/future/core/future_Folder.h \
            src/future/core/Project.h \
+           src/future/core/UndoStorage.h \
            src/future/core/ProjectConfigPage.h \
            src/future/core/PartMdiView.h \
            src/future/core/AbstractColumn.h \
@@ -253,6 +279,7 @@ HEADERS += src/future/core/AbstractAspect.h \
            src/future/core/datatypes/DateTime2StringFilter.h \
            src/future/core/datatypes/DayOfWeek2DoubleFilter.h \
            src/future/core/datatypes/Double2DateTimeFilter.h \
+           src/future/core/datatypes/FixedDateTimeFormat.h \
            src/future/core/datatypes/NumericDateTimeBaseFilter.h \
            src/future/core/datatypes/Double2DayOfWeekFilter.h \
            src/future/core/datatypes/Double2MonthFilter.h \
@@ -268,10 +295,18 @@ HEADERS += src/future/core/AbstractAspect.h \
            src/future/lib/ConfigPageWidget.h \
            src/future/lib/Interval.h \
            src/future/lib/IntervalAttribute.h \
+           src/future/lib/DescriptiveStatistics.h \
+           src/future/lib/PeakDetection.h \
+           src/future/lib/PolynomialLeastSquares.h \
+           src/future/lib/RowSorter.h \
+           src/future/lib/GroupAggregation.h \
+           src/future/lib/TableJoin.h \
+           src/future/lib/ColumnTransform.h \
            src/future/matrix/future_Matrix.h \
            src/future/matrix/MatrixModel.h \
            src/future/matrix/MatrixView.h \
            src/future/matrix/matrixcommands.h \
+           src/future/matrix/MatrixOperations.h \
            src/future/table/future_Table.h \
            src/future/table/TableModel.h \
            src/future/table/TableView.h \
@@ -290,6 +325,7 @@ SOURCES += src/future/core/AbstractAspect.cpp \
            src/future/core/future_Folder.cpp \
            src/future/core/PartMdiView.cpp \
            src/future/core/Project.cpp \
+           src/future/core/UndoStorage.cpp \
            src/future/core/column/Column.cpp \
            src/future/core/column/ColumnPrivate.cpp \
            src/future/core/column/columncommands.cpp \
@@ -297,16 +333,25 @@ SOURCES += src/future/core/AbstractAspect.cpp \
            src/future/core/datatypes/String2DateTimeFilter.cpp \
            src/future/core/datatypes/Double2StringFilter.cpp \
            src/future/core/datatypes/NumericDateTimeBaseFilter.cpp \
+           src/future/core/datatypes/FixedDateTimeFormat.cpp \
            src/future/core/AbstractSimpleFilter.cpp \
            src/future/core/AbstractFilter.cpp \
            src/future/core/ProjectConfigPage.cpp \
            src/future/lib/XmlStreamReader.cpp \
            src/future/lib/ActionManager.cpp \
            src/future/lib/ConfigPageWidget.cpp \
+           src/future/lib/DescriptiveStatistics.cpp \
+           src/future/lib/PeakDetection.cpp \
+           src/future/lib/PolynomialLeastSquares.cpp \
+           src/future/lib/RowSorter.cpp \
+           src/future/lib/GroupAggregation.cpp \
+           src/future/lib/TableJoin.cpp \
+           src/future/lib/ColumnTransform.cpp \
            src/future/matrix/future_Matrix.cpp \
            src/future/matrix/MatrixModel.cpp \
            src/future/matrix/MatrixView.cpp \
            src/future/matrix/matrixcommands.cpp \
+           src/future/matrix/MatrixOperations.cpp \
            src/future/table/future_Table.cpp \
            src/future/table/TableModel.cpp \
            src/future/table/TableView.cpp \
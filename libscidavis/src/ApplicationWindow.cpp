@@ -73,6 +73,7 @@
 #include "InterpolationDialog.h"
 #include "ImportASCIIDialog.h"
 #include "ImageExportDialog.h"
+#include "GraphExporter.h"
 #include "SmoothCurveDialog.h"
 #include "FilterDialog.h"
 #include "FFTDialog.h"
@@ -82,6 +83,10 @@
 #include "ScaleDraw.h"
 #include "ScriptingLangDialog.h"
 #include "TableStatistics.h"
+#include "FilteredTable.h"
+#include "GroupedTable.h"
+#include "GroupRowsDialog.h"
+#include "JoinTablesDialog.h"
 #include "Fit.h"
 #include "MultiPeakFit.h"
 #include "PolynomialFit.h"
@@ -100,7 +105,9 @@
 #include "OpenProjectDialog.h"
 #include "IconLoader.h"
 #include "core/Project.h"
+#include "core/UndoStorage.h"
 #include "core/column/Column.h"
+#include "lib/TableJoin.h"
 #include "lib/XmlStreamReader.h"
 #include "table/future_Table.h"
 
@@ -116,6 +123,7 @@
 
 #include <QFileDialog>
 #include <QInputDialog>
+#include <QLineEdit>
 #include <QProgressDialog>
 #include <QPrintDialog>
 #include <QPixmapCache>
@@ -140,6 +148,8 @@
 #include <QTextStream>
 #include <QVarLengthArray>
 #include <QList>
+#include <QHash>
+#include <QSet>
 #include <QUrl>
 #include <QDesktopServices>
 #include <QStatusBar>
@@ -198,6 +208,7 @@ ApplicationWindow::ApplicationWindow()
       projectname("untitled"),
       logInfo(QString()),
       savingTimerId(0),
+      curvesTimerId(0),
       copiedLayer(false),
       renamedTables(QStringList()),
       copiedMarkerType(Graph::None),
@@ -365,8 +376,11 @@ ApplicationWindow::ApplicationWindow()
     folders.setAcceptDrops(true);
     folders.setDefaultDropAction(Qt::MoveAction);
 
-    connect(d_project->undoStack(), SIGNAL(canUndoChanged(bool)), actionUndo,
-            SLOT(setEnabled(bool)));
+    connect(d_project->undoStack(), SIGNAL(canUndoChanged(bool)), this,
+            SLOT(updateUndoAction()));
+    connect(d_project->undoStack(), SIGNAL(indexChanged(int)), this, SLOT(updateUndoAction()));
+    connect(UndoStorage::instance(), SIGNAL(historyDiscarded(QUndoStack *)), this,
+            SLOT(updateUndoAction()));
     connect(d_project->undoStack(), SIGNAL(canRedoChanged(bool)), actionRedo,
             SLOT(setEnabled(bool)));
 }
@@ -1096,6 +1110,9 @@ void ApplicationWindow::initTableAnalysisMenu()
 
     dataMenu->addAction(actionShowColStatistics);
     dataMenu->addAction(actionShowRowStatistics);
+    dataMenu->addAction(actionFilterRows);
+    dataMenu->addAction(actionGroupRows);
+    dataMenu->addAction(actionJoinTables);
 
     dataMenu->addSeparator();
     dataMenu->addAction(actionFFT);
@@ -1795,9 +1812,11 @@ void ApplicationWindow::editSurfacePlot()
         SurfaceDialog *sd = new SurfaceDialog(this);
         sd->setAttribute(Qt::WA_DeleteOnClose);
         connect(sd,
-                SIGNAL(options(const QString &, double, double, double, double, double, double)), g,
+                SIGNAL(options(const QString &, double, double, double, double, double, double,
+                               bool)),
+                g,
                 SLOT(insertFunction(const QString &, double, double, double, double, double,
-                                    double)));
+                                    double, bool)));
         connect(sd, SIGNAL(clearFunctionsList()), this, SLOT(clearSurfaceFunctionsList()));
 
         sd->insertFunctionsList(surfaceFunc);
@@ -1805,6 +1824,7 @@ void ApplicationWindow::editSurfacePlot()
             sd->setFunction(g->formula());
             sd->setLimits(g->xStart(), g->xStop(), g->yStart(), g->yStop(), g->zStart(),
                           g->zStop());
+            sd->setAdaptiveRefinement(g->adaptiveRefinement());
         }
         sd->exec();
     }
@@ -1814,8 +1834,11 @@ void ApplicationWindow::newSurfacePlot()
 {
     SurfaceDialog *sd = new SurfaceDialog(this);
     sd->setAttribute(Qt::WA_DeleteOnClose);
-    connect(sd, SIGNAL(options(const QString &, double, double, double, double, double, double)),
-            this, SLOT(newPlot3D(const QString &, double, double, double, double, double, double)));
+    connect(sd,
+            SIGNAL(options(const QString &, double, double, double, double, double, double, bool)),
+            this,
+            SLOT(newPlot3D(const QString &, double, double, double, double, double, double,
+                           bool)));
     connect(sd, SIGNAL(clearFunctionsList()), this, SLOT(clearSurfaceFunctionsList()));
 
     sd->insertFunctionsList(surfaceFunc);
@@ -1823,13 +1846,13 @@ void ApplicationWindow::newSurfacePlot()
 }
 
 Graph3D *ApplicationWindow::newPlot3D(const QString &formula, double xl, double xr, double yl,
-                                      double yr, double zl, double zr)
+                                      double yr, double zl, double zr, bool adaptive)
 {
     QString label = generateUniqueName(tr("Graph"));
 
     Graph3D *plot = new Graph3D("", &d_workspace, 0);
     plot->setAttribute(Qt::WA_DeleteOnClose);
-    plot->addFunction(formula, xl, xr, yl, yr, zl, zr);
+    plot->addFunction(formula, xl, xr, yl, yr, zl, zr, adaptive);
     plot->resize(500, 400);
     plot->setWindowTitle(label);
     plot->setName(label);
@@ -1851,11 +1874,12 @@ void ApplicationWindow::updateSurfaceFuncList(const QString &s)
 }
 
 Graph3D *ApplicationWindow::newPlot3D(const QString &caption, const QString &formula, double xl,
-                                      double xr, double yl, double yr, double zl, double zr)
+                                      double xr, double yl, double yr, double zl, double zr,
+                                      bool adaptive)
 {
     Graph3D *plot = new Graph3D("", &d_workspace, 0);
     plot->setAttribute(Qt::WA_DeleteOnClose);
-    plot->addFunction(formula, xl, xr, yl, yr, zl, zr);
+    plot->addFunction(formula, xl, xr, yl, yr, zl, zr, adaptive);
     plot->update();
 
     QString label = caption;
@@ -2527,6 +2551,8 @@ TableStatistics *ApplicationWindow::newTableStatistics(Table *base, int type, QL
         s->setName(caption);
 
     d_project->addChild(s->d_future_table);
+    connect(base, SIGNAL(modifiedRows(Table *, const QString &, int, int)), s,
+            SLOT(markModifiedRows(Table *, const QString &, int, int)));
     connect(base, SIGNAL(modifiedData(Table *, const QString &)), s,
             SLOT(update(Table *, const QString &)));
     connect(base, SIGNAL(changedColHeader(const QString &, const QString &)), s,
@@ -2537,22 +2563,154 @@ TableStatistics *ApplicationWindow::newTableStatistics(Table *base, int type, QL
     return s;
 }
 
+/*
+ * !creates a new table showing the rows of table base which satisfy condition
+ */
+FilteredTable *ApplicationWindow::newFilteredTable(Table *base, const QString &condition,
+                                                   const QString &caption)
+{
+    FilteredTable *f = new FilteredTable(scriptEnv, &d_workspace, base, condition);
+    if (!caption.isEmpty())
+        f->setName(caption);
+
+    d_project->addChild(f->d_future_table);
+    connect(base, SIGNAL(modifiedRows(Table *, const QString &, int, int)), f,
+            SLOT(markModifiedRows(Table *, const QString &, int, int)));
+    connect(base, SIGNAL(modifiedData(Table *, const QString &)), f,
+            SLOT(update(Table *, const QString &)));
+    connect(base, SIGNAL(changedColHeader(const QString &, const QString &)), f, SLOT(rebuild()));
+    connect(base, SIGNAL(removedCol(const QString &)), f, SLOT(rebuild()));
+    connect(base->d_future_table, SIGNAL(aspectAboutToBeRemoved(const AbstractAspect *)), this,
+            SLOT(removeDependentTableStatistics(const AbstractAspect *)));
+    return f;
+}
+
+Table *ApplicationWindow::newGroupedTable(Table *base, const QString &keys,
+                                          const QString &aggregates, bool live,
+                                          const QString &caption, QString *error)
+{
+    GroupedTable::Specification specification =
+            GroupedTable::Specification::parse(keys, aggregates, base->d_future_table);
+    if (!specification.isValid()) {
+        if (error)
+            *error = specification.error;
+        return 0;
+    }
+    if (!live) {
+        Table *t = newTable(1, 1, caption.isEmpty() ? base->name() + "-" + tr("Groups") : caption);
+        GroupedTable::aggregate(base, specification, t);
+        return t;
+    }
+
+    GroupedTable *g = new GroupedTable(scriptEnv, &d_workspace, base, keys, aggregates);
+    if (!caption.isEmpty())
+        g->setName(caption);
+
+    d_project->addChild(g->d_future_table);
+    connect(base, SIGNAL(modifiedData(Table *, const QString &)), g,
+            SLOT(update(Table *, const QString &)));
+    connect(base, SIGNAL(changedColHeader(const QString &, const QString &)), g,
+            SLOT(recompute()));
+    connect(base, SIGNAL(removedCol(const QString &)), g, SLOT(recompute()));
+    connect(base->d_future_table, SIGNAL(aspectAboutToBeRemoved(const AbstractAspect *)), this,
+            SLOT(removeDependentTableStatistics(const AbstractAspect *)));
+    return g;
+}
+
+Table *ApplicationWindow::newJoinedTable(Table *left, Table *right, const QString &left_keys,
+                                         const QString &right_keys, int type, double tolerance,
+                                         const QString &caption, QString *error)
+{
+    auto fail = [error](const QString &message) {
+        if (error)
+            *error = message;
+        return (Table *)0;
+    };
+    if (type < TableJoin::Inner || type > TableJoin::Nearest)
+        return fail(tr("Unknown kind of join %1.").arg(type));
+    // the key lists are read like those of grouped tables
+    GroupedTable::Specification lspec =
+            GroupedTable::Specification::parse(left_keys, QString(), left->d_future_table);
+    GroupedTable::Specification rspec = GroupedTable::Specification::parse(
+            right_keys.trimmed().isEmpty() ? left_keys : right_keys, QString(),
+            right->d_future_table);
+    if (!lspec.isValid())
+        return fail(lspec.error);
+    if (!rspec.isValid())
+        return fail(rspec.error);
+    if (lspec.keys.isEmpty())
+        return fail(tr("Please choose at least one key column."));
+    if (lspec.keys.size() != rspec.keys.size())
+        return fail(tr("Both tables have to be joined on the same number of key columns."));
+
+    TableJoin join(left->numRows(), right->numRows(), TableJoin::Type(type));
+    QList<Column *> left_key_columns, right_key_columns;
+    for (int i = 0; i < lspec.keys.size(); i++) {
+        Column *l = left->d_future_table->column(lspec.keys.at(i), false);
+        Column *r = right->d_future_table->column(rspec.keys.at(i), false);
+        if (l->dataType() != r->dataType())
+            return fail(tr("The key columns %1 and %2 do not have the same type.")
+                                .arg(l->name(), r->name()));
+        join.addKey(l, r);
+        left_key_columns << l;
+        right_key_columns << r;
+    }
+    if (type == TableJoin::Nearest
+        && left_key_columns.last()->dataType() == SciDAVis::TypeQString)
+        return fail(tr("The last key column of a nearest key join has to hold numbers or "
+                       "dates and times."));
+    // the keys of dates and times are compared in milliseconds
+    if (left_key_columns.last()->dataType() == SciDAVis::TypeQDateTime && tolerance > 0)
+        tolerance *= 1000;
+    join.setTolerance(tolerance);
+
+    QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
+    join.join();
+
+    // the columns of left, with the keys of unmatched rows of right, then the other columns of
+    // right
+    QList<TableJoin::Output> outputs;
+    QStringList names;
+    for (int i = 0; i < left->numCols(); i++) {
+        Column *column = left->column(i);
+        const int key = left_key_columns.indexOf(column);
+        outputs << TableJoin::Output{ column->name(), column,
+                                      key >= 0 ? right_key_columns.at(key) : nullptr };
+        names << column->name();
+    }
+    for (int i = 0; i < right->numCols(); i++) {
+        Column *column = right->column(i);
+        if (right_key_columns.contains(column))
+            continue;
+        QString name = column->name();
+        if (names.contains(name))
+            name += "_" + right->name();
+        outputs << TableJoin::Output{ name, nullptr, column };
+    }
+    Table *t = newTable(caption.isEmpty() ? left->name() + "-" + tr("Join") : caption,
+                        tr("Join of %1 and %2").arg(left->name(), right->name()),
+                        join.columns(outputs));
+    QApplication::restoreOverrideCursor();
+    return t;
+}
+
 void ApplicationWindow::removeDependentTableStatistics(const AbstractAspect *aspect)
 {
     ::future::Table *future_table =
             qobject_cast<::future::Table *>(const_cast<AbstractAspect *>(aspect));
     if (!future_table)
         return;
+    Table *table = qobject_cast<Table *>(future_table->view());
+    if (!table)
+        return;
     QList<MyWidget *> windows = windowsList();
     foreach (MyWidget *win, windows) {
         TableStatistics *table_stat = qobject_cast<TableStatistics *>(win);
-        if (!table_stat)
-            continue;
-        Table *table = qobject_cast<Table *>(future_table->view());
-        if (!table)
-            continue;
-        if (table_stat->base() == table)
-            d_project->removeChild(table_stat->d_future_table);
+        FilteredTable *filtered = qobject_cast<FilteredTable *>(win);
+        GroupedTable *grouped = qobject_cast<GroupedTable *>(win);
+        if ((table_stat && table_stat->base() == table) || (filtered && filtered->base() == table)
+            || (grouped && grouped->base() == table))
+            d_project->removeChild(static_cast<Table *>(win)->d_future_table);
     }
 }
 
@@ -2940,19 +3098,100 @@ void ApplicationWindow::removeCurves(const QString &name)
 
 void ApplicationWindow::updateCurves(Table *t, const QString &name)
 {
+    // rows announced by markModifiedRows(), or all rows
+    Interval<int> rows = modifiedCurveRows.take(name);
+    QStringList &names = pendingCurveColumns[t];
+    if (!names.contains(name)) {
+        names << name;
+        pendingCurveRows[name] = rows;
+    } else {
+        Interval<int> &pending = pendingCurveRows[name];
+        if (!pending.isValid() || !rows.isValid())
+            pending = Interval<int>();
+        else
+            pending = Interval<int>(qMin(pending.start(), rows.start()),
+                                    qMax(pending.end(), rows.end()));
+    }
+    if (!curvesTimerId)
+        curvesTimerId = startTimer(0);
+}
+
+void ApplicationWindow::markModifiedRows(Table *t, const QString &name, int first, int last)
+{
+    Q_UNUSED(t);
+    Interval<int> rows(first, last);
+    if (modifiedCurveRows.contains(name))
+        rows = Interval<int>(qMin(first, modifiedCurveRows[name].start()),
+                             qMax(last, modifiedCurveRows[name].end()));
+    modifiedCurveRows[name] = rows;
+}
+
+void ApplicationWindow::updatePendingCurves()
+{
+    killTimer(curvesTimerId);
+    curvesTimerId = 0;
+    if (pendingCurveColumns.isEmpty())
+        return;
+    QHash<Table *, QStringList> changes;
+    changes.swap(pendingCurveColumns);
+    QHash<QString, Interval<int>> rows;
+    rows.swap(pendingCurveRows);
+
+    // index the 2D layers by the columns their curves are plotted from, so that each layer is
+    // only visited if one of its columns changed and then updated once for all of its columns
     QList<MyWidget *> windows = windowsList();
+    QHash<QPair<Table *, QString>, QList<Graph *>> graphsByColumn;
+    QSet<Table *> tables;
     foreach (MyWidget *w, windows) {
-        if (w->inherits("MultiLayer")) {
+        if (w->inherits("Table"))
+            tables << (Table *)w;
+        else if (w->inherits("MultiLayer")) {
             QWidgetList graphsList = ((MultiLayer *)w)->graphPtrs();
             for (int k = 0; k < (int)graphsList.count(); k++) {
                 Graph *g = (Graph *)graphsList.at(k);
-                if (g)
-                    g->updateCurvesData(t, name);
+                if (!g)
+                    continue;
+                for (int i = 0; i < g->curves(); i++) {
+                    PlotCurve *pc = (PlotCurve *)g->curve(i);
+                    if (!pc || pc->type() == Graph::Function)
+                        continue;
+                    DataCurve *c = (DataCurve *)pc;
+                    if (!c->table())
+                        continue;
+                    foreach (const QString &column, c->columnNames()) {
+                        QList<Graph *> &graphs = graphsByColumn[qMakePair(c->table(), column)];
+                        if (!graphs.contains(g))
+                            graphs << g;
+                    }
+                }
             }
-        } else if (w->inherits("Graph3D")) {
-            Graph3D *g = (Graph3D *)w;
-            if ((g->formula()).contains(name))
-                g->updateData(t);
+        }
+    }
+
+    QHash<Graph *, QHash<Table *, QStringList>> graphChanges;
+    for (auto it = changes.constBegin(); it != changes.constEnd(); ++it) {
+        // skip tables closed since the change
+        if (!tables.contains(it.key()))
+            continue;
+        foreach (const QString &name, it.value())
+            foreach (Graph *g, graphsByColumn.value(qMakePair(it.key(), name)))
+                graphChanges[g][it.key()] << name;
+    }
+    for (auto it = graphChanges.constBegin(); it != graphChanges.constEnd(); ++it)
+        it.key()->updateCurvesData(it.value(), rows);
+
+    foreach (MyWidget *w, windows) {
+        if (!w->inherits("Graph3D"))
+            continue;
+        Graph3D *g = (Graph3D *)w;
+        for (auto it = changes.constBegin(); it != changes.constEnd(); ++it) {
+            if (!tables.contains(it.key()))
+                continue;
+            foreach (const QString &name, it.value())
+                if ((g->formula()).contains(name)) {
+                    g->updateData(it.key());
+                    break;
+                }
         }
     }
 }
@@ -2981,6 +3220,14 @@ void ApplicationWindow::setSaveSettings(bool autoSaving, int min)
         savingTimerId = 0;
 }
 
+void ApplicationWindow::setUndoStorageSettings(int memoryLimit, bool spillToDisk)
+{
+    undoMemoryLimit = memoryLimit;
+    undoSpillToDisk = spillToDisk;
+    UndoStorage::instance()->setBudget(qint64(undoMemoryLimit) << 20);
+    UndoStorage::instance()->setSpillingEnabled(undoSpillToDisk);
+}
+
 void ApplicationWindow::changeAppStyle(const QString &s)
 {
     // style keys are case insensitive
@@ -3693,6 +3940,22 @@ bool ApplicationWindow::loadProject(const QString &fn)
             }
             lst.pop_back();
             openTableStatistics(lst);
+        } else if (s.left(15) == "<FilteredTable>") {
+            QStringList lst;
+            while (s != "</FilteredTable>") {
+                s = t.readLine();
+                lst << s;
+            }
+            lst.pop_back();
+            openFilteredTable(lst);
+        } else if (s.left(14) == "<GroupedTable>") {
+            QStringList lst;
+            while (s != "</GroupedTable>") {
+                s = t.readLine();
+                lst << s;
+            }
+            lst.pop_back();
+            openGroupedTable(lst);
         } else if (s == "<matrix>") {
             title = titleBase + QString::number(++aux) + "/" + QString::number(widgets);
             progress.setLabelText(title);
@@ -4151,6 +4414,8 @@ void ApplicationWindow::readSettings()
     changeAppStyle(settings.value("/Style", appStyle).toString());
     undoLimit = settings.value("/UndoLimit", 10).toInt();
     d_project->undoStack()->setUndoLimit(undoLimit);
+    setUndoStorageSettings(settings.value("/UndoMemoryLimit", 1024).toInt(),
+                           settings.value("/UndoSpillToDisk", false).toBool());
     autoSave = settings.value("/AutoSave", true).toBool();
     autoSaveTime = settings.value("/AutoSaveTime", 15).toInt();
     defaultScriptingLang = settings.value("/ScriptingLang", "muParser").toString();
@@ -4419,6 +4684,8 @@ void ApplicationWindow::saveSettings()
     settings.setValue("/AutoSave", autoSave);
     settings.setValue("/AutoSaveTime", autoSaveTime);
     settings.setValue("/UndoLimit", undoLimit);
+    settings.setValue("/UndoMemoryLimit", undoMemoryLimit);
+    settings.setValue("/UndoSpillToDisk", undoSpillToDisk);
     settings.setValue("/ScriptingLang", defaultScriptingLang);
     settings.setValue("/Locale", QLocale().name());
     settings.setValue("/LocaleUseGroupSeparator",
@@ -4652,6 +4919,8 @@ void ApplicationWindow::saveSettings()
 
 void ApplicationWindow::exportGraph()
 {
+    updatePendingCurves();
+
     QWidget *w = d_workspace.activeSubWindow();
     if (!w)
         return;
@@ -4722,6 +4991,8 @@ void ApplicationWindow::exportGraph()
 
 void ApplicationWindow::exportLayer()
 {
+    updatePendingCurves();
+
     QWidget *w = d_workspace.activeSubWindow();
     if (!w || !w->inherits("MultiLayer"))
         return;
@@ -4770,6 +5041,8 @@ void ApplicationWindow::exportLayer()
 
 void ApplicationWindow::exportAllGraphs()
 {
+    updatePendingCurves();
+
     ImageExportDialog *ied = new ImageExportDialog(this, true, d_extended_export_dialog);
     ied->setWindowTitle(tr("Choose a directory to export the graphs to"));
     QStringList tmp = ied->nameFilters();
@@ -4798,6 +5071,8 @@ void ApplicationWindow::exportAllGraphs()
     bool confirm_overwrite = true;
     MultiLayer *plot2D;
     Graph3D *plot3D;
+    // 2D plots are recorded here and written concurrently at the end
+    GraphExporter exporter(QString(file_suffix).remove("."), ied->quality(), ied->color());
 
     foreach (MyWidget *w, windows) {
         if (w->inherits("MultiLayer")) {
@@ -4836,6 +5111,7 @@ void ApplicationWindow::exportAllGraphs()
                 QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
                 break;
             case 2:
+                // the windows recorded so far are discarded with the exporter
                 return;
             }
         }
@@ -4848,6 +5124,9 @@ void ApplicationWindow::exportAllGraphs()
                             .arg(file_name));
             return;
         }
+        f.close();
+        if (plot2D && exporter.add(plot2D, file_name))
+            continue;
         if (file_suffix.contains(".eps") || file_suffix.contains(".pdf")
             || file_suffix.contains(".ps")) {
             if (plot3D)
@@ -4870,7 +5149,60 @@ void ApplicationWindow::exportAllGraphs()
         }
     }
 
+    QStringList failed = exporter.exportAll();
     QApplication::restoreOverrideCursor();
+    if (!failed.isEmpty())
+        QMessageBox::critical(
+                this, tr("Export Error"),
+                tr("Could not write to file: <br><h4>%1</h4><p>"
+                   "Please verify that you have the right to write to this location!")
+                        .arg(failed.join("<br>")));
+}
+
+bool ApplicationWindow::exportGraphs(const QString &directory, const QString &format,
+                                     const QStringList &names)
+{
+    updatePendingCurves();
+
+    if (!GraphExporter::isSupported(format)) {
+        std::cerr << tr("Unsupported export format: %1").arg(format).toStdString() << std::endl;
+        return false;
+    }
+
+    GraphExporter exporter(format);
+    QStringList exported;
+    foreach (MyWidget *w, windowsList()) {
+        if (!names.isEmpty() && !names.contains(w->objectName()))
+            continue;
+        QString file_name = directory + "/" + w->objectName() + "." + format;
+        if (w->inherits("MultiLayer")) {
+            MultiLayer *plot = (MultiLayer *)w;
+            if (plot->isEmpty())
+                continue;
+            if (!exporter.add(plot, file_name))
+                plot->exportToFile(file_name);
+        } else if (w->inherits("Graph3D")) {
+            Graph3D *plot = (Graph3D *)w;
+            if (format == "eps" || format == "pdf" || format == "ps")
+                plot->exportVector(file_name, format);
+            else if (format != "svg")
+                plot->exportImage(file_name);
+        } else
+            continue;
+        exported << w->objectName();
+    }
+
+    bool ok = true;
+    foreach (const QString &name, names)
+        if (!exported.contains(name)) {
+            std::cerr << tr("No plot window called %1").arg(name).toStdString() << std::endl;
+            ok = false;
+        }
+    foreach (const QString &file_name, exporter.exportAll()) {
+        std::cerr << tr("Could not write to file: %1").arg(file_name).toStdString() << std::endl;
+        ok = false;
+    }
+    return ok;
 }
 
 QString ApplicationWindow::windowGeometryInfo(MyWidget *w)
@@ -5567,6 +5899,50 @@ void ApplicationWindow::showRowStatistics()
         QMessageBox::warning(this, tr("Row selection error"), tr("Please select a row first!"));
 }
 
+void ApplicationWindow::showFilterRows()
+{
+    if (!d_workspace.activeSubWindow() || !d_workspace.activeSubWindow()->inherits("Table"))
+        return;
+    Table *t = (Table *)d_workspace.activeSubWindow();
+
+    bool ok;
+    QString condition = QInputDialog::getText(
+            this, tr("Filter Rows"),
+            tr("Show the rows of %1 where (e.g. temp > 300 && status == \"ok\"):").arg(t->name()),
+            QLineEdit::Normal, QString(), &ok);
+    if (!ok || condition.trimmed().isEmpty())
+        return;
+
+    RowPredicate predicate(condition, t->d_future_table);
+    if (!predicate.isValid()) {
+        QMessageBox::critical(this, tr("Invalid condition"), predicate.errorString());
+        return;
+    }
+    newFilteredTable(t, condition)->showNormal();
+}
+
+void ApplicationWindow::showGroupRows()
+{
+    if (!d_workspace.activeSubWindow() || !d_workspace.activeSubWindow()->inherits("Table"))
+        return;
+    Table *t = (Table *)d_workspace.activeSubWindow();
+
+    GroupRowsDialog *gd = new GroupRowsDialog(t, this);
+    gd->setAttribute(Qt::WA_DeleteOnClose);
+    gd->show();
+}
+
+void ApplicationWindow::showJoinTables()
+{
+    if (!d_workspace.activeSubWindow() || !d_workspace.activeSubWindow()->inherits("Table"))
+        return;
+    Table *t = (Table *)d_workspace.activeSubWindow();
+
+    JoinTablesDialog *jd = new JoinTablesDialog(t, this);
+    jd->setAttribute(Qt::WA_DeleteOnClose);
+    jd->show();
+}
+
 void ApplicationWindow::plot2VerticalLayers()
 {
     multilayerPlot(1, 2, defaultCurveStyle);
@@ -6117,6 +6493,8 @@ void ApplicationWindow::movePoints()
 
 void ApplicationWindow::exportPDF()
 {
+    updatePendingCurves();
+
     QWidget *w = d_workspace.activeSubWindow();
     if (!w)
         return;
@@ -6157,6 +6535,8 @@ void ApplicationWindow::exportPDF()
 
 void ApplicationWindow::print(MyWidget *w)
 {
+    updatePendingCurves();
+
     if (w->inherits("MultiLayer") && ((MultiLayer *)w)->isEmpty()) {
         QMessageBox::warning(this, tr("Warning"),
                              tr("<h4>There are no plot layers available in this window.</h4>"));
@@ -6189,6 +6569,8 @@ void ApplicationWindow::printWindow()
 
 void ApplicationWindow::printAllPlots()
 {
+    updatePendingCurves();
+
     QPrinter printer;
     printer.setPageOrientation(QPageLayout::Landscape);
     printer.setColorMode(QPrinter::Color);
@@ -7068,7 +7450,7 @@ MyWidget *ApplicationWindow::clone(MyWidget *w)
         QString s = g->formula();
         if (g->userFunction())
             nw = newPlot3D(caption, s, g->xStart(), g->xStop(), g->yStart(), g->yStop(),
-                           g->zStart(), g->zStop());
+                           g->zStart(), g->zStop(), g->adaptiveRefinement());
         else if (s.endsWith("(Z)"))
             nw = dataPlotXYZ(caption, s, g->xStart(), g->xStop(), g->yStart(), g->yStop(),
                              g->zStart(), g->zStop());
@@ -7122,11 +7504,19 @@ MyWidget *ApplicationWindow::clone(MyWidget *w)
 
 void ApplicationWindow::undo()
 {
+    // discarded commands would be dropped without undoing anything
+    if (!UndoStorage::canUndo(d_project->undoStack()))
+        return;
     QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
     d_project->undoStack()->undo();
     QApplication::restoreOverrideCursor();
 }
 
+void ApplicationWindow::updateUndoAction()
+{
+    actionUndo->setEnabled(UndoStorage::canUndo(d_project->undoStack()));
+}
+
 void ApplicationWindow::redo()
 {
     QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
@@ -7486,6 +7876,8 @@ void ApplicationWindow::timerEvent(QTimerEvent *e)
 {
     if (e->timerId() == savingTimerId)
         saveProject();
+    else if (e->timerId() == curvesTimerId)
+        updatePendingCurves();
     else
         QWidget::timerEvent(e);
 }
@@ -9251,6 +9643,71 @@ TableStatistics *ApplicationWindow::openTableStatistics(const QStringList &flist
     return w;
 }
 
+FilteredTable *ApplicationWindow::openFilteredTable(const QStringList &flist)
+{
+    QStringList::const_iterator line = flist.begin();
+
+    QStringList list = (*line++).split("\t");
+    QString caption = list[0];
+    QString condition = (*line).section('\t', 1);
+
+    Table *base = table(list[1]);
+    if (!base)
+        return 0;
+    FilteredTable *w = newFilteredTable(base, condition, caption);
+
+    setListViewDate(caption, list[2]);
+    w->setBirthDate(list[2]);
+
+    for (line++; line != flist.end(); line++) {
+        QStringList fields = (*line).split("\t");
+        if (fields[0] == "geometry") {
+            restoreWindowGeometry(this, w, *line);
+        } else if (fields[0] == "ColWidth") {
+            fields.pop_front();
+            w->setColWidths(fields);
+        } else if (fields[0] == "WindowLabel") {
+            w->setWindowLabel(fields[1]);
+            w->setCaptionPolicy((MyWidget::CaptionPolicy)fields[2].toInt());
+            setListViewLabel(w->name(), fields[1]);
+        }
+    }
+    return w;
+}
+
+GroupedTable *ApplicationWindow::openGroupedTable(const QStringList &flist)
+{
+    QStringList::const_iterator line = flist.begin();
+
+    QStringList list = (*line++).split("\t");
+    QString caption = list[0];
+    QString keys = (*line++).section('\t', 1);
+    QString aggregates = (*line).section('\t', 1);
+
+    GroupedTable *w = qobject_cast<GroupedTable *>(
+            newGroupedTable(table(list[1]), keys, aggregates, true, caption));
+    if (!w)
+        return 0;
+
+    setListViewDate(caption, list[2]);
+    w->setBirthDate(list[2]);
+
+    for (line++; line != flist.end(); line++) {
+        QStringList fields = (*line).split("\t");
+        if (fields[0] == "geometry") {
+            restoreWindowGeometry(this, w, *line);
+        } else if (fields[0] == "ColWidth") {
+            fields.pop_front();
+            w->setColWidths(fields);
+        } else if (fields[0] == "WindowLabel") {
+            w->setWindowLabel(fields[1]);
+            w->setCaptionPolicy((MyWidget::CaptionPolicy)fields[2].toInt());
+            setListViewLabel(w->name(), fields[1]);
+        }
+    }
+    return w;
+}
+
 Graph *ApplicationWindow::openGraph(ApplicationWindow *app, MultiLayer *plot,
                                     const QStringList &list)
 {
@@ -9867,7 +10324,7 @@ Graph3D *ApplicationWindow::openSurfacePlot(ApplicationWindow *app, const QStrin
     else
         plot = app->newPlot3D(caption, fList[1], fList[2].toDouble(), fList[3].toDouble(),
                               fList[4].toDouble(), fList[5].toDouble(), fList[6].toDouble(),
-                              fList[7].toDouble());
+                              fList[7].toDouble(), fList.value(8) == "adaptive");
 
     if (!plot)
         return 0;
@@ -10007,6 +10464,8 @@ Graph3D *ApplicationWindow::openSurfacePlot(ApplicationWindow *app, const QStrin
 
 void ApplicationWindow::copyActiveLayer()
 {
+    updatePendingCurves();
+
     if (!d_workspace.activeSubWindow() || !d_workspace.activeSubWindow()->inherits("MultiLayer"))
         return;
 
@@ -10067,6 +10526,26 @@ void ApplicationWindow::analyzeCurve(Graph *g, const QString &whichFit, const QS
                 fitter->showLegend();
             delete fitter;
         }
+    } else if (whichFit == "fitMultiPeakGauss" || whichFit == "fitMultiPeakLorentz") {
+        MultiPeakFit::PeakProfile profile =
+                whichFit == "fitMultiPeakGauss" ? MultiPeakFit::Gauss : MultiPeakFit::Lorentz;
+        MultiPeakFit *fitter = new MultiPeakFit(this, g, profile);
+        if (fitter->setDataFromCurve(curveTitle)) {
+            if (fitter->findPeaks()) {
+                fitter->enablePeakCurves(generatePeakCurves);
+                fitter->setPeakCurvesColor(peakCurvesColor);
+                fitter->enableIndependentRegions(true);
+                fitter->scaleErrors(fit_scale_errors);
+                fitter->setOutputPrecision(fit_output_precision);
+                fitter->generateFunction(generateUniformFitPoints, fitPoints);
+                fitter->fit();
+                if (pasteFitResultsToPlot)
+                    fitter->showLegend();
+            } else
+                QMessageBox::warning(this, tr("Warning"),
+                                     tr("No peaks were found in the data set %1!").arg(curveTitle));
+        }
+        delete fitter;
     } else if (whichFit == "differentiate") {
         Differentiation *diff = new Differentiation(this, g, curveTitle);
         diff->run();
@@ -10199,6 +10678,8 @@ void ApplicationWindow::connectTable(Table *w)
     connect(w, SIGNAL(closedWindow(MyWidget *)), this, SLOT(closeWindow(MyWidget *)));
     connect(w, SIGNAL(aboutToRemoveCol(const QString &)), this,
             SLOT(removeCurves(const QString &)));
+    connect(w, SIGNAL(modifiedRows(Table *, const QString &, int, int)), this,
+            SLOT(markModifiedRows(Table *, const QString &, int, int)));
     connect(w, SIGNAL(modifiedData(Table *, const QString &)), this,
             SLOT(updateCurves(Table *, const QString &)));
     connect(w, SIGNAL(modifiedWindow(MyWidget *)), this, SLOT(modifiedProject(MyWidget *)));
@@ -10555,6 +11036,15 @@ void ApplicationWindow::createActions()
             new QAction(QIcon(QPixmap(":/stat_rows.xpm")), tr("Statistics on &Rows"), this);
     connect(actionShowRowStatistics, SIGNAL(triggered()), this, SLOT(showRowStatistics()));
 
+    actionFilterRows = new QAction(tr("&Filter Rows..."), this);
+    connect(actionFilterRows, SIGNAL(triggered()), this, SLOT(showFilterRows()));
+
+    actionGroupRows = new QAction(tr("&Group Rows..."), this);
+    connect(actionGroupRows, SIGNAL(triggered()), this, SLOT(showGroupRows()));
+
+    actionJoinTables = new QAction(tr("&Join Tables..."), this);
+    connect(actionJoinTables, SIGNAL(triggered()), this, SLOT(showJoinTables()));
+
     actionShowIntDialog = new QAction(tr("&Integrate ..."), this);
     connect(actionShowIntDialog, SIGNAL(triggered()), this, SLOT(showIntegrationDialog()));
 
@@ -11093,6 +11583,13 @@ void ApplicationWindow::translateActionsStrings()
 
     actionShowRowStatistics->setText(tr("Statistics on &Rows"));
     actionShowRowStatistics->setToolTip(tr("Selected rows statistics"));
+    actionFilterRows->setText(tr("&Filter Rows..."));
+    actionFilterRows->setToolTip(tr("Show the rows which satisfy a condition in a new table"));
+    actionGroupRows->setText(tr("&Group Rows..."));
+    actionGroupRows->setToolTip(tr("Aggregate the groups of rows with equal keys in a new table"));
+    actionJoinTables->setText(tr("&Join Tables..."));
+    actionJoinTables->setToolTip(tr("Combine the rows of two tables with matching keys in a new "
+                                    "table"));
     actionShowIntDialog->setText(tr("&Integrate ..."));
     actionInterpolate->setText(tr("Inte&rpolate ..."));
     actionLowPassFilter->setText(tr("&Low Pass..."));
@@ -11655,9 +12152,12 @@ void ApplicationWindow::fitMultiPeak(int profile)
         return;
     } else {
         bool ok;
-        int peaks = QInputDialog::getInt(this, tr("Enter the number of peaks"), tr("Peaks"), 2, 2,
-                                         1000000, 1, &ok);
-        if (ok && peaks) {
+        int peaks = QInputDialog::getInt(this, tr("Enter the number of peaks"),
+                                         tr("Peaks (0 = find automatically)"), 2, 0, 1000000, 1,
+                                         &ok);
+        if (ok && !peaks)
+            analysis(profile == MultiPeakFit::Gauss ? "fitMultiPeakGauss" : "fitMultiPeakLorentz");
+        else if (ok && peaks) {
             g->setActiveTool(new MultiPeakFitTool(g, this, (MultiPeakFit::PeakProfile)profile,
                                                   peaks, d_status_info,
                                                   SLOT(setText(const QString &))));
@@ -11687,23 +12187,39 @@ void ApplicationWindow::showBugTracker()
     QDesktopServices::openUrl(QUrl(BUGREPORT_URI));
 }
 
-void ApplicationWindow::parseCommandLineArguments(const QStringList &args)
+int ApplicationWindow::parseCommandLineArguments(const QStringList &args)
 {
     int num_args = args.count();
     if (num_args == 0)
-        return;
+        return -1;
+
+    // with --export nothing is shown, so errors go to stderr and end SciDAVis with exit code 1
+    bool headless = false;
+    for (const QString &arg : args)
+        if (arg.startsWith("--export="))
+            headless = true;
+    auto error = [&](const QString &title, const QString &message) {
+        if (headless)
+            std::cerr << QString(message).remove(QRegExp("<[^>]*>")).toStdString() << std::endl;
+        else
+            QMessageBox::critical(this, title, message);
+    };
 
     QString str;
     bool exec = false;
+    QString export_dir, export_format = "png";
+    QStringList export_windows;
     int scriptArg = 0;
     //	foreach(str, args){
     for (int i = 0; i < num_args; ++i) {
         str = args[i];
         if ((str == "-a" || str == "--about") || (str == "-m" || str == "--manual")) {
-            QMessageBox::critical(this, tr("Error"),
-                                  tr("<b> %1 </b>: This command line option must be used without "
-                                     "other arguments!")
-                                          .arg(str));
+            error(tr("Error"),
+                  tr("<b> %1 </b>: This command line option must be used without other "
+                     "arguments!")
+                          .arg(str));
+            if (headless)
+                return 1;
         } else if (str == "-v" || str == "--version") {
             QString s = SciDAVis::versionString() + SciDAVis::extraVersion() + "\n";
             s += QObject::tr("Released") + ": " + SciDAVis::releaseDateString() + "\n";
@@ -11729,6 +12245,17 @@ void ApplicationWindow::parseCommandLineArguments(const QStringList &args)
             s += "-v " + tr("or") + " --version: " + tr("print SciDAVis version and release date")
                     + "\n";
             s += "-x " + tr("or") + " --execute: " + tr("execute the script file given as argument")
+                    + "\n";
+            s += "--export=DIR: "
+                    + tr("export the plot windows of the project given as argument to the "
+                         "directory DIR and exit without showing the project")
+                    + "\n";
+            s += "--export-format=FMT: "
+                    + tr("file format (suffix) used by --export, e.g. png, svg or pdf (default: "
+                         "png)")
+                    + "\n";
+            s += "--export-windows=W1,W2,...: "
+                    + tr("names of the windows exported by --export (default: all plots)")
                     + "\n\n";
 #ifdef ORIGIN_IMPORT
             s += "'" + tr("file") + "_" + tr("name") + "' "
@@ -11751,18 +12278,28 @@ void ApplicationWindow::parseCommandLineArguments(const QStringList &args)
             if (locales.contains(locale))
                 switchToLanguage(locale);
 
-            if (!locales.contains(locale))
-                QMessageBox::critical(
-                        this, tr("Error"),
-                        tr("<b> %1 </b>: Wrong locale option or no translation available!")
-                                .arg(locale));
+            if (!locales.contains(locale)) {
+                error(tr("Error"),
+                      tr("<b> %1 </b>: Wrong locale option or no translation available!")
+                              .arg(locale));
+                if (headless)
+                    return 1;
+            }
         } else if (str.startsWith("--execute") || str.startsWith("-x"))
             exec = true;
+        else if (str.startsWith("--export="))
+            export_dir = str.mid(str.indexOf('=') + 1);
+        else if (str.startsWith("--export-format="))
+            export_format = str.mid(str.indexOf('=') + 1).toLower();
+        else if (str.startsWith("--export-windows="))
+            export_windows = str.mid(str.indexOf('=') + 1).split(",");
         else if (str.startsWith("-") || str.startsWith("--")) {
-            QMessageBox::critical(this, tr("Error"),
-                                  tr("<b> %1 </b> unknown command line option!").arg(str) + "\n"
-                                          + tr("Type %1 to see the list of the valid options.")
-                                                    .arg("'scidavis -h'"));
+            error(tr("Error"),
+                  tr("<b> %1 </b> unknown command line option!").arg(str) + "\n"
+                          + tr("Type %1 to see the list of the valid options.")
+                                    .arg("'scidavis -h'"));
+            if (headless)
+                return 1;
         }
         if (str.startsWith("-"))
             scriptArg = i; // save last flag
@@ -11776,41 +12313,62 @@ void ApplicationWindow::parseCommandLineArguments(const QStringList &args)
     for (auto i = scriptArg + 1; i < num_args; ++i)
         scriptArgs << args[i];
 
-    if (file_name.startsWith("-"))
-        return; // no file name given
+    if (file_name.startsWith("-") || file_name.isEmpty()) { // no file name given
+        if (!headless)
+            return -1;
+        error(tr("Error"), tr("<b>%1</b> needs the project file to export").arg("--export"));
+        return 1;
+    }
 
-    if (!file_name.isEmpty()) {
-        QFileInfo fi(file_name);
-        if (fi.isDir()) {
-            QMessageBox::critical(
-                    this, tr("File opening error"),
-                    tr("<b>%1</b> is a directory, please specify a file name!").arg(file_name));
-            return;
-        } else if (!fi.isReadable()) {
-            QMessageBox::critical(this, tr("File opening error"),
-                                  tr("You don't have the permission to open this file: <b>%1</b>")
-                                          .arg(file_name));
-            return;
-        } else if (!fi.exists()) {
-            QMessageBox::critical(this, tr("File opening error"),
-                                  tr("The file: <b>%1</b> doesn't exist!").arg(file_name));
-            return;
+    QFileInfo fi(file_name);
+    QString file_error;
+    if (fi.isDir())
+        file_error = tr("<b>%1</b> is a directory, please specify a file name!").arg(file_name);
+    else if (!fi.exists())
+        file_error = tr("The file: <b>%1</b> doesn't exist!").arg(file_name);
+    else if (!fi.isReadable())
+        file_error = tr("You don't have the permission to open this file: <b>%1</b>")
+                             .arg(file_name);
+    if (!file_error.isEmpty()) {
+        error(tr("File opening error"), file_error);
+        return headless ? 1 : -1;
+    }
+
+    workingDir = fi.absolutePath();
+
+    if (headless) {
+        QFileInfo dir(export_dir);
+        if (export_dir.isEmpty() || !dir.isDir() || !dir.isWritable()) {
+            error(tr("Error"),
+                  tr("<b>%1</b> is not a writable directory").arg(export_dir) + "\n"
+                          + tr("Please give an existing directory to %1.").arg("--export"));
+            return 1;
+        }
+        // load the project into a window which is never shown, export it and quit
+        unique_ptr<ApplicationWindow> app(new ApplicationWindow);
+        app->setAttribute(Qt::WA_DontShowOnScreen);
+        app->applyUserSettings();
+        if (!app->loadProject(file_name)) {
+            error(tr("File opening error"),
+                  tr("Could not open the project <b>%1</b>").arg(file_name));
+            return 1;
         }
+        return app->exportGraphs(export_dir, export_format, export_windows) ? 0 : 1;
+    }
 
-        workingDir = fi.absolutePath();
-        saveSettings(); // the recent projects must be saved
+    saveSettings(); // the recent projects must be saved
 
-        ApplicationWindow *a;
-        if (exec)
-            a = loadScript(file_name, scriptArgs, exec);
-        else
-            a = open(file_name, scriptArgs);
+    ApplicationWindow *a;
+    if (exec)
+        a = loadScript(file_name, scriptArgs, exec);
+    else
+        a = open(file_name, scriptArgs);
 
-        if (a) {
-            a->workingDir = workingDir;
-            close();
-        }
+    if (a) {
+        a->workingDir = workingDir;
+        close();
     }
+    return -1;
 }
 
 void ApplicationWindow::createLanguagesList()
@@ -12244,6 +12802,8 @@ void ApplicationWindow::rawSaveFolder(Folder *folder, QIODevice *device)
 
 void ApplicationWindow::saveFolder(Folder *folder, const QString &fn)
 {
+    updatePendingCurves();
+
     // file saving procedure follows
     // https://bugs.launchpad.net/ubuntu/+source/linux/+bug/317781/comments/54
     QFile f(fn + ".new");
@@ -12457,7 +13017,8 @@ void ApplicationWindow::showFindDialogue()
 {
     FindDialog *fd = new FindDialog(this);
     fd->setAttribute(Qt::WA_DeleteOnClose);
-    fd->exec();
+    // not modal, so that content matches can be inspected in their windows
+    fd->show();
 }
 
 void ApplicationWindow::startRenameFolder()
@@ -39,6 +39,7 @@
 #include <QNetworkReply>
 #endif
 #include <QFile>
+#include <QHash>
 #include <QSplitter>
 #include <QDesktopServices>
 #include <QBuffer>
@@ -86,6 +87,8 @@ class FunctionDialog;
 class Plot3DDialog;
 class MyWidget;
 class TableStatistics;
+class FilteredTable;
+class GroupedTable;
 class CurveRangeDialog;
 class Project;
 class AbstractAspect;
@@ -239,6 +242,8 @@ public slots:
     void saveSettings();
     void applyUserSettings();
     void setSaveSettings(bool autoSaving, int min);
+    //! Set the memory budget of the undo history (in MB, 0 for no limit)
+    void setUndoStorageSettings(int memoryLimit, bool spillToDisk);
     void changeAppStyle(const QString &s);
     void changeAppFont(const QFont &f);
     void updateAppFonts();
@@ -294,10 +299,11 @@ public slots:
     //! \name Surface Plots
     //@{
     Graph3D *newPlot3D();
+    //! Plot a function; 'adaptive' enables adaptive refinement of the mesh (see UserFunction)
     Graph3D *newPlot3D(const QString &formula, double xl, double xr, double yl, double yr,
-                       double zl, double zr);
+                       double zl, double zr, bool adaptive = false);
     Graph3D *newPlot3D(const QString &caption, const QString &formula, double xl, double xr,
-                       double yl, double yr, double zl, double zr);
+                       double yl, double yr, double zl, double zr, bool adaptive = false);
     void connectSurfacePlot(Graph3D *plot);
     void newSurfacePlot();
     void editSurfacePlot();
@@ -406,6 +412,27 @@ public slots:
 
     TableStatistics *newTableStatistics(Table *base, int type, QList<int>,
                                         const QString &caption = {});
+    //! creates a table showing the rows of base which satisfy condition (see RowPredicate)
+    FilteredTable *newFilteredTable(Table *base, const QString &condition,
+                                    const QString &caption = {});
+    //! creates a table of aggregates of the groups of rows of base (see GroupedTable)
+    /**
+     * If live is true, the table is a GroupedTable following the changes of base. Returns 0
+     * and sets error if keys or aggregates are invalid.
+     */
+    Table *newGroupedTable(Table *base, const QString &keys, const QString &aggregates, bool live,
+                           const QString &caption = {}, QString *error = nullptr);
+    //! creates a table of the rows of left and right with matching keys (see TableJoin)
+    /**
+     * left_keys and right_keys are lists of key columns like those of newGroupedTable(); if
+     * right_keys is empty, the keys have the same names in both tables. type is a
+     * TableJoin::Type. The tolerance limits the distance of nearest keys (in seconds for dates
+     * and times); a negative one does not.
+     * Returns 0 and sets error if the keys are invalid.
+     */
+    Table *newJoinedTable(Table *left, Table *right, const QString &left_keys,
+                          const QString &right_keys, int type, double tolerance = -1,
+                          const QString &caption = {}, QString *error = nullptr);
     //@}
 
     //! \name Graphs
@@ -447,6 +474,8 @@ public slots:
 
     void undo();
     void redo();
+    //! Disable undo if the next command has been discarded (see UndoStorage)
+    void updateUndoAction();
 
     //! \name MDI Windows
     //@{
@@ -513,7 +542,22 @@ public slots:
     void updateColNames(const QString &oldName, const QString &newName);
     void updateTableNames(const QString &oldName, const QString &newName);
     void changeMatrixName(const QString &oldName, const QString &newName);
+    //! Schedule an update of the curves plotted from column 'name' of t
+    /**
+     * Changes are collected until control returns to the event loop and then dispatched by
+     * updatePendingCurves(), so that a macro changing many columns reloads every curve and
+     * replots every graph only once.
+     */
     void updateCurves(Table *t, const QString &name);
+    //! Remember which rows the next updateCurves() of a column concerns (to be connected with
+    //! Table::modifiedRows)
+    void markModifiedRows(Table *t, const QString &name, int first, int last);
+    //! Update the curves depending on the columns collected by updateCurves()
+    /**
+     * Also called before graphs are saved, exported, printed or copied and before scripts or
+     * filters read curve data, so that changes made in the same event loop tick are never missed.
+     */
+    void updatePendingCurves();
 
     void showTable(const QString &curve);
 
@@ -535,6 +579,8 @@ public slots:
     Matrix *openMatrix(ApplicationWindow *app, const QStringList &flist);
     Table *openTable(ApplicationWindow *app, QTextStream &stream);
     TableStatistics *openTableStatistics(const QStringList &flist);
+    FilteredTable *openFilteredTable(const QStringList &flist);
+    GroupedTable *openGroupedTable(const QStringList &flist);
     Graph3D *openSurfacePlot(ApplicationWindow *app, const QStringList &lst);
     Graph *openGraph(ApplicationWindow *app, MultiLayer *plot, const QStringList &list);
 
@@ -697,6 +743,9 @@ public slots:
     void showExpDecay3Dialog();
     void showRowStatistics();
     void showColStatistics();
+    void showFilterRows();
+    void showGroupRows();
+    void showJoinTables();
     void showFitDialog();
     void showImageDialog();
     void showPlotGeometryDialog();
@@ -783,7 +832,20 @@ public slots:
     void downloadManual();
 #endif
 
-    void parseCommandLineArguments(const QStringList &args);
+    //! Process the command line options and open the file given
+    /**
+     * Returns the exit code if SciDAVis has to quit right away (after --export), otherwise -1.
+     */
+    int parseCommandLineArguments(const QStringList &args);
+    //! Export plot windows to files named after the windows (used by --export)
+    /**
+     * \param directory the directory to write to
+     * \param format file suffix of the format, e.g. "png", "svg" or "pdf"
+     * \param names names of the windows to export, or empty for all 2D and 3D plots
+     * Errors are reported on standard error; returns false if any occurred.
+     */
+    bool exportGraphs(const QString &directory, const QString &format,
+                      const QStringList &names = QStringList());
     void createLanguagesList();
     void switchToLanguage(int param);
     void switchToLanguage(const QString &locale);
@@ -1019,6 +1081,9 @@ public:
     int majTicksLength, minTicksLength, defaultPlotMargin;
     int defaultCurveStyle, defaultCurveLineWidth, defaultSymbolSize;
     int undoLimit;
+    //! Memory budget of the undo history in MB (0 for no limit), see UndoStorage
+    int undoMemoryLimit;
+    bool undoSpillToDisk;
     QFont appFont, plot3DTitleFont, plot3DNumbersFont, plot3DAxesFont;
     QFont tableTextFont, tableHeaderFont, plotAxesFont, plotLegendFont, plotNumbersFont,
             plotTitleFont;
@@ -1026,7 +1091,13 @@ public:
     QString projectname, columnSeparator, appLanguage;
     QString configFilePath, logInfo, fitPluginsPath, asciiDirPath, imagesDirPath;
     int logID, asciiID, closeID, exportID, printAllID, ignoredLines, savingTimerId,
-            plot3DResolution;
+            curvesTimerId, plot3DResolution;
+    //! Changed columns (by table) whose curves have not been updated yet, see updateCurves()
+    QHash<Table *, QStringList> pendingCurveColumns;
+    //! Changed rows of the columns in pendingCurveColumns (invalid if all rows changed)
+    QHash<QString, Interval<int>> pendingCurveRows;
+    //! Rows announced by markModifiedRows() for the next updateCurves() of a column
+    QHash<QString, Interval<int>> modifiedCurveRows;
     bool renameColumns, copiedLayer, strip_spaces, simplify_spaces;
     QStringList recentProjects;
     QStringList tableWindows();
@@ -1144,7 +1215,9 @@ private:
     QAction *actionPlotHistogram, *actionPlotStackedHistograms, *actionPlot2VerticalLayers,
             *actionPlot2HorizontalLayers, *actionPlot4Layers, *actionPlotStackedLayers;
     QAction *actionPlot3DRibbon, *actionPlot3DBars, *actionPlot3DScatter, *actionPlot3DTrajectory;
-    QAction *actionShowColStatistics, *actionShowRowStatistics, *actionShowIntDialog;
+    QAction *actionShowColStatistics, *actionShowRowStatistics, *actionFilterRows, *actionGroupRows,
+            *actionJoinTables;
+    QAction *actionShowIntDialog;
     QAction *actionDifferentiate, *actionFitLinear, *actionShowFitPolynomDialog;
     QAction *actionShowExpDecayDialog, *actionShowTwoExpDecayDialog, *actionShowExpDecay3Dialog;
     QAction *actionFitExpGrowth, *actionFitSigmoidal, *actionFitGauss, *actionFitLorentz,
@@ -27,12 +27,11 @@
  *                                                                         *
  ***************************************************************************/
 #include "BoxCurve.h"
+#include "ColumnAggregation.h"
 #include "core/column/Column.h"
 #include <QPainter>
-#include <QLocale>
 
-#include <gsl/gsl_sort.h>
-#include <gsl/gsl_statistics.h>
+#include <cmath>
 
 BoxCurve::BoxCurve(Table *t, QString name, int startRow, int endRow)
     : DataCurve(t, QString(), name, startRow, endRow)
@@ -69,48 +68,50 @@ void BoxCurve::copy(const BoxCurve *b)
     b_width = b->b_width;
 }
 
-void BoxCurve::draw(QPainter *painter, const QwtScaleMap &xMap, const QwtScaleMap &yMap, int from,
-                    int to) const
+void BoxCurve::draw(QPainter *painter, const QwtScaleMap &xMap, const QwtScaleMap &yMap, int,
+                    int) const
 {
     if (!painter || dataSize() <= 0)
         return;
 
-    int size = dataSize();
-    if (to < 0)
-        to = size - 1;
+    // select all required quantiles at once
+    QVector<double> probabilities;
+    probabilities << 0.5;
+    if (b_range != SD && b_range != SE)
+        probabilities << 1 - 0.01 * b_coeff << 0.01 * b_coeff;
+    if (b_style == WindBox)
+        probabilities << 0.25 << 0.75;
+    else if (b_style == Notch)
+        probabilities << notchProbabilities();
+    if (w_range && w_range != SD && w_range != SE)
+        probabilities << 1 - 0.01 * w_coeff << 0.01 * w_coeff;
+    if (p1_style != QwtSymbol::NoSymbol)
+        probabilities << 0.01;
+    if (p99_style != QwtSymbol::NoSymbol)
+        probabilities << 0.99;
+    updateQuantiles(probabilities);
 
     painter->save();
     painter->setPen(QwtPlotCurve::pen());
 
-    double *dat = new double[size];
-    for (int i = from; i <= to; i++)
-        dat[i] = y(i);
-
-    drawBox(painter, xMap, yMap, dat, size);
-    drawSymbols(painter, xMap, yMap, dat, size);
+    drawBox(painter, xMap, yMap);
+    drawSymbols(painter, xMap, yMap);
 
     painter->restore();
-    delete[] dat;
 }
 
-void BoxCurve::drawBox(QPainter *painter, const QwtScaleMap &xMap, const QwtScaleMap &yMap,
-                       double *dat, int size) const
+void BoxCurve::drawBox(QPainter *painter, const QwtScaleMap &xMap, const QwtScaleMap &yMap) const
 {
     const int px = xMap.transform(x(0));
     const int px_min = xMap.transform(x(0) - 0.5);
     const int px_max = xMap.transform(x(0) + 0.5);
     const int box_width = 1 + (px_max - px_min) * b_width / 100;
     const int hbw = box_width / 2;
-    const int median = yMap.transform(gsl_stats_median_from_sorted_data(dat, 1, size));
+    const int median = yMap.transform(quantile(0.5));
     int b_lowerq, b_upperq;
-    double sd = 0;
-    double se = 0;
-    double mean = 0;
-    if (w_range == SD || w_range == SE || b_range == SD || b_range == SE) {
-        sd = gsl_stats_sd(dat, 1, size);
-        se = sd / sqrt((double)size);
-        mean = gsl_stats_mean(dat, 1, size);
-    }
+    const double sd = d_statistics.standardDeviation();
+    const double se = sd / sqrt((double)d_statistics.count());
+    const double mean = d_statistics.mean();
 
     if (b_range == SD) {
         b_lowerq = yMap.transform(mean - sd * b_coeff);
@@ -119,10 +120,8 @@ void BoxCurve::drawBox(QPainter *painter, const QwtScaleMap &xMap, const QwtScal
         b_lowerq = yMap.transform(mean - se * b_coeff);
         b_upperq = yMap.transform(mean + se * b_coeff);
     } else {
-        b_lowerq = yMap.transform(
-                gsl_stats_quantile_from_sorted_data(dat, 1, size, 1 - 0.01 * b_coeff));
-        b_upperq =
-                yMap.transform(gsl_stats_quantile_from_sorted_data(dat, 1, size, 0.01 * b_coeff));
+        b_lowerq = yMap.transform(quantile(1 - 0.01 * b_coeff));
+        b_upperq = yMap.transform(quantile(0.01 * b_coeff));
     }
 
     // draw box
@@ -140,8 +139,8 @@ void BoxCurve::drawBox(QPainter *painter, const QwtScaleMap &xMap, const QwtScal
         painter->setBrush(QwtPlotCurve::brush());
         painter->drawPolygon(pa);
     } else if (b_style == WindBox) {
-        const int lowerq = yMap.transform(gsl_stats_quantile_from_sorted_data(dat, 1, size, 0.25));
-        const int upperq = yMap.transform(gsl_stats_quantile_from_sorted_data(dat, 1, size, 0.75));
+        const int lowerq = yMap.transform(quantile(0.25));
+        const int upperq = yMap.transform(quantile(0.75));
         QPolygon pa(8);
         pa[0] = QPoint(px + hbw, b_upperq);
         pa[1] = QPoint(int(px + 0.4 * box_width), upperq);
@@ -155,10 +154,9 @@ void BoxCurve::drawBox(QPainter *painter, const QwtScaleMap &xMap, const QwtScal
         painter->setBrush(QwtPlotCurve::brush());
         painter->drawPolygon(pa);
     } else if (b_style == Notch) {
-        int j = (int)ceil(0.5 * (size - 1.96 * sqrt((double)size)));
-        int k = (int)ceil(0.5 * (size + 1.96 * sqrt((double)size)));
-        const int lowerCI = yMap.transform(dat[j]);
-        const int upperCI = yMap.transform(dat[k]);
+        const QVector<double> ci = notchProbabilities();
+        const int lowerCI = yMap.transform(quantile(ci.at(0)));
+        const int upperCI = yMap.transform(quantile(ci.at(1)));
 
         QPolygon pa(10);
         pa[0] = QPoint(px + hbw, b_upperq);
@@ -186,10 +184,8 @@ void BoxCurve::drawBox(QPainter *painter, const QwtScaleMap &xMap, const QwtScal
             w_lowerq = yMap.transform(mean - se * w_coeff);
             w_upperq = yMap.transform(mean + se * w_coeff);
         } else {
-            w_lowerq = yMap.transform(
-                    gsl_stats_quantile_from_sorted_data(dat, 1, size, 1 - 0.01 * w_coeff));
-            w_upperq = yMap.transform(
-                    gsl_stats_quantile_from_sorted_data(dat, 1, size, 0.01 * w_coeff));
+            w_lowerq = yMap.transform(quantile(1 - 0.01 * w_coeff));
+            w_upperq = yMap.transform(quantile(0.01 * w_coeff));
         }
 
         painter->drawLine(px - l, w_lowerq, px + l, w_lowerq);
@@ -213,34 +209,34 @@ void BoxCurve::drawBox(QPainter *painter, const QwtScaleMap &xMap, const QwtScal
         painter->drawLine(px - hbw, median, px + hbw, median);
 }
 
-void BoxCurve::drawSymbols(QPainter *painter, const QwtScaleMap &xMap, const QwtScaleMap &yMap,
-                           double *dat, int size) const
+void BoxCurve::drawSymbols(QPainter *painter, const QwtScaleMap &xMap,
+                           const QwtScaleMap &yMap) const
 {
     const int px = xMap.transform(x(0));
 
     QwtSymbol s = this->symbol();
     if (min_style != QwtSymbol::NoSymbol) {
-        const int py_min = yMap.transform(y(0));
+        const int py_min = yMap.transform(d_statistics.minimum());
         s.setStyle(min_style);
         s.draw(painter, px, py_min);
     }
     if (max_style != QwtSymbol::NoSymbol) {
-        const int py_max = yMap.transform(y(size - 1));
+        const int py_max = yMap.transform(d_statistics.maximum());
         s.setStyle(max_style);
         s.draw(painter, px, py_max);
     }
     if (p1_style != QwtSymbol::NoSymbol) {
-        const int p1 = yMap.transform(gsl_stats_quantile_from_sorted_data(dat, 1, size, 0.01));
+        const int p1 = yMap.transform(quantile(0.01));
         s.setStyle(p1_style);
         s.draw(painter, px, p1);
     }
     if (p99_style != QwtSymbol::NoSymbol) {
-        const int p99 = yMap.transform(gsl_stats_quantile_from_sorted_data(dat, 1, size, 0.99));
+        const int p99 = yMap.transform(quantile(0.99));
         s.setStyle(p99_style);
         s.draw(painter, px, p99);
     }
     if (mean_style != QwtSymbol::NoSymbol) {
-        const int mean = yMap.transform(gsl_stats_mean(dat, 1, size));
+        const int mean = yMap.transform(d_statistics.mean());
         s.setStyle(mean_style);
         s.draw(painter, px, mean);
     }
@@ -310,32 +306,59 @@ QwtDoubleRect BoxCurve::boundingRect() const
 
 bool BoxCurve::loadData()
 {
-    QVector<double> Y(abs(d_end_row - d_start_row) + 1);
-    int ycol = d_table->colIndex(title().text());
-    Column *y_col_ptr = d_table->column(ycol);
-    auto yColType = d_table->columnType(ycol);
-    int size = 0;
-    for (int row = d_start_row; row <= d_end_row && row < y_col_ptr->rowCount(); row++) {
-        if (!y_col_ptr->isInvalid(row)) {
-            if (yColType == SciDAVis::ColumnMode::Text) {
-                QString yval = y_col_ptr->textAt(row);
-                bool valid_data = true;
-                Y[size] = QLocale().toDouble(yval, &valid_data);
-                if (!valid_data)
-                    continue;
-            } else
-                Y[size] = y_col_ptr->valueAt(row);
-
-            size++;
-        }
-    }
+    const Column *y_col_ptr = d_table->column(d_table->colIndex(title().text()));
+    if (y_col_ptr && y_col_ptr->version() == d_loaded_version
+        && d_start_row == d_loaded_start_row && d_end_row == d_loaded_end_row)
+        return true;
 
-    if (size > 0) {
-        Y.resize(size);
-        gsl_sort(Y.data(), 1, size);
-        setData(QwtSingleArrayData(this->x(0), Y, size));
-    } else
+    const QVector<double> Y = ColumnAggregation::values(y_col_ptr, d_start_row, d_end_row);
+    if (Y.isEmpty()) {
         remove();
+        return true;
+    }
+
+    d_loaded_version = y_col_ptr->version();
+    d_loaded_start_row = d_start_row;
+    d_loaded_end_row = d_end_row;
+    d_statistics = DescriptiveStatistics::compute(Y.constData(), Y.size(), QList<Interval<int>>());
+    d_quantiles.clear();
+    setData(QwtSingleArrayData(this->x(0), Y, Y.size()));
 
     return true;
 }
+
+QVector<double> BoxCurve::notchProbabilities() const
+{
+    // ranks delimiting the 95% confidence interval of the median
+    const int size = dataSize();
+    const int j = (int)ceil(0.5 * (size - 1.96 * sqrt((double)size)));
+    const int k = (int)ceil(0.5 * (size + 1.96 * sqrt((double)size)));
+    const double n = qMax(size - 1, 1);
+    return QVector<double>() << j / n << k / n;
+}
+
+double BoxCurve::quantile(double p) const
+{
+    auto it = d_quantiles.constFind(p);
+    if (it != d_quantiles.constEnd())
+        return it.value();
+    updateQuantiles(QVector<double>() << p);
+    return d_quantiles.value(p);
+}
+
+void BoxCurve::updateQuantiles(const QVector<double> &probabilities) const
+{
+    QVector<double> missing;
+    for (double p : probabilities)
+        if (!d_quantiles.contains(p) && !missing.contains(p))
+            missing << p;
+    if (missing.isEmpty() || dataSize() <= 0)
+        return;
+
+    QVector<double> values(dataSize());
+    for (int i = 0; i < values.size(); i++)
+        values[i] = y(i);
+    const QVector<double> results = DescriptiveStatistics::quantiles(values, missing);
+    for (int i = 0; i < missing.size(); i++)
+        d_quantiles.insert(missing.at(i), results.at(i));
+}
@@ -30,6 +30,8 @@
 #define BOXCURVE_H
 
 #include "PlotCurve.h"
+#include "lib/DescriptiveStatistics.h"
+#include <QHash>
 #include <qwt_plot.h>
 #include <qwt_symbol.h>
 
@@ -80,15 +82,28 @@ public:
 private:
     void draw(QPainter *painter, const QwtScaleMap &xMap, const QwtScaleMap &yMap, int from,
               int to) const;
-    void drawBox(QPainter *painter, const QwtScaleMap &xMap, const QwtScaleMap &yMap, double *dat,
-                 int size) const;
+    void drawBox(QPainter *painter, const QwtScaleMap &xMap, const QwtScaleMap &yMap) const;
     using QwtPlotCurve::drawSymbols;
-    void drawSymbols(QPainter *painter, const QwtScaleMap &xMap, const QwtScaleMap &yMap,
-                     double *dat, int size) const;
+    void drawSymbols(QPainter *painter, const QwtScaleMap &xMap, const QwtScaleMap &yMap) const;
+
+    //! Return the probabilities of the ranks delimiting the notch
+    QVector<double> notchProbabilities() const;
+    //! Return the p-quantile of the curve data
+    double quantile(double p) const;
+    //! Select those of the given quantiles which are not cached yet (in one go)
+    void updateQuantiles(const QVector<double> &probabilities) const;
 
     QwtSymbol::Style min_style, max_style, mean_style, p99_style, p1_style;
     double b_coeff, w_coeff;
     int b_style, b_width, b_range, w_range;
+
+    //! Statistics of the curve data, computed when loading it
+    DescriptiveStatistics d_statistics;
+    //! Quantiles of the curve data, selected on demand (the data is not sorted)
+    mutable QHash<double, double> d_quantiles;
+    //! Column version and rows the curve data was loaded from
+    quint64 d_loaded_version = 0;
+    int d_loaded_start_row = 0, d_loaded_end_row = -1;
 };
 
 //! Single array data (extension to QwtData)
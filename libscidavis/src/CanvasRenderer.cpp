@@ -0,0 +1,457 @@
+/***************************************************************************
+    File                 : CanvasRenderer.cpp
+    Project              : SciDAVis
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 SciDAVis developers
+    Description          : Renders the curves of a plot layer in the background
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "CanvasRenderer.h"
+#include "FunctionCurve.h"
+#include "PlotCurve.h"
+
+#include <QPainter>
+#include <QPainterPath>
+#include <QtConcurrentRun>
+
+#include <qwt_plot_canvas.h>
+#include <qwt_plot_curve.h>
+#include <qwt_plot_printfilter.h>
+#include <qwt_symbol.h>
+
+#include <cmath>
+#include <typeinfo>
+
+namespace {
+//! Number of points drawn between two checks whether rendering has been canceled
+const size_t CancelCheckInterval = 1 << 16;
+
+void appendKey(QVector<double> &key, const QPen &pen)
+{
+    key << pen.color().rgba() << pen.widthF() << pen.style() << pen.capStyle()
+        << pen.joinStyle();
+}
+
+void appendKey(QVector<double> &key, const QBrush &brush)
+{
+    key << brush.color().rgba() << brush.style();
+}
+
+//! Return the outline of a symbol, centered at the origin (see QwtSymbol::draw())
+QPainterPath symbolPath(QwtSymbol::Style style, const QSize &size)
+{
+    const double w2 = 0.5 * size.width(), h2 = 0.5 * size.height();
+    QPainterPath path;
+    auto line = [&path](double x1, double y1, double x2, double y2) {
+        path.moveTo(x1, y1);
+        path.lineTo(x2, y2);
+    };
+    // points on the ellipse inscribed in the symbol's rectangle, starting at the top
+    auto star = [&path, w2, h2](int corners, double inner_radius) {
+        QPolygonF polygon;
+        const int n = inner_radius > 0 ? 2 * corners : corners;
+        for (int i = 0; i < n; i++) {
+            const double r = (inner_radius > 0 && i % 2) ? inner_radius : 1.0;
+            const double phi = -M_PI_2 + 2 * M_PI * i / n;
+            polygon << QPointF(r * w2 * std::cos(phi), r * h2 * std::sin(phi));
+        }
+        path.addPolygon(polygon);
+        path.closeSubpath();
+    };
+    auto polygon = [&path](const QPolygonF &points) {
+        path.addPolygon(points);
+        path.closeSubpath();
+    };
+
+    switch (style) {
+    case QwtSymbol::Ellipse:
+        path.addEllipse(QRectF(-w2, -h2, 2 * w2, 2 * h2));
+        break;
+    case QwtSymbol::Rect:
+        path.addRect(QRectF(-w2, -h2, 2 * w2, 2 * h2));
+        break;
+    case QwtSymbol::Diamond:
+        polygon(QPolygonF() << QPointF(0, -h2) << QPointF(w2, 0) << QPointF(0, h2)
+                            << QPointF(-w2, 0));
+        break;
+    case QwtSymbol::Triangle:
+    case QwtSymbol::UTriangle:
+        polygon(QPolygonF() << QPointF(0, -h2) << QPointF(w2, h2) << QPointF(-w2, h2));
+        break;
+    case QwtSymbol::DTriangle:
+        polygon(QPolygonF() << QPointF(-w2, -h2) << QPointF(w2, -h2) << QPointF(0, h2));
+        break;
+    case QwtSymbol::LTriangle:
+        polygon(QPolygonF() << QPointF(w2, -h2) << QPointF(-w2, 0) << QPointF(w2, h2));
+        break;
+    case QwtSymbol::RTriangle:
+        polygon(QPolygonF() << QPointF(-w2, -h2) << QPointF(w2, 0) << QPointF(-w2, h2));
+        break;
+    case QwtSymbol::Cross:
+        line(0, -h2, 0, h2);
+        line(-w2, 0, w2, 0);
+        break;
+    case QwtSymbol::XCross:
+        line(-w2, -h2, w2, h2);
+        line(-w2, h2, w2, -h2);
+        break;
+    case QwtSymbol::HLine:
+        line(-w2, 0, w2, 0);
+        break;
+    case QwtSymbol::VLine:
+        line(0, -h2, 0, h2);
+        break;
+    case QwtSymbol::Star1:
+        line(0, -h2, 0, h2);
+        line(-w2, 0, w2, 0);
+        line(-M_SQRT1_2 * w2, -M_SQRT1_2 * h2, M_SQRT1_2 * w2, M_SQRT1_2 * h2);
+        line(-M_SQRT1_2 * w2, M_SQRT1_2 * h2, M_SQRT1_2 * w2, -M_SQRT1_2 * h2);
+        break;
+    case QwtSymbol::Star2:
+        star(6, 1 / std::sqrt(3.0));
+        break;
+    case QwtSymbol::Hexagon:
+        star(6, 0);
+        break;
+    default:
+        break;
+    }
+    return path;
+}
+}
+
+CanvasRenderer::Job::~Job()
+{
+    qDeleteAll(curves);
+}
+
+CanvasRenderer::CanvasRenderer(QwtPlot *plot)
+    : QObject(plot), d_plot(plot), d_generation(0), d_job(nullptr)
+{
+    connect(&d_watcher, SIGNAL(finished()), this, SLOT(renderingFinished()));
+}
+
+CanvasRenderer::~CanvasRenderer()
+{
+    if (d_job) {
+        d_job->canceled.ref();
+        d_watcher.waitForFinished();
+        delete d_job;
+    }
+}
+
+bool CanvasRenderer::canRender(const QwtPlotItem *item)
+{
+    if (!item || item->rtti() != QwtPlotItem::Rtti_PlotCurve)
+        return false;
+    // subclasses drawing themselves differently are left to the GUI thread
+    if (typeid(*item) != typeid(DataCurve) && typeid(*item) != typeid(FunctionCurve))
+        return false;
+    // curve fitters are shared with the original curve and not thread safe
+    return !static_cast<const QwtPlotCurve *>(item)->testCurveAttribute(QwtPlotCurve::Fitted);
+}
+
+void CanvasRenderer::invalidate()
+{
+    d_generation++;
+}
+
+QVector<double> CanvasRenderer::stateKey(const QRect &rect,
+                                         const QwtScaleMap map[QwtPlot::axisCnt]) const
+{
+    QVector<double> key;
+    key << double(d_generation) << rect.x() << rect.y() << rect.width() << rect.height();
+#if QT_VERSION >= QT_VERSION_CHECK(5, 6, 0)
+    key << d_plot->canvas()->devicePixelRatioF();
+#else
+    key << d_plot->canvas()->devicePixelRatio();
+#endif
+    for (int axis = 0; axis < QwtPlot::axisCnt; axis++)
+        key << map[axis].s1() << map[axis].s2() << map[axis].p1() << map[axis].p2()
+            << map[axis].transformation()->type();
+
+    // the plot dialog, for example, changes pens or hides curves without a replot
+    foreach (QwtPlotItem *item, d_plot->itemList()) {
+        if (!item->isVisible() || !canRender(item))
+            continue;
+        const QwtPlotCurve *curve = static_cast<const QwtPlotCurve *>(item);
+        key << double(quintptr(curve)) << curve->z() << curve->xAxis() << curve->yAxis()
+            << double(curve->dataSize()) << curve->style() << curve->curveType()
+            << curve->baseline() << curve->testCurveAttribute(QwtPlotCurve::Inverted)
+            << curve->testPaintAttribute(QwtPlotCurve::PaintFiltered)
+            << curve->testRenderHint(QwtPlotItem::RenderAntialiased);
+        appendKey(key, curve->pen());
+        appendKey(key, curve->brush());
+        const QwtSymbol &symbol = curve->symbol();
+        key << symbol.style() << symbol.size().width() << symbol.size().height();
+        appendKey(key, symbol.pen());
+        appendKey(key, symbol.brush());
+    }
+    return key;
+}
+
+bool CanvasRenderer::drawItems(QPainter *painter, const QRect &rect,
+                               const QwtScaleMap map[QwtPlot::axisCnt],
+                               const QwtPlotPrintFilter &pfilter)
+{
+    const QwtPlotItemList &items = d_plot->itemList();
+    qint64 points = 0;
+    foreach (QwtPlotItem *item, items)
+        if (item->isVisible() && canRender(item))
+            points += static_cast<QwtPlotCurve *>(item)->dataSize();
+    if (points < MinPoints) {
+        d_image = QImage();
+        d_image_key.clear();
+        return false;
+    }
+
+    QVector<double> key = stateKey(rect, map);
+    if (key != d_image_key) {
+        if (!d_job)
+            start(rect, map, key);
+        else if (d_job->key != key)
+            d_job->canceled.ref(); // renderingFinished() triggers another repaint
+    }
+
+    bool image_drawn = false;
+    foreach (QwtPlotItem *item, items) {
+        if (!item || !item->isVisible())
+            continue;
+        if (!(pfilter.options() & QwtPlotPrintFilter::PrintGrid)
+            && item->rtti() == QwtPlotItem::Rtti_PlotGrid)
+            continue;
+        if (canRender(item)) {
+            // the previous image is stretched if the canvas has been resized meanwhile
+            if (!image_drawn && !d_image.isNull())
+                painter->drawImage(rect, d_image);
+            image_drawn = true;
+            continue;
+        }
+        painter->save();
+        painter->setRenderHint(QPainter::Antialiasing,
+                               item->testRenderHint(QwtPlotItem::RenderAntialiased));
+        item->draw(painter, map[item->xAxis()], map[item->yAxis()], rect);
+        painter->restore();
+    }
+
+    if (d_job)
+        drawProgress(painter, rect);
+    return true;
+}
+
+QwtPlotCurve *CanvasRenderer::renderCopy(const QwtPlotCurve *curve)
+{
+    QwtPlotCurve *copy = new QwtPlotCurve();
+    copy->setData(curve->data());
+    copy->setPen(curve->pen());
+    copy->setBrush(curve->brush());
+    copy->setSymbol(curve->symbol());
+    copy->setStyle(curve->style());
+    copy->setBaseline(curve->baseline());
+    copy->setCurveType(curve->curveType());
+    copy->setCurveAttribute(QwtPlotCurve::Inverted,
+                            curve->testCurveAttribute(QwtPlotCurve::Inverted));
+    copy->setPaintAttribute(QwtPlotCurve::PaintFiltered,
+                            curve->testPaintAttribute(QwtPlotCurve::PaintFiltered));
+    copy->setRenderHint(QwtPlotItem::RenderAntialiased,
+                        curve->testRenderHint(QwtPlotItem::RenderAntialiased));
+    copy->setAxis(curve->xAxis(), curve->yAxis());
+    copy->setZ(curve->z());
+    return copy;
+}
+
+void CanvasRenderer::start(const QRect &rect, const QwtScaleMap map[QwtPlot::axisCnt],
+                           const QVector<double> &key)
+{
+    d_job = new Job;
+    for (int axis = 0; axis < QwtPlot::axisCnt; axis++)
+        d_job->maps[axis] = map[axis];
+    d_job->rect = rect;
+#if QT_VERSION >= QT_VERSION_CHECK(5, 6, 0)
+    d_job->devicePixelRatio = d_plot->canvas()->devicePixelRatioF();
+#else
+    d_job->devicePixelRatio = d_plot->canvas()->devicePixelRatio();
+#endif
+    d_job->key = key;
+    // the item list is sorted by z
+    foreach (QwtPlotItem *item, d_plot->itemList())
+        if (item->isVisible() && canRender(item))
+            d_job->curves << renderCopy(static_cast<QwtPlotCurve *>(item));
+
+    d_watcher.setFuture(QtConcurrent::run(&CanvasRenderer::render, d_job));
+}
+
+QImage CanvasRenderer::render(Job *job)
+{
+    QImage image((QSizeF(job->rect.size()) * job->devicePixelRatio).toSize(),
+                 QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(job->devicePixelRatio);
+    image.fill(Qt::transparent);
+
+    QPainter painter(&image);
+    painter.translate(-job->rect.topLeft());
+    painter.setClipRect(job->rect);
+    foreach (QwtPlotCurve *curve, job->curves) {
+        if (job->canceled.loadAcquire())
+            return QImage();
+        painter.save();
+        painter.setRenderHint(QPainter::Antialiasing,
+                              curve->testRenderHint(QwtPlotItem::RenderAntialiased));
+        const bool drawn = drawCurve(&painter, curve, job->maps[curve->xAxis()],
+                                     job->maps[curve->yAxis()], job->rect, job->canceled);
+        painter.restore();
+        if (!drawn)
+            return QImage();
+        job->rendered_curves.ref();
+    }
+    return image;
+}
+
+bool CanvasRenderer::drawCurve(QPainter *painter, const QwtPlotCurve *curve,
+                               const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+                               const QRect &rect, const QAtomicInt &canceled)
+{
+    // points are rounded to pixels like QwtScaleMap::transform() does
+    const QwtData &data = curve->data();
+    const bool filtered = curve->testPaintAttribute(QwtPlotCurve::PaintFiltered);
+    QPolygonF points;
+    points.reserve(int(data.size()));
+    for (size_t i = 0; i < data.size(); i++) {
+        if (i % CancelCheckInterval == 0 && canceled.loadAcquire())
+            return false;
+        const QPointF p(std::round(xMap.xTransform(data.x(i))),
+                        std::round(yMap.xTransform(data.y(i))));
+        if (!std::isfinite(p.x()) || !std::isfinite(p.y()))
+            continue;
+        if (filtered && !points.isEmpty() && points.last() == p)
+            continue;
+        points << p;
+    }
+    if (points.isEmpty())
+        return true;
+
+    const bool vertical = curve->curveType() == QwtPlotCurve::Yfx;
+    double baseline = vertical ? std::round(yMap.xTransform(curve->baseline()))
+                               : std::round(xMap.xTransform(curve->baseline()));
+    if (!std::isfinite(baseline)) // e.g. a baseline of 0 on a logarithmic scale
+        baseline = vertical ? yMap.p1() : xMap.p1();
+
+    QPolygonF polyline;
+    switch (curve->style()) {
+    case QwtPlotCurve::Lines:
+        polyline = points;
+        break;
+    case QwtPlotCurve::Steps: {
+        bool inverted = vertical;
+        if (curve->testCurveAttribute(QwtPlotCurve::Inverted))
+            inverted = !inverted;
+        polyline.reserve(2 * points.size() - 1);
+        polyline << points[0];
+        for (int i = 1; i < points.size(); i++) {
+            const QPointF previous = polyline.last();
+            polyline << (inverted ? QPointF(points[i].x(), previous.y())
+                                  : QPointF(previous.x(), points[i].y()))
+                     << points[i];
+        }
+        break;
+    }
+    case QwtPlotCurve::Sticks: {
+        QVector<QLineF> sticks;
+        sticks.reserve(points.size());
+        for (const QPointF &p : points)
+            sticks << (vertical ? QLineF(p.x(), baseline, p.x(), p.y())
+                                : QLineF(baseline, p.y(), p.x(), p.y()));
+        painter->setPen(curve->pen());
+        painter->drawLines(sticks);
+        break;
+    }
+    default:
+        break;
+    }
+
+    // the area between the curve and the baseline
+    const QPolygonF &outline = curve->style() == QwtPlotCurve::Dots ? points : polyline;
+    if (curve->brush().style() != Qt::NoBrush && !outline.isEmpty()) {
+        QPolygonF area = outline;
+        if (vertical)
+            area << QPointF(area.last().x(), baseline) << QPointF(area.first().x(), baseline);
+        else
+            area << QPointF(baseline, area.last().y()) << QPointF(baseline, area.first().y());
+        painter->setPen(Qt::NoPen);
+        painter->setBrush(curve->brush());
+        painter->drawPolygon(area);
+    }
+    painter->setPen(curve->pen());
+    painter->setBrush(Qt::NoBrush);
+    if (!polyline.isEmpty())
+        painter->drawPolyline(polyline);
+    else if (curve->style() == QwtPlotCurve::Dots)
+        painter->drawPoints(points);
+
+    const QwtSymbol &symbol = curve->symbol();
+    if (symbol.style() == QwtSymbol::NoSymbol)
+        return true;
+    const QPainterPath path = symbolPath(symbol.style(), symbol.size());
+    const QSize &size = symbol.size();
+    const QRectF visible =
+            QRectF(rect).adjusted(-size.width(), -size.height(), size.width(), size.height());
+    painter->setPen(symbol.pen());
+    painter->setBrush(symbol.brush());
+    for (int i = 0; i < points.size(); i++) {
+        if (size_t(i) % CancelCheckInterval == 0 && canceled.loadAcquire())
+            return false;
+        if (visible.contains(points[i]))
+            painter->drawPath(path.translated(points[i]));
+    }
+    return true;
+}
+
+void CanvasRenderer::renderingFinished()
+{
+    Job *job = d_job;
+    d_job = nullptr;
+    QImage image = d_watcher.result();
+    if (!job->canceled.loadAcquire() && !image.isNull()) {
+        d_image = image;
+        d_image_key = job->key;
+    }
+    delete job;
+    // show the new image, or start rendering again if the job was outdated
+    d_plot->canvas()->update();
+}
+
+void CanvasRenderer::drawProgress(QPainter *painter, const QRect &rect) const
+{
+    const int width = qMin(100, rect.width() - 8);
+    if (width <= 0 || d_job->curves.isEmpty())
+        return;
+    const QRect bar(rect.left() + 4, rect.bottom() - 9, width, 6);
+    const int done = width * d_job->rendered_curves.loadAcquire() / d_job->curves.size();
+
+    painter->save();
+    painter->setPen(QPen(QColor(0, 0, 0, 128), 0));
+    painter->setBrush(QColor(255, 255, 255, 160));
+    painter->drawRect(bar);
+    painter->fillRect(QRect(bar.left(), bar.top(), done, bar.height()), QColor(0, 0, 0, 96));
+    painter->restore();
+}
@@ -0,0 +1,144 @@
+/***************************************************************************
+    File                 : CanvasRenderer.h
+    Project              : SciDAVis
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 SciDAVis developers
+    Description          : Renders the curves of a plot layer in the background
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef CANVASRENDERER_H
+#define CANVASRENDERER_H
+
+#include <QAtomicInt>
+#include <QFutureWatcher>
+#include <QImage>
+#include <QList>
+#include <QObject>
+#include <QVector>
+
+#include <qwt_plot.h>
+#include <qwt_scale_map.h>
+
+class QwtPlotCurve;
+class QwtPlotItem;
+class QwtPlotPrintFilter;
+
+//! Renders the curves of a plot layer into an offscreen image on a worker thread
+/**
+  Drawing many points blocks the GUI thread, which is especially noticeable in
+  workspaces with many plots: every expose, resize or window cascade repaints
+  all of them. Instead, the canvas shows the last image rendered for the
+  layer and only renders again (in the background) after the layer has been
+  invalidated, e.g. by Plot::replot(), or when size or scales changed. While
+  rendering, the previous image is shown stretched to the canvas, together with
+  a progress indicator.
+
+  Only plain data and function curves are rendered in the background. They are
+  copied on the GUI thread into curves only used for rendering (which share the
+  data with the originals), so that they may be modified while rendering.
+  The copies are drawn with a plain QPainter instead of QwtPlotCurve::draw(),
+  since QwtPainter keeps its metrics map and clipping in static variables,
+  which the GUI thread changes, e.g. while printing or exporting.
+  Other items (markers, spectrograms, error bars, bars, ...) are drawn directly
+  on the GUI thread. The rendered curves are drawn in place of the lowest of
+  them, i.e. items between two rendered curves in the z order end up below or
+  above all of them.
+
+  Layers with less than MinPoints points are drawn directly, as before.
+  */
+class CanvasRenderer : public QObject
+{
+    Q_OBJECT
+
+public:
+    //! Render the curves of the given plot
+    CanvasRenderer(QwtPlot *plot);
+    ~CanvasRenderer();
+
+    //! Whether an item is rendered in the background
+    static bool canRender(const QwtPlotItem *item);
+    //! Discard the rendered image, because the layer has changed
+    void invalidate();
+    //! Whether an image is being rendered in the background
+    bool isRendering() const { return d_job; }
+    //! Draw the items of the plot on its canvas (see QwtPlot::drawItems())
+    /**
+     * Returns false if there is not enough to render in the background, in which case the plot
+     * has to draw the items itself.
+     */
+    bool drawItems(QPainter *painter, const QRect &rect, const QwtScaleMap map[QwtPlot::axisCnt],
+                   const QwtPlotPrintFilter &pfilter);
+
+private slots:
+    void renderingFinished();
+
+private:
+    //! Layers with fewer points (in curves rendered in the background) are drawn directly
+    static constexpr int MinPoints = 100000;
+
+    //! Everything needed to render in the background
+    struct Job
+    {
+        //! Copies of the curves to render, in z order
+        QList<QwtPlotCurve *> curves;
+        QwtScaleMap maps[QwtPlot::axisCnt];
+        QRect rect;
+        qreal devicePixelRatio = 1.0;
+        //! Identifies the state of the layer rendered (see stateKey())
+        QVector<double> key;
+        QAtomicInt rendered_curves;
+        QAtomicInt canceled;
+        ~Job();
+    };
+
+    //! Return the key of what is displayed by the layer in 'rect' with the given maps
+    /**
+     * Besides size and scales, the key contains the attributes of the rendered curves, which may
+     * change without a replot.
+     */
+    QVector<double> stateKey(const QRect &rect, const QwtScaleMap map[QwtPlot::axisCnt]) const;
+    //! Return a copy of 'curve' for rendering, sharing its data
+    static QwtPlotCurve *renderCopy(const QwtPlotCurve *curve);
+    //! Start rendering in the background
+    void start(const QRect &rect, const QwtScaleMap map[QwtPlot::axisCnt],
+               const QVector<double> &key);
+    //! Render the curves of a job (on a worker thread)
+    static QImage render(Job *job);
+    //! Draw a copy made by renderCopy() like QwtPlotCurve::draw(); returns false if canceled
+    static bool drawCurve(QPainter *painter, const QwtPlotCurve *curve, const QwtScaleMap &xMap,
+                          const QwtScaleMap &yMap, const QRect &rect, const QAtomicInt &canceled);
+    //! Draw the progress of the running job
+    void drawProgress(QPainter *painter, const QRect &rect) const;
+
+    QwtPlot *d_plot;
+    //! Incremented by invalidate()
+    quint64 d_generation;
+    //! The last completed image and the key it has been rendered for
+    QImage d_image;
+    QVector<double> d_image_key;
+    //! The running job, if any
+    Job *d_job;
+    QFutureWatcher<QImage> d_watcher;
+};
+
+#endif // ifndef CANVASRENDERER_H
@@ -0,0 +1,240 @@
+/***************************************************************************
+    File                 : ColumnAggregation.cpp
+    Project              : SciDAVis
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 SciDAVis developers
+    Description          : Histogram and quantile aggregation of column data
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+#include "ColumnAggregation.h"
+#include "core/column/Column.h"
+#include "lib/DescriptiveStatistics.h"
+
+#include <QList>
+#include <QLocale>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QtConcurrentMap>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+//! Number of histograms kept in the cache
+const int CacheSize = 32;
+
+struct HistogramCacheEntry
+{
+    quint64 version;
+    int first, last;
+    HistogramBinning binning;
+    HistogramData histogram;
+};
+
+QMutex histogram_cache_mutex;
+//! Most recently used entries first
+QList<HistogramCacheEntry> histogram_cache;
+} // namespace
+
+QVector<double> ColumnAggregation::values(const Column *column, int first, int last)
+{
+    QVector<double> result;
+    if (!column)
+        return result;
+    first = qMax(first, 0);
+    last = qMin(last, column->rowCount() - 1);
+    if (first > last)
+        return result;
+
+    if (column->dataType() == SciDAVis::TypeDouble) {
+        const QVector<double> data = column->values();
+        const QVector<Interval<int>> valid =
+                DescriptiveStatistics::validIntervals(data.size(), column->invalidIntervals());
+        if (valid.size() == 1 && valid.first().start() <= first && valid.first().end() >= last)
+            return (first == 0 && last == data.size() - 1) ? data
+                                                           : data.mid(first, last - first + 1);
+
+        result.reserve(last - first + 1);
+        for (const Interval<int> &iv : valid) {
+            if (iv.end() < first)
+                continue;
+            if (iv.start() > last)
+                break;
+            const int end = qMin(last, iv.end());
+            for (int row = qMax(first, iv.start()); row <= end; row++)
+                result << data.at(row);
+        }
+        return result;
+    }
+
+    const bool text = column->columnMode() == SciDAVis::ColumnMode::Text;
+    result.reserve(last - first + 1);
+    for (int row = first; row <= last; row++) {
+        if (column->isInvalid(row))
+            continue;
+        if (text) {
+            bool valid_data = true;
+            const double value = QLocale().toDouble(column->textAt(row), &valid_data);
+            if (valid_data)
+                result << value;
+        } else
+            result << column->valueAt(row);
+    }
+    return result;
+}
+
+HistogramData ColumnAggregation::histogram(const Column *column, int first, int last,
+                                           const HistogramBinning &binning)
+{
+    if (!column)
+        return HistogramData();
+
+    const quint64 version = column->version();
+    {
+        QMutexLocker locker(&histogram_cache_mutex);
+        for (int i = 0; i < histogram_cache.size(); i++) {
+            const HistogramCacheEntry &entry = histogram_cache.at(i);
+            if (entry.version == version && entry.first == first && entry.last == last
+                && entry.binning == binning) {
+                histogram_cache.move(i, 0);
+                return histogram_cache.first().histogram;
+            }
+        }
+    }
+
+    HistogramCacheEntry entry;
+    entry.version = version;
+    entry.first = first;
+    entry.last = last;
+    entry.binning = binning;
+    entry.histogram = histogram(values(column, first, last), binning);
+
+    QMutexLocker locker(&histogram_cache_mutex);
+    histogram_cache.prepend(entry);
+    while (histogram_cache.size() > CacheSize)
+        histogram_cache.removeLast();
+    return entry.histogram;
+}
+
+HistogramData ColumnAggregation::histogram(const QVector<double> &values,
+                                           const HistogramBinning &binning)
+{
+    HistogramData result;
+    const int size = values.size();
+    if (size < 2 || (size == 2 && values.at(0) == values.at(1)))
+        return result;
+    const double *data = values.constData();
+
+    // bin boundaries, computed the same way as gsl_histogram_set_ranges(_uniform)() does
+    int n;
+    QVector<double> range;
+    if (binning.autoBin) {
+        const DescriptiveStatistics stats =
+                DescriptiveStatistics::compute(data, size, QList<Interval<int>>());
+        const double begin = floor(stats.minimum()), end = ceil(stats.maximum());
+        if (!(begin < end))
+            return result;
+        n = 10;
+        range.resize(n + 1);
+        for (int i = 0; i <= n; i++)
+            range[i] = (double(n - i) / n) * begin + (double(i) / n) * end;
+        result.binning.autoBin = true;
+        result.binning.begin = begin;
+        result.binning.end = end;
+        result.binning.size = (end - begin) / n;
+    } else {
+        if (!(binning.size > 0))
+            return result;
+        n = int((binning.end - binning.begin) / binning.size + 1);
+        if (n <= 0)
+            return result;
+        range.resize(n + 1);
+        for (int i = 0; i <= n; i++)
+            range[i] = binning.begin + i * binning.size;
+        result.binning = binning;
+    }
+
+    // count blockwise on the thread pool; a value x belongs to bin i if range[i] <= x < range[i+1]
+    const double low = range.first(), high = range.last();
+    const double scale = n / (high - low);
+    const double *bounds = range.constData();
+    const int block_count = (size + DescriptiveStatistics::BlockSize - 1)
+            / DescriptiveStatistics::BlockSize;
+    QVector<QVector<int>> partial(block_count, QVector<int>(n, 0));
+    QVector<int> blocks(block_count);
+    for (int b = 0; b < block_count; b++) {
+        blocks[b] = b;
+        partial[b].detach();
+    }
+    QVector<int> *partial_counts = partial.data();
+    auto count_block = [&](int b) {
+        int *counts = partial_counts[b].data();
+        const int end = qMin((b + 1) * DescriptiveStatistics::BlockSize, size);
+        for (int j = b * DescriptiveStatistics::BlockSize; j < end; j++) {
+            const double x = data[j];
+            if (!(x >= low && x < high))
+                continue;
+            int i = qBound(0, int((x - low) * scale), n - 1);
+            // the estimate may be off by one due to rounding
+            while (i > 0 && x < bounds[i])
+                i--;
+            while (i < n - 1 && x >= bounds[i + 1])
+                i++;
+            counts[i]++;
+        }
+    };
+    if (block_count > 1)
+        QtConcurrent::blockingMap(blocks, count_block);
+    else
+        count_block(0);
+
+    result.lower = range.mid(0, n);
+    result.counts.fill(0.0, n);
+    for (const QVector<int> &counts : partial)
+        for (int i = 0; i < n; i++)
+            result.counts[i] += counts.at(i);
+
+    // weighted moments of the bin centers, like gsl_histogram_mean() and gsl_histogram_sigma()
+    double weight = 0.0, mean = 0.0;
+    for (int i = 0; i < n; i++) {
+        const double w = result.counts.at(i);
+        if (w > 0) {
+            weight += w;
+            mean += (0.5 * (range.at(i) + range.at(i + 1)) - mean) * (w / weight);
+        }
+    }
+    double variance = 0.0;
+    weight = 0.0;
+    for (int i = 0; i < n; i++) {
+        const double w = result.counts.at(i);
+        if (w > 0) {
+            const double delta = 0.5 * (range.at(i) + range.at(i + 1)) - mean;
+            weight += w;
+            variance += (delta * delta - variance) * (w / weight);
+        }
+    }
+    result.mean = mean;
+    result.standardDeviation = sqrt(variance);
+    result.minimum = *std::min_element(result.counts.constBegin(), result.counts.constEnd());
+    result.maximum = *std::max_element(result.counts.constBegin(), result.counts.constEnd());
+    return result;
+}
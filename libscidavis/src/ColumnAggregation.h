@@ -0,0 +1,101 @@
+/***************************************************************************
+    File                 : ColumnAggregation.h
+    Project              : SciDAVis
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 SciDAVis developers
+    Description          : Histogram and quantile aggregation of column data
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+#ifndef COLUMNAGGREGATION_H
+#define COLUMNAGGREGATION_H
+
+#include <QVector>
+
+class Column;
+
+//! Bin specification of a histogram
+struct HistogramBinning
+{
+    //! Use 10 bins between the floor of the minimum and the ceiling of the maximum
+    bool autoBin = true;
+    double size = 0.0;
+    double begin = 0.0;
+    double end = 0.0;
+
+    bool operator==(const HistogramBinning &other) const
+    {
+        return autoBin == other.autoBin
+                && (autoBin || (size == other.size && begin == other.begin && end == other.end));
+    }
+};
+
+//! Binned counts of a set of values
+struct HistogramData
+{
+    //! The binning that was actually used (computed ranges in the case of automatic binning)
+    HistogramBinning binning;
+    //! Lower bounds of the bins
+    QVector<double> lower;
+    //! Number of values in each bin
+    QVector<double> counts;
+    //! Mean and standard deviation of the bin centers, weighted by the counts
+    double mean = 0.0, standardDeviation = 0.0;
+    //! Smallest and largest count
+    double minimum = 0.0, maximum = 0.0;
+
+    //! Return whether any bins exist (less than two distinct values give no histogram)
+    bool isValid() const { return !counts.isEmpty(); }
+};
+
+//! Aggregation of column data for statistical plots
+/**
+  Histograms and box plots used to copy the values of their rows into
+  temporary arrays (several times), sort them and hand them to GSL. This
+  class works directly on the storage of numeric columns instead: the data
+  vector is shared with the column (no copy at all if all rows are used and
+  valid), minimum and maximum are found in one parallel pass, the values are
+  binned blockwise on the global thread pool and quantiles are found by
+  selection rather than sorting.
+
+  Histograms are cached per column version, row range and binning, so that
+  reloading a curve whose column has not changed (e.g. after a change to
+  another column of the same table) is free.
+  */
+class ColumnAggregation
+{
+public:
+    //! Return the valid values of the rows first to last of 'column'
+    /**
+     * For numeric columns whose rows are all valid, the result shares the
+     * data of the column. Text is converted using the current locale, values
+     * which cannot be converted are skipped.
+     */
+    static QVector<double> values(const Column *column, int first, int last);
+
+    //! Return the histogram of the valid values of the rows first to last of 'column'
+    static HistogramData histogram(const Column *column, int first, int last,
+                                   const HistogramBinning &binning);
+    //! Return the histogram of 'values'
+    static HistogramData histogram(const QVector<double> &values, const HistogramBinning &binning);
+};
+
+#endif // COLUMNAGGREGATION_H
@@ -0,0 +1,96 @@
+/***************************************************************************
+    File                 : CompiledFormula.cpp
+    Project              : SciDAVis
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 SciDAVis developers
+    Description          : Mathematical expression compiled once for repeated evaluation
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+#include "CompiledFormula.h"
+
+#include <QList>
+#include <QThreadStorage>
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+//! Number of formulas kept per thread
+const int CacheSize = 16;
+
+//! Most recently used formulas first
+QThreadStorage<QList<QSharedPointer<CompiledFormula>>> formula_cache;
+} // namespace
+
+CompiledFormula::CompiledFormula(const QString &formula, const QStringList &variables)
+    : d_formula(formula),
+      d_variable_names(variables),
+      d_values(variables.size(), std::numeric_limits<double>::quiet_NaN())
+{
+    for (int i = 0; i < variables.size(); i++)
+        d_parser.DefineVar(toString<string_type>(variables.at(i)), &d_values[i]);
+    d_parser.SetExpr(formula);
+    // the byte code is generated by the first evaluation; this also reports syntax errors now
+    d_parser.Eval();
+}
+
+QSharedPointer<CompiledFormula> CompiledFormula::cached(const QString &formula,
+                                                        const QStringList &variables,
+                                                        QString *error)
+{
+    QList<QSharedPointer<CompiledFormula>> &cache = formula_cache.localData();
+    for (int i = 0; i < cache.size(); i++)
+        if (cache.at(i)->formula() == formula && cache.at(i)->variableNames() == variables) {
+            cache.move(i, 0);
+            return cache.first();
+        }
+
+    QSharedPointer<CompiledFormula> result;
+    try {
+        result = QSharedPointer<CompiledFormula>(new CompiledFormula(formula, variables));
+    } catch (mu::ParserError &e) {
+        if (error)
+            *error = QStringFromString(e.GetMsg());
+        return QSharedPointer<CompiledFormula>();
+    }
+    cache.prepend(result);
+    while (cache.size() > CacheSize)
+        cache.removeLast();
+    return result;
+}
+
+double CompiledFormula::evaluate()
+{
+    try {
+        return d_parser.Eval();
+    } catch (mu::ParserError &e) {
+        if (d_error.isEmpty())
+            d_error = QStringFromString(e.GetMsg());
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+}
+
+double CompiledFormula::evaluate(const double *values)
+{
+    std::copy(values, values + d_values.size(), d_values.begin());
+    return evaluate();
+}
@@ -0,0 +1,94 @@
+/***************************************************************************
+    File                 : CompiledFormula.h
+    Project              : SciDAVis
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 SciDAVis developers
+    Description          : Mathematical expression compiled once for repeated evaluation
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+#ifndef COMPILEDFORMULA_H
+#define COMPILEDFORMULA_H
+
+#include "MyParser.h"
+
+#include <QSharedPointer>
+#include <QStringList>
+#include <QVector>
+
+//! A formula in a fixed set of variables, parsed once and evaluated many times
+/**
+  Setting a variable by name on a Script involves a map lookup and a
+  conversion of the name for every single value. A CompiledFormula binds its
+  variables to an array instead, so evaluating it for a new point only means
+  storing the values and running the byte code muParser generated on the
+  first evaluation.
+
+  The formula may use the functions and constants of MyParser, but no
+  statements, comments or table access; cached() fails for those, and callers
+  should fall back to a Script.
+
+  A CompiledFormula must not be evaluated by two threads at the same time.
+  cached() therefore keeps a separate cache for every thread.
+  */
+class CompiledFormula
+{
+public:
+    //! Parse 'formula'; throws mu::ParserError if it is invalid
+    CompiledFormula(const QString &formula, const QStringList &variables);
+
+    //! Return the compiled 'formula', reusing the one compiled last time on this thread if possible
+    /**
+     * Returns a null pointer if the formula cannot be compiled, storing the
+     * message of the parser in 'error' if given.
+     */
+    static QSharedPointer<CompiledFormula> cached(const QString &formula,
+                                                  const QStringList &variables,
+                                                  QString *error = nullptr);
+
+    const QString &formula() const { return d_formula; }
+    const QStringList &variableNames() const { return d_variable_names; }
+
+    //! The values of the variables, in the order given to the constructor
+    double *variables() { return d_values.data(); }
+    //! Evaluate the formula for the current values of the variables
+    /**
+     * Returns NaN if muParser throws an error; the message is then available from error().
+     */
+    double evaluate();
+    //! Set the variables to 'values' and evaluate the formula
+    double evaluate(const double *values);
+    //! Return the message of the first error of evaluate() since the last clearError()
+    const QString &error() const { return d_error; }
+    void clearError() { d_error.clear(); }
+
+private:
+    Q_DISABLE_COPY(CompiledFormula)
+
+    QString d_formula;
+    QStringList d_variable_names;
+    //! Storage of the variables; never resized, as muParser holds pointers into it
+    QVector<double> d_values;
+    MyParser d_parser;
+    QString d_error;
+};
+
+#endif // COMPILEDFORMULA_H
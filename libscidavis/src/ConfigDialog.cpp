@@ -556,13 +556,25 @@ void ConfigDialog::initAppPage()
     boxUndoLimit->setValue(app->undoLimit);
     topBoxLayout->addWidget(boxUndoLimit, 5, 1);
 
+    lblUndoMemoryLimit = new QLabel();
+    topBoxLayout->addWidget(lblUndoMemoryLimit, 6, 0);
+    boxUndoMemoryLimit = new QSpinBox();
+    boxUndoMemoryLimit->setRange(0, 1 << 20);
+    boxUndoMemoryLimit->setSingleStep(64);
+    boxUndoMemoryLimit->setValue(app->undoMemoryLimit);
+    topBoxLayout->addWidget(boxUndoMemoryLimit, 6, 1);
+
+    boxUndoSpillToDisk = new QCheckBox();
+    boxUndoSpillToDisk->setChecked(app->undoSpillToDisk);
+    topBoxLayout->addWidget(boxUndoSpillToDisk, 7, 0, 1, 2);
+
 #ifdef SEARCH_FOR_UPDATES
     boxSearchUpdates = new QCheckBox();
     boxSearchUpdates->setChecked(app->autoSearchUpdates);
-    topBoxLayout->addWidget(boxSearchUpdates, 6, 0, 1, 2);
+    topBoxLayout->addWidget(boxSearchUpdates, 8, 0, 1, 2);
 #endif
 
-    topBoxLayout->setRowStretch(7, 1);
+    topBoxLayout->setRowStretch(9, 1);
 
     appTabWidget->addTab(application, QString());
 
@@ -922,6 +934,10 @@ void ConfigDialog::languageChange()
     lblPanelsText->setText(tr("Panels text"));
     lblPanels->setText(tr("Panels"));
     lblUndoLimit->setText(tr("Undo/Redo History limit"));
+    lblUndoMemoryLimit->setText(tr("Undo/Redo memory limit"));
+    boxUndoMemoryLimit->setSuffix(tr(" MB"));
+    boxUndoMemoryLimit->setSpecialValueText(tr("unlimited"));
+    boxUndoSpillToDisk->setText(tr("Move old Undo/Redo data to a temporary file"));
     boxSave->setText(tr("Save every"));
 #ifdef SEARCH_FOR_UPDATES
     boxSearchUpdates->setText(tr("Check for new versions at startup"));
@@ -1138,6 +1154,7 @@ void ConfigDialog::apply()
     app->defaultScriptingLang = boxScriptingLanguage->currentText();
 
     app->undoLimit = boxUndoLimit->value(); // FIXME: can apply only after restart
+    app->setUndoStorageSettings(boxUndoMemoryLimit->value(), boxUndoSpillToDisk->isChecked());
 
     // general page: numeric format tab
     app->d_decimal_digits = boxAppPrecision->value();
@@ -159,7 +159,8 @@ private:
             *boxAppPrecision;
     QSpinBox *boxCurveLineWidth, *boxSymbolSize, *boxMinTicksLength, *boxMajTicksLength,
             *generatePointsBox;
-    QSpinBox *boxUndoLimit;
+    QSpinBox *boxUndoLimit, *boxUndoMemoryLimit;
+    QCheckBox *boxUndoSpillToDisk;
     ColorButton *btnWorkspace, *btnPanels, *btnPanelsText;
     QListWidget *itemsList;
     QLabel *labelFrameWidth, *lblLanguage, *lblWorkspace, *lblPanels, *lblPageHeader;
@@ -171,7 +172,7 @@ private:
     QGroupBox *groupBox3DFonts, *groupBox3DCol;
     QLabel *lblMargin, *lblMajTicks, *lblMajTicksLength, *lblLineWidth, *lblMinTicks,
             *lblMinTicksLength, *lblPoints, *lblPeaksColor;
-    QLabel *lblUndoLimit;
+    QLabel *lblUndoLimit, *lblUndoMemoryLimit;
     QGroupBox *groupBoxFittingCurve, *groupBoxFitParameters;
     QRadioButton *samePointsBtn, *generatePointsBtn;
     QGroupBox *groupBoxMultiPeak;
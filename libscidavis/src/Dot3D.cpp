@@ -0,0 +1,87 @@
+/***************************************************************************
+    File                 : Dot3D.cpp
+    Project              : SciDAVis
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 SciDAVis developers
+    Description          : 3D dots drawn from vertex arrays
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+#include "Dot3D.h"
+
+#include <qwt3d_color.h>
+
+using namespace Qwt3D;
+
+Dot3D::Dot3D()
+{
+    configure(1, false);
+}
+
+Dot3D::Dot3D(double pointsize, bool smooth)
+{
+    configure(pointsize, smooth);
+}
+
+void Dot3D::configure(double pointsize, bool smooth)
+{
+    plot = 0;
+    pointsize_ = pointsize;
+    smooth_ = smooth;
+}
+
+void Dot3D::drawBegin()
+{
+    vertices_.clear();
+    colors_.clear();
+}
+
+void Dot3D::draw(Qwt3D::Triple const &pos)
+{
+    RGBA rgba = (*plot->dataColor())(pos);
+    vertices_.insert(vertices_.end(), { pos.x, pos.y, pos.z });
+    colors_.insert(colors_.end(), { rgba.r, rgba.g, rgba.b, rgba.a });
+}
+
+void Dot3D::drawEnd()
+{
+    if (!vertices_.empty()) {
+        glPushAttrib(GL_POINT_BIT);
+        glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+        glPointSize(pointsize_);
+        if (smooth_)
+            glEnable(GL_POINT_SMOOTH);
+        else
+            glDisable(GL_POINT_SMOOTH);
+
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glEnableClientState(GL_COLOR_ARRAY);
+        glVertexPointer(3, GL_DOUBLE, 0, vertices_.data());
+        glColorPointer(4, GL_DOUBLE, 0, colors_.data());
+        glDrawArrays(GL_POINTS, 0, GLsizei(vertices_.size() / 3));
+
+        glPopClientAttrib();
+        glPopAttrib();
+    }
+    // release the memory, the points are collected again for every redraw
+    std::vector<GLdouble>().swap(vertices_);
+    std::vector<GLdouble>().swap(colors_);
+}
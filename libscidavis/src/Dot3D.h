@@ -0,0 +1,61 @@
+/***************************************************************************
+    File                 : Dot3D.h
+    Project              : SciDAVis
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 SciDAVis developers
+    Description          : 3D dots drawn from vertex arrays
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+#ifndef DOT3D_H
+#define DOT3D_H
+
+#include <qwt3d_plot.h>
+
+#include <vector>
+
+//! 3D dots (like Qwt3D::Dot, but drawn with a single glDrawArrays() call)
+/**
+ * The vertices passed to draw() are only collected, together with their colors. drawEnd() hands
+ * them to OpenGL as vertex arrays, which is much faster for large point clouds than issuing one
+ * glVertex() call per point.
+ */
+class Dot3D : public Qwt3D::VertexEnrichment
+{
+public:
+    Dot3D();
+    Dot3D(double pointsize, bool smooth);
+
+    Qwt3D::Enrichment *clone() const { return new Dot3D(*this); }
+
+    void configure(double pointsize, bool smooth);
+    void drawBegin();
+    void drawEnd();
+    void draw(Qwt3D::Triple const &);
+
+private:
+    double pointsize_;
+    bool smooth_;
+    //! Coordinates (x, y, z) and colors (r, g, b, a) of the points collected by draw()
+    std::vector<GLdouble> vertices_, colors_;
+};
+
+#endif
@@ -88,6 +88,9 @@ void Filter::setDataCurve(const int curve, double start, double end)
     if (start > end)
         qSwap(start, end);
 
+    // the curve has to reflect changes of its table made in the same event loop tick
+    ((ApplicationWindow *)parent())->updatePendingCurves();
+
     d_init_err = false;
     d_curve = d_graph->curve(curve);
     if ((nullptr == d_curve)|| (d_curve->rtti() != QwtPlotItem::Rtti_PlotCurve)) {
@@ -191,6 +194,7 @@ bool Filter::setDataFromCurve(const QString &curveTitle, Graph *const g)
         return false;
     }
 
+    ((ApplicationWindow *)parent())->updatePendingCurves();
     d_graph->range(index, d_from, d_to);
     setDataCurve(index, d_from, d_to);
     return true;
@@ -0,0 +1,347 @@
+/***************************************************************************
+    File                 : FilteredTable.cpp
+    Project              : SciDAVis
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 SciDAVis developers
+    Description          : Table showing the rows of another table which
+                           satisfy a condition
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "FilteredTable.h"
+#include "table/TableView.h"
+#include "table/future_Table.h"
+#include "core/column/Column.h"
+
+#include <QDateTime>
+#include <QtConcurrentMap>
+
+#include <algorithm>
+#include <limits>
+
+FilteredTable::FilteredTable(ScriptingEnv *env, QWidget *parent, Table *base,
+                             const QString &condition)
+    : Table(env, 1, 1, "", parent, ""), d_base(base), d_condition(condition), d_base_rows(0)
+{
+    setReadOnly();
+    d_apply_timer.setSingleShot(true);
+    d_apply_timer.setInterval(0);
+    connect(&d_apply_timer, SIGNAL(timeout()), this, SLOT(applyChanges()));
+
+    setCaptionPolicy(MyWidget::Both);
+    setName(QString(d_base->name()) + "-" + tr("Filtered"));
+    rebuild();
+}
+
+void FilteredTable::update(Table *t, const QString &colName)
+{
+    if (t != d_base)
+        return;
+
+    // rows announced by markModifiedRows(), or all rows
+    Interval<int> rows = d_modified_rows.take(colName);
+    if (d_changes.contains(colName)) {
+        Interval<int> pending = d_changes.value(colName);
+        if (rows.isValid() && pending.isValid())
+            rows = Interval<int>(qMin(rows.start(), pending.start()),
+                                 qMax(rows.end(), pending.end()));
+        else
+            rows = Interval<int>();
+    }
+    d_changes[colName] = rows;
+    d_apply_timer.start();
+}
+
+void FilteredTable::markModifiedRows(Table *t, const QString &colName, int first, int last)
+{
+    if (t != d_base)
+        return;
+    Interval<int> rows(first, last);
+    if (d_modified_rows.contains(colName))
+        rows = Interval<int>(qMin(first, d_modified_rows[colName].start()),
+                             qMax(last, d_modified_rows[colName].end()));
+    d_modified_rows[colName] = rows;
+}
+
+void FilteredTable::rebuild()
+{
+    d_apply_timer.stop();
+    d_changes.clear();
+    d_modified_rows.clear();
+
+    const int columns = d_base->numCols();
+    d_future_table->setColumnCount(columns);
+    // column names have to be unique at any time, so move changed ones out of the way first
+    for (int i = 0; i < columns; i++)
+        if (column(i)->name() != d_base->column(i)->name())
+            setColName(i, "_" + QString::number(i));
+    QVector<int> all(columns);
+    for (int i = 0; i < columns; i++) {
+        Column *source = d_base->column(i);
+        setColName(i, source->name());
+        if (column(i)->columnMode() != source->columnMode())
+            setColumnType(i, source->columnMode());
+        setColPlotDesignation(i, source->plotDesignation());
+        all[i] = i;
+    }
+
+    d_predicate = RowPredicate(d_condition, d_base->d_future_table);
+    if (d_predicate.isValid())
+        setWindowLabel(tr("Rows of %1 where %2").arg(d_base->name(), d_condition));
+    else
+        setWindowLabel(tr("Invalid condition %1 on %2: %3")
+                               .arg(d_condition, d_base->name(), d_predicate.errorString()));
+
+    d_rows.clear();
+    d_base_rows = d_base->numRows();
+    reselect(0, d_base_rows - 1);
+    d_future_table->setRowCount(d_rows.size());
+    copyRows(all, 0, d_rows.size() - 1);
+}
+
+void FilteredTable::applyChanges()
+{
+    QHash<QString, Interval<int>> changes;
+    changes.swap(d_changes);
+    if (!hasBaseColumns()) {
+        rebuild();
+        return;
+    }
+
+    // the changed columns of the base table, and the rows changed in them
+    const int base_rows = d_base->numRows();
+    QVector<int> columns;
+    QVector<Interval<int>> rows;
+    for (auto change = changes.constBegin(); change != changes.constEnd(); ++change) {
+        Column *source = d_base->column(change.key());
+        if (!source) {
+            rebuild();
+            return;
+        }
+        columns << d_base->d_future_table->columnIndex(source);
+        if (change.value().isValid())
+            rows << Interval<int>(change.value().start(),
+                                  qMin(change.value().end(), base_rows - 1));
+        else
+            rows << Interval<int>(0, base_rows - 1);
+    }
+
+    // select rows again where the condition may have changed; view rows before
+    // first_changed keep showing the same base rows
+    int first_changed = -1;
+    auto earliest = [&first_changed](int row) {
+        if (row >= 0 && (first_changed < 0 || row < first_changed))
+            first_changed = row;
+    };
+    if (base_rows != d_base_rows) {
+        // rows have been inserted or removed, so every row may have moved
+        const int kept = std::lower_bound(d_rows.constBegin(), d_rows.constEnd(), base_rows)
+                - d_rows.constBegin();
+        if (kept < d_rows.size()) {
+            d_rows.resize(kept);
+            earliest(kept);
+        }
+        d_base_rows = base_rows;
+        earliest(reselect(0, base_rows - 1));
+    } else
+        for (int i = 0; i < columns.size(); i++)
+            if (rows.at(i).isValid()
+                && d_predicate.refersTo(d_base->column(columns.at(i))->name()))
+                earliest(reselect(rows.at(i).start(), rows.at(i).end()));
+
+    if (first_changed >= 0) {
+        d_future_table->setRowCount(d_rows.size());
+        QVector<int> all(numCols());
+        for (int i = 0; i < all.size(); i++)
+            all[i] = i;
+        copyRows(all, first_changed, d_rows.size() - 1);
+    }
+
+    // changed cells in rows which are still shown at the same place
+    for (int i = 0; i < columns.size(); i++) {
+        if (!rows.at(i).isValid())
+            continue;
+        const int first = std::lower_bound(d_rows.constBegin(), d_rows.constEnd(),
+                                           rows.at(i).start())
+                - d_rows.constBegin();
+        int last = std::upper_bound(d_rows.constBegin(), d_rows.constEnd(), rows.at(i).end())
+                - d_rows.constBegin() - 1;
+        if (first_changed >= 0)
+            last = qMin(last, first_changed - 1);
+        copyRows(QVector<int>() << columns.at(i), first, last);
+    }
+}
+
+bool FilteredTable::hasBaseColumns()
+{
+    if (numCols() != d_base->numCols())
+        return false;
+    for (int i = 0; i < numCols(); i++) {
+        Column *source = d_base->column(i);
+        Column *target = column(i);
+        if (target->name() != source->name() || target->columnMode() != source->columnMode()
+            || target->plotDesignation() != source->plotDesignation())
+            return false;
+    }
+    return true;
+}
+
+int FilteredTable::reselect(int first, int last)
+{
+    QVector<int> selected;
+    const QVector<char> flags = d_predicate.evaluate(d_base->d_future_table, first, last);
+    for (int i = 0; i < flags.size(); i++)
+        if (flags.at(i))
+            selected << first + i;
+
+    // replace the rows previously selected out of first, ..., last
+    const int from =
+            std::lower_bound(d_rows.constBegin(), d_rows.constEnd(), first) - d_rows.constBegin();
+    const int to = std::upper_bound(d_rows.constBegin() + from, d_rows.constEnd(), last)
+            - d_rows.constBegin();
+    int same = 0;
+    while (same < selected.size() && from + same < to
+           && selected.at(same) == d_rows.at(from + same))
+        same++;
+    if (same == selected.size() && from + same == to)
+        return -1;
+    d_rows = d_rows.mid(0, from) + selected + d_rows.mid(to);
+    return from + same;
+}
+
+void FilteredTable::copyRows(const QVector<int> &columns, int first, int last)
+{
+    if (first > last || columns.isEmpty())
+        return;
+
+    // snapshot the base columns on this thread, then gather the cells in parallel
+    struct Job
+    {
+        Column *source;
+        QVector<qreal> values;
+        QStringList texts;
+        QList<QDateTime> date_times;
+        QList<Interval<int>> invalid;
+        //! whether the copied cells are invalid
+        QVector<bool> invalid_rows;
+    };
+    QVector<Job> jobs;
+    for (int col : columns) {
+        Job job;
+        job.source = d_base->column(col);
+        switch (job.source->dataType()) {
+        case SciDAVis::TypeDouble:
+            job.values = job.source->values();
+            break;
+        case SciDAVis::TypeQString:
+            job.texts = job.source->texts();
+            break;
+        case SciDAVis::TypeQDateTime:
+            job.date_times = job.source->dateTimes();
+            break;
+        }
+        job.invalid = job.source->invalidIntervals();
+        jobs << job;
+    }
+
+    const int count = last - first + 1;
+    const int *rows = d_rows.constData() + first;
+    auto gather = [&](Job &job) {
+        const int base_rows = rows[count - 1] + 1;
+        const QVector<bool> invalid = rowFlags(job.invalid, base_rows);
+        job.invalid_rows.resize(count);
+        switch (job.source->dataType()) {
+        case SciDAVis::TypeDouble: {
+            QVector<qreal> cells(count);
+            for (int i = 0; i < count; i++) {
+                const int row = rows[i];
+                job.invalid_rows[i] = invalid.at(row) || row >= job.values.size();
+                cells[i] = job.invalid_rows.at(i) ? std::numeric_limits<qreal>::quiet_NaN()
+                                                  : job.values.at(row);
+            }
+            job.values = cells;
+            break;
+        }
+        case SciDAVis::TypeQString: {
+            QStringList cells;
+            cells.reserve(count);
+            for (int i = 0; i < count; i++) {
+                const int row = rows[i];
+                job.invalid_rows[i] = invalid.at(row) || row >= job.texts.size();
+                cells << (job.invalid_rows.at(i) ? QString() : job.texts.at(row));
+            }
+            job.texts = cells;
+            break;
+        }
+        case SciDAVis::TypeQDateTime: {
+            QList<QDateTime> cells;
+            cells.reserve(count);
+            for (int i = 0; i < count; i++) {
+                const int row = rows[i];
+                job.invalid_rows[i] = invalid.at(row) || row >= job.date_times.size();
+                cells << (job.invalid_rows.at(i) ? QDateTime() : job.date_times.at(row));
+            }
+            job.date_times = cells;
+            break;
+        }
+        }
+    };
+    if (jobs.size() > 1)
+        QtConcurrent::blockingMap(jobs, gather);
+    else
+        gather(jobs.first());
+
+    for (int j = 0; j < jobs.size(); j++) {
+        const Job &job = jobs.at(j);
+        Column *target = column(columns.at(j));
+        switch (job.source->dataType()) {
+        case SciDAVis::TypeDouble:
+            target->replaceValues(first, job.values);
+            break;
+        case SciDAVis::TypeQString:
+            target->replaceTexts(first, job.texts);
+            break;
+        case SciDAVis::TypeQDateTime:
+            target->replaceDateTimes(first, job.date_times);
+            break;
+        }
+        // mark each run of invalid cells at once
+        for (Interval<int> iv :
+             flaggedIntervals(count, [&job](int i) { return job.invalid_rows.at(i); })) {
+            iv.translate(first);
+            target->setInvalid(iv);
+        }
+    }
+}
+
+QString FilteredTable::saveToString(const QString &geometry)
+{
+    QString s = "<FilteredTable>\n";
+    s += QString(name()) + "\t";
+    s += QString(d_base->name()) + "\t";
+    s += birthDate() + "\n";
+    s += "Condition\t" + d_condition + "\n";
+    s += geometry;
+    s += saveColumnWidths();
+    s += "WindowLabel\t" + windowLabel() + "\t" + QString::number(captionPolicy()) + "\n";
+    return s + "</FilteredTable>\n";
+}
@@ -0,0 +1,106 @@
+/***************************************************************************
+    File                 : FilteredTable.h
+    Project              : SciDAVis
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 SciDAVis developers
+    Description          : Table showing the rows of another table which
+                           satisfy a condition
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef FILTEREDTABLE_H
+#define FILTEREDTABLE_H
+
+#include "Table.h"
+#include "RowPredicate.h"
+
+#include <QHash>
+#include <QTimer>
+#include <QVector>
+
+//! Table showing the rows of another table which satisfy a condition
+/**
+  The filtered table has the columns (names, modes and plot designations) of
+  its base table and the rows for which a RowPredicate is true, in their
+  original order. Being a Table, it can be plotted, fitted, analyzed or
+  exported like any other table; it is read-only and can only be changed by
+  changing the base table.
+
+  Changes of the base table are collected (see Table::modifiedRows) and
+  applied together once control returns to the event loop. Only the changed
+  rows of the columns the condition refers to are evaluated again; if the
+  selection did not change, only the corresponding rows of the changed
+  columns are copied. The cells are copied in parallel over columns, from
+  snapshots of the base columns.
+  */
+class FilteredTable : public Table
+{
+    Q_OBJECT
+
+public:
+    FilteredTable(ScriptingEnv *env, QWidget *parent, Table *base, const QString &condition);
+    //! return the table of which rows are displayed
+    Table *base() const { return d_base; }
+    const RowPredicate &predicate() const { return d_predicate; }
+    //! return the rows of the base table shown (starting at 0), in ascending order
+    const QVector<int> &baseRows() const { return d_rows; }
+    // saving
+    virtual QString saveToString(const QString &geometry);
+
+public slots:
+    //! update the rows after a column has changed (to be connected with Table::modifiedData)
+    void update(Table *, const QString &colName);
+    //! remember which rows of a column have changed (to be connected with Table::modifiedRows)
+    void markModifiedRows(Table *, const QString &colName, int first, int last);
+    //! copy columns and rows of the base table again (e.g. after columns have been renamed)
+    void rebuild();
+
+private slots:
+    //! apply the changes collected by update() and markModifiedRows()
+    void applyChanges();
+
+private:
+    //! whether the columns match those of the base table
+    bool hasBaseColumns();
+    //! select the rows first, ..., last of the base table again; returns the first changed row
+    /**
+     * Returns -1 if the selection did not change.
+     */
+    int reselect(int first, int last);
+    //! copy the cells of the given columns to the rows first, ..., last
+    void copyRows(const QVector<int> &columns, int first, int last);
+
+    Table *d_base;
+    QString d_condition;
+    RowPredicate d_predicate;
+    //! the rows of the base table shown
+    QVector<int> d_rows;
+    //! number of rows of the base table when the rows were selected
+    int d_base_rows;
+    //! changed rows announced by markModifiedRows(), by column name
+    QHash<QString, Interval<int>> d_modified_rows;
+    //! changes collected by update(); an invalid interval means all rows
+    QHash<QString, Interval<int>> d_changes;
+    QTimer d_apply_timer;
+};
+
+#endif // ifndef FILTEREDTABLE_H
@@ -29,6 +29,9 @@
 #include "FindDialog.h"
 #include "ApplicationWindow.h"
 #include "Folder.h"
+#include "Matrix.h"
+#include "Note.h"
+#include "Table.h"
 
 #include <QPushButton>
 #include <QCheckBox>
@@ -36,6 +39,10 @@
 #include <QGridLayout>
 #include <QRegExp>
 #include <QLabel>
+#include <QLineEdit>
+#include <QMessageBox>
+#include <QTextCursor>
+#include <QTreeWidget>
 #include <QVBoxLayout>
 #include <QFrame>
 #include <QGroupBox>
@@ -64,6 +71,21 @@ FindDialog::FindDialog(QWidget *parent, Qt::WindowFlags fl) : QDialog(parent, fl
     boxFind->setSizePolicy(QSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed));
     topLayout->addWidget(boxFind, 1, 1, 1, 4);
 
+    topLayout->addWidget(new QLabel(tr("Match")), 2, 0);
+    boxMode = new QComboBox();
+    boxMode->addItem(tr("Text"));
+    boxMode->addItem(tr("Numbers From"));
+    boxMode->addItem(tr("Dates/Times From"));
+    topLayout->addWidget(boxMode, 2, 1);
+    labelTo = new QLabel(tr("to"));
+    topLayout->addWidget(labelTo, 2, 2);
+    boxTo = new QLineEdit();
+    topLayout->addWidget(boxTo, 2, 3, 1, 2);
+
+    topLayout->addWidget(new QLabel(tr("Replace With")), 3, 0);
+    boxReplace = new QLineEdit();
+    topLayout->addWidget(boxReplace, 3, 1, 1, 4);
+
     QGroupBox *groupBox = new QGroupBox(tr("Search in"));
     QVBoxLayout *groupBoxLayout = new QVBoxLayout(groupBox);
 
@@ -79,7 +101,19 @@ FindDialog::FindDialog(QWidget *parent, Qt::WindowFlags fl) : QDialog(parent, fl
     boxFolderNames->setChecked(false);
     groupBoxLayout->addWidget(boxFolderNames);
 
-    bottomLayout->addWidget(groupBox, 0, 0, 3, 1);
+    boxTableCells = new QCheckBox(tr("T&able Cells"));
+    boxTableCells->setChecked(false);
+    groupBoxLayout->addWidget(boxTableCells);
+
+    boxMatrixCells = new QCheckBox(tr("&Matrix Cells"));
+    boxMatrixCells->setChecked(false);
+    groupBoxLayout->addWidget(boxMatrixCells);
+
+    boxNotes = new QCheckBox(tr("N&otes"));
+    boxNotes->setChecked(false);
+    groupBoxLayout->addWidget(boxNotes);
+
+    bottomLayout->addWidget(groupBox, 0, 0, 4, 1);
 
     boxCaseSensitive = new QCheckBox(tr("Case &Sensitive"));
     boxCaseSensitive->setChecked(false);
@@ -93,25 +127,53 @@ FindDialog::FindDialog(QWidget *parent, Qt::WindowFlags fl) : QDialog(parent, fl
     boxSubfolders->setChecked(true);
     bottomLayout->addWidget(boxSubfolders, 2, 1);
 
+    boxRegExp = new QCheckBox(tr("Regular E&xpression"));
+    boxRegExp->setChecked(false);
+    bottomLayout->addWidget(boxRegExp, 3, 1);
+
     buttonFind = new QPushButton(tr("&Find"));
     buttonFind->setDefault(true);
     bottomLayout->addWidget(buttonFind, 0, 2);
 
+    buttonReplace = new QPushButton(tr("&Replace All"));
+    bottomLayout->addWidget(buttonReplace, 1, 2);
     buttonReset = new QPushButton(tr("&Update Start Path"));
-    bottomLayout->addWidget(buttonReset, 1, 2);
+    bottomLayout->addWidget(buttonReset, 2, 2);
     buttonCancel = new QPushButton(tr("&Close"));
-    bottomLayout->addWidget(buttonCancel, 2, 2);
+    bottomLayout->addWidget(buttonCancel, 3, 2);
+
+    labelResults = new QLabel();
+    resultList = new QTreeWidget();
+    resultList->setColumnCount(3);
+    resultList->setHeaderLabels(QStringList() << tr("Window") << tr("Cell") << tr("Content"));
+    resultList->setRootIsDecorated(false);
+    resultList->setUniformRowHeights(true);
 
     QVBoxLayout *mainLayout = new QVBoxLayout(this);
     mainLayout->addLayout(topLayout);
     mainLayout->addLayout(bottomLayout);
+    mainLayout->addWidget(labelResults);
+    mainLayout->addWidget(resultList);
+
+    d_search = new ProjectSearch(this);
 
     setStartPath();
+    updateControls();
 
     // signals and slots connections
     connect(buttonFind, SIGNAL(clicked()), this, SLOT(accept()));
+    connect(buttonReplace, SIGNAL(clicked()), this, SLOT(replaceAll()));
     connect(buttonReset, SIGNAL(clicked()), this, SLOT(setStartPath()));
     connect(buttonCancel, SIGNAL(clicked()), this, SLOT(reject()));
+    connect(boxMode, SIGNAL(currentIndexChanged(int)), this, SLOT(updateControls()));
+    connect(boxTableCells, SIGNAL(toggled(bool)), this, SLOT(updateControls()));
+    connect(boxMatrixCells, SIGNAL(toggled(bool)), this, SLOT(updateControls()));
+    connect(boxNotes, SIGNAL(toggled(bool)), this, SLOT(updateControls()));
+    connect(d_search, SIGNAL(hitsFound(QList<ProjectSearch::Hit>)), this,
+            SLOT(addHits(QList<ProjectSearch::Hit>)));
+    connect(d_search, SIGNAL(finished()), this, SLOT(searchFinished()));
+    connect(resultList, SIGNAL(itemActivated(QTreeWidgetItem *, int)), this,
+            SLOT(showHit(QTreeWidgetItem *)));
 }
 
 void FindDialog::setStartPath()
@@ -120,12 +182,171 @@ void FindDialog::setStartPath()
     labelStart->setText(app->current_folder->path());
 }
 
-void FindDialog::accept()
+void FindDialog::updateControls()
+{
+    bool contents = contentSearch();
+    bool text = boxMode->currentIndex() == ProjectSearch::Text;
+    boxWindowNames->setEnabled(!contents);
+    boxWindowLabels->setEnabled(!contents);
+    boxFolderNames->setEnabled(!contents);
+    boxMode->setEnabled(contents);
+    labelTo->setEnabled(contents && !text);
+    boxTo->setEnabled(contents && !text);
+    boxReplace->setEnabled(contents);
+    buttonReplace->setEnabled(contents);
+    boxRegExp->setEnabled(contents && text);
+    boxCaseSensitive->setEnabled(!contents || text);
+    boxPartialMatch->setEnabled(!contents || text);
+}
+
+bool FindDialog::contentSearch() const
+{
+    return boxTableCells->isChecked() || boxMatrixCells->isChecked() || boxNotes->isChecked();
+}
+
+bool FindDialog::readQuery(ProjectSearch::Query *query)
+{
+    query->mode = ProjectSearch::Mode(boxMode->currentIndex());
+    query->text = boxFind->currentText();
+    query->regexp = boxRegExp->isChecked();
+    query->case_sensitive = boxCaseSensitive->isChecked();
+    query->whole_cell = !boxPartialMatch->isChecked();
+    query->tables = boxTableCells->isChecked();
+    query->matrices = boxMatrixCells->isChecked();
+    query->notes = boxNotes->isChecked();
+
+    switch (query->mode) {
+    case ProjectSearch::Text: {
+        if (query->text.isEmpty()) {
+            QMessageBox::warning(this, tr("Nothing to find"),
+                                 tr("Please enter the text to find."));
+            return false;
+        }
+        QRegularExpression expression = query->expression();
+        if (!expression.isValid()) {
+            QMessageBox::warning(this, tr("Invalid regular expression"),
+                                 expression.errorString());
+            return false;
+        }
+        break;
+    }
+    case ProjectSearch::NumberRange:
+        if (!ProjectSearch::toNumber(query->text, &query->min)
+            || !ProjectSearch::toNumber(boxTo->text(), &query->max)) {
+            QMessageBox::warning(this, tr("Invalid range"),
+                                 tr("Please enter the first and the last number to find."));
+            return false;
+        }
+        if (query->min > query->max)
+            qSwap(query->min, query->max);
+        break;
+    case ProjectSearch::DateTimeRange:
+        query->from = ProjectSearch::toDateTime(query->text);
+        query->to = ProjectSearch::toDateTime(boxTo->text());
+        if (!query->from.isValid() || !query->to.isValid()) {
+            QMessageBox::warning(this, tr("Invalid range"),
+                                 tr("Please enter the first and the last date/time to find."));
+            return false;
+        }
+        if (query->from > query->to)
+            qSwap(query->from, query->to);
+        break;
+    }
+    return true;
+}
+
+QList<MyWidget *> FindDialog::searchedWindows() const
 {
     ApplicationWindow *app = (ApplicationWindow *)this->parent();
-    app->find(boxFind->currentText(), boxWindowNames->isChecked(), boxWindowLabels->isChecked(),
-              boxFolderNames->isChecked(), boxCaseSensitive->isChecked(),
-              boxPartialMatch->isChecked(), boxSubfolders->isChecked());
+    QList<Folder *> folders;
+    folders << app->current_folder;
+    QList<MyWidget *> windows;
+    for (int i = 0; i < folders.size(); i++) {
+        windows << folders.at(i)->windowsList();
+        if (boxSubfolders->isChecked())
+            folders << folders.at(i)->folders();
+    }
+    return windows;
+}
+
+void FindDialog::findContents()
+{
+    ProjectSearch::Query query;
+    if (!readQuery(&query))
+        return;
+    resultList->clear();
+    d_hits.clear();
+    labelResults->setText(tr("Searching..."));
+    d_search->start(searchedWindows(), query);
+}
+
+void FindDialog::addHits(const QList<ProjectSearch::Hit> &hits)
+{
+    QList<QTreeWidgetItem *> items;
+    for (const ProjectSearch::Hit &hit : hits) {
+        if (d_hits.size() == MaxHits) {
+            d_search->cancel();
+            break;
+        }
+        if (!hit.window)
+            continue;
+        QTreeWidgetItem *item = new QTreeWidgetItem();
+        item->setText(0, hit.window->name());
+        if (qobject_cast<Note *>(hit.window))
+            item->setText(1, tr("character %1").arg(hit.row + 1));
+        else
+            item->setText(1, tr("column %1, row %2").arg(hit.column + 1).arg(hit.row + 1));
+        item->setText(2, hit.text);
+        item->setData(0, Qt::UserRole, d_hits.size());
+        items << item;
+        d_hits << hit;
+    }
+    resultList->addTopLevelItems(items);
+}
+
+void FindDialog::searchFinished()
+{
+    if (d_hits.size() == MaxHits)
+        labelResults->setText(tr("Only the first %1 matches are shown").arg(MaxHits));
+    else if (d_hits.isEmpty())
+        labelResults->setText(tr("No match found"));
+    else
+        labelResults->setText(tr("%1 match(es) found").arg(d_hits.size()));
+}
+
+void FindDialog::showHit(QTreeWidgetItem *item)
+{
+    const ProjectSearch::Hit &hit = d_hits.at(item->data(0, Qt::UserRole).toInt());
+    MyWidget *w = hit.window;
+    if (!w)
+        return;
+    ApplicationWindow *app = (ApplicationWindow *)this->parent();
+    if (w->folder())
+        app->folders.setCurrentItem(w->folder()->folderListItem());
+    app->activateSubWindow(w);
+    if (Table *table = qobject_cast<Table *>(w))
+        table->goToCell(hit.row, hit.column);
+    else if (Matrix *matrix = qobject_cast<Matrix *>(w))
+        matrix->goToCell(hit.row, hit.column);
+    else if (Note *note = qobject_cast<Note *>(w)) {
+        QTextCursor cursor = note->textWidget()->textCursor();
+        cursor.setPosition(hit.row);
+        cursor.setPosition(hit.row + hit.column, QTextCursor::KeepAnchor);
+        note->textWidget()->setTextCursor(cursor);
+    }
+}
+
+void FindDialog::accept()
+{
+    if (contentSearch())
+        findContents();
+    else {
+        ApplicationWindow *app = (ApplicationWindow *)this->parent();
+        app->find(boxFind->currentText(), boxWindowNames->isChecked(),
+                  boxWindowLabels->isChecked(), boxFolderNames->isChecked(),
+                  boxCaseSensitive->isChecked(), boxPartialMatch->isChecked(),
+                  boxSubfolders->isChecked());
+    }
     // add the combo box's current text to the list when the find button is pressed
     QString text = boxFind->currentText();
     if (!text.isEmpty()) {
@@ -137,4 +358,26 @@ void FindDialog::accept()
     }
 }
 
+void FindDialog::replaceAll()
+{
+    ProjectSearch::Query query;
+    if (!readQuery(&query))
+        return;
+    QString replacement = boxReplace->text();
+    double number;
+    if ((query.mode == ProjectSearch::NumberRange
+         && !ProjectSearch::toNumber(replacement, &number))
+        || (query.mode == ProjectSearch::DateTimeRange
+            && !ProjectSearch::toDateTime(replacement).isValid())) {
+        QMessageBox::warning(this, tr("Invalid replacement"),
+                             tr("Please enter the value to put into the matching cells."));
+        return;
+    }
+    d_search->cancel();
+    resultList->clear();
+    d_hits.clear();
+    int count = ProjectSearch::replace(searchedWindows(), query, replacement);
+    labelResults->setText(tr("%1 cell(s) or passage(s) replaced").arg(count));
+}
+
 FindDialog::~FindDialog() { }
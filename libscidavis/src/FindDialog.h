@@ -32,12 +32,22 @@
 #include <QDialog>
 #include <QLabel>
 
+#include "ProjectSearch.h"
+
 class QPushButton;
 class QCheckBox;
 class QComboBox;
 class QLabel;
+class QLineEdit;
+class QTreeWidget;
+class QTreeWidgetItem;
 
 //! Find dialog
+/**
+ * Finds windows and folders by name or, if any of the content boxes is checked, searches the
+ * contents of tables, matrices and notes (see ProjectSearch). Content hits are listed as they
+ * are found; double-clicking one shows the cell or passage.
+ */
 class FindDialog : public QDialog
 {
     Q_OBJECT
@@ -47,20 +57,46 @@ public:
     ~FindDialog();
 
 private:
+    //! At most that many content hits are listed
+    static constexpr int MaxHits = 10000;
+
+    //! Whether the contents of windows are searched instead of names
+    bool contentSearch() const;
+    //! Read the content query from the dialog; returns false (after telling why) if invalid
+    bool readQuery(ProjectSearch::Query *query);
+    //! The windows in the start folder and, optionally, its subfolders
+    QList<MyWidget *> searchedWindows() const;
+    void findContents();
+
     QPushButton *buttonFind;
+    QPushButton *buttonReplace;
     QPushButton *buttonCancel;
     QPushButton *buttonReset;
 
     QLabel *labelStart;
     QComboBox *boxFind;
+    QComboBox *boxMode;
+    QLabel *labelTo;
+    QLineEdit *boxTo;
+    QLineEdit *boxReplace;
 
     QCheckBox *boxWindowNames;
     QCheckBox *boxWindowLabels;
     QCheckBox *boxFolderNames;
+    QCheckBox *boxTableCells;
+    QCheckBox *boxMatrixCells;
+    QCheckBox *boxNotes;
 
     QCheckBox *boxCaseSensitive;
     QCheckBox *boxPartialMatch;
     QCheckBox *boxSubfolders;
+    QCheckBox *boxRegExp;
+
+    QLabel *labelResults;
+    QTreeWidget *resultList;
+
+    ProjectSearch *d_search;
+    QList<ProjectSearch::Hit> d_hits;
 
 public slots:
 
@@ -70,6 +106,11 @@ public slots:
 protected slots:
 
     void accept();
+    void replaceAll();
+    void updateControls();
+    void addHits(const QList<ProjectSearch::Hit> &hits);
+    void searchFinished();
+    void showHit(QTreeWidgetItem *item);
 };
 
 #endif // exportDialog_H
@@ -35,6 +35,8 @@
 #include "FunctionCurve.h"
 #include "ColorButton.h"
 #include "Script.h"
+#include "CompiledFormula.h"
+#include "MuParserScripting.h"
 #include "core/column/Column.h"
 
 #include <gsl/gsl_statistics.h>
@@ -42,6 +44,8 @@
 #include <gsl/gsl_deriv.h>
 #include <gsl/gsl_version.h>
 
+#include <cmath>
+
 #include <QApplication>
 #include <QMessageBox>
 #include <QDateTime>
@@ -252,6 +256,9 @@ QString Fit::logFitInfo(const vector<double> &par, int iterations, int status,
             info += tr("Scaled Levenberg-Marquardt");
 
         info += tr(" algorithm with tolerance = ") + QLocale().toString(d_tolerance) + "\n";
+    } else if (d_robust_weighting != NoRobustWeighting) {
+        info += (d_robust_weighting == HuberWeighting ? tr("Huber") : tr("Bisquare"))
+                + tr(" robust weighting, %1 iterations").arg(iterations) + "\n";
     }
 
     info += tr("From x") + " = " + QLocale().toString(d_x[0], 'g', 15) + " " + tr("to x") + " = "
@@ -493,15 +500,20 @@ void Fit::fit()
 
     int status, iterations;
     vector<double> par;
-    d_script.reset(scriptEnv->newScript(d_formula, this, metaObject()->className()));
-    connect(d_script.get(), SIGNAL(error(const QString &, const QString &, int)), this,
-            SLOT(scriptError(const QString &, const QString &, int)));
+    compileFormula();
 
     if (d_solver == NelderMeadSimplex)
         par = fitGslMultimin(iterations, status);
     else
         par = fitGslMultifit(iterations, status);
 
+    if (!d_formula_error.isEmpty()) {
+        QApplication::restoreOverrideCursor();
+        QMessageBox::critical(qobject_cast<QWidget *>(parent()), tr("Input function error"),
+                              d_formula_error);
+        return;
+    }
+
     storeCustomFitResults(par);
     if (status == GSL_SUCCESS)
         generateFitCurve(par);
@@ -509,19 +521,71 @@ void Fit::fit()
     ApplicationWindow *app = (ApplicationWindow *)parent();
     if (app->writeFitResultsToLog)
         app->updateLog(logFitInfo(d_results, iterations, status, d_graph->parentPlotName()));
-    disconnect(d_script.get(), SIGNAL(error(const QString &, const QString &, int)), this,
-               SLOT(scriptError(const QString &, const QString &, int)));
+    if (d_script)
+        disconnect(d_script.get(), SIGNAL(error(const QString &, const QString &, int)), this,
+                   SLOT(scriptError(const QString &, const QString &, int)));
     QApplication::restoreOverrideCursor();
 }
 
+void Fit::compileFormula()
+{
+    d_compiled_formula.clear();
+    d_formula_error.clear();
+    d_script.reset();
+    // built-in models are evaluated natively and don't need the formula
+    if (d_fsimplex != user_d)
+        return;
+
+    // the compiled formula is evaluated by muParser, which gives functions like log() a different
+    // meaning than e.g. Python does
+    if (scriptEnv->objectName() == MuParserScripting::langName) {
+        d_compiled_formula = CompiledFormula::cached(d_formula, QStringList(d_param_names) << "x");
+        if (d_compiled_formula) {
+            d_compiled_formula->clearError();
+            return;
+        }
+    }
+
+    // formulas using features of the scripting language are left to it
+    d_script.reset(scriptEnv->newScript(d_formula, this, metaObject()->className()));
+    connect(d_script.get(), SIGNAL(error(const QString &, const QString &, int)), this,
+            SLOT(scriptError(const QString &, const QString &, int)));
+}
+
 void Fit::scriptError(const QString &message, const QString &script_name, int line_number)
 {
     QMessageBox::critical(qobject_cast<QWidget *>(parent()), tr("Input function error"),
                           QString("%1:%2\n").arg(script_name).arg(line_number) + message);
 }
 
+int Fit::formulaError(double x)
+{
+    if (d_formula_error.isEmpty()) {
+        d_formula_error = tr("The fit function cannot be evaluated at x = %1 for the parameters "
+                             "reached by the fit.")
+                                  .arg(x);
+        if (!d_compiled_formula->error().isEmpty())
+            d_formula_error += "\n" + d_compiled_formula->error();
+    }
+    return GSL_EINVAL;
+}
+
 int Fit::evaluate_f(const gsl_vector *x, gsl_vector *f)
 {
+    if (d_compiled_formula) {
+        double *variables = d_compiled_formula->variables();
+        for (unsigned i = 0; i < d_p; i++)
+            variables[i] = gsl_vector_get(x, i);
+        for (unsigned j = 0; j < d_x.size(); j++) {
+            variables[d_p] = d_x[j];
+            const double y = d_compiled_formula->evaluate();
+            if (!std::isfinite(y))
+                return formulaError(d_x[j]);
+            gsl_vector_set(f, j, (y - d_y[j]) / d_y_errors[j]);
+        }
+        return GSL_SUCCESS;
+    }
+
     for (unsigned i = 0; i < d_p; i++) {
         d_script->setDouble(gsl_vector_get(x, i), d_param_names[i].toUtf8());
     }
@@ -542,6 +606,24 @@ int Fit::evaluate_f(const gsl_vector *x, gsl_vector *f)
 double Fit::evaluate_d(const gsl_vector *x)
 {
     double result = 0.0;
+    if (d_compiled_formula) {
+        double *variables = d_compiled_formula->variables();
+        for (unsigned i = 0; i < d_p; i++)
+            variables[i] = gsl_vector_get(x, i);
+        for (unsigned j = 0; j < d_x.size(); j++) {
+            variables[d_p] = d_x[j];
+            const double y = d_compiled_formula->evaluate();
+            if (!std::isfinite(y)) {
+                // the simplex stops at a non-finite value
+                formulaError(d_x[j]);
+                return y;
+            }
+            const double residual = (y - d_y[j]) / d_y_errors[j];
+            result += residual * residual;
+        }
+        return result;
+    }
+
     for (unsigned i = 0; i < d_p; i++)
         d_script->setDouble(gsl_vector_get(x, i), d_param_names[i].toUtf8());
     for (unsigned j = 0; j < d_x.size(); j++) {
@@ -558,12 +640,19 @@ typedef struct
 {
     Script *script;
     QString param;
+    CompiledFormula *formula;
+    //! Index of the parameter in the variables of formula
+    unsigned index;
     bool success;
 } DiffData;
 
 double Fit::evaluate_df_helper(double x, void *params)
 {
     DiffData *data = static_cast<DiffData *>(params);
+    if (data->formula) {
+        data->formula->variables()[data->index] = x;
+        return data->formula->evaluate();
+    }
     data->script->setDouble(x, (data->param).toUtf8());
     bool success;
     double result = data->script->eval().toDouble(&success);
@@ -582,17 +671,34 @@ int Fit::evaluate_df(const gsl_vector *x, gsl_matrix *J)
     DiffData data;
     F.params = &data;
     data.script = d_script.get();
+    data.formula = d_compiled_formula.data();
     data.success = true;
-    for (unsigned i = 0; i < d_p; i++)
-        d_script->setDouble(gsl_vector_get(x, i), d_param_names[i].toUtf8());
+    double *variables = data.formula ? data.formula->variables() : nullptr;
+    for (unsigned i = 0; i < d_p; i++) {
+        if (variables)
+            variables[i] = gsl_vector_get(x, i);
+        else
+            d_script->setDouble(gsl_vector_get(x, i), d_param_names[i].toUtf8());
+    }
     for (unsigned i = 0; i < d_x.size(); i++) {
-        d_script->setDouble(d_x[i], "x");
+        if (variables)
+            variables[d_p] = d_x[i];
+        else
+            d_script->setDouble(d_x[i], "x");
         for (unsigned j = 0; j < d_p; j++) {
             data.param = d_param_names[j];
+            data.index = j;
             gsl_deriv_central(&F, gsl_vector_get(x, j), 1e-8, &result, &abserr);
             if (!data.success)
                 return GSL_EINVAL;
-            gsl_matrix_set(J, i, j, result / d_y_errors[j]);
+            if (variables && !std::isfinite(result))
+                return formulaError(d_x[i]);
+            // the differentiation leaves the parameter at a displaced value
+            if (variables)
+                variables[j] = gsl_vector_get(x, j);
+            else
+                d_script->setDouble(gsl_vector_get(x, j), d_param_names[j].toUtf8());
+            gsl_matrix_set(J, i, j, result / d_y_errors[i]);
         }
     }
     return GSL_SUCCESS;
@@ -37,12 +37,15 @@
 #include <gsl/gsl_multifit_nlin.h>
 #include <gsl/gsl_multimin.h>
 
+#include <QSharedPointer>
+
 #include <vector>
 
 class Table;
 class Matrix;
 class ApplicationWindow;
 class Script;
+class CompiledFormula;
 
 //! Fit base class
 class Fit : public Filter, public scripted
@@ -57,6 +60,8 @@ public:
 
     enum Algorithm { ScaledLevenbergMarquardt, UnscaledLevenbergMarquardt, NelderMeadSimplex };
     enum ErrorSource { UnknownErrors, AssociatedErrors, PoissonErrors, CustomErrors };
+    //! Iterative down-weighting of outliers, supported by the linear fits
+    enum RobustWeighting { NoRobustWeighting, HuberWeighting, BisquareWeighting };
 
     Fit(ApplicationWindow *parent, Graph *g = 0, QString name = QString());
     virtual ~Fit();
@@ -78,6 +83,7 @@ public:
     virtual void guessInitialValues() {};
 
     void setAlgorithm(Algorithm s) { d_solver = s; };
+    void setRobustWeighting(RobustWeighting w) { d_robust_weighting = w; };
 
     //! Specifies weather the result of the fit is a function curve
     void generateFunction(bool yes, int points = 100);
@@ -118,10 +124,18 @@ private:
     //! Execute the fit using GSL non-linear least-squares fitting (Levenberg-Marquardt).
     std::vector<double> fitGslMultifit(int &iterations, int &status);
 
+    //! Prepares the evaluation of d_formula, if the fit model is given by it
+    void compileFormula();
+
     //! Customs and stores the fit results according to the derived class specifications. Used by exponential fits.
     virtual void storeCustomFitResults(const std::vector<double> &par) { d_results = par; }
 
 protected:
+    //! Record that d_compiled_formula could not be evaluated at 'x'; returns GSL_EINVAL
+    /**
+     * The error is reported by fit() once the solver has stopped.
+     */
+    int formulaError(double x);
     //! Generates argument values wrt to d_gen_function
     void generateX(std::vector<double> &X) const;
 
@@ -174,6 +188,9 @@ protected:
     //! Algorithm type
     Algorithm d_solver;
 
+    //! Weight function for outliers (linear fits only)
+    RobustWeighting d_robust_weighting = NoRobustWeighting;
+
     //! The fit formula
     QString d_formula;
 
@@ -198,7 +215,12 @@ protected:
     //! Specifies wheather the errors must be scaled with sqrt(chi_2/dof)
     bool d_scale_errors;
 
-    //! Script used to evaluate user-defined functions.
+    //! Compiled user-defined function, with the parameters followed by x as variables.
+    QSharedPointer<CompiledFormula> d_compiled_formula;
+    //! The first error of d_compiled_formula during the fit, see formulaError()
+    QString d_formula_error;
+
+    //! Script used to evaluate user-defined functions which cannot be compiled.
     std::unique_ptr<Script> d_script;
 };
 
@@ -166,6 +166,14 @@ void FitDialog::initFitPage()
     gl3->addWidget(new QLabel(tr("Tolerance")), 1, 0);
     boxTolerance = new QLineEdit("1e-4");
     gl3->addWidget(boxTolerance, 1, 1);
+    lblRobustWeighting = new QLabel(tr("Robust weighting"));
+    gl3->addWidget(lblRobustWeighting, 2, 0);
+    boxRobustWeighting = new QComboBox();
+    boxRobustWeighting->addItem(tr("None"));
+    boxRobustWeighting->addItem(tr("Huber"));
+    boxRobustWeighting->addItem(tr("Bisquare"));
+    boxRobustWeighting->setToolTip(tr("Down-weights outliers"));
+    gl3->addWidget(boxRobustWeighting, 2, 1);
     QGroupBox *gb3 = new QGroupBox();
     gb3->setLayout(gl3);
 
@@ -676,6 +684,12 @@ void FitDialog::showFitPage()
         }
     }
 
+    // robust weighting is only supported by the (linear) polynomial fit
+    const bool robust = boxUseBuiltIn->isChecked() && categoryBox->currentRow() == 1
+            && funcBox->currentItem() && funcBox->currentItem()->text() == "Polynomial";
+    lblRobustWeighting->setVisible(robust);
+    boxRobustWeighting->setVisible(robust);
+
     boxFunction->setText(editBox->toPlainText().simplified());
     lblFunction->setText(boxName->text() + " (x, " + par + ")");
 
@@ -1164,6 +1178,11 @@ void FitDialog::accept()
 
     d_fitter->setTolerance(eps);
     d_fitter->setAlgorithm((Fit::Algorithm)boxAlgorithm->currentIndex());
+    // the weighting is hidden for fits which don't support it
+    const Fit::RobustWeighting weighting = boxRobustWeighting->isHidden()
+            ? Fit::NoRobustWeighting
+            : (Fit::RobustWeighting)boxRobustWeighting->currentIndex();
+    d_fitter->setRobustWeighting(weighting);
     d_fitter->setColor(btnColor->color());
     d_fitter->generateFunction(generatePointsBtn->isChecked(), generatePointsBox->value());
     d_fitter->setMaximumIterations(boxPoints->value());
@@ -166,7 +166,7 @@ private:
     QPushButton *buttonPlugins;
     QPushButton *btnBack;
     QComboBox *boxCurve;
-    QComboBox *boxAlgorithm;
+    QComboBox *boxAlgorithm, *boxRobustWeighting;
     QTableWidget *boxParams;
     QLineEdit *boxFrom;
     QLineEdit *boxTo;
@@ -176,7 +176,7 @@ private:
     QTextEdit *editBox, *explainBox, *boxFunction;
     QListWidget *categoryBox, *funcBox;
     QLineEdit *boxName, *boxParam;
-    QLabel *lblFunction, *lblPoints, *polynomOrderLabel;
+    QLabel *lblFunction, *lblPoints, *polynomOrderLabel, *lblRobustWeighting;
     QPushButton *btnAddFunc, *btnDelFunc, *btnContinue, *btnApply;
     QPushButton *buttonEdit, *btnAddTxt, *btnAddName, *btnDeleteFitCurves;
     ColorButton *btnColor;
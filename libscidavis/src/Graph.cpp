@@ -1802,6 +1802,14 @@ QString Graph::pieLegendText()
 }
 
 void Graph::updateCurvesData(Table *w, const QString &colName)
+{
+    QHash<Table *, QStringList> columns;
+    columns[w] << colName;
+    updateCurvesData(columns);
+}
+
+void Graph::updateCurvesData(const QHash<Table *, QStringList> &columns,
+                             const QHash<QString, Interval<int>> &rows)
 {
     QList<int> keys = d_plot->curveKeys();
     int updated_curves = 0;
@@ -1815,7 +1823,12 @@ void Graph::updateCurvesData(Table *w, const QString &colName)
         if (static_cast<PlotCurve *>(it)->type() == Function)
             continue;
         DataCurve *c = static_cast<DataCurve *>(it);
-        if (c->table() == w && (c->xColumnName() == colName || c->yColumnName() == colName)) {
+        Table *w = c->table();
+        const QStringList changed = columns.value(w);
+        bool remove = false;
+        foreach (const QString &colName, changed) {
+            if (c->xColumnName() != colName && c->yColumnName() != colName)
+                continue;
             auto colType = w->column(colName)->columnMode();
             AxisType atype;
             if (c->xColumnName() == colName) {
@@ -1833,12 +1846,38 @@ void Graph::updateCurvesData(Table *w, const QString &colName)
             if ((colType == SciDAVis::ColumnMode::Text && atype != AxisType::Txt)
                 || (colType == SciDAVis::ColumnMode::DateTime
                     && ((atype != AxisType::Time) && (atype != AxisType::Date)
-                        && (atype != AxisType::DateTime))))
-                to_remove << c;
-            else if (c->updateData(w, colName))
+                        && (atype != AxisType::DateTime)))) {
+                remove = true;
+                break;
+            }
+        }
+        if (remove) {
+            to_remove << c;
+            continue;
+        }
+        // rows changed in any of the columns the curve depends on (invalid if all rows changed)
+        QStringList dependencies = c->columnNames();
+        Interval<int> changed_rows;
+        bool first_change = true;
+        foreach (const QString &colName, changed) {
+            if (!dependencies.contains(colName))
+                continue;
+            Interval<int> r = rows.value(colName);
+            if (first_change)
+                changed_rows = r;
+            else if (changed_rows.isValid() && r.isValid())
+                changed_rows = Interval<int>(qMin(changed_rows.start(), r.start()),
+                                             qMax(changed_rows.end(), r.end()));
+            else
+                changed_rows = Interval<int>();
+            first_change = false;
+        }
+        // the first changed column the curve depends on reloads it
+        foreach (const QString &colName, changed)
+            if (c->updateRows(w, colName, changed_rows)) {
                 updated_curves++;
-        } else if (((DataCurve *)it)->updateData(w, colName))
-            updated_curves++;
+                break;
+            }
     }
     foreach (PlotCurve *c, to_remove) {
         removeCurve(curveIndex(c));
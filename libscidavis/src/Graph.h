@@ -223,6 +223,14 @@ public slots:
     void removeCurves(const QString &s);
 
     void updateCurvesData(Table *w, const QString &yColName);
+    //! Reload the curves plotted from any of the given columns (by table) and replot once
+    /**
+     * Every curve is reloaded at most once, no matter how many of its columns changed. 'rows'
+     * holds the changed rows of a column, if not all of them changed (see
+     * DataCurve::updateRows()).
+     */
+    void updateCurvesData(const QHash<Table *, QStringList> &columns,
+                          const QHash<QString, Interval<int>> &rows = QHash<QString, Interval<int>>());
 
     int curves() const { return n_curves; };
     bool validCurvesDataSize() const;
@@ -32,7 +32,8 @@
 #include "Graph3D.h"
 #include "Bar.h"
 #include "Cone3D.h"
-#include "MyParser.h"
+#include "Dot3D.h"
+#include "CompiledFormula.h"
 #include "ColorButton.h"
 #include "core/column/Column.h"
 
@@ -47,16 +48,31 @@
 #include <QDateTime>
 #include <QCursor>
 #include <QImageWriter>
+#include <QtConcurrentMap>
 
 #include <qwt3d_io_gl2ps.h>
 #include <qwt3d_coordsys.h>
 
 #include <gsl/gsl_vector.h>
+#include <cfloat>
+#include <cmath>
 #include <fstream>
 #include <stdexcept>
 using namespace std;
 
-UserFunction::UserFunction(const QString &s, SurfacePlot &pw) : Function(pw)
+UserFunction::UserFunction(const QString &s, SurfacePlot &pw)
+    : Function(pw),
+      d_plot(&pw),
+      d_columns(0),
+      d_rows(0),
+      d_x_min(0.0),
+      d_x_max(0.0),
+      d_y_min(0.0),
+      d_y_max(0.0),
+      d_z_min(-DBL_MAX),
+      d_z_max(DBL_MAX),
+      d_adaptive(false),
+      d_tolerance(1e-3)
 {
     formula = s;
 }
@@ -66,18 +82,185 @@ double UserFunction::operator()(double x, double y)
     if (formula.isEmpty())
         return 0.0;
 
-    MyParser parser;
-    double result = 0.0;
-    try {
-        parser.DefineVar(_T("x"), &x);
-        parser.DefineVar(_T("y"), &y);
+    QString error;
+    QSharedPointer<CompiledFormula> compiled =
+            CompiledFormula::cached(formula, QStringList() << "x" << "y", &error);
+    if (!compiled) {
+        QMessageBox::critical(0, "Input function error", error);
+        return 0.0;
+    }
+    const double xy[] = { x, y };
+    return compiled->evaluate(xy);
+}
+
+void UserFunction::setGrid(unsigned int columns, unsigned int rows)
+{
+    setMesh(columns, rows);
+    d_columns = columns;
+    d_rows = rows;
+}
+
+void UserFunction::setXYRange(double xl, double xr, double yl, double yr)
+{
+    setDomain(xl, xr, yl, yr);
+    d_x_min = xl;
+    d_x_max = xr;
+    d_y_min = yl;
+    d_y_max = yr;
+}
+
+void UserFunction::setZRange(double zl, double zr)
+{
+    setMinZ(zl);
+    setMaxZ(zr);
+    d_z_min = zl;
+    d_z_max = zr;
+}
+
+void UserFunction::setAdaptiveRefinement(bool on, double tolerance)
+{
+    d_adaptive = on;
+    d_tolerance = tolerance;
+}
 
-        parser.SetExpr(formula);
-        result = parser.Eval();
-    } catch (mu::ParserError &e) {
-        QMessageBox::critical(0, "Input function error", QStringFromString(e.GetMsg()));
+void UserFunction::sample(double *values, const QVector<int> &points) const
+{
+    const int block_size = 1024;
+    QVector<int> blocks((points.size() + block_size - 1) / block_size);
+    for (int b = 0; b < blocks.size(); b++)
+        blocks[b] = b;
+    const double dx = (d_x_max - d_x_min) / (d_columns - 1);
+    const double dy = (d_y_max - d_y_min) / (d_rows - 1);
+    const int rows = d_rows;
+    QtConcurrent::blockingMap(blocks, [&](int b) {
+        const int end = qMin((b + 1) * block_size, points.size());
+        // every thread has its own copy of the compiled formula
+        QSharedPointer<CompiledFormula> compiled =
+                CompiledFormula::cached(formula, QStringList() << "x" << "y");
+        double *xy = compiled ? compiled->variables() : nullptr;
+        for (int k = b * block_size; k < end; k++) {
+            const int point = points.at(k);
+            if (!compiled) {
+                values[point] = 0.0;
+                continue;
+            }
+            xy[0] = d_x_min + (point / rows) * dx;
+            xy[1] = d_y_min + (point % rows) * dy;
+            values[point] = compiled->evaluate();
+        }
+    });
+}
+
+void UserFunction::sampleAdaptively(double *values, QVector<char> &known) const
+{
+    const int rows = d_rows;
+    auto coarse = [](int count) {
+        QVector<int> result;
+        for (int i = 0; i < count - 1; i += RefinementStep)
+            result << i;
+        result << count - 1;
+        return result;
+    };
+    const QVector<int> ci = coarse(d_columns), cj = coarse(d_rows);
+
+    // corners and centers of the coarse cells
+    QVector<int> points;
+    for (int i : ci)
+        for (int j : cj)
+            points << i * rows + j;
+    for (int m = 0; m < ci.size() - 1; m++)
+        for (int n = 0; n < cj.size() - 1; n++)
+            points << (ci.at(m) + ci.at(m + 1)) / 2 * rows + (cj.at(n) + cj.at(n + 1)) / 2;
+    sample(values, points);
+    for (int point : points)
+        known[point] = 1;
+
+    double z_min = DBL_MAX, z_max = -DBL_MAX;
+    for (int point : points)
+        if (std::isfinite(values[point])) {
+            z_min = qMin(z_min, values[point]);
+            z_max = qMax(z_max, values[point]);
+        }
+    const double tolerance = d_tolerance * (z_max > z_min ? z_max - z_min : 1.0);
+
+    // refine the cells where the center is not approximated well by the corners
+    auto interpolate = [&](int a, int b, int c, int d, int i, int j) {
+        const double u = double(i - a) / (b - a), v = double(j - c) / (d - c);
+        return (1 - u) * ((1 - v) * values[a * rows + c] + v * values[a * rows + d])
+                + u * ((1 - v) * values[b * rows + c] + v * values[b * rows + d]);
+    };
+    QVector<int> refine;
+    QVector<QPair<int, int>> smooth;
+    for (int m = 0; m < ci.size() - 1; m++)
+        for (int n = 0; n < cj.size() - 1; n++) {
+            const int a = ci.at(m), b = ci.at(m + 1), c = cj.at(n), d = cj.at(n + 1);
+            const int ic = (a + b) / 2, jc = (c + d) / 2;
+            const double estimate = interpolate(a, b, c, d, ic, jc);
+            if (std::isfinite(estimate) && fabs(estimate - values[ic * rows + jc]) <= tolerance) {
+                smooth << qMakePair(m, n);
+                continue;
+            }
+            for (int i = a; i <= b; i++)
+                for (int j = c; j <= d; j++)
+                    if (!known.at(i * rows + j)) {
+                        known[i * rows + j] = 1;
+                        refine << i * rows + j;
+                    }
+        }
+    sample(values, refine);
+
+    // interpolate the remaining points of the smooth cells
+    for (const QPair<int, int> &cell : smooth) {
+        const int a = ci.at(cell.first), b = ci.at(cell.first + 1);
+        const int c = cj.at(cell.second), d = cj.at(cell.second + 1);
+        for (int i = a; i <= b; i++)
+            for (int j = c; j <= d; j++)
+                if (!known.at(i * rows + j)) {
+                    known[i * rows + j] = 1;
+                    values[i * rows + j] = interpolate(a, b, c, d, i, j);
+                }
+    }
+}
+
+QVector<double> UserFunction::samples() const
+{
+    QVector<double> values(d_columns * d_rows, 0.0);
+    if (!formula.isEmpty() && d_columns > 1 && d_rows > 1) {
+        if (d_adaptive) {
+            QVector<char> known(values.size(), 0);
+            sampleAdaptively(values.data(), known);
+        } else {
+            QVector<int> points(values.size());
+            for (int k = 0; k < points.size(); k++)
+                points[k] = k;
+            sample(values.data(), points);
+        }
+    }
+    for (double &value : values) {
+        if (value > d_z_max)
+            value = d_z_max;
+        else if (value < d_z_min)
+            value = d_z_min;
     }
-    return result;
+    return values;
+}
+
+bool UserFunction::create()
+{
+    if (d_columns <= 2 || d_rows <= 2)
+        return false;
+
+    QString error;
+    if (!formula.isEmpty()
+        && !CompiledFormula::cached(formula, QStringList() << "x" << "y", &error))
+        QMessageBox::critical(0, "Input function error", error);
+
+    QVector<double> values = samples();
+    QVector<double *> data(d_columns);
+    for (unsigned int i = 0; i < d_columns; i++)
+        data[i] = values.data() + i * d_rows;
+    d_plot->loadFromData(data.data(), d_columns, d_rows, d_x_min, d_x_max, d_y_min, d_y_max);
+    return true;
 }
 
 UserFunction::~UserFunction() { }
@@ -92,6 +275,7 @@ void Graph3D::initPlot()
 {
     worksheet = 0;
     d_matrix = 0;
+    d_matrix_version = 0;
     plotAssociation = QString();
 
     QDateTime dt = QDateTime::currentDateTime();
@@ -210,17 +394,17 @@ void Graph3D::initCoord()
 }
 
 void Graph3D::addFunction(const QString &s, double xl, double xr, double yl, double yr, double zl,
-                          double zr)
+                          double zr, bool adaptive)
 {
     sp->makeCurrent();
     sp->resize(this->size());
 
     func = new UserFunction(s, *sp);
 
-    func->setMesh(41, 31);
-    func->setDomain(xl, xr, yl, yr);
-    func->setMinZ(zl);
-    func->setMaxZ(zr);
+    func->setGrid(41, 31);
+    func->setXYRange(xl, xr, yl, yr);
+    func->setZRange(zl, zr);
+    func->setAdaptiveRefinement(adaptive);
     func->create();
 
     sp->legend()->setLimits(zl, zr);
@@ -235,9 +419,9 @@ void Graph3D::addFunction(const QString &s, double xl, double xr, double yl, dou
 }
 
 void Graph3D::insertFunction(const QString &s, double xl, double xr, double yl, double yr,
-                             double zl, double zr)
+                             double zl, double zr, bool adaptive)
 {
-    addFunction(s, xl, xr, yl, yr, zl, zr);
+    addFunction(s, xl, xr, yl, yr, zl, zr, adaptive);
     update();
 }
 
@@ -323,24 +507,14 @@ void Graph3D::addMatrixData(Matrix *m)
     d_matrix = m;
     plotAssociation = "matrix<" + QString(m->name()) + ">";
 
-    int cols = m->numCols();
-    int rows = m->numRows();
-    double **data_matrix = Matrix::allocateMatrixData(rows, cols);
-    for (int i = 0; i < rows; i++) {
-        for (int j = 0; j < cols; j++)
-            data_matrix[i][j] = m->cell(i, j);
-    }
-
     sp->makeCurrent();
-    sp->loadFromData(data_matrix, rows, cols, m->xStart(), m->xEnd(), m->yStart(), m->yEnd());
+    loadMatrix(m);
 
     double start, end;
     sp->coordinates()->axes[Z1].limits(start, end);
     sp->legend()->setLimits(start, end);
     sp->legend()->setMajors(legendMajorTicks);
 
-    Matrix::freeMatrixData(data_matrix, rows);
-
     if (d_autoscale || first_time)
         findBestLayout();
     update();
@@ -436,41 +610,18 @@ void Graph3D::changeDataColumn(Table *table, const QString &colName)
 void Graph3D::addData(Table *table, int xCol, int yCol, int zCol, int type)
 {
     worksheet = table;
-    int r = table->numRows();
 
     QString s = table->colName(xCol) + "(X),";
     s += table->colName(yCol) + "(Y),";
     s += table->colName(zCol) + "(Z)";
     plotAssociation = s;
 
-    int i, j, columns = 0;
-    for (i = 0; i < r; i++) {
-        if (!table->column(xCol)->isInvalid(i) && !table->column(yCol)->isInvalid(i)
-            && !table->column(zCol)->isInvalid(i))
-            columns++;
-    }
-
-    if (columns == 0)
-        columns++;
-
-    Qwt3D::Triple **data = allocateData(columns, columns);
-    for (j = 0; j < columns; j++) {
-        int k = 0;
-        for (i = 0; i < r; i++) {
-            if (!table->column(xCol)->isInvalid(i) && !table->column(yCol)->isInvalid(i)
-                && !table->column(zCol)->isInvalid(i)) {
-                double xv = table->cell(i, xCol);
-                double yv = table->cell(i, yCol);
-                double zv = table->cell(i, zCol);
-
-                data[k][j] = Triple(xv, yv, zv);
-                k++;
-            }
-        }
-    }
+    Qwt3D::TripleField points = pointCloud(table, xCol, yCol, zCol);
+    if (points.empty())
+        points.push_back(Triple());
 
     sp->makeCurrent();
-    sp->loadFromData(data, columns, columns, false, false);
+    loadPointCloud(points);
 
     double start, end;
     sp->coordinates()->axes[Z1].limits(start, end);
@@ -478,7 +629,7 @@ void Graph3D::addData(Table *table, int xCol, int yCol, int zCol, int type)
     sp->legend()->setMajors(legendMajorTicks);
 
     if (type == Scatter) {
-        Dot d(pointSize, smooth);
+        Dot3D d(pointSize, smooth);
         sp->setPlotStyle(d);
         pointStyle = Dots;
         style_ = Qwt3D::USER;
@@ -493,63 +644,28 @@ void Graph3D::addData(Table *table, int xCol, int yCol, int zCol, int type)
 
     if (d_autoscale)
         findBestLayout();
-    deleteData(data, columns);
 }
 
 void Graph3D::addData(Table *table, int xCol, int yCol, int zCol, double xl, double xr, double yl,
                       double yr, double zl, double zr)
 {
     worksheet = table;
-    int r = table->numRows();
 
     QString s = table->colName(xCol) + "(X),";
     s += table->colName(yCol) + "(Y),";
     s += table->colName(zCol) + "(Z)";
     plotAssociation = s;
 
-    int i, j, columns = 0;
-    double xv, yv;
-    for (i = 0; i < r; i++) {
-        if (!table->column(xCol)->isInvalid(i) && !table->column(yCol)->isInvalid(i)
-            && !table->column(zCol)->isInvalid(i)) {
-            xv = table->cell(i, xCol);
-            yv = table->cell(i, yCol);
-            if (xv >= xl && xv <= xr && yv >= yl && yv <= yr)
-                columns++;
-        }
-    }
-
-    if (columns == 0)
-        columns++;
+    const ParallelEpiped clip(Triple(xl, yl, zl), Triple(xr, yr, zr));
+    Qwt3D::TripleField points = pointCloud(table, xCol, yCol, zCol, &clip);
+    if (points.empty())
+        points.push_back(Triple());
 
-    Qwt3D::Triple **data = allocateData(columns, columns);
-    for (j = 0; j < columns; j++) {
-        int k = 0;
-        for (i = 0; i < r; i++) {
-            if (!table->column(xCol)->isInvalid(i) && !table->column(yCol)->isInvalid(i)
-                && !table->column(zCol)->isInvalid(i)) {
-                xv = table->cell(i, xCol);
-                yv = table->cell(i, yCol);
-                if (xv >= xl && xv <= xr && yv >= yl && yv <= yr) {
-                    double zv = table->cell(i, zCol);
-                    if (zv > zr)
-                        data[k][j] = Triple(xv, yv, zr);
-                    else if (zv < zl)
-                        data[k][j] = Triple(xv, yv, zl);
-                    else
-                        data[k][j] = Triple(xv, yv, zv);
-                    k++;
-                }
-            }
-        }
-    }
     sp->makeCurrent();
-    sp->loadFromData(data, columns, columns, false, false);
+    loadPointCloud(points);
     sp->createCoordinateSystem(Triple(xl, yl, zl), Triple(xr, yr, zr));
     sp->legend()->setLimits(zl, zr);
     sp->legend()->setMajors(legendMajorTicks);
-
-    deleteData(data, columns);
 }
 
 void Graph3D::updateData(Table *table)
@@ -639,66 +755,50 @@ void Graph3D::updateDataXY(Table *table, int xCol, int yCol)
 
 void Graph3D::updateDataXYZ(Table *table, int xCol, int yCol, int zCol)
 {
-    int r = table->numRows();
-    int i, j, columns = 0;
-
-    for (i = 0; i < r; i++) {
-        if (!table->column(xCol)->isInvalid(i) && !table->column(yCol)->isInvalid(i)
-            && !table->column(zCol)->isInvalid(i))
-            columns++;
-    }
-
-    if (columns < 2) {
+    const Qwt3D::TripleField points = pointCloud(table, xCol, yCol, zCol);
+    if (points.size() < 2) {
         sp->setPlotStyle(NOPLOT);
         update();
         return;
     }
 
-    Qwt3D::Triple **data = allocateData(columns, columns);
-    gsl_vector *z = gsl_vector_alloc(columns);
-
-    for (j = 0; j < columns; j++) {
-        int k = 0;
-        for (i = 0; i < r; i++) {
-            if (!table->column(xCol)->isInvalid(i) && !table->column(yCol)->isInvalid(i)
-                && !table->column(zCol)->isInvalid(i)) {
-                double xv = table->cell(i, xCol);
-                double yv = table->cell(i, yCol);
-                double zv = table->cell(i, zCol);
-
-                gsl_vector_set(z, k, zv);
-                data[k][j] = Triple(xv, yv, zv);
-                k++;
-            }
-        }
+    double minz = points[0].z, maxz = points[0].z;
+    for (const Triple &point : points) {
+        minz = qMin(minz, point.z);
+        maxz = qMax(maxz, point.z);
     }
 
-    double minz = gsl_vector_min(z);
-    double maxz = gsl_vector_max(z);
-    gsl_vector_free(z);
-
     sp->makeCurrent();
     resetNonEmptyStyle();
 
-    sp->loadFromData(data, columns, columns, false, false);
+    loadPointCloud(points);
     sp->legend()->setLimits(minz, maxz);
     sp->legend()->setMajors(legendMajorTicks);
+}
+
+void Graph3D::loadMatrix(Matrix *m)
+{
+    const future::Matrix *matrix = m->d_future_matrix;
+    const int rows = matrix->rowCount();
+    const int cols = matrix->columnCount();
+
+    QVector<double> cells(rows * cols);
+    matrix->copyCells(cells.data(), cols, 1);
+    QVector<double *> data(rows);
+    for (int i = 0; i < rows; i++)
+        data[i] = cells.data() + i * cols;
 
-    deleteData(data, columns);
+    sp->loadFromData(data.data(), rows, cols, matrix->xStart(), matrix->xEnd(), matrix->yStart(),
+                     matrix->yEnd());
+    d_matrix_version = matrix->version();
 }
 
 void Graph3D::updateMatrixData(Matrix *m)
 {
-    int cols = m->numCols();
-    int rows = m->numRows();
-
-    double **data = Matrix::allocateMatrixData(rows, cols);
-    for (int i = 0; i < rows; i++) {
-        for (int j = 0; j < cols; j++)
-            data[i][j] = m->cell(i, j);
-    }
+    if (m == d_matrix && m->d_future_matrix->version() == d_matrix_version)
+        return;
 
-    sp->loadFromData(data, rows, cols, m->xStart(), m->xEnd(), m->yStart(), m->yEnd());
+    loadMatrix(m);
 
     Qwt3D::Axis z_axis = sp->coordinates()->axes[Z1];
     double start, end;
@@ -709,7 +809,6 @@ void Graph3D::updateMatrixData(Matrix *m)
     sp->legend()->setLimits(start, end);
     sp->legend()->setMajors(legendMajorTicks);
 
-    Matrix::freeMatrixData(data, rows);
     if (d_autoscale)
         findBestLayout();
     update();
@@ -726,7 +825,7 @@ void Graph3D::resetNonEmptyStyle()
             break;
 
         case Dots:
-            sp->setPlotStyle(Dot(pointSize, smooth));
+            sp->setPlotStyle(Dot3D(pointSize, smooth));
             break;
 
         case VerticalBars:
@@ -754,6 +853,22 @@ UserFunction *Graph3D::userFunction()
         return 0;
 }
 
+bool Graph3D::adaptiveRefinement() const
+{
+    return func && func->adaptiveRefinement();
+}
+
+void Graph3D::setAdaptiveRefinement(bool on)
+{
+    if (!func || func->adaptiveRefinement() == on)
+        return;
+    sp->makeCurrent();
+    func->setAdaptiveRefinement(on);
+    func->create();
+    sp->updateData();
+    sp->updateGL();
+}
+
 void Graph3D::update()
 {
     sp->makeCurrent();
@@ -1217,9 +1332,8 @@ void Graph3D::updateScale(int axis, const QStringList &options)
         *min = options[0].toDouble();
         *max = options[1].toDouble();
         if (func) {
-            func->setDomain(xMin, xMax, yMin, yMax);
-            func->setMinZ(zMin);
-            func->setMaxZ(zMax);
+            func->setXYRange(xMin, xMax, yMin, yMax);
+            func->setZRange(zMin, zMax);
             func->create();
             sp->createCoordinateSystem(Triple(xMin, yMin, zMin), Triple(xMax, yMax, zMax));
         } else
@@ -1305,6 +1419,8 @@ void Graph3D::updateScalesFromMatrix(double xl, double xr, double yl, double yr,
     double x_begin = qMin(xl, xr);
     double y_begin = qMin(yl, yr);
 
+    // read the (implicitly shared) columns directly instead of going through cell()
+    const QVector<QVector<qreal>> columns = d_matrix->d_future_matrix->columns();
     double **data_matrix = Matrix::allocateMatrixData(nc, nr);
     for (int i = 0; i < nc; i++) {
         double x = x_begin + i * dx;
@@ -1313,7 +1429,7 @@ void Graph3D::updateScalesFromMatrix(double xl, double xr, double yl, double yr,
             if (x >= xStart && x <= xEnd && y >= yStart && y <= yEnd) {
                 int k = abs((y - yStart) / dy);
                 int l = abs((x - xStart) / dx);
-                double val = d_matrix->cell(k, l);
+                double val = columns.at(l).at(k);
                 if (val > zr)
                     data_matrix[i][j] = zr;
                 else if (val < zl)
@@ -1326,6 +1442,7 @@ void Graph3D::updateScalesFromMatrix(double xl, double xr, double yl, double yr,
     }
     sp->loadFromData(data_matrix, nc, nr, xl, xr, yl, yr);
     Matrix::freeMatrixData(data_matrix, nc);
+    d_matrix_version = d_matrix->d_future_matrix->version();
 
     sp->createCoordinateSystem(Triple(xl, yl, zl), Triple(xr, yr, zr));
     sp->legend()->setLimits(zl, zr);
@@ -1380,46 +1497,13 @@ void Graph3D::updateScales(double xl, double xr, double yl, double yr, double zl
 void Graph3D::updateScales(double xl, double xr, double yl, double yr, double zl, double zr,
                            int xCol, int yCol, int zCol)
 {
-    int r = worksheet->numRows();
-    int i, j, columns = 0;
-    double xv, yv, zv;
-    for (i = 0; i < r; i++) {
-        if (!worksheet->column(xCol)->isInvalid(i) && !worksheet->column(yCol)->isInvalid(i)
-            && !worksheet->column(zCol)->isInvalid(i)) {
-            xv = worksheet->cell(i, xCol);
-            yv = worksheet->cell(i, yCol);
-            if (xv >= xl && xv <= xr && yv >= yl && yv <= yr)
-                columns++;
-        }
-    }
+    const ParallelEpiped clip(Triple(xl, yl, zl), Triple(xr, yr, zr));
+    Qwt3D::TripleField points = pointCloud(worksheet, xCol, yCol, zCol, &clip);
+    if (points.empty())
+        points.push_back(Triple());
 
-    if (columns == 0)
-        columns++;
-
-    Qwt3D::Triple **data = allocateData(columns, columns);
-    for (j = 0; j < columns; j++) {
-        int k = 0;
-        for (i = 0; i < r; i++) {
-            if (!worksheet->column(xCol)->isInvalid(i) && !worksheet->column(yCol)->isInvalid(i)
-                && !worksheet->column(zCol)->isInvalid(i)) {
-                xv = worksheet->cell(i, xCol);
-                yv = worksheet->cell(i, yCol);
-                if (xv >= xl && xv <= xr && yv >= yl && yv <= yr) {
-                    zv = worksheet->cell(i, zCol);
-                    if (zv > zr)
-                        data[k][j] = Triple(xv, yv, zr);
-                    else if (zv < zl)
-                        data[k][j] = Triple(xv, yv, zl);
-                    else
-                        data[k][j] = Triple(xv, yv, zv);
-                    k++;
-                }
-            }
-        }
-    }
-    sp->loadFromData(data, columns, columns, false, false);
+    loadPointCloud(points);
     sp->createCoordinateSystem(Triple(xl, yl, zl), Triple(xr, yr, zr));
-    deleteData(data, columns);
 }
 
 void Graph3D::setTicks(const QStringList &options)
@@ -1747,7 +1831,7 @@ void Graph3D::setPointsMesh()
     style_ = Qwt3D::USER;
 
     sp->makeCurrent();
-    sp->setPlotStyle(Dot(pointSize, smooth));
+    sp->setPlotStyle(Dot3D(pointSize, smooth));
     sp->updateData();
     sp->update();
 }
@@ -1786,6 +1870,7 @@ void Graph3D::setCrossMesh()
 
 void Graph3D::clearData()
 {
+    d_matrix_version = 0;
     if (d_matrix)
         d_matrix = 0;
     else if (worksheet)
@@ -2059,7 +2144,7 @@ void Graph3D::updatePoints(double size, bool sm)
     smooth = sm;
     pointStyle = Dots;
 
-    Dot d(pointSize, smooth);
+    Dot3D d(pointSize, smooth);
     sp->setPlotStyle(d);
 
     update();
@@ -2124,7 +2209,7 @@ void Graph3D::setStyle(Qwt3D::COORDSTYLE coord, Qwt3D::FLOORSTYLE floor, Qwt3D::
     else if (point == VerticalBars)
         sp->setPlotStyle(Bar(barsRad));
     else if (point == Dots)
-        sp->setPlotStyle(Dot(pointSize, smooth));
+        sp->setPlotStyle(Dot3D(pointSize, smooth));
     else if (point == HairCross)
         sp->setPlotStyle(
                 CrossHair(crossHairRad, crossHairLineWidth, crossHairSmooth, crossHairBoxed));
@@ -2181,7 +2266,7 @@ void Graph3D::customPlotStyle(int style)
         pointStyle = Dots;
         style_ = Qwt3D::USER;
 
-        Dot d(pointSize, smooth);
+        Dot3D d(pointSize, smooth);
         sp->setPlotStyle(d);
         break;
     }
@@ -2225,7 +2310,7 @@ void Graph3D::setStyle(const QStringList &st)
         if (st[5] == "1")
             smooth = true;
 
-        sp->setPlotStyle(Dot(pointSize, smooth));
+        sp->setPlotStyle(Dot3D(pointSize, smooth));
         pointStyle = Dots;
     } else if (st[3] == "wireframe")
         sp->setPlotStyle(WIREFRAME);
@@ -2358,7 +2443,10 @@ QString Graph3D::saveToString(const QString &geometry)
     s += QString::number(stop) + "\t";
     sp->coordinates()->axes[Z1].limits(start, stop);
     s += QString::number(start) + "\t";
-    s += QString::number(stop) + "\n";
+    s += QString::number(stop);
+    if (adaptiveRefinement())
+        s += "\tadaptive";
+    s += "\n";
 
     QString st;
     if (sp->coordinates()->style() == Qwt3D::NOCOORD)
@@ -2613,22 +2701,45 @@ void Graph3D::setOptions(bool legend, int r, int dist)
     adjustLabels(dist);
 }
 
-Qwt3D::Triple **Graph3D::allocateData(int columns, int rows)
+Qwt3D::TripleField Graph3D::pointCloud(Table *table, int xCol, int yCol, int zCol,
+                                       const Qwt3D::ParallelEpiped *clip)
 {
-    Qwt3D::Triple **data = new Qwt3D::Triple *[columns];
-
-    for (int i = 0; i < columns; ++i) {
-        data[i] = new Qwt3D::Triple[rows];
+    Column *x = table->column(xCol);
+    Column *y = table->column(yCol);
+    Column *z = table->column(zCol);
+    Qwt3D::TripleField points;
+    int r = table->numRows();
+    for (int i = 0; i < r; i++) {
+        if (x->isInvalid(i) || y->isInvalid(i) || z->isInvalid(i))
+            continue;
+        double xv = table->cell(i, xCol);
+        double yv = table->cell(i, yCol);
+        double zv = table->cell(i, zCol);
+        if (clip) {
+            if (xv < clip->minVertex.x || xv > clip->maxVertex.x || yv < clip->minVertex.y
+                || yv > clip->maxVertex.y)
+                continue;
+            zv = qBound(clip->minVertex.z, zv, clip->maxVertex.z);
+        }
+        points.push_back(Triple(xv, yv, zv));
     }
-    return data;
+    return points;
 }
 
-void Graph3D::deleteData(Qwt3D::Triple **data, int columns)
+void Graph3D::loadPointCloud(const Qwt3D::TripleField &points)
 {
-    for (int i = 0; i < columns; i++) {
-        delete[] data[i];
+    Qwt3D::CellField cells;
+    if (points.size() == 1)
+        cells.push_back(Qwt3D::Cell(1, 0));
+    else if (points.size() > 1)
+        cells.reserve(points.size() - 1);
+    for (unsigned i = 1; i < points.size(); i++) {
+        Qwt3D::Cell line(2);
+        line[0] = i - 1;
+        line[1] = i;
+        cells.push_back(line);
     }
-    delete[] data;
+    sp->loadFromData(points, cells);
 }
 
 QColor Graph3D::minDataColor()
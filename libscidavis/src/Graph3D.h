@@ -68,14 +68,21 @@ public:
     Qwt3D::SurfacePlot *sp;
     UserFunction *func;
 
+    //! Return the points given by the valid rows of three table columns
+    /**
+     * If 'clip' is given, points outside of its x/y range are dropped and z is clamped to it.
+     */
+    static Qwt3D::TripleField pointCloud(Table *table, int xCol, int yCol, int zCol,
+                                         const Qwt3D::ParallelEpiped *clip = 0);
+
 public slots:
     void copy(Graph3D *g);
     void initPlot();
     void initCoord();
     void addFunction(const QString &s, double xl, double xr, double yl, double yr, double zl,
-                     double zr);
+                     double zr, bool adaptive = false);
     void insertFunction(const QString &s, double xl, double xr, double yl, double yr, double zl,
-                        double zr);
+                        double zr, bool adaptive = false);
     void insertNewData(Table *table, const QString &colName);
 
     Matrix *matrix() { return d_matrix; };
@@ -109,6 +116,9 @@ public slots:
     //@{
     UserFunction *userFunction();
     QString formula();
+    //! Whether the mesh of the function is refined adaptively (see UserFunction)
+    bool adaptiveRefinement() const;
+    void setAdaptiveRefinement(bool on);
     //@}
 
     //! \name Event Handlers
@@ -359,8 +369,19 @@ signals:
     void custom3DActions(MyWidget *);
 
 private:
-    Qwt3D::Triple **allocateData(int columns, int rows);
-    void deleteData(Qwt3D::Triple **data, int columns);
+    //! Load points into the plot as a free mesh
+    /**
+     * Every point is stored once (memory grows linearly with the number of points), consecutive
+     * points are connected by line cells, so that the mesh styles show the trajectory.
+     */
+    void loadPointCloud(const Qwt3D::TripleField &points);
+    //! Load all cells of m into the plot as a grid
+    /**
+     * The cells are copied row by row into a single buffer by future::Matrix::copyCells(),
+     * instead of being read one at a time. The version of the loaded content is remembered in
+     * d_matrix_version.
+     */
+    void loadMatrix(Matrix *m);
 
     //! Wait this many msecs before redraw 3D plot (used for animations)
     int animation_redraw_wait;
@@ -387,10 +408,25 @@ private:
     PointStyle pointStyle;
     Table *worksheet;
     Matrix *d_matrix;
+    //! Version (see future::Matrix::version()) of the matrix content loaded into the plot, or 0
+    quint64 d_matrix_version;
     Qwt3D::PLOTSTYLE style_;
 };
 
 //! Class for user defined functions
+/**
+ * The formula is compiled once (see CompiledFormula). create() samples the mesh in blocks on the
+ * global thread pool, every thread evaluating its own copy of the compiled formula.
+ *
+ * With adaptive refinement, the function is first sampled on a mesh RefinementStep times coarser
+ * than the requested one, and at the centers of its cells. Only the cells where the center
+ * deviates from the bilinear interpolation of the corners by more than the tolerance (relative
+ * to the range of the coarse samples) are sampled at full resolution; the mesh points of the
+ * other cells are interpolated.
+ *
+ * The mesh and ranges are set with setGrid(), setXYRange() and setZRange(), which also pass them
+ * on to Qwt3D::Function, so that create() knows them.
+ */
 class UserFunction : public Function
 {
 public:
@@ -399,8 +435,34 @@ public:
     double operator()(double x, double y);
     QString function() { return formula; };
 
+    //! Set the number of samples along x (columns) and y (rows)
+    void setGrid(unsigned int columns, unsigned int rows);
+    void setXYRange(double xl, double xr, double yl, double yr);
+    //! Set the range the samples are clipped to
+    void setZRange(double zl, double zr);
+    //! Enable/disable adaptive refinement of the mesh
+    void setAdaptiveRefinement(bool on, double tolerance = 1e-3);
+    bool adaptiveRefinement() const { return d_adaptive; }
+    //! Return the samples of the mesh, column by column, clipped to the z range
+    QVector<double> samples() const;
+    //! Sample the function and load the mesh into the plot
+    bool create();
+
 private:
+    //! Ratio of the full and the coarse mesh spacing used for adaptive refinement
+    static const int RefinementStep = 4;
+
+    //! Evaluate the function at the given mesh points (column * rows + row) on the thread pool
+    void sample(double *values, const QVector<int> &points) const;
+    //! Fill 'values' by sampling only the curved parts of the surface; 'known' marks sampled points
+    void sampleAdaptively(double *values, QVector<char> &known) const;
+
     QString formula;
+    SurfacePlot *d_plot;
+    unsigned int d_columns, d_rows;
+    double d_x_min, d_x_max, d_y_min, d_y_max, d_z_min, d_z_max;
+    bool d_adaptive;
+    double d_tolerance;
 };
 
 #endif // Plot3D_H
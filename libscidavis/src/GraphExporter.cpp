@@ -0,0 +1,130 @@
+/***************************************************************************
+    File                 : GraphExporter.cpp
+    Project              : SciDAVis
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 SciDAVis developers
+    Description          : Concurrent export of plot windows to files
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "GraphExporter.h"
+#include "MultiLayer.h"
+
+#include <QImage>
+#include <QImageWriter>
+#include <QPageSize>
+#include <QPainter>
+#include <QPdfWriter>
+#include <QSvgGenerator>
+#include <QVector>
+#include <QtConcurrentMap>
+
+namespace {
+bool isVectorFormat(const QString &format)
+{
+    return format == "pdf" || format == "eps" || format == "ps";
+}
+} // namespace
+
+GraphExporter::GraphExporter(const QString &format, int quality, bool color)
+    : d_format(format.toLower()), d_quality(quality), d_color(color)
+{
+}
+
+bool GraphExporter::isSupported(const QString &format)
+{
+    const QString f = format.toLower();
+    return f == "svg" || isVectorFormat(f)
+            || QImageWriter::supportedImageFormats().contains(f.toLatin1());
+}
+
+bool GraphExporter::add(MultiLayer *plot, const QString &fileName)
+{
+    if (!isSupported(d_format) || (isVectorFormat(d_format) && !d_color))
+        return false;
+    foreach (QWidget *w, plot->graphPtrs())
+        if (!static_cast<Graph *>(w)->imageMarkerKeys().isEmpty())
+            return false;
+
+    Task task;
+    task.picture = plot->exportPicture();
+    task.rect = task.picture.boundingRect();
+    task.title = plot->name();
+    task.fileName = fileName;
+    d_tasks << task;
+    return true;
+}
+
+QStringList GraphExporter::exportAll()
+{
+    QVector<bool> written = QtConcurrent::blockingMapped<QVector<bool>>(
+            d_tasks, [this](const Task &task) { return write(task); });
+
+    QStringList failed;
+    for (int i = 0; i < d_tasks.size(); i++)
+        if (!written[i])
+            failed << d_tasks[i].fileName;
+    d_tasks.clear();
+    return failed;
+}
+
+bool GraphExporter::write(const Task &task) const
+{
+    const QSize size = task.rect.size();
+    if (size.isEmpty())
+        return false;
+    QPainter painter;
+
+    if (d_format == "svg") {
+        QSvgGenerator generator;
+        generator.setFileName(task.fileName);
+        generator.setSize(size);
+        generator.setViewBox(QRect(QPoint(0, 0), size));
+        generator.setResolution(96); // as MultiLayer::exportSVG()
+        generator.setTitle(task.title);
+        if (!painter.begin(&generator))
+            return false;
+        painter.drawPicture(0, 0, task.picture);
+        return painter.end();
+    }
+
+    if (isVectorFormat(d_format)) {
+        // Qt 5 cannot write PostScript, MultiLayer::exportVector() also writes PDF instead
+        QPdfWriter writer(d_format == "eps" ? task.fileName + ".pdf" : task.fileName);
+        writer.setCreator("SciDAVis");
+        writer.setTitle(task.title);
+        writer.setPageSize(QPageSize(size, QPageSize::Point));
+        writer.setPageMargins(QMarginsF());
+        if (!painter.begin(&writer))
+            return false;
+        painter.scale(double(writer.width()) / size.width(), double(writer.height()) / size.height());
+        painter.drawPicture(0, 0, task.picture);
+        return painter.end();
+    }
+
+    QImage image(size, QImage::Format_ARGB32);
+    painter.begin(&image);
+    painter.drawPicture(0, 0, task.picture);
+    painter.end();
+    return image.save(task.fileName, 0, d_quality);
+}
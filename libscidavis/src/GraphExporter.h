@@ -0,0 +1,86 @@
+/***************************************************************************
+    File                 : GraphExporter.h
+    Project              : SciDAVis
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 SciDAVis developers
+    Description          : Concurrent export of plot windows to files
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef GRAPHEXPORTER_H
+#define GRAPHEXPORTER_H
+
+#include <QList>
+#include <QPicture>
+#include <QRect>
+#include <QString>
+#include <QStringList>
+
+class MultiLayer;
+
+//! Exports 2D plot windows to files, rendering them concurrently
+/**
+  The layers of each window are recorded into a QPicture on the GUI thread by
+  add(), which is cheap compared to rasterizing them, writing vector formats or
+  compressing images. exportAll() then replays the recordings into the output
+  files on the global thread pool, one window per task.
+
+  Windows which cannot be rendered away from the GUI thread (image markers
+  hold pixmaps; grayscale PDFs need a QPrinter) are rejected by add() and have
+  to be exported directly, as do 3D plots.
+  */
+class GraphExporter
+{
+public:
+    /**
+     * \param format file suffix of the output format without dot ("png", "svg", "pdf", ...)
+     * \param quality image quality (-1 for the default of the format)
+     * \param color false for grayscale vector output
+     */
+    GraphExporter(const QString &format, int quality = -1, bool color = true);
+
+    //! Whether the format can be written at all
+    static bool isSupported(const QString &format);
+    //! Record 'plot' to be exported to 'fileName'; returns false if it has to be exported directly
+    bool add(MultiLayer *plot, const QString &fileName);
+    //! Write all recorded windows concurrently and return the names of the files that failed
+    QStringList exportAll();
+
+private:
+    struct Task
+    {
+        QPicture picture;
+        QRect rect;
+        QString title;
+        QString fileName;
+    };
+
+    //! Write a single window (on a worker thread)
+    bool write(const Task &task) const;
+
+    QString d_format;
+    int d_quality;
+    bool d_color;
+    QList<Task> d_tasks;
+};
+
+#endif // ifndef GRAPHEXPORTER_H
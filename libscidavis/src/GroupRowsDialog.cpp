@@ -0,0 +1,111 @@
+/***************************************************************************
+    File                 : GroupRowsDialog.cpp
+    Project              : SciDAVis
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 SciDAVis developers
+    Description          : Dialog for grouping the rows of a table
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "GroupRowsDialog.h"
+#include "ApplicationWindow.h"
+#include "GroupedTable.h"
+#include "Table.h"
+#include "core/column/Column.h"
+
+#include <QCheckBox>
+#include <QGroupBox>
+#include <QLabel>
+#include <QLayout>
+#include <QLineEdit>
+#include <QMessageBox>
+#include <QPushButton>
+
+GroupRowsDialog::GroupRowsDialog(Table *table, QWidget *parent, Qt::WindowFlags fl)
+    : QDialog(parent, fl), d_table(table)
+{
+    setWindowTitle(tr("Group Rows of %1").arg(table->name()));
+    setSizePolicy(QSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed));
+
+    // group by the selected columns, and show the means of the other Y columns
+    QStringList keys;
+    QStringList aggregates("count()");
+    for (int i = 0; i < table->numCols(); i++)
+        if (table->isColumnSelected(i, false))
+            keys << table->column(i)->name();
+    for (int i = 0; i < table->numCols(); i++) {
+        Column *column = table->column(i);
+        if (column->plotDesignation() == SciDAVis::Y && !keys.contains(column->name())
+            && column->dataType() == SciDAVis::TypeDouble)
+            aggregates << "mean(" + column->name() + ")";
+    }
+
+    QGroupBox *gb1 = new QGroupBox();
+    QGridLayout *gl1 = new QGridLayout(gb1);
+    gl1->addWidget(new QLabel(tr("Group by columns")), 0, 0);
+    boxKeys = new QLineEdit(keys.join(", "));
+    boxKeys->setToolTip(tr("Comma separated column names; rows with equal cells in all of "
+                           "them form a group"));
+    gl1->addWidget(boxKeys, 0, 1);
+
+    gl1->addWidget(new QLabel(tr("Aggregates")), 1, 0);
+    boxAggregates = new QLineEdit(aggregates.join(", "));
+    boxAggregates->setToolTip(tr("count(), count(col), sum(col), mean(col), min(col), max(col), "
+                                 "std(col), median(col) or quantile(col, p)"));
+    gl1->addWidget(boxAggregates, 1, 1);
+
+    boxLive = new QCheckBox(tr("&Update when %1 changes").arg(table->name()));
+    boxLive->setChecked(true);
+    gl1->addWidget(boxLive, 2, 1);
+    gl1->setColumnMinimumWidth(1, 300);
+    gl1->setRowStretch(3, 1);
+
+    buttonOk = new QPushButton(tr("&OK"));
+    buttonOk->setDefault(true);
+    buttonCancel = new QPushButton(tr("&Cancel"));
+
+    QVBoxLayout *vl = new QVBoxLayout();
+    vl->addWidget(buttonOk);
+    vl->addWidget(buttonCancel);
+    vl->addStretch();
+
+    QHBoxLayout *hb = new QHBoxLayout(this);
+    hb->addWidget(gb1);
+    hb->addLayout(vl);
+
+    connect(buttonOk, SIGNAL(clicked()), this, SLOT(accept()));
+    connect(buttonCancel, SIGNAL(clicked()), this, SLOT(reject()));
+}
+
+void GroupRowsDialog::accept()
+{
+    ApplicationWindow *app = (ApplicationWindow *)parent();
+    QString error;
+    Table *groups = app->newGroupedTable(d_table, boxKeys->text(), boxAggregates->text(),
+                                         boxLive->isChecked(), QString(), &error);
+    if (!groups) {
+        QMessageBox::critical(this, tr("Invalid groups"), error);
+        return;
+    }
+    groups->showNormal();
+    QDialog::accept();
+}
@@ -0,0 +1,59 @@
+/***************************************************************************
+    File                 : GroupRowsDialog.h
+    Project              : SciDAVis
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 SciDAVis developers
+    Description          : Dialog for grouping the rows of a table
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef GROUPROWSDIALOG_H
+#define GROUPROWSDIALOG_H
+
+#include <QDialog>
+
+class QCheckBox;
+class QLineEdit;
+class QPushButton;
+class Table;
+
+//! Asks for the key columns and aggregates of a grouped table (see GroupedTable)
+class GroupRowsDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    GroupRowsDialog(Table *table, QWidget *parent = 0, Qt::WindowFlags fl = Qt::Widget);
+
+public slots:
+    void accept();
+
+private:
+    Table *d_table;
+    QLineEdit *boxKeys;
+    QLineEdit *boxAggregates;
+    QCheckBox *boxLive;
+    QPushButton *buttonOk;
+    QPushButton *buttonCancel;
+};
+
+#endif // ifndef GROUPROWSDIALOG_H
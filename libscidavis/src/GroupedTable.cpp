@@ -0,0 +1,302 @@
+/***************************************************************************
+    File                 : GroupedTable.cpp
+    Project              : SciDAVis
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 SciDAVis developers
+    Description          : Table of aggregates of the groups of rows of
+                           another table
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "GroupedTable.h"
+#include "table/TableView.h"
+#include "table/future_Table.h"
+#include "core/column/Column.h"
+
+#include <QDateTime>
+#include <QHash>
+#include <QRegularExpression>
+
+#include <cmath>
+
+namespace {
+//! Return the column named by 'match' (captured as col("name") or plain name)
+QString columnName(const QRegularExpressionMatch &match, int quoted, int plain)
+{
+    return match.capturedStart(quoted) >= 0 ? match.captured(quoted)
+                                            : match.captured(plain).trimmed();
+}
+} // namespace
+
+GroupedTable::Specification GroupedTable::Specification::parse(const QString &keys,
+                                                               const QString &aggregates,
+                                                               const future::Table *table)
+{
+    Specification result;
+    auto check = [&](const QString &name) {
+        if (result.error.isEmpty() && !table->column(name, false))
+            result.error = QObject::tr("There is no column %1.").arg(name);
+    };
+
+    const QString key_list = keys.trimmed();
+    QRegularExpression key("\\s*(?:col\\(\"([^\"]*)\"\\)|([^,\"]*?))\\s*(?:,|$)");
+    for (int offset = 0; offset < key_list.length() && result.isValid();) {
+        QRegularExpressionMatch match = key.match(key_list, offset, QRegularExpression::NormalMatch,
+                                                  QRegularExpression::AnchoredMatchOption);
+        QString name = match.hasMatch() ? columnName(match, 1, 2) : QString();
+        if (name.isEmpty()) {
+            result.error = QObject::tr("Cannot read the key columns %1.").arg(keys);
+            break;
+        }
+        check(name);
+        result.keys << name;
+        offset = match.capturedEnd();
+    }
+
+    const QString aggregate_list = aggregates.trimmed();
+    QRegularExpression aggregate("\\s*(\\w+)\\s*\\(\\s*(?:col\\(\"([^\"]*)\"\\)|([^,()\"]*?))\\s*"
+                                 "(?:,\\s*([^,()]*?)\\s*)?\\)\\s*(?:,|$)");
+    for (int offset = 0; offset < aggregate_list.length() && result.isValid();) {
+        QRegularExpressionMatch match =
+                aggregate.match(aggregate_list, offset, QRegularExpression::NormalMatch,
+                                QRegularExpression::AnchoredMatchOption);
+        if (!match.hasMatch()) {
+            result.error = QObject::tr("Cannot read the aggregates %1.").arg(aggregates);
+            break;
+        }
+        offset = match.capturedEnd();
+
+        Output output;
+        output.column = columnName(match, 2, 3);
+        output.aggregate = { GroupAggregation::Quantile, 0.5 };
+        const QString function = match.captured(1).toLower();
+        QString suffix = function;
+        if (function == "count")
+            output.aggregate.function = GroupAggregation::Count;
+        else if (function == "sum")
+            output.aggregate.function = GroupAggregation::Sum;
+        else if (function == "mean")
+            output.aggregate.function = GroupAggregation::Mean;
+        else if (function == "min")
+            output.aggregate.function = GroupAggregation::Minimum;
+        else if (function == "max")
+            output.aggregate.function = GroupAggregation::Maximum;
+        else if (function == "std")
+            output.aggregate.function = GroupAggregation::StandardDeviation;
+        else if (function == "quantile") {
+            bool ok = false;
+            output.aggregate.probability = match.captured(4).toDouble(&ok);
+            if (!ok || output.aggregate.probability < 0 || output.aggregate.probability > 1) {
+                result.error = QObject::tr("The probability of quantile(%1, p) has to be a number "
+                                           "between 0 and 1.")
+                                       .arg(output.column);
+                break;
+            }
+            suffix = "q" + QString::number(100 * output.aggregate.probability);
+        } else if (function != "median") {
+            result.error = QObject::tr("Unknown aggregate %1; use count, sum, mean, min, max, "
+                                       "std, median or quantile.")
+                                   .arg(match.captured(1));
+            break;
+        }
+        if (match.capturedStart(4) >= 0 && function != "quantile") {
+            result.error = QObject::tr("%1() takes a single column.").arg(function);
+            break;
+        }
+
+        if (output.column.isEmpty() && output.aggregate.function == GroupAggregation::Count) {
+            output.name = "count";
+        } else {
+            check(output.column);
+            if (!result.isValid())
+                break;
+            if (output.aggregate.function != GroupAggregation::Count
+                && table->column(output.column, false)->dataType() != SciDAVis::TypeDouble) {
+                result.error = QObject::tr("Column %1 is not numeric.").arg(output.column);
+                break;
+            }
+            output.name = output.column + "_" + suffix;
+        }
+        result.outputs << output;
+    }
+    return result;
+}
+
+bool GroupedTable::Specification::refersTo(const QString &column_name) const
+{
+    if (keys.contains(column_name))
+        return true;
+    for (const Output &output : outputs)
+        if (output.column == column_name)
+            return true;
+    return false;
+}
+
+void GroupedTable::aggregate(Table *base, const Specification &specification, Table *target)
+{
+    future::Table *source = base->d_future_table;
+    GroupAggregation grouping(source->rowCount());
+    for (const QString &key : specification.keys)
+        grouping.addKey(source->column(key, false));
+    grouping.group();
+    const int groups = grouping.groupCount();
+    const QVector<int> &first_rows = grouping.firstRows();
+
+    // aggregates of the same column are computed in one pass
+    QVector<QVector<double>> results(specification.outputs.size());
+    QHash<QString, QVector<int>> outputs_by_column;
+    for (int o = 0; o < specification.outputs.size(); o++)
+        outputs_by_column[specification.outputs.at(o).column] << o;
+    for (auto column = outputs_by_column.constBegin(); column != outputs_by_column.constEnd();
+         ++column) {
+        if (column.key().isEmpty()) {
+            for (int o : column.value())
+                results[o] = grouping.groupSizes();
+            continue;
+        }
+        QVector<GroupAggregation::Aggregate> aggregates;
+        for (int o : column.value())
+            aggregates << specification.outputs.at(o).aggregate;
+        const QVector<QVector<double>> values =
+                grouping.aggregate(source->column(column.key(), false), aggregates);
+        for (int i = 0; i < column.value().size(); i++)
+            results[column.value().at(i)] = values.at(i);
+    }
+
+    future::Table *table = target->d_future_table;
+    const int keys = specification.keys.size();
+    const int columns = keys + specification.outputs.size();
+    table->beginMacro(QObject::tr("%1: group the rows of %2").arg(table->name(), source->name()));
+    table->setColumnCount(columns);
+    table->setRowCount(groups);
+    // column names have to be unique at any time, so move changed ones out of the way first
+    QStringList names = specification.keys;
+    for (const Specification::Output &output : specification.outputs)
+        names << output.name;
+    for (int i = 0; i < columns; i++)
+        if (target->column(i)->name() != names.at(i))
+            target->setColName(i, "_" + QString::number(i));
+
+    for (int k = 0; k < keys; k++) {
+        const Column *key = source->column(specification.keys.at(k), false);
+        Column *column = target->column(k);
+        target->setColName(k, names.at(k));
+        if (column->columnMode() != key->columnMode())
+            column->setColumnMode(key->columnMode());
+        column->setPlotDesignation(k == 0 ? SciDAVis::X : SciDAVis::noDesignation);
+        switch (key->dataType()) {
+        case SciDAVis::TypeDouble: {
+            const QVector<qreal> values = key->values();
+            QVector<qreal> cells(groups);
+            for (int g = 0; g < groups; g++)
+                cells[g] = values.at(first_rows.at(g));
+            column->replaceValues(0, cells);
+            break;
+        }
+        case SciDAVis::TypeQString: {
+            const QStringList texts = key->texts();
+            QStringList cells;
+            for (int g = 0; g < groups; g++)
+                cells << texts.at(first_rows.at(g));
+            column->replaceTexts(0, cells);
+            break;
+        }
+        case SciDAVis::TypeQDateTime: {
+            const QList<QDateTime> date_times = key->dateTimes();
+            QList<QDateTime> cells;
+            for (int g = 0; g < groups; g++)
+                cells << date_times.at(first_rows.at(g));
+            column->replaceDateTimes(0, cells);
+            break;
+        }
+        }
+    }
+
+    for (int o = 0; o < specification.outputs.size(); o++) {
+        Column *column = target->column(keys + o);
+        target->setColName(keys + o, names.at(keys + o));
+        if (column->columnMode() != SciDAVis::ColumnMode::Numeric)
+            column->setColumnMode(SciDAVis::ColumnMode::Numeric);
+        column->setPlotDesignation(SciDAVis::Y);
+        const QVector<double> &values = results.at(o);
+        column->replaceValues(0, values);
+        // aggregates of groups without values are invalid, mark each run at once
+        for (const Interval<int> &iv :
+             flaggedIntervals(groups, [&values](int g) { return std::isnan(values.at(g)); }))
+            column->setInvalid(iv);
+    }
+    table->endMacro();
+}
+
+GroupedTable::GroupedTable(ScriptingEnv *env, QWidget *parent, Table *base, const QString &keys,
+                           const QString &aggregates)
+    : Table(env, 1, 1, "", parent, ""), d_base(base), d_keys(keys), d_aggregates(aggregates)
+{
+    setReadOnly();
+    d_recompute_timer.setSingleShot(true);
+    d_recompute_timer.setInterval(0);
+    connect(&d_recompute_timer, SIGNAL(timeout()), this, SLOT(recompute()));
+
+    setCaptionPolicy(MyWidget::Both);
+    setName(QString(d_base->name()) + "-" + tr("Groups"));
+    recompute();
+}
+
+void GroupedTable::update(Table *t, const QString &colName)
+{
+    if (t != d_base || d_recompute_timer.isActive())
+        return;
+    Column *column = d_base->column(colName);
+    if (!column || Specification::parse(d_keys, d_aggregates, d_base->d_future_table)
+                           .refersTo(column->name()))
+        d_recompute_timer.start();
+}
+
+void GroupedTable::recompute()
+{
+    d_recompute_timer.stop();
+    const Specification specification =
+            Specification::parse(d_keys, d_aggregates, d_base->d_future_table);
+    if (!specification.isValid()) {
+        setWindowLabel(tr("Invalid groups of %1: %2").arg(d_base->name(), specification.error));
+        return;
+    }
+    if (d_keys.trimmed().isEmpty())
+        setWindowLabel(tr("%1 of %2").arg(d_aggregates, d_base->name()));
+    else
+        setWindowLabel(tr("%1 of %2 by %3").arg(d_aggregates, d_base->name(), d_keys));
+    aggregate(d_base, specification, this);
+}
+
+QString GroupedTable::saveToString(const QString &geometry)
+{
+    QString s = "<GroupedTable>\n";
+    s += QString(name()) + "\t";
+    s += QString(d_base->name()) + "\t";
+    s += birthDate() + "\n";
+    s += "Keys\t" + d_keys + "\n";
+    s += "Aggregates\t" + d_aggregates + "\n";
+    s += geometry;
+    s += saveColumnWidths();
+    s += "WindowLabel\t" + windowLabel() + "\t" + QString::number(captionPolicy()) + "\n";
+    return s + "</GroupedTable>\n";
+}
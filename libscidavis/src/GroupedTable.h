@@ -0,0 +1,113 @@
+/***************************************************************************
+    File                 : GroupedTable.h
+    Project              : SciDAVis
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 SciDAVis developers
+    Description          : Table of aggregates of the groups of rows of
+                           another table
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef GROUPEDTABLE_H
+#define GROUPEDTABLE_H
+
+#include "Table.h"
+#include "lib/GroupAggregation.h"
+
+#include <QList>
+#include <QStringList>
+#include <QTimer>
+
+//! Table of aggregates of the groups of rows of another table
+/**
+  The rows of the base table are grouped by the cells of one or more key
+  columns (see GroupAggregation). The grouped table has one row per group,
+  showing the keys of the group followed by the requested aggregates of its
+  values. Keys are given as a comma separated list of column names (or
+  col("name")), aggregates as a list like count(), mean(y), std(y),
+  median(y), quantile(y, 0.9); see Specification.
+
+  aggregate() writes the groups of a table into any other table, e.g. a new
+  one. A GroupedTable in addition computes the groups again whenever a column
+  it depends on changes, once control returns to the event loop.
+  */
+class GroupedTable : public Table
+{
+    Q_OBJECT
+
+public:
+    //! Key columns and aggregates of a grouped table
+    struct Specification
+    {
+        //! An aggregate column
+        struct Output
+        {
+            //! Name of the aggregated column; empty for the size of the groups (count())
+            QString column;
+            GroupAggregation::Aggregate aggregate;
+            //! Name of the column showing the aggregate
+            QString name;
+        };
+
+        QStringList keys;
+        QList<Output> outputs;
+        //! Why the specification is invalid; empty if it is valid
+        QString error;
+
+        //! Parse the lists of keys and aggregates for the columns of 'table'
+        static Specification parse(const QString &keys, const QString &aggregates,
+                                   const future::Table *table);
+        bool isValid() const { return error.isEmpty(); }
+        //! Whether the groups depend on the column with the given name
+        bool refersTo(const QString &column_name) const;
+    };
+
+    //! Write the groups of the rows of 'base' into 'target', in one undo step
+    /**
+     * The columns of 'target' are replaced by the key columns (the first one being X)
+     * and the aggregates (Y). 'specification' has to be valid.
+     */
+    static void aggregate(Table *base, const Specification &specification, Table *target);
+
+    GroupedTable(ScriptingEnv *env, QWidget *parent, Table *base, const QString &keys,
+                 const QString &aggregates);
+    //! return the table of which rows are grouped
+    Table *base() const { return d_base; }
+    const QString &keys() const { return d_keys; }
+    const QString &aggregates() const { return d_aggregates; }
+    // saving
+    virtual QString saveToString(const QString &geometry);
+
+public slots:
+    //! compute the groups again if the column is used (to be connected with Table::modifiedData)
+    void update(Table *, const QString &colName);
+    //! compute the groups again
+    void recompute();
+
+private:
+    Table *d_base;
+    QString d_keys;
+    QString d_aggregates;
+    QTimer d_recompute_timer;
+};
+
+#endif // ifndef GROUPEDTABLE_H
@@ -0,0 +1,144 @@
+/***************************************************************************
+    File                 : JoinTablesDialog.cpp
+    Project              : SciDAVis
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 SciDAVis developers
+    Description          : Join tables dialog
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "JoinTablesDialog.h"
+#include "ApplicationWindow.h"
+#include "Table.h"
+#include "core/column/Column.h"
+#include "lib/TableJoin.h"
+
+#include <QComboBox>
+#include <QGroupBox>
+#include <QLabel>
+#include <QLayout>
+#include <QLineEdit>
+#include <QMessageBox>
+#include <QPushButton>
+
+JoinTablesDialog::JoinTablesDialog(Table *table, QWidget *parent, Qt::WindowFlags fl)
+    : QDialog(parent, fl), d_table(table)
+{
+    setWindowTitle(tr("Join %1 with Another Table").arg(table->name()));
+    setSizePolicy(QSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed));
+
+    // join on the selected columns
+    QStringList keys;
+    for (int i = 0; i < table->numCols(); i++)
+        if (table->isColumnSelected(i, false))
+            keys << table->column(i)->name();
+
+    QGroupBox *gb1 = new QGroupBox();
+    QGridLayout *gl1 = new QGridLayout(gb1);
+    gl1->addWidget(new QLabel(tr("Join with table")), 0, 0);
+    boxTable = new QComboBox();
+    QStringList tables = ((ApplicationWindow *)parent)->tableWindows();
+    tables.removeAll(table->name());
+    boxTable->addItems(tables);
+    gl1->addWidget(boxTable, 0, 1);
+
+    gl1->addWidget(new QLabel(tr("Key columns of %1").arg(table->name())), 1, 0);
+    boxLeftKeys = new QLineEdit(keys.join(", "));
+    boxLeftKeys->setToolTip(tr("Comma separated column names; rows with equal cells in all of "
+                               "them are joined"));
+    gl1->addWidget(boxLeftKeys, 1, 1);
+
+    gl1->addWidget(new QLabel(tr("Key columns of the other table")), 2, 0);
+    boxRightKeys = new QLineEdit();
+    boxRightKeys->setToolTip(tr("Leave empty if the key columns have the same names"));
+    gl1->addWidget(boxRightKeys, 2, 1);
+
+    gl1->addWidget(new QLabel(tr("Kind of join")), 3, 0);
+    boxType = new QComboBox();
+    boxType->addItem(tr("Inner (rows with matching keys only)"), TableJoin::Inner);
+    boxType->addItem(tr("Left (all rows of %1)").arg(table->name()), TableJoin::Left);
+    boxType->addItem(tr("Outer (all rows of both tables)"), TableJoin::Outer);
+    boxType->addItem(tr("Nearest last key (as of)"), TableJoin::Nearest);
+    gl1->addWidget(boxType, 3, 1);
+
+    gl1->addWidget(new QLabel(tr("Tolerance")), 4, 0);
+    boxTolerance = new QLineEdit();
+    boxTolerance->setToolTip(tr("Largest distance of nearest keys, in seconds for dates and "
+                                "times; leave empty for no limit"));
+    gl1->addWidget(boxTolerance, 4, 1);
+    gl1->setColumnMinimumWidth(1, 300);
+    gl1->setRowStretch(5, 1);
+
+    buttonOk = new QPushButton(tr("&OK"));
+    buttonOk->setDefault(true);
+    buttonOk->setEnabled(boxTable->count() > 0);
+    buttonCancel = new QPushButton(tr("&Cancel"));
+
+    QVBoxLayout *vl = new QVBoxLayout();
+    vl->addWidget(buttonOk);
+    vl->addWidget(buttonCancel);
+    vl->addStretch();
+
+    QHBoxLayout *hb = new QHBoxLayout(this);
+    hb->addWidget(gb1);
+    hb->addLayout(vl);
+
+    updateTolerance();
+    connect(boxType, SIGNAL(currentIndexChanged(int)), this, SLOT(updateTolerance()));
+    connect(buttonOk, SIGNAL(clicked()), this, SLOT(accept()));
+    connect(buttonCancel, SIGNAL(clicked()), this, SLOT(reject()));
+}
+
+void JoinTablesDialog::updateTolerance()
+{
+    boxTolerance->setEnabled(boxType->currentData().toInt() == TableJoin::Nearest);
+}
+
+void JoinTablesDialog::accept()
+{
+    ApplicationWindow *app = (ApplicationWindow *)parent();
+    Table *right = app->table(boxTable->currentText());
+    if (!right)
+        return;
+
+    const int type = boxType->currentData().toInt();
+    double tolerance = -1;
+    if (type == TableJoin::Nearest && !boxTolerance->text().trimmed().isEmpty()) {
+        bool ok = false;
+        tolerance = boxTolerance->text().toDouble(&ok);
+        if (!ok || tolerance < 0) {
+            QMessageBox::critical(this, tr("Invalid tolerance"),
+                                  tr("The tolerance has to be a positive number."));
+            return;
+        }
+    }
+
+    QString error;
+    Table *joined = app->newJoinedTable(d_table, right, boxLeftKeys->text(),
+                                        boxRightKeys->text(), type, tolerance, QString(), &error);
+    if (!joined) {
+        QMessageBox::critical(this, tr("Invalid join"), error);
+        return;
+    }
+    joined->showNormal();
+    QDialog::accept();
+}
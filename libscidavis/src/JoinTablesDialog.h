@@ -0,0 +1,64 @@
+/***************************************************************************
+    File                 : JoinTablesDialog.h
+    Project              : SciDAVis
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 SciDAVis developers
+    Description          : Join tables dialog
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef JOINTABLESDIALOG_H
+#define JOINTABLESDIALOG_H
+
+#include <QDialog>
+
+class QComboBox;
+class QLineEdit;
+class QPushButton;
+class Table;
+
+//! Asks for the second table, the key columns and the kind of a join (see TableJoin)
+class JoinTablesDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    JoinTablesDialog(Table *table, QWidget *parent = 0, Qt::WindowFlags fl = Qt::Widget);
+
+public slots:
+    void accept();
+
+private slots:
+    void updateTolerance();
+
+private:
+    Table *d_table;
+    QComboBox *boxTable;
+    QLineEdit *boxLeftKeys;
+    QLineEdit *boxRightKeys;
+    QComboBox *boxType;
+    QLineEdit *boxTolerance;
+    QPushButton *buttonOk;
+    QPushButton *buttonCancel;
+};
+
+#endif // ifndef JOINTABLESDIALOG_H
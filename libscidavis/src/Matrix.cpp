@@ -57,7 +57,6 @@
 #include <math.h>
 #include <stdio.h>
 
-#include <gsl/gsl_linalg.h>
 #include <gsl/gsl_math.h>
 
 Matrix::Matrix(ScriptingEnv *env, int r, int c, const QString &label, QWidget *parent,
@@ -302,72 +301,77 @@ void Matrix::setNumCols(int cols)
 
 double Matrix::determinant()
 {
-    int rows = numRows();
-    int cols = numCols();
-
-    if (rows != cols) {
+    if (numRows() != numCols()) {
         QMessageBox::critical(0, tr("Error"), tr("Calculation failed, the matrix is not square!"));
         return GSL_POSINF;
     }
 
     QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
-
-    gsl_matrix *A = gsl_matrix_alloc(rows, cols);
-    int i;
-    for (i = 0; i < rows; i++)
-        for (int j = 0; j < cols; j++)
-            gsl_matrix_set(A, i, j, cell(i, j));
-
-    gsl_permutation *p = gsl_permutation_alloc(rows);
-    gsl_linalg_LU_decomp(A, p, &i);
-
-    double det = gsl_linalg_LU_det(A, i);
-
-    gsl_matrix_free(A);
-    gsl_permutation_free(p);
-
+    double det = d_future_matrix->determinant();
     QApplication::restoreOverrideCursor();
     return det;
 }
 
 void Matrix::invert()
 {
-    int rows = numRows();
-    int cols = numCols();
-
-    if (rows != cols) {
+    if (numRows() != numCols()) {
         QMessageBox::critical(0, tr("Error"), tr("Inversion failed, the matrix is not square!"));
         return;
     }
 
     QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
+    const bool ok = d_future_matrix->invert();
+    QApplication::restoreOverrideCursor();
+    if (!ok) {
+        QMessageBox::critical(0, tr("Error"), tr("Inversion failed, the matrix is singular!"));
+        return;
+    }
+    emit modifiedWindow(this);
+}
 
-    gsl_matrix *A = gsl_matrix_alloc(rows, cols);
-    int i;
-    for (i = 0; i < rows; i++) {
-        for (int j = 0; j < cols; j++)
-            gsl_matrix_set(A, i, j, cell(i, j));
+bool Matrix::multiply(Matrix *other)
+{
+    if (!other || numCols() != other->numRows()) {
+        QMessageBox::critical(0, tr("Error"),
+                              tr("Multiplication failed, the number of columns does not match "
+                                 "the number of rows of the other matrix!"));
+        return false;
     }
 
-    gsl_permutation *p = gsl_permutation_alloc(cols);
-    gsl_linalg_LU_decomp(A, p, &i);
+    d_future_matrix->multiply(other->d_future_matrix);
+    emit modifiedWindow(this);
+    return true;
+}
 
-    gsl_matrix *inverse = gsl_matrix_alloc(rows, cols);
-    gsl_linalg_LU_invert(A, p, inverse);
+bool Matrix::solve(Matrix *a)
+{
+    if (!a || a->numRows() != a->numCols() || a->numRows() != numRows()) {
+        QMessageBox::critical(0, tr("Error"),
+                              tr("Solving failed, the coefficient matrix is not square or does "
+                                 "not match the number of rows!"));
+        return false;
+    }
 
-    gsl_matrix_free(A);
-    gsl_permutation_free(p);
+    if (!d_future_matrix->solve(a->d_future_matrix)) {
+        QMessageBox::critical(0, tr("Error"),
+                              tr("Solving failed, the coefficient matrix is singular!"));
+        return false;
+    }
+    emit modifiedWindow(this);
+    return true;
+}
 
-    this->blockSignals(true);
-    for (i = 0; i < rows; i++) {
-        for (int j = 0; j < cols; j++)
-            setCell(i, j, gsl_matrix_get(inverse, i, j));
+bool Matrix::combine(Matrix *other, MatrixOperations::ElementwiseOperation operation)
+{
+    if (!other || numRows() != other->numRows() || numCols() != other->numCols()) {
+        QMessageBox::critical(0, tr("Error"),
+                              tr("Calculation failed, the matrices differ in size!"));
+        return false;
     }
-    this->blockSignals(false);
 
-    gsl_matrix_free(inverse);
-    QApplication::restoreOverrideCursor();
+    d_future_matrix->combine(other->d_future_matrix, operation);
     emit modifiedWindow(this);
+    return true;
 }
 
 void Matrix::transpose()
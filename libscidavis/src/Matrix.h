@@ -147,6 +147,12 @@ public slots:
     void invert();
     //! Calculate the determinant of the matrix
     double determinant();
+    //! Replace the matrix by its product with 'other'
+    bool multiply(Matrix *other);
+    //! Replace the matrix B by the solution X of a * X = B
+    bool solve(Matrix *a);
+    //! Add, subtract, multiply or divide the cells by those of 'other'
+    bool combine(Matrix *other, MatrixOperations::ElementwiseOperation operation);
 
     //! Calculate matrix values using the formula for all selected cells
     bool recalculate();
@@ -0,0 +1,412 @@
+/***************************************************************************
+    File                 : MatrixRaster.cpp
+    Project              : SciDAVis
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 SciDAVis developers
+    Description          : Shared matrix snapshots and color mapped tiles for
+                           spectrograms
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+#include "MatrixRaster.h"
+#include "Matrix.h"
+#include "lib/DescriptiveStatistics.h"
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QPair>
+#include <QtConcurrentMap>
+
+#include <qwt_color_map.h>
+#include <qwt_scale_map.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+QMutex snapshot_mutex;
+//! Snapshots in use, by matrix version
+QHash<quint64, QWeakPointer<const MatrixRaster>> snapshots;
+
+//! Extrema and replacement values of a block of columns
+struct BlockSummary
+{
+    double min = std::numeric_limits<double>::max();
+    double max = -std::numeric_limits<double>::max();
+    QVector<QPair<qint64, double>> replacements;
+};
+
+//! Memory available for tiles, in kilobytes
+const int TileCacheSize = 32768;
+//! Number of screen rows composed per task
+const int ComposeBlockSize = 64;
+} // namespace
+
+QSharedPointer<const MatrixRaster> MatrixRaster::snapshot(Matrix *m)
+{
+    const quint64 version = m->d_future_matrix->version();
+    QMutexLocker locker(&snapshot_mutex);
+    QSharedPointer<const MatrixRaster> result = snapshots.value(version).toStrongRef();
+    if (result)
+        return result;
+
+    result = QSharedPointer<const MatrixRaster>(new MatrixRaster(m));
+    for (auto it = snapshots.begin(); it != snapshots.end();) {
+        if (it.value().isNull())
+            it = snapshots.erase(it);
+        else
+            ++it;
+    }
+    snapshots.insert(version, result);
+    return result;
+}
+
+MatrixRaster::MatrixRaster(Matrix *m)
+    : d_version(m->d_future_matrix->version()),
+      d_columns(m->d_future_matrix->columns()),
+      d_row_count(m->numRows()),
+      d_column_count(m->numCols()),
+      d_bounding_rect(m->boundingRect()),
+      d_min(std::numeric_limits<double>::max()),
+      d_max(-std::numeric_limits<double>::max())
+{
+    d_x_start = m->xStart();
+    d_dx = (m->xEnd() - d_x_start) / (double)d_column_count;
+    d_y_start = m->yStart();
+    d_dy = (m->yEnd() - d_y_start) / (double)d_row_count;
+    if (d_row_count == 0 || d_column_count == 0)
+        return;
+
+    // scan blocks of whole columns on the thread pool
+    const int columns_per_block = qMax(1, DescriptiveStatistics::BlockSize / d_row_count);
+    QVector<int> blocks((d_column_count + columns_per_block - 1) / columns_per_block);
+    for (int b = 0; b < blocks.size(); b++)
+        blocks[b] = b;
+    const QVector<QVector<qreal>> &columns = d_columns;
+    const int rows = d_row_count, cols = d_column_count;
+    auto summarize = [&](int b) {
+        BlockSummary summary;
+        const int end = qMin((b + 1) * columns_per_block, cols);
+        for (int j = b * columns_per_block; j < end; j++) {
+            const qreal *column = columns.at(j).constData();
+            for (int i = 0; i < rows; i++) {
+                double v = column[i];
+                if (!std::isfinite(v)) {
+                    // average of the finite diagonal neighbours; cells outside count as 0
+                    double av = 0;
+                    unsigned cnt = 0;
+                    for (int ii = i - 1; ii <= i + 1; ii += 2)
+                        for (int jj = j - 1; jj <= j + 1; jj += 2) {
+                            const double neighbour = (ii >= 0 && ii < rows && jj >= 0 && jj < cols)
+                                    ? columns.at(jj).at(ii)
+                                    : 0.0;
+                            if (std::isfinite(neighbour)) {
+                                av += neighbour;
+                                cnt++;
+                            }
+                        }
+                    v = cnt > 0 ? av / cnt : 0.0;
+                    summary.replacements << qMakePair(qint64(j) * rows + i, v);
+                }
+                summary.min = qMin(summary.min, v);
+                summary.max = qMax(summary.max, v);
+            }
+        }
+        return summary;
+    };
+    const QVector<BlockSummary> summaries = blocks.size() > 1
+            ? QtConcurrent::blockingMapped<QVector<BlockSummary>>(blocks, summarize)
+            : QVector<BlockSummary>() << summarize(0);
+
+    for (const BlockSummary &summary : summaries) {
+        d_min = qMin(d_min, summary.min);
+        d_max = qMax(d_max, summary.max);
+        for (const QPair<qint64, double> &replacement : summary.replacements)
+            d_replacements.insert(replacement.first, replacement.second);
+    }
+}
+
+double MatrixRaster::value(double x, double y) const
+{
+    int i = abs((int)floor((y - d_y_start) / d_dy - 1));
+    int j = abs((int)floor((x - d_x_start) / d_dx));
+
+    if (i < d_row_count && j < d_column_count)
+        return cell(i, j);
+    else
+        return 0.0;
+}
+
+QwtRasterData::ContourLines MatrixRaster::contourLines(const QwtValueList &levels) const
+{
+    QwtRasterData::ContourLines result;
+    const int rows = d_row_count, cols = d_column_count;
+    if (rows < 2 || cols < 2 || levels.isEmpty())
+        return result;
+
+    // the displayed values at the cell centers, row by row
+    QVector<double> grid(rows * cols);
+    QVector<double> xs(cols), ys(rows);
+    for (int j = 0; j < cols; j++)
+        xs[j] = d_x_start + (j + 0.5) * d_dx;
+    for (int k = 0; k < rows; k++)
+        ys[k] = d_y_start + (k + 0.5) * d_dy;
+    const int rows_per_block = qMax(1, DescriptiveStatistics::BlockSize / cols);
+    QVector<int> blocks((rows + rows_per_block - 1) / rows_per_block);
+    for (int b = 0; b < blocks.size(); b++)
+        blocks[b] = b;
+    double *values = grid.data();
+    QtConcurrent::blockingMap(blocks, [&](int b) {
+        const int end = qMin((b + 1) * rows_per_block, rows);
+        for (int k = b * rows_per_block; k < end; k++)
+            for (int j = 0; j < cols; j++)
+                values[k * cols + j] = value(xs.at(j), ys.at(k));
+    });
+
+    // one task per level and block of grid cells
+    const int cell_blocks = (rows - 1 + rows_per_block - 1) / rows_per_block;
+    QVector<QPair<int, int>> tasks;
+    for (int l = 0; l < levels.size(); l++)
+        for (int b = 0; b < cell_blocks; b++)
+            tasks << qMakePair(l, b);
+    auto trace = [&](const QPair<int, int> &task) {
+        const double level = levels.at(task.first);
+        QPolygonF lines;
+        const int end = qMin((task.second + 1) * rows_per_block, rows - 1);
+        for (int k = task.second * rows_per_block; k < end; k++) {
+            const double *lower = values + k * cols, *upper = lower + cols;
+            for (int j = 0; j < cols - 1; j++) {
+                // corners counter-clockwise from the lower left
+                const double a = lower[j], b = lower[j + 1], c = upper[j + 1], d = upper[j];
+                const int index = (a >= level ? 1 : 0) | (b >= level ? 2 : 0)
+                        | (c >= level ? 4 : 0) | (d >= level ? 8 : 0);
+                if (index == 0 || index == 15)
+                    continue;
+
+                // crossing points on the edges: 0 bottom, 1 right, 2 top, 3 left
+                auto crossing = [&](int edge) {
+                    switch (edge) {
+                    case 0:
+                        return QPointF(xs.at(j) + (level - a) / (b - a) * d_dx, ys.at(k));
+                    case 1:
+                        return QPointF(xs.at(j + 1), ys.at(k) + (level - b) / (c - b) * d_dy);
+                    case 2:
+                        return QPointF(xs.at(j) + (level - d) / (c - d) * d_dx, ys.at(k + 1));
+                    default:
+                        return QPointF(xs.at(j), ys.at(k) + (level - a) / (d - a) * d_dy);
+                    }
+                };
+                auto segment = [&](int from, int to) { lines << crossing(from) << crossing(to); };
+                switch (index) {
+                case 1:
+                case 14:
+                    segment(3, 0);
+                    break;
+                case 2:
+                case 13:
+                    segment(0, 1);
+                    break;
+                case 3:
+                case 12:
+                    segment(3, 1);
+                    break;
+                case 4:
+                case 11:
+                    segment(1, 2);
+                    break;
+                case 6:
+                case 9:
+                    segment(0, 2);
+                    break;
+                case 7:
+                case 8:
+                    segment(3, 2);
+                    break;
+                case 5:
+                    // saddle: the average of the corners decides which corners are connected
+                    if ((a + b + c + d) / 4 >= level) {
+                        segment(0, 1);
+                        segment(2, 3);
+                    } else {
+                        segment(3, 0);
+                        segment(1, 2);
+                    }
+                    break;
+                case 10:
+                    if ((a + b + c + d) / 4 >= level) {
+                        segment(3, 0);
+                        segment(1, 2);
+                    } else {
+                        segment(0, 1);
+                        segment(2, 3);
+                    }
+                    break;
+                }
+            }
+        }
+        return lines;
+    };
+    const QVector<QPolygonF> traced =
+            QtConcurrent::blockingMapped<QVector<QPolygonF>>(tasks, trace);
+    for (int t = 0; t < tasks.size(); t++)
+        if (!traced.at(t).isEmpty())
+            result[levels.at(tasks.at(t).first)] += traced.at(t);
+    return result;
+}
+
+/* ========================== MatrixRasterTiles ====================== */
+
+MatrixRasterTiles::MatrixRasterTiles() : d_tiles(TileCacheSize), d_version(0), d_color_map_key(0)
+{
+}
+
+void MatrixRasterTiles::clear()
+{
+    d_tiles.clear();
+}
+
+QImage MatrixRasterTiles::renderTile(const MatrixRaster &raster, const QwtColorMap &colorMap,
+                                     int level, int tx, int ty)
+{
+    const int step = 1 << level;
+    const int width = qMin(TileSize, (raster.columnCount() + step - 1) / step - tx * TileSize);
+    const int height = qMin(TileSize, (raster.rowCount() + step - 1) / step - ty * TileSize);
+    const QwtDoubleInterval range = raster.range();
+    const double pixel_width = raster.cellWidth() * step;
+    const double pixel_height = raster.cellHeight() * step;
+
+    QImage tile(width, height, QImage::Format_ARGB32);
+    for (int b = 0; b < height; b++) {
+        const double y = raster.yStart() + (ty * TileSize + b + 0.5) * pixel_height;
+        QRgb *line = reinterpret_cast<QRgb *>(tile.scanLine(b));
+        for (int a = 0; a < width; a++) {
+            const double x = raster.xStart() + (tx * TileSize + a + 0.5) * pixel_width;
+            line[a] = colorMap.rgb(range, raster.value(x, y));
+        }
+    }
+    return tile;
+}
+
+QImage MatrixRasterTiles::render(const MatrixRaster &raster, const QwtColorMap &colorMap,
+                                 const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+                                 const QRect &rect)
+{
+    if (rect.isEmpty())
+        return QImage();
+    QImage image(rect.size(), QImage::Format_ARGB32);
+    const QwtDoubleInterval range = raster.range();
+    if (!range.isValid() || raster.cellWidth() == 0.0 || raster.cellHeight() == 0.0) {
+        image.fill(0);
+        return image;
+    }
+
+    const QVector<QRgb> color_table = colorMap.colorTable(range);
+    const uint color_map_key = qHashBits(color_table.constData(),
+                                         color_table.size() * sizeof(QRgb), colorMap.format());
+    if (raster.version() != d_version || color_map_key != d_color_map_key) {
+        d_tiles.clear();
+        d_version = raster.version();
+        d_color_map_key = color_map_key;
+    }
+
+    // plot coordinates of the pixel centers
+    const int width = rect.width(), height = rect.height();
+    QVector<double> xs(width), ys(height);
+    for (int px = 0; px < width; px++)
+        xs[px] = xMap.invTransform(rect.left() + px + 0.5);
+    for (int py = 0; py < height; py++)
+        ys[py] = yMap.invTransform(rect.top() + py + 0.5);
+
+    // coarsest level with at least one tile pixel per screen pixel on both axes
+    const double cells_per_pixel =
+            qMin(fabs(xMap.invTransform(rect.right() + 1) - xMap.invTransform(rect.left()))
+                         / (width * fabs(raster.cellWidth())),
+                 fabs(yMap.invTransform(rect.bottom() + 1) - yMap.invTransform(rect.top()))
+                         / (height * fabs(raster.cellHeight())));
+    int level = 0;
+    while (level < 24 && double(2 << level) <= cells_per_pixel)
+        level++;
+    const int step = 1 << level;
+    const int tile_columns = (raster.columnCount() + step - 1) / step;
+    const int tile_rows = (raster.rowCount() + step - 1) / step;
+
+    // tile pixel shown by each screen column and row
+    QVector<int> us(width), vs(height);
+    for (int px = 0; px < width; px++)
+        us[px] = qBound(0, (int)floor((xs.at(px) - raster.xStart()) / (raster.cellWidth() * step)),
+                        tile_columns - 1);
+    for (int py = 0; py < height; py++)
+        vs[py] = qBound(0, (int)floor((ys.at(py) - raster.yStart()) / (raster.cellHeight() * step)),
+                        tile_rows - 1);
+    const int tx_min = *std::min_element(us.constBegin(), us.constEnd()) / TileSize;
+    const int tx_max = *std::max_element(us.constBegin(), us.constEnd()) / TileSize;
+    const int ty_min = *std::min_element(vs.constBegin(), vs.constEnd()) / TileSize;
+    const int ty_max = *std::max_element(vs.constBegin(), vs.constEnd()) / TileSize;
+
+    // collect the tiles, rendering the missing ones on the thread pool
+    const int tiles_per_row = tx_max - tx_min + 1;
+    QVector<QImage> tiles(tiles_per_row * (ty_max - ty_min + 1));
+    QVector<QPair<int, int>> missing;
+    for (int ty = ty_min; ty <= ty_max; ty++)
+        for (int tx = tx_min; tx <= tx_max; tx++) {
+            if (const QImage *tile = d_tiles.object(key(level, tx, ty)))
+                tiles[(ty - ty_min) * tiles_per_row + tx - tx_min] = *tile;
+            else
+                missing << qMakePair(tx, ty);
+        }
+    auto render_tile = [&](const QPair<int, int> &index) {
+        return renderTile(raster, colorMap, level, index.first, index.second);
+    };
+    const QVector<QImage> rendered =
+            QtConcurrent::blockingMapped<QVector<QImage>>(missing, render_tile);
+    for (int i = 0; i < missing.size(); i++) {
+        const int tx = missing.at(i).first, ty = missing.at(i).second;
+        const QImage &tile = rendered.at(i);
+        tiles[(ty - ty_min) * tiles_per_row + tx - tx_min] = tile;
+        d_tiles.insert(key(level, tx, ty), new QImage(tile),
+                       qMax(1, tile.width() * tile.height() * int(sizeof(QRgb)) / 1024));
+    }
+
+    // compose the image from the tiles, in blocks of rows on the thread pool
+    uchar *bits = image.bits();
+    const int bytes_per_line = image.bytesPerLine();
+    QVector<int> blocks((height + ComposeBlockSize - 1) / ComposeBlockSize);
+    for (int b = 0; b < blocks.size(); b++)
+        blocks[b] = b;
+    auto compose = [&](int b) {
+        QVector<const QRgb *> lines(tiles_per_row);
+        const int end = qMin((b + 1) * ComposeBlockSize, height);
+        for (int py = b * ComposeBlockSize; py < end; py++) {
+            const int v = vs.at(py);
+            const QImage *row = tiles.constData() + (v / TileSize - ty_min) * tiles_per_row;
+            for (int t = 0; t < tiles_per_row; t++)
+                lines[t] = reinterpret_cast<const QRgb *>(row[t].constScanLine(v % TileSize));
+            QRgb *line = reinterpret_cast<QRgb *>(bits + py * bytes_per_line);
+            for (int px = 0; px < width; px++) {
+                const int u = us.at(px);
+                line[px] = lines.at(u / TileSize - tx_min)[u % TileSize];
+            }
+        }
+    };
+    QtConcurrent::blockingMap(blocks, compose);
+    return image;
+}
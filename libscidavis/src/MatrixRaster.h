@@ -0,0 +1,155 @@
+/***************************************************************************
+    File                 : MatrixRaster.h
+    Project              : SciDAVis
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 SciDAVis developers
+    Description          : Shared matrix snapshots and color mapped tiles for
+                           spectrograms
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef MATRIXRASTER_H
+#define MATRIXRASTER_H
+
+#include <QCache>
+#include <QHash>
+#include <QImage>
+#include <QSharedPointer>
+#include <QVector>
+
+#include <qwt_double_interval.h>
+#include <qwt_double_rect.h>
+#include <qwt_raster_data.h>
+
+#include <cmath>
+
+class Matrix;
+class QwtColorMap;
+class QwtScaleMap;
+
+//! Immutable snapshot of the cells of a matrix, as displayed by spectrograms
+/**
+  The cells are shared with the matrix (see future::Matrix::columns()), so
+  taking a snapshot copies nothing. Snapshots are identified by the version of
+  the matrix: as long as a snapshot is in use, snapshot() returns it again
+  instead of creating a new one.
+
+  Non-finite cells are displayed as the average of their finite diagonal
+  neighbours (neighbours outside of the matrix count as 0). These replacement
+  values and the range of the displayed values are computed when the snapshot
+  is taken, in parallel over blocks of columns.
+  */
+class MatrixRaster
+{
+public:
+    //! Return a snapshot of the current content of m
+    static QSharedPointer<const MatrixRaster> snapshot(Matrix *m);
+
+    //! The version of the matrix the snapshot was taken from
+    quint64 version() const { return d_version; }
+    int rowCount() const { return d_row_count; }
+    int columnCount() const { return d_column_count; }
+    QwtDoubleRect boundingRect() const { return d_bounding_rect; }
+    //! Range of the displayed values; invalid if the matrix is empty
+    QwtDoubleInterval range() const { return QwtDoubleInterval(d_min, d_max); }
+    //! Width of a cell in plot coordinates (negative if xEnd < xStart)
+    double cellWidth() const { return d_dx; }
+    //! Height of a cell in plot coordinates (negative if yEnd < yStart)
+    double cellHeight() const { return d_dy; }
+    double xStart() const { return d_x_start; }
+    double yStart() const { return d_y_start; }
+
+    //! Return the displayed value of a cell (with non-finite values replaced)
+    double cell(int row, int col) const
+    {
+        const double v = d_columns.at(col).at(row);
+        if (std::isfinite(v))
+            return v;
+        return d_replacements.value(qint64(col) * d_row_count + row);
+    }
+    //! Return the value displayed at the point (x, y) in plot coordinates
+    double value(double x, double y) const;
+    //! Return the isolines of the displayed values for the given levels
+    /**
+     * The lines are traced by marching squares on the grid of the cell centers. They are
+     * returned in plot coordinates as pairs of points (one line segment each) per level, as
+     * drawn by QwtPlotSpectrogram::drawContourLines(). Levels and blocks of grid rows are
+     * processed in parallel on the global thread pool.
+     */
+    QwtRasterData::ContourLines contourLines(const QwtValueList &levels) const;
+
+private:
+    MatrixRaster(Matrix *m);
+
+    quint64 d_version;
+    //! The cells, one vector per column
+    QVector<QVector<qreal>> d_columns;
+    //! Displayed values of the non-finite cells, indexed by column * rows + row
+    QHash<qint64, double> d_replacements;
+    int d_row_count, d_column_count;
+    QwtDoubleRect d_bounding_rect;
+    double d_min, d_max;
+    double d_x_start, d_y_start, d_dx, d_dy;
+};
+
+//! Color mapped images of a MatrixRaster, cut into tiles at several zoom levels
+/**
+  At zoom level L, a pixel of a tile shows the cell at its center out of a
+  block of 2^L x 2^L cells. render() chooses the coarsest level which still
+  has at least one tile pixel per screen pixel, renders the tiles it does not
+  have yet on the global thread pool and composes the image from the tiles.
+  Panning or repainting at the same zoom level thus does not evaluate the
+  color map again. The tiles are kept until the raster (i.e. the matrix
+  version) or the color map changes.
+  */
+class MatrixRasterTiles
+{
+public:
+    MatrixRasterTiles();
+
+    //! Render the image of 'raster' which covers 'rect' on the paint device
+    QImage render(const MatrixRaster &raster, const QwtColorMap &colorMap,
+                  const QwtScaleMap &xMap, const QwtScaleMap &yMap, const QRect &rect);
+    //! Discard all tiles
+    void clear();
+
+private:
+    //! Width and height of a tile in pixels
+    static constexpr int TileSize = 256;
+
+    //! Return the tile of the given level with column index tx and row index ty
+    static QImage renderTile(const MatrixRaster &raster, const QwtColorMap &colorMap,
+                             int level, int tx, int ty);
+    static quint64 key(int level, int tx, int ty)
+    {
+        return (quint64(level) << 58) | (quint64(ty) << 29) | quint64(tx);
+    }
+
+    //! Tiles, with their size in kilobytes as cost
+    QCache<quint64, QImage> d_tiles;
+    //! Version of the raster the tiles belong to
+    quint64 d_version;
+    //! Fingerprint of the color map the tiles were rendered with
+    uint d_color_map_key;
+};
+
+#endif // ifndef MATRIXRASTER_H
@@ -750,6 +750,16 @@ void MultiLayer::exportPainter(QPainter &painter, bool keepAspect, QRect rect, Q
     }
 }
 
+QPicture MultiLayer::exportPicture()
+{
+    QPicture picture;
+    QPainter painter(&picture);
+    exportPainter(painter);
+    painter.end();
+    picture.setBoundingRect(canvas->rect());
+    return picture;
+}
+
 void MultiLayer::copyAllLayers()
 {
     QImage image(canvas->size(), QImage::Format_ARGB32);
@@ -36,6 +36,7 @@
 #include "Graph.h"
 #include <QPushButton>
 #include <QLayout>
+#include <QPicture>
 #include <QPointer>
 #include "core/column/Column.h"
 
@@ -172,6 +173,8 @@ public slots:
                       bool keepAspect = true, QPageSize pageSize = QPageSize(QPageSize::Custom),
                       QPageLayout::Orientation orientation = QPageLayout::Portrait);
     void exportPainter(QPaintDevice &paintDevice, bool keepAspect = false, QRect rect = QRect());
+    //! Record the painting of all layers (as by exportPainter()) for replaying it elsewhere
+    QPicture exportPicture();
     void exportPainter(QPainter &painter, bool keepAspect = false, QRect rect = QRect(),
                        QSize size = QSize());
 
@@ -35,6 +35,9 @@
 
 #include <QLocale>
 #include <QMessageBox>
+#include <QtConcurrentMap>
+
+#include <algorithm>
 
 using namespace std;
 
@@ -62,6 +65,7 @@ MultiPeakFit::MultiPeakFit(ApplicationWindow *parent, Graph *g, PeakProfile prof
 
     generate_peak_curves = true;
     d_peaks_color = 2; // green
+    d_independent_regions = false;
 }
 
 void MultiPeakFit::setNumPeaks(int n)
@@ -187,6 +191,134 @@ void MultiPeakFit::guessInitialValues()
     gsl_vector_set(d_param_init, 3, min_out);
 }
 
+int MultiPeakFit::findPeaks(const PeakDetection::Options &options)
+{
+    if (d_x.empty())
+        return 0;
+
+    const QVector<PeakDetection::Peak> peaks =
+            PeakDetection::find(d_x.data(), d_y.data(), d_x.size(), options);
+    if (peaks.isEmpty())
+        return 0;
+
+    setNumPeaks(peaks.size());
+    const double offset = *std::min_element(d_y.begin(), d_y.end());
+    for (int i = 0; i < peaks.size(); i++) {
+        const PeakDetection::Peak &peak = peaks.at(i);
+        const double height = peak.height - offset;
+        // convert the full width at half maximum and the height into the parameters of the
+        // profile (note that the fit functions use the scaled amplitude A*PI/2 for Lorentzians)
+        double w, a;
+        if (d_profile == Gauss) {
+            w = peak.width / sqrt(2 * M_LN2);
+            a = height * w * sqrt(M_PI_2);
+        } else {
+            w = peak.width;
+            a = height * w;
+        }
+        setInitialGuess(3 * i, a);
+        setInitialGuess(3 * i + 1, peak.position);
+        setInitialGuess(3 * i + 2, w);
+    }
+    setInitialGuess(d_p - 1, offset);
+    return peaks.size();
+}
+
+void MultiPeakFit::fit()
+{
+    if (d_independent_regions && d_peaks > 1 && d_graph && !d_init_err && !d_x.empty()
+        && d_solver != NelderMeadSimplex)
+        fitIndependentRegions();
+    Fit::fit();
+}
+
+void MultiPeakFit::fitIndependentRegions()
+{
+    // outside of this distance (in units of w) a peak is negligible compared to the noise
+    const double reach = d_profile == Gauss ? 2.5 : 10.0;
+    QVector<double> centers, ranges;
+    for (int i = 0; i < d_peaks; i++) {
+        centers << gsl_vector_get(d_param_init, 3 * i + 1);
+        ranges << reach * gsl_vector_get(d_param_init, 3 * i + 2);
+    }
+
+    struct RegionFit
+    {
+        PeakDetection::Region region;
+        std::vector<double> parameters;
+        bool success;
+    };
+    QVector<RegionFit> fits;
+    for (const PeakDetection::Region &region :
+         PeakDetection::regions(d_x.data(), d_x.size(), centers, ranges))
+        fits << RegionFit { region, std::vector<double>(), false };
+    if (fits.size() < 2)
+        return;
+
+    auto fit_region = [this](RegionFit &f) {
+        const size_t n = f.region.points.size();
+        const size_t p = 3 * f.region.peaks.size() + 1;
+        if (n <= p)
+            return;
+
+        gsl_vector *init = gsl_vector_alloc(p);
+        for (int k = 0; k < f.region.peaks.size(); k++)
+            for (int j = 0; j < 3; j++)
+                gsl_vector_set(init, 3 * k + j,
+                               gsl_vector_get(d_param_init, 3 * f.region.peaks.at(k) + j));
+        gsl_vector_set(init, p - 1, gsl_vector_get(d_param_init, d_p - 1));
+
+        const int first = f.region.points.start();
+        struct FitData data = { n, p, d_x.data() + first, d_y.data() + first,
+                                d_y_errors.data() + first, this };
+        gsl_multifit_function_fdf function;
+        function.f = d_f;
+        function.df = d_df;
+        function.fdf = d_fdf;
+        function.n = n;
+        function.p = p;
+        function.params = &data;
+
+        gsl_multifit_fdfsolver *s = gsl_multifit_fdfsolver_alloc(
+                d_solver == UnscaledLevenbergMarquardt ? gsl_multifit_fdfsolver_lmder
+                                                       : gsl_multifit_fdfsolver_lmsder,
+                n, p);
+        int status = gsl_multifit_fdfsolver_set(s, &function, init);
+        for (int iterations = 0; !status && iterations < d_max_iterations; iterations++) {
+            status = gsl_multifit_fdfsolver_iterate(s);
+            if (status)
+                break;
+            status = gsl_multifit_test_delta(s->dx, s->x, d_tolerance, d_tolerance);
+            if (status != GSL_CONTINUE)
+                break;
+        }
+        if (status == GSL_SUCCESS) {
+            f.parameters.resize(p);
+            for (size_t i = 0; i < p; i++)
+                f.parameters[i] = gsl_vector_get(s->x, i);
+            f.success = true;
+        }
+        gsl_multifit_fdfsolver_free(s);
+        gsl_vector_free(init);
+    };
+    QtConcurrent::blockingMap(fits, fit_region);
+
+    // merge: take over the peak parameters, average the offsets weighted by the number of points
+    double offset = 0.0, points = 0.0;
+    for (const RegionFit &f : fits) {
+        if (!f.success)
+            continue;
+        for (int k = 0; k < f.region.peaks.size(); k++)
+            for (int j = 0; j < 3; j++)
+                gsl_vector_set(d_param_init, 3 * f.region.peaks.at(k) + j,
+                               f.parameters[3 * k + j]);
+        offset += f.parameters.back() * f.region.points.size();
+        points += f.region.points.size();
+    }
+    if (points > 0)
+        gsl_vector_set(d_param_init, d_p - 1, offset / points);
+}
+
 void MultiPeakFit::storeCustomFitResults(const vector<double> &par)
 {
     d_results = par;
@@ -31,6 +31,7 @@
 
 #include <QColor>
 #include "Fit.h"
+#include "lib/PeakDetection.h"
 
 class MultiPeakFit : public Fit
 {
@@ -47,6 +48,22 @@ public:
     void enablePeakCurves(bool on) { generate_peak_curves = on; };
     void setPeakCurvesColor(QColor color) { d_peaks_color = color; };
 
+    //! Detects the peaks of the data set and uses them as number of peaks and initial values
+    /**
+     * Has to be called after the data has been set. Returns the number of peaks found; if no
+     * peak is found, the fit is left unchanged.
+     */
+    int findPeaks(const PeakDetection::Options &options = PeakDetection::Options());
+
+    //! Specifies whether groups of non-overlapping peaks are fitted separately first
+    /**
+     * The groups are fitted in parallel; their results are merged and used as initial
+     * values for the final fit of all peaks, which then only needs a few iterations.
+     */
+    void enableIndependentRegions(bool on) { d_independent_regions = on; };
+
+    void fit() override;
+
     static QString generateFormula(int order, PeakProfile profile);
     static QStringList generateParameterList(int order);
     static QStringList generateExplanationList(int order);
@@ -58,6 +75,8 @@ private:
     //! Inserts a peak function curve into the plot
     void insertPeakFunctionCurve(std::vector<double> &x, std::vector<double> &y, int peak);
     void storeCustomFitResults(const std::vector<double> &) override;
+    //! Refines the initial values by fitting groups of non-overlapping peaks separately
+    void fitIndependentRegions();
 
     //! Used by the GaussFit and LorentzFit derived classes to calculate initial values for the parameters
 protected:
@@ -75,6 +94,9 @@ private:
 
     //! The peak profile
     PeakProfile d_profile;
+
+    //! Tells whether non-overlapping groups of peaks are fitted separately first
+    bool d_independent_regions;
 };
 
 class LorentzFit : public MultiPeakFit
@@ -28,6 +28,7 @@
  ***************************************************************************/
 #include "NonLinearFit.h"
 #include "MyParser.h"
+#include "CompiledFormula.h"
 #include "fit_gsl.h"
 
 #include <QMessageBox>
@@ -103,6 +104,19 @@ void NonLinearFit::setParametersList(const QStringList &lst)
 bool NonLinearFit::calculateFitCurveData(const vector<double> &par, std::vector<double> &X,
                                          std::vector<double> &Y)
 {
+    if (d_compiled_formula) {
+        generateX(X);
+        double *variables = d_compiled_formula->variables();
+        for (unsigned i = 0; i < d_p; i++)
+            variables[i] = par[i];
+        for (int i = 0; i < d_points; i++) {
+            variables[d_p] = X[i];
+            Y[i] = d_compiled_formula->evaluate();
+        }
+        // values outside of the domain of the function are left out of the curve
+        return d_compiled_formula->error().isEmpty();
+    }
+
     for (unsigned i = 0; i < d_p; i++)
         if (!d_script->setDouble(par[i], d_param_names[i].toUtf8()))
             return false;
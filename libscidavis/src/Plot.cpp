@@ -27,6 +27,7 @@
  *                                                                         *
  ***************************************************************************/
 #include "Plot.h"
+#include "CanvasRenderer.h"
 #include "Graph.h"
 #include "Grid.h"
 #include "ScaleDraw.h"
@@ -46,7 +47,8 @@
 #include <iostream>
 using namespace std;
 
-Plot::Plot(QWidget *parent, QString) : QwtPlot(parent)
+Plot::Plot(QWidget *parent, QString)
+    : QwtPlot(parent), d_renderer(new CanvasRenderer(this)), d_drawing_canvas(false)
 {
     setAutoReplot(false);
 
@@ -155,10 +157,24 @@ void Plot::printFrame(QPainter *painter, const QRect &rect) const
     painter->restore();
 }
 
+void Plot::replot()
+{
+    d_renderer->invalidate();
+    QwtPlot::replot();
+}
+
+void Plot::drawCanvas(QPainter *painter)
+{
+    d_drawing_canvas = true;
+    QwtPlot::drawCanvas(painter);
+    d_drawing_canvas = false;
+}
+
 void Plot::drawItems(QPainter *painter, const QRect &rect, const QwtScaleMap map[axisCnt],
                      const QwtPlotPrintFilter &pfilter) const
 {
-    QwtPlot::drawItems(painter, rect, map, pfilter);
+    if (!d_drawing_canvas || !d_renderer->drawItems(painter, rect, map, pfilter))
+        QwtPlot::drawItems(painter, rect, map, pfilter);
 
     for (int i = 0; i < QwtPlot::axisCnt; i++) {
         if (!axisEnabled(i))
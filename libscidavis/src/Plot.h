@@ -37,6 +37,7 @@
 #include <qwt_plot_grid.h>
 #include <qwt_plot_marker.h>
 
+class CanvasRenderer;
 class Grid;
 
 //! Plot window class
@@ -93,7 +94,11 @@ public:
     void print(QPainter *, const QRect &rect,
                const QwtPlotPrintFilter & = QwtPlotPrintFilter()) const override;
 
+    //! Replot, rendering the curves again (see CanvasRenderer)
+    void replot() override;
+
 protected:
+    void drawCanvas(QPainter *painter) override;
     void drawItems(QPainter *painter, const QRect &rect, const QwtScaleMap map[axisCnt],
                    const QwtPlotPrintFilter &pfilter) const override;
 
@@ -106,5 +111,11 @@ protected:
     int minTickLength, majTickLength;
     int marker_key;
     int curve_key;
+
+private:
+    //! Renders the curves drawn on the canvas in the background
+    CanvasRenderer *d_renderer;
+    //! Whether drawItems() is called for the canvas (and not for printing)
+    bool d_drawing_canvas;
 };
 #endif
@@ -32,8 +32,13 @@
 #include "core/datatypes/DateTime2StringFilter.h"
 #include <QDateTime>
 #include <QMessageBox>
+#include <QPainter>
+#include <QPainterPath>
+#include <qwt_painter.h>
 #include <qwt_symbol.h>
 
+#include <algorithm>
+
 DataCurve::DataCurve(Table *t, const QString &xColName, const QString &name, int startRow,
                      int endRow)
     : PlotCurve(name), d_table(t), d_x_column(xColName), d_start_row(startRow), d_end_row(endRow)
@@ -120,6 +125,86 @@ bool DataCurve::updateData(Table *t, const QString &colName)
     return true;
 }
 
+bool DataCurve::updateRows(Table *t, const QString &colName, const Interval<int> &rows)
+{
+    if (rows.isValid() && d_table == t && (colName == title().text() || d_x_column == colName)
+        && loadRows(rows))
+        return true;
+    return updateData(t, colName);
+}
+
+namespace {
+//! Replace values[first, last) by 'replacement', appending without moving the other values
+template<class T>
+void replaceRange(QVector<T> &values, int first, int last, const QVector<T> &replacement)
+{
+    const int common = qMin(last - first, replacement.size());
+    std::copy(replacement.constBegin(), replacement.constBegin() + common,
+              values.begin() + first);
+    if (common < last - first)
+        values.remove(first + common, last - first - common);
+    else if (first + common == values.size())
+        values += replacement.mid(common);
+    else if (common < replacement.size()) {
+        values.insert(first + common, replacement.size() - common, T());
+        std::copy(replacement.constBegin() + common, replacement.constEnd(),
+                  values.begin() + first + common);
+    }
+}
+} // namespace
+
+bool DataCurve::loadRows(const Interval<int> &rows)
+{
+    if (d_x_values.isEmpty() || !d_error_bars.isEmpty())
+        return false;
+    Column *x_col_ptr = d_table->column(d_x_column);
+    Column *y_col_ptr = d_table->column(title().text());
+    if (!x_col_ptr || !y_col_ptr)
+        return false;
+    // text and date/time values depend on the axis formats set up by convertData()
+    if (x_col_ptr->columnMode() != SciDAVis::ColumnMode::Numeric
+        || y_col_ptr->columnMode() != SciDAVis::ColumnMode::Numeric)
+        return false;
+    if (d_type == Graph::HorizontalBars)
+        qSwap(x_col_ptr, y_col_ptr);
+
+    int end_row = qMin(d_end_row, qMin(x_col_ptr->rowCount(), y_col_ptr->rowCount()) - 1);
+    int first = qMax(rows.start(), d_start_row);
+    int last = rows.end();
+    // if the change reaches the end of the plotted rows (e.g. rows were removed), the points of
+    // all following rows are dropped as well
+    const bool to_end = last >= end_row;
+    if (to_end)
+        last = end_row;
+
+    const int lo = std::lower_bound(d_index_to_row.constBegin(), d_index_to_row.constEnd(), first)
+            - d_index_to_row.constBegin();
+    const int hi = to_end ? d_index_to_row.size()
+                          : std::upper_bound(d_index_to_row.constBegin(),
+                                             d_index_to_row.constEnd(), last)
+                    - d_index_to_row.constBegin();
+
+    QVector<int> valid_rows;
+    QVector<double> x, y;
+    for (int row = first; row <= last; row++) {
+        if (x_col_ptr->isInvalid(row) || y_col_ptr->isInvalid(row))
+            continue;
+        valid_rows << row;
+        x << x_col_ptr->valueAt(row);
+        y << y_col_ptr->valueAt(row);
+    }
+    if (d_index_to_row.size() - (hi - lo) + valid_rows.size() == 0)
+        return false; // let loadData() remove the curve
+
+    // release the curve's reference to the values, so that they are modified in place
+    setData(QwtArrayData(QwtArray<double>(), QwtArray<double>()));
+    replaceRange(d_x_values, lo, hi, x);
+    replaceRange(d_y_values, lo, hi, y);
+    replaceRange(d_index_to_row, lo, hi, valid_rows);
+    setData(QwtArrayData(d_x_values, d_y_values));
+    return true;
+}
+
 QList<QVector<double>> DataCurve::convertData(const QList<Column *> &cols,
                                               const QList<int> &axes) const
 {
@@ -238,11 +323,15 @@ bool DataCurve::loadData()
             QList<int>() << xAxis() << yAxis());
 
     if (points.isEmpty() || points[0].size() == 0) {
+        d_x_values.clear();
+        d_y_values.clear();
         remove();
         return false;
     }
 
-    setData(points[0].data(), points[1].data(), points[0].size());
+    d_x_values = points[0];
+    d_y_values = points[1];
+    setData(QwtArrayData(d_x_values, d_y_values));
     foreach (DataCurve *c, d_error_bars)
         c->setData(points[0].data(), points[1].data(), points[0].size());
 
@@ -316,3 +405,42 @@ QwtDoubleRect PlotCurve::boundingRect() const
 
     return QwtDoubleRect(d_x_left, d_y_top, qAbs(d_x_right - d_x_left), qAbs(d_y_bottom - d_y_top));
 }
+
+QRect PlotCurve::visibleRect(QPainter *painter)
+{
+    // the clip region is given in logical coordinates, the window after the world transformation
+    // (e.g. the scaling of printouts)
+    QRect rect;
+    if (painter->hasClipping()) {
+        rect = painter->clipBoundingRect().toAlignedRect();
+    } else {
+        bool invertible;
+        const QTransform inverse = painter->worldTransform().inverted(&invertible);
+        if (!invertible)
+            return QRect(QPoint(-0xfffffff, -0xfffffff), QPoint(0xfffffff, 0xfffffff));
+        rect = inverse.mapRect(QRectF(painter->window())).toAlignedRect();
+    }
+    return QwtPainter::metricsMap().deviceToLayout(rect);
+}
+
+void PlotCurve::drawLines(QPainter *painter, QVector<QLine> &lines)
+{
+    const QwtMetricsMap &map = QwtPainter::metricsMap();
+    if (!map.isIdentity())
+        for (QLine &l : lines)
+            l = QLine(map.layoutToDevice(l.p1()), map.layoutToDevice(l.p2()));
+    painter->drawLines(lines);
+}
+
+void PlotCurve::drawPolygons(QPainter *painter, QVector<QPolygon> &polygons)
+{
+    const QwtMetricsMap &map = QwtPainter::metricsMap();
+    // all polygons of a curve have the same orientation, so that overlapping ones are filled
+    QPainterPath path;
+    path.setFillRule(Qt::WindingFill);
+    for (const QPolygon &polygon : polygons) {
+        path.addPolygon(map.isIdentity() ? polygon : map.layoutToDevice(polygon));
+        path.closeSubpath();
+    }
+    painter->drawPath(path);
+}
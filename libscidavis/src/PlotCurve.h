@@ -31,6 +31,12 @@
 
 #include <qwt_plot_curve.h>
 #include "Table.h"
+#include "lib/Interval.h"
+
+#include <QLine>
+#include <QPolygon>
+
+class QPainter;
 
 //! Abstract 2D plot curve class
 class PlotCurve : public QwtPlotCurve
@@ -45,6 +51,17 @@ public:
     QwtDoubleRect boundingRect() const;
 
 protected:
+    //! Return the part of the painter's device which may be painted on, in layout coordinates
+    /**
+     * Items outside of this rectangle need not be drawn. The rectangle is given in the
+     * coordinates used by QwtPainter, i.e. before applying QwtPainter::metricsMap().
+     */
+    static QRect visibleRect(QPainter *painter);
+    //! Draw lines given in layout coordinates with one call (see QwtPainter::drawLine())
+    static void drawLines(QPainter *painter, QVector<QLine> &lines);
+    //! Draw polygons given in layout coordinates as one path (see QwtPainter::drawPolygon())
+    static void drawPolygons(QPainter *painter, QVector<QPolygon> &polygons);
+
     int d_type;
 };
 
@@ -71,7 +88,17 @@ public:
     void setFullRange();
 
     virtual bool updateData(Table *t, const QString &colName);
+    //! Update the curve after the given rows of column colName of t changed
+    /**
+     * If possible, only the points of these rows are converted again and patched into the data
+     * of the curve, so that appending k rows costs O(k). Otherwise (all rows changed, text or
+     * date/time data, error bars or curve types loading their data differently) this falls
+     * back to updateData().
+     */
+    bool updateRows(Table *t, const QString &colName, const Interval<int> &rows);
     virtual bool loadData();
+    //! Return the names of the columns of table() the curve is plotted from
+    virtual QStringList columnNames() { return QStringList() << d_x_column << title().text(); }
     QList<QVector<double>> convertData(const QList<Column *> &cols, const QList<int> &axes) const;
 
     //! Returns the row index in the data source table corresponding to the data point index.
@@ -143,6 +170,14 @@ private:
      * and has to store it like this.
      */
     mutable QVector<int> d_index_to_row;
+    //! \brief The values plotted by loadData(), shared with the data of the curve.
+    /*
+     * Empty for subclasses which load their data differently. Used by loadRows() to patch the
+     * values of changed rows in place.
+     */
+    QVector<double> d_x_values, d_y_values;
+    //! Convert the given rows again and patch them into the plotted data (see updateRows())
+    bool loadRows(const Interval<int> &rows);
     bool validCurveType();
 };
 #endif
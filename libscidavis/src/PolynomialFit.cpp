@@ -27,14 +27,51 @@
  *                                                                         *
  ***************************************************************************/
 #include "PolynomialFit.h"
+#include "lib/PolynomialLeastSquares.h"
 
 #include <QMessageBox>
 #include <QLocale>
 
-#include <gsl/gsl_multifit.h>
-#include <gsl/gsl_fit.h>
+#include <cmath>
 using namespace std;
 
+namespace {
+//! Fit a polynomial of degree 'order' to (x, y), weighting by 1/errors^2 if 'weighted' is set
+PolynomialLeastSquares::Result fitPolynomial(const vector<double> &x, const vector<double> &y,
+                                             const vector<double> &errors, bool weighted,
+                                             int order, Fit::RobustWeighting robust)
+{
+    vector<double> weights;
+    if (weighted) {
+        weights.resize(errors.size());
+        for (unsigned i = 0; i < errors.size(); i++)
+            weights[i] = 1.0 / pow(errors[i], 2);
+    }
+    PolynomialLeastSquares::Robustness robustness = PolynomialLeastSquares::Ordinary;
+    if (robust == Fit::HuberWeighting)
+        robustness = PolynomialLeastSquares::Huber;
+    else if (robust == Fit::BisquareWeighting)
+        robustness = PolynomialLeastSquares::Bisquare;
+    return PolynomialLeastSquares::fit(x.data(), y.data(), weighted ? weights.data() : nullptr,
+                                       int(x.size()), order, robustness);
+}
+
+//! Copy the covariance matrix of 'result' to 'covar'
+/**
+ * Without known errors, the covariance is estimated from the scatter of the residuals, like
+ * gsl_multifit_linear() does.
+ */
+void storeCovariance(const PolynomialLeastSquares::Result &result, bool weighted, size_t points,
+                     gsl_matrix *covar)
+{
+    const int p = result.coefficients.size();
+    const double scale = weighted ? 1.0 : result.weightedChiSquare / (double(points) - p);
+    for (int i = 0; i < p; i++)
+        for (int j = 0; j < p; j++)
+            gsl_matrix_set(covar, i, j, scale * result.covariance.at(i * p + j));
+}
+} // namespace
+
 PolynomialFit::PolynomialFit(ApplicationWindow *parent, Graph *g, int order, bool legend)
     : Fit(parent, g), d_order(order), show_legend(legend)
 {
@@ -125,38 +162,18 @@ void PolynomialFit::fit()
         return;
     }
 
-    gsl_matrix *X = gsl_matrix_alloc(d_x.size(), d_p);
-    gsl_vector *c = gsl_vector_alloc(d_p);
-
-    for (unsigned i = 0; i < d_x.size(); i++) {
-        for (unsigned j = 0; j < d_p; j++)
-            gsl_matrix_set(X, i, j, pow(d_x[i], j));
-    }
-
-    gsl_vector_view y = gsl_vector_view_array(d_y.data(), d_y_errors.size());
-
-    gsl_vector *weights = gsl_vector_alloc(d_y_errors.size());
-    for (unsigned i = 0; i < d_y_errors.size(); i++)
-        gsl_vector_set(weights, i, 1.0 / pow(d_y_errors[i], 2));
-
-    gsl_multifit_linear_workspace *work = gsl_multifit_linear_alloc(d_x.size(), d_p);
-
-    if (d_y_error_source == UnknownErrors)
-        gsl_multifit_linear(X, &y.vector, c, covar, &chi_2, work);
-    else
-        gsl_multifit_wlinear(X, weights, &y.vector, c, covar, &chi_2, work);
-
+    const bool weighted = d_y_error_source != UnknownErrors;
+    const PolynomialLeastSquares::Result result =
+            fitPolynomial(d_x, d_y, d_y_errors, weighted, d_order, d_robust_weighting);
     for (unsigned i = 0; i < d_p; i++)
-        d_results[i] = gsl_vector_get(c, i);
-
-    gsl_multifit_linear_free(work);
-    gsl_matrix_free(X);
-    gsl_vector_free(c);
-    gsl_vector_free(weights);
+        d_results[i] = result.coefficients.at(i);
+    chi_2 = result.chiSquare;
+    storeCovariance(result, weighted, d_x.size(), covar);
 
     ApplicationWindow *app = (ApplicationWindow *)parent();
     if (app->writeFitResultsToLog)
-        app->updateLog(logFitInfo(d_results, 0, 0, d_graph->parentPlotName()));
+        app->updateLog(
+                logFitInfo(d_results, result.iterations, 0, d_graph->parentPlotName()));
 
     if (show_legend || app->pasteFitResultsToPlot)
         showLegend();
@@ -250,30 +267,18 @@ void LinearFit::fit()
         return;
     }
 
-    double c0, c1, cov00, cov01, cov11;
-
-    std::vector<double> weights(d_y_errors.size());
-    for (unsigned i = 0; i < d_y_errors.size(); i++)
-        weights[i] = 1.0 / pow(d_y_errors[i], 2);
-
-    if (d_y_error_source == UnknownErrors)
-        gsl_fit_linear(d_x.data(), 1, d_y.data(), 1, d_x.size(), &c0, &c1, &cov00, &cov01, &cov11,
-                       &chi_2);
-    else
-        gsl_fit_wlinear(d_x.data(), 1, weights.data(), 1, d_y.data(), 1, d_x.size(), &c0, &c1, &cov00,
-                        &cov01, &cov11, &chi_2);
-
-    d_results[0] = c0;
-    d_results[1] = c1;
-
-    gsl_matrix_set(covar, 0, 0, cov00);
-    gsl_matrix_set(covar, 0, 1, cov01);
-    gsl_matrix_set(covar, 1, 1, cov11);
-    gsl_matrix_set(covar, 1, 0, cov01);
+    const bool weighted = d_y_error_source != UnknownErrors;
+    const PolynomialLeastSquares::Result result =
+            fitPolynomial(d_x, d_y, d_y_errors, weighted, 1, d_robust_weighting);
+    d_results[0] = result.coefficients.at(0);
+    d_results[1] = result.coefficients.at(1);
+    chi_2 = result.chiSquare;
+    storeCovariance(result, weighted, d_x.size(), covar);
 
     ApplicationWindow *app = (ApplicationWindow *)parent();
     if (app->writeFitResultsToLog)
-        app->updateLog(logFitInfo(d_results, 0, 0, d_graph->parentPlotName()));
+        app->updateLog(
+                logFitInfo(d_results, result.iterations, 0, d_graph->parentPlotName()));
 
     generateFitCurve(d_results);
 }
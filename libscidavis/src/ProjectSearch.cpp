@@ -0,0 +1,410 @@
+/***************************************************************************
+    File                 : ProjectSearch.cpp
+    Project              : SciDAVis
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 SciDAVis developers
+    Description          : Search and replace in the contents of project windows
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "ProjectSearch.h"
+#include "Matrix.h"
+#include "Note.h"
+#include "Table.h"
+#include "core/column/Column.h"
+
+#include <QLocale>
+#include <QTextCursor>
+#include <QtConcurrentMap>
+
+#include <functional>
+
+namespace {
+//! Whether 'expression' matches a non-empty part of 'text'
+/**
+ * Patterns like "a*" match the empty string everywhere, which is no reason to report or replace
+ * a cell.
+ */
+bool hasMatch(const QRegularExpression &expression, const QString &text)
+{
+    QRegularExpressionMatchIterator matches = expression.globalMatch(text);
+    while (matches.hasNext())
+        if (matches.next().capturedLength() > 0)
+            return true;
+    return false;
+}
+
+//! Replace the non-empty matches of 'expression' in 'text' and return their number
+/**
+ * As with QString::replace(), \\1 to \\9 in 'replacement' refer to the captured groups.
+ */
+int replaceMatches(QString &text, const QRegularExpression &expression, const QString &replacement)
+{
+    QString result;
+    int count = 0, end = 0;
+    QRegularExpressionMatchIterator matches = expression.globalMatch(text);
+    while (matches.hasNext()) {
+        const QRegularExpressionMatch match = matches.next();
+        if (match.capturedLength() == 0)
+            continue;
+        result += text.mid(end, match.capturedStart() - end);
+        for (int i = 0; i < replacement.size(); i++) {
+            const QChar c = replacement.at(i);
+            if (c == '\\' && i + 1 < replacement.size() && replacement.at(i + 1).isDigit()
+                && replacement.at(i + 1).digitValue() <= expression.captureCount())
+                result += match.captured(replacement.at(++i).digitValue());
+            else
+                result += c;
+        }
+        end = match.capturedEnd();
+        count++;
+    }
+    if (count > 0)
+        text = result + text.mid(end);
+    return count;
+}
+
+//! Changes to one column of a table, computed on a worker thread
+struct ColumnReplacement
+{
+    Column *column;
+    QVector<qreal> values;
+    QStringList texts;
+    QList<QDateTime> date_times;
+    QList<Interval<int>> invalid;
+    //! The range of rows changed and the number of cells changed in it
+    int first = -1, last = -1, count = 0;
+
+    void changed(int row)
+    {
+        if (first < 0)
+            first = row;
+        last = row;
+        count++;
+    }
+};
+} // namespace
+
+QRegularExpression ProjectSearch::Query::expression(bool cells) const
+{
+    QString pattern = regexp ? text : QRegularExpression::escape(text);
+    if (cells && whole_cell)
+        pattern = "\\A(?:" + pattern + ")\\z";
+    return QRegularExpression(pattern,
+                              case_sensitive ? QRegularExpression::NoPatternOption
+                                             : QRegularExpression::CaseInsensitiveOption);
+}
+
+ProjectSearch::ProjectSearch(QObject *parent) : QObject(parent)
+{
+    connect(&d_watcher, SIGNAL(resultReadyAt(int)), this, SLOT(reportHits(int)));
+    connect(&d_watcher, SIGNAL(finished()), this, SIGNAL(finished()));
+}
+
+ProjectSearch::~ProjectSearch()
+{
+    cancel();
+}
+
+void ProjectSearch::start(const QList<MyWidget *> &windows, const Query &query)
+{
+    cancel();
+    QList<Target> all_targets;
+    for (MyWidget *window : windows)
+        all_targets << targets(window, query);
+    // QtConcurrent needs the result_type of std::function to deduce the type of the results
+    std::function<QList<Hit>(const Target &)> scan = [query](const Target &target) {
+        return search(target, query);
+    };
+    d_watcher.setFuture(QtConcurrent::mapped(all_targets, scan));
+}
+
+void ProjectSearch::cancel()
+{
+    d_watcher.cancel();
+    d_watcher.waitForFinished();
+}
+
+void ProjectSearch::reportHits(int index)
+{
+    if (d_watcher.isCanceled())
+        return;
+    const QList<Hit> hits = d_watcher.resultAt(index);
+    if (!hits.isEmpty())
+        emit hitsFound(hits);
+}
+
+QList<ProjectSearch::Target> ProjectSearch::targets(MyWidget *window, const Query &query)
+{
+    QList<Target> result;
+    Target target;
+    target.window = window;
+    if (Table *table = qobject_cast<Table *>(window)) {
+        if (!query.tables || !table->d_future_table)
+            return result;
+        future::Table *future_table = table->d_future_table;
+        for (int i = 0; i < future_table->columnCount(); i++) {
+            Column *column = future_table->column(i);
+            target.column = i;
+            if (query.mode == NumberRange && column->dataType() == SciDAVis::TypeDouble)
+                target.values = column->values();
+            else if (query.mode == Text && column->dataType() == SciDAVis::TypeQString)
+                target.texts = column->texts();
+            else if (query.mode == DateTimeRange
+                     && column->dataType() == SciDAVis::TypeQDateTime)
+                target.date_times = column->dateTimes();
+            else
+                continue;
+            target.invalid = column->invalidIntervals();
+            result << target;
+        }
+    } else if (Matrix *matrix = qobject_cast<Matrix *>(window)) {
+        if (!query.matrices || query.mode != NumberRange)
+            return result;
+        const QVector<QVector<qreal>> columns = matrix->d_future_matrix->columns();
+        for (int i = 0; i < columns.size(); i++) {
+            target.column = i;
+            target.values = columns.at(i);
+            result << target;
+        }
+    } else if (Note *note = qobject_cast<Note *>(window)) {
+        if (!query.notes || query.mode != Text)
+            return result;
+        target.column = -1;
+        target.note = note->text();
+        result << target;
+    }
+    return result;
+}
+
+QList<ProjectSearch::Hit> ProjectSearch::search(const Target &target, const Query &query)
+{
+    QList<Hit> hits;
+    Hit hit;
+    hit.window = target.window;
+    hit.column = target.column;
+
+    if (target.column < 0) {
+        const QString &note = target.note;
+        QRegularExpressionMatchIterator matches = query.expression(false).globalMatch(note);
+        while (matches.hasNext()) {
+            const QRegularExpressionMatch match = matches.next();
+            if (match.capturedLength() == 0)
+                continue;
+            hit.row = match.capturedStart();
+            hit.column = match.capturedLength();
+            int line_start = hit.row > 0 ? note.lastIndexOf('\n', hit.row - 1) + 1 : 0;
+            int line_end = note.indexOf('\n', hit.row);
+            if (line_end < 0)
+                line_end = note.size();
+            hit.text = note.mid(line_start, line_end - line_start).trimmed();
+            hits << hit;
+        }
+        return hits;
+    }
+
+    QLocale locale;
+    switch (query.mode) {
+    case Text: {
+        const QRegularExpression expression = query.expression();
+        const QVector<bool> invalid = rowFlags(target.invalid, target.texts.size());
+        for (int row = 0; row < target.texts.size(); row++)
+            if (!invalid.at(row) && hasMatch(expression, target.texts.at(row))) {
+                hit.row = row;
+                hit.text = target.texts.at(row);
+                hits << hit;
+            }
+        break;
+    }
+    case NumberRange: {
+        const QVector<bool> invalid = rowFlags(target.invalid, target.values.size());
+        const double *values = target.values.constData();
+        for (int row = 0; row < target.values.size(); row++)
+            if (values[row] >= query.min && values[row] <= query.max && !invalid.at(row)) {
+                hit.row = row;
+                hit.text = locale.toString(values[row], 'g', 14);
+                hits << hit;
+            }
+        break;
+    }
+    case DateTimeRange: {
+        const QVector<bool> invalid = rowFlags(target.invalid, target.date_times.size());
+        for (int row = 0; row < target.date_times.size(); row++) {
+            const QDateTime &value = target.date_times.at(row);
+            if (value.isValid() && value >= query.from && value <= query.to && !invalid.at(row)) {
+                hit.row = row;
+                hit.text = locale.toString(value, QLocale::ShortFormat);
+                hits << hit;
+            }
+        }
+        break;
+    }
+    }
+    return hits;
+}
+
+int ProjectSearch::replace(const QList<MyWidget *> &windows, const Query &query,
+                           const QString &replacement)
+{
+    double number = 0.0;
+    if (query.mode == NumberRange && !toNumber(replacement, &number))
+        return 0;
+    const QDateTime date_time = toDateTime(replacement);
+    if (query.mode == DateTimeRange && !date_time.isValid())
+        return 0;
+    const QRegularExpression expression = query.expression();
+    auto matches = [&](double value) { return value >= query.min && value <= query.max; };
+
+    int count = 0;
+    for (MyWidget *window : windows) {
+        if (Table *table = qobject_cast<Table *>(window)) {
+            if (!query.tables || !table->d_future_table)
+                continue;
+            future::Table *future_table = table->d_future_table;
+            QVector<ColumnReplacement> columns;
+            for (int i = 0; i < future_table->columnCount(); i++) {
+                ColumnReplacement column;
+                column.column = future_table->column(i);
+                const SciDAVis::ColumnDataType type = column.column->dataType();
+                if (query.mode == NumberRange && type == SciDAVis::TypeDouble)
+                    column.values = column.column->values();
+                else if (query.mode == Text && type == SciDAVis::TypeQString)
+                    column.texts = column.column->texts();
+                else if (query.mode == DateTimeRange && type == SciDAVis::TypeQDateTime)
+                    column.date_times = column.column->dateTimes();
+                else
+                    continue;
+                column.invalid = column.column->invalidIntervals();
+                columns << column;
+            }
+            QtConcurrent::blockingMap(columns, [&](ColumnReplacement &column) {
+                const int rows = qMax(column.values.size(),
+                                      qMax(column.texts.size(), column.date_times.size()));
+                const QVector<bool> invalid = rowFlags(column.invalid, rows);
+                for (int row = 0; row < rows; row++) {
+                    if (invalid.at(row))
+                        continue;
+                    if (query.mode == NumberRange) {
+                        if (matches(column.values.at(row))) {
+                            column.values[row] = number;
+                            column.changed(row);
+                        }
+                    } else if (query.mode == Text) {
+                        if (replaceMatches(column.texts[row], expression, replacement) > 0)
+                            column.changed(row);
+                    } else {
+                        const QDateTime &value = column.date_times.at(row);
+                        if (value.isValid() && value >= query.from && value <= query.to) {
+                            column.date_times[row] = date_time;
+                            column.changed(row);
+                        }
+                    }
+                }
+            });
+
+            bool macro = false;
+            for (const ColumnReplacement &column : columns) {
+                if (column.count == 0)
+                    continue;
+                if (!macro) {
+                    future_table->beginMacro(
+                            QObject::tr("%1: replace cells").arg(future_table->name()));
+                    macro = true;
+                }
+                const int first = column.first, rows = column.last - column.first + 1;
+                if (query.mode == NumberRange)
+                    column.column->replaceValues(first, column.values.mid(first, rows));
+                else if (query.mode == Text)
+                    column.column->replaceTexts(first, column.texts.mid(first, rows));
+                else
+                    column.column->replaceDateTimes(first, column.date_times.mid(first, rows));
+                // replacing validates all cells in the range, including the skipped invalid ones
+                for (const Interval<int> &invalid : column.invalid) {
+                    Interval<int> skipped = Interval<int>::intersection(
+                            invalid, Interval<int>(column.first, column.last));
+                    if (skipped.isValid())
+                        column.column->setInvalid(skipped);
+                }
+                count += column.count;
+            }
+            if (macro)
+                future_table->endMacro();
+        } else if (Matrix *matrix = qobject_cast<Matrix *>(window)) {
+            if (!query.matrices || query.mode != NumberRange)
+                continue;
+            QVector<QVector<qreal>> columns = matrix->d_future_matrix->columns();
+            QVector<int> changed(columns.size(), 0);
+            QVector<int> indices(columns.size());
+            for (int i = 0; i < indices.size(); i++)
+                indices[i] = i;
+            // detach the list of columns here, not on the worker threads
+            QVector<qreal> *column_data = columns.data();
+            QtConcurrent::blockingMap(indices, [&](int i) {
+                QVector<qreal> &values = column_data[i];
+                for (int row = 0; row < values.size(); row++)
+                    if (matches(values.at(row))) {
+                        // detaches the column from the matrix on the first change only
+                        values[row] = number;
+                        changed[i]++;
+                    }
+            });
+            int matrix_count = 0;
+            for (int n : changed)
+                matrix_count += n;
+            if (matrix_count > 0)
+                matrix->d_future_matrix->replaceCells(columns);
+            count += matrix_count;
+        } else if (Note *note = qobject_cast<Note *>(window)) {
+            if (!query.notes || query.mode != Text)
+                continue;
+            const QRegularExpression passages = query.expression(false);
+            QString text = note->text();
+            const int note_count = replaceMatches(text, passages, replacement);
+            if (note_count == 0)
+                continue;
+            QTextCursor cursor(note->textWidget()->document());
+            cursor.beginEditBlock();
+            cursor.select(QTextCursor::Document);
+            cursor.insertText(text);
+            cursor.endEditBlock();
+            count += note_count;
+        }
+    }
+    return count;
+}
+
+bool ProjectSearch::toNumber(const QString &text, double *number)
+{
+    bool ok;
+    *number = QLocale().toDouble(text, &ok);
+    if (!ok)
+        *number = text.toDouble(&ok);
+    return ok;
+}
+
+QDateTime ProjectSearch::toDateTime(const QString &text)
+{
+    QDateTime result = QLocale().toDateTime(text, QLocale::ShortFormat);
+    if (!result.isValid())
+        result = QDateTime::fromString(text, Qt::ISODate);
+    return result;
+}
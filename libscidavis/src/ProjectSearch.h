@@ -0,0 +1,149 @@
+/***************************************************************************
+    File                 : ProjectSearch.h
+    Project              : SciDAVis
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 SciDAVis developers
+    Description          : Search and replace in the contents of project windows
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef PROJECTSEARCH_H
+#define PROJECTSEARCH_H
+
+#include "lib/Interval.h"
+
+#include <QDateTime>
+#include <QFutureWatcher>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QRegularExpression>
+#include <QStringList>
+#include <QVector>
+
+class MyWidget;
+
+//! Searches the cells of tables and matrices and the text of notes
+/**
+  start() takes snapshots of the windows to search (which share the data with
+  the windows instead of copying it) and scans them on the global thread pool,
+  one column, matrix column or note at a time. The hits of each of them are
+  reported by hitsFound() as soon as it has been scanned, so that a result list
+  can be filled while the search is still running.
+
+  What is searched depends on the mode of the query: text is looked for in text
+  columns and notes, number ranges in numeric columns and matrices and
+  date/time ranges in date-time columns. Invalid cells never match.
+  */
+class ProjectSearch : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Mode { Text, NumberRange, DateTimeRange };
+
+    //! What to search for
+    struct Query
+    {
+        Mode mode = Text;
+        //! For Text: the string or regular expression to look for
+        QString text;
+        bool regexp = false;
+        bool case_sensitive = false;
+        //! For Text: whether the whole cell has to match (does not apply to notes)
+        bool whole_cell = false;
+        //! For NumberRange: the closed interval of values to look for
+        double min = 0.0, max = 0.0;
+        //! For DateTimeRange: the closed interval of values to look for
+        QDateTime from, to;
+        //! Which kinds of windows to search
+        bool tables = true, matrices = true, notes = true;
+
+        //! Return the expression matching cells (or, if 'cells' is false, passages of notes)
+        QRegularExpression expression(bool cells = true) const;
+    };
+
+    //! A matching cell or passage of a note
+    struct Hit
+    {
+        QPointer<MyWidget> window;
+        //! The cell; for notes, row is the position of the match in the text and column its length
+        int row, column;
+        //! The content of the cell or the line of the note containing the match
+        QString text;
+    };
+
+    ProjectSearch(QObject *parent = 0);
+    ~ProjectSearch();
+
+    //! Start searching the contents of 'windows', canceling the running search
+    void start(const QList<MyWidget *> &windows, const Query &query);
+    //! Stop the running search; no more hits are reported
+    void cancel();
+    bool isRunning() const { return d_watcher.isRunning(); }
+
+    //! Replace everything matching 'query' in 'windows'
+    /**
+     * For Text queries, 'replacement' may refer to groups captured by the regular expression
+     * (\1, \2, ...); for range queries, it is the number or date/time to put into the matching
+     * cells. Each table and matrix is changed in one undo step, each note in one step of its
+     * editor. Returns the number of cells and passages replaced.
+     */
+    static int replace(const QList<MyWidget *> &windows, const Query &query,
+                       const QString &replacement);
+
+    //! Parse a number as entered in the current locale or in C notation
+    static bool toNumber(const QString &text, double *number);
+    //! Parse a date/time as entered in the current locale or in ISO 8601 notation
+    static QDateTime toDateTime(const QString &text);
+
+signals:
+    //! Report the hits in one column, matrix column or note
+    void hitsFound(const QList<ProjectSearch::Hit> &hits);
+    //! The search is complete or has been canceled
+    void finished();
+
+private slots:
+    void reportHits(int index);
+
+private:
+    //! Snapshot of a column, a matrix column or (with column < 0) a note
+    struct Target
+    {
+        QPointer<MyWidget> window;
+        int column;
+        QVector<qreal> values;
+        QStringList texts;
+        QList<QDateTime> date_times;
+        QList<Interval<int>> invalid;
+        QString note;
+    };
+
+    //! Return the snapshots of the parts of 'window' searched for 'query'
+    static QList<Target> targets(MyWidget *window, const Query &query);
+    //! Scan a snapshot (on a worker thread)
+    static QList<Hit> search(const Target &target, const Query &query);
+
+    QFutureWatcher<QList<Hit>> d_watcher;
+};
+
+#endif // ifndef PROJECTSEARCH_H
@@ -102,82 +102,119 @@ void QwtErrorPlotCurve::drawErrorBars(QPainter *painter, const QwtScaleMap &xMap
     else if (d_master_curve->type() == Graph::HorizontalBars)
         d_yOffset = ((QwtBarCurve *)d_master_curve)->dataOffset();
 
+    // lines are collected in batches and drawn with one call each; lines which are completely
+    // outside of the visible part of the device are skipped
+    const QRect visible = visibleRect(painter).adjusted(-pen().width(), -pen().width(),
+                                                        pen().width(), pen().width());
+    const int batchSize = 16384;
+    QVector<QLine> lines;
+    lines.reserve(qMin(3 * (to - from + 1), batchSize));
+    auto addLine = [&](int x1, int y1, int x2, int y2) {
+        if (qMax(x1, x2) < visible.left() || qMin(x1, x2) > visible.right()
+            || qMax(y1, y2) < visible.top() || qMin(y1, y2) > visible.bottom())
+            return;
+        lines.append(QLine(x1, y1, x2, y2));
+        if (lines.size() == batchSize) {
+            drawLines(painter, lines);
+            lines.clear();
+        }
+    };
+
+    const bool log_x = xMap.transformation()->type() == QwtScaleTransformation::Log10;
+    const bool log_y = yMap.transformation()->type() == QwtScaleTransformation::Log10;
+    const double *err_data = err.constData();
     for (int i = from; i <= to; i++) {
-        const int xi = xMap.transform(x(i) + d_xOffset);
-        const int yi = yMap.transform(y(i) + d_yOffset);
+        const double xv = x(i);
+        const double yv = y(i);
+        const int xi = xMap.transform(xv + d_xOffset);
+        const int yi = yMap.transform(yv + d_yOffset);
 
         if (type == Vertical) {
-            int y_plus = yMap.transform(y(i) + err[i]);
-            int y_minus = yMap.transform(y(i) - err[i]);
+            int y_plus = yMap.transform(yv + err_data[i]);
+            int y_minus = yMap.transform(yv - err_data[i]);
             bool y_minus_is_finite = true;
 
-            if (yMap.transformation()->type() == QwtScaleTransformation::Log10 && err[i] >= y(i)) {
+            if (log_y && err_data[i] >= yv) {
                 y_minus = yMap.transform(qMin(yMap.s1(), yMap.s2()));
                 y_minus_is_finite = false;
             }
 
+            // skip bars which are completely outside of the visible area
+            if (xi + cap / 2 < visible.left() || xi - cap / 2 > visible.right()
+                || qMax(qMax(y_plus, y_minus), yi) < visible.top()
+                || qMin(qMin(y_plus, y_minus), yi) > visible.bottom())
+                continue;
+
             // draw caps
             if (plus)
-                QwtPainter::drawLine(painter, xi - cap / 2, y_plus, xi + cap / 2, y_plus);
+                addLine(xi - cap / 2, y_plus, xi + cap / 2, y_plus);
             if (minus && y_minus_is_finite)
-                QwtPainter::drawLine(painter, xi - cap / 2, y_minus, xi + cap / 2, y_minus);
+                addLine(xi - cap / 2, y_minus, xi + cap / 2, y_minus);
 
             // draw vertical line
             if (through) {
                 if (plus && minus)
-                    QwtPainter::drawLine(painter, xi, y_minus, xi, y_plus);
+                    addLine(xi, y_minus, xi, y_plus);
                 else if (plus)
-                    QwtPainter::drawLine(painter, xi, yi, xi, y_plus);
+                    addLine(xi, yi, xi, y_plus);
                 else if (minus)
-                    QwtPainter::drawLine(painter, xi, y_minus, xi, yi);
+                    addLine(xi, y_minus, xi, yi);
             } else if (y_plus <= y_minus) {
                 if (plus && y_plus < yi - sh / 2)
-                    QwtPainter::drawLine(painter, xi, yi - sh / 2, xi, y_plus);
+                    addLine(xi, yi - sh / 2, xi, y_plus);
                 if (minus && y_minus > yi + sh / 2)
-                    QwtPainter::drawLine(painter, xi, yi + sh / 2, xi, y_minus);
+                    addLine(xi, yi + sh / 2, xi, y_minus);
             } else { // inverted scale
                 if (plus && y_plus > yi + sh / 2)
-                    QwtPainter::drawLine(painter, xi, yi + sh / 2, xi, y_plus);
+                    addLine(xi, yi + sh / 2, xi, y_plus);
                 if (minus && y_minus < yi - sh / 2)
-                    QwtPainter::drawLine(painter, xi, yi - sh / 2, xi, y_minus);
+                    addLine(xi, yi - sh / 2, xi, y_minus);
             }
         } else if (type == Horizontal) {
-            int x_plus = xMap.transform(x(i) + err[i]);
-            int x_minus = xMap.transform(x(i) - err[i]);
+            int x_plus = xMap.transform(xv + err_data[i]);
+            int x_minus = xMap.transform(xv - err_data[i]);
             bool x_minus_is_finite = true;
 
-            if (xMap.transformation()->type() == QwtScaleTransformation::Log10 && err[i] >= x(i)) {
+            if (log_x && err_data[i] >= xv) {
                 x_minus = xMap.transform(qMin(xMap.s1(), xMap.s2()));
                 x_minus_is_finite = false;
             }
 
+            // skip bars which are completely outside of the visible area
+            if (yi + cap / 2 < visible.top() || yi - cap / 2 > visible.bottom()
+                || qMax(qMax(x_plus, x_minus), xi) < visible.left()
+                || qMin(qMin(x_plus, x_minus), xi) > visible.right())
+                continue;
+
             // draw caps
             if (plus)
-                QwtPainter::drawLine(painter, x_plus, yi - cap / 2, x_plus, yi + cap / 2);
+                addLine(x_plus, yi - cap / 2, x_plus, yi + cap / 2);
             if (minus && x_minus_is_finite)
-                QwtPainter::drawLine(painter, x_minus, yi - cap / 2, x_minus, yi + cap / 2);
+                addLine(x_minus, yi - cap / 2, x_minus, yi + cap / 2);
 
             // draw vertical line
             if (through) {
                 if (plus && minus)
-                    QwtPainter::drawLine(painter, x_minus, yi, x_plus, yi);
+                    addLine(x_minus, yi, x_plus, yi);
                 else if (plus)
-                    QwtPainter::drawLine(painter, xi, yi, x_plus, yi);
+                    addLine(xi, yi, x_plus, yi);
                 else if (minus)
-                    QwtPainter::drawLine(painter, x_minus, yi, xi, yi);
+                    addLine(x_minus, yi, xi, yi);
             } else if (x_plus >= x_minus) {
                 if (plus && x_plus > xi + sh / 2)
-                    QwtPainter::drawLine(painter, xi + sh / 2, yi, x_plus, yi);
+                    addLine(xi + sh / 2, yi, x_plus, yi);
                 if (minus && x_minus < xi - sh / 2)
-                    QwtPainter::drawLine(painter, xi - sh / 2, yi, x_minus, yi);
+                    addLine(xi - sh / 2, yi, x_minus, yi);
             } else { // inverted scale
                 if (plus && x_plus < xi - sh / 2)
-                    QwtPainter::drawLine(painter, xi - sh / 2, yi, x_plus, yi);
+                    addLine(xi - sh / 2, yi, x_plus, yi);
                 if (minus && x_minus > xi + sh / 2)
-                    QwtPainter::drawLine(painter, xi + sh / 2, yi, x_minus, yi);
+                    addLine(xi + sh / 2, yi, x_minus, yi);
             }
         }
     }
+    if (!lines.isEmpty())
+        drawLines(painter, lines);
 }
 
 double QwtErrorPlotCurve::errorValue(int i)
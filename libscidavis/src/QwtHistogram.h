@@ -28,6 +28,8 @@
  ***************************************************************************/
 #include "QwtBarCurve.h"
 
+struct HistogramData;
+
 //! Histogram class
 class QwtHistogram : public QwtBarCurve
 {
@@ -55,6 +57,8 @@ public:
 private:
     void draw(QPainter *painter, const QwtScaleMap &xMap, const QwtScaleMap &yMap, int from,
               int to) const;
+    //! Display 'histogram' and take over its binning and statistics; returns false if it is empty
+    bool setHistogram(const HistogramData &histogram);
 
     bool d_autoBin;
     double d_bin_size, d_begin, d_end;
@@ -0,0 +1,204 @@
+/***************************************************************************
+    File                 : RowPredicate.cpp
+    Project              : SciDAVis
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 SciDAVis developers
+    Description          : Condition selecting rows of a table
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "RowPredicate.h"
+#include "CompiledFormula.h"
+#include "core/column/Column.h"
+#include "table/future_Table.h"
+
+#include <QHash>
+#include <QRegularExpression>
+#include <QtConcurrentMap>
+
+#include <cmath>
+#include <limits>
+
+namespace {
+//! Number of rows evaluated by one task
+const int BlockRows = 16384;
+
+//! Return 'text' with every match of 'expression' replaced by replacement(match)
+template<class F>
+QString replaceMatches(const QString &text, const QRegularExpression &expression, F replacement)
+{
+    QString result;
+    int end = 0;
+    QRegularExpressionMatchIterator matches = expression.globalMatch(text);
+    while (matches.hasNext()) {
+        const QRegularExpressionMatch match = matches.next();
+        result += text.mid(end, match.capturedStart() - end) + replacement(match);
+        end = match.capturedEnd();
+    }
+    return result + text.mid(end);
+}
+} // namespace
+
+RowPredicate::RowPredicate(const QString &condition, const future::Table *table)
+    : d_condition(condition)
+{
+    d_variables << "_i";
+    QHash<QString, SciDAVis::ColumnDataType> types;
+    for (int i = 0; i < table->columnCount(); i++)
+        types[table->column(i)->name()] = table->column(i)->dataType();
+
+    // check that 'name' is a column of type 'type' and return its variable
+    auto variable = [&](const QString &name, SciDAVis::ColumnDataType type,
+                        const QString &text = QString()) {
+        if (!d_error.isEmpty())
+            return QString();
+        if (!types.contains(name))
+            d_error = QObject::tr("There is no column %1.").arg(name);
+        else if (types.value(name) == SciDAVis::TypeQString && type != SciDAVis::TypeQString)
+            d_error = QObject::tr("Column %1 contains text, which can only be compared with a "
+                                  "string by == or !=.")
+                              .arg(name);
+        else if (types.value(name) != type)
+            d_error = QObject::tr("Column %1 is neither numeric nor does it contain text.")
+                              .arg(name);
+        else
+            return operand(name, type == SciDAVis::TypeQString, text);
+        return QString();
+    };
+
+    // comparisons of text columns with strings
+    QString formula = replaceMatches(
+            condition,
+            QRegularExpression("(?:col\\(\"([^\"]*)\"\\)|\\b([A-Za-z_]\\w*))\\s*(==|!=)\\s*"
+                               "\"([^\"]*)\""),
+            [&](const QRegularExpressionMatch &match) {
+                QString name = match.capturedStart(1) >= 0 ? match.captured(1) : match.captured(2);
+                return "(" + variable(name, SciDAVis::TypeQString, match.captured(4)) + " "
+                        + match.captured(3) + " 1)";
+            });
+    // col("name") and names of numeric columns
+    formula = replaceMatches(formula, QRegularExpression("col\\(\"([^\"]*)\"\\)"),
+                             [&](const QRegularExpressionMatch &match) {
+                                 return variable(match.captured(1), SciDAVis::TypeDouble);
+                             });
+    formula = replaceMatches(
+            formula, QRegularExpression("(?<![\\w.])([A-Za-z_]\\w*)\\b(?!\\s*\\()"),
+            [&](const QRegularExpressionMatch &match) {
+                const QString name = match.captured(1);
+                if (types.contains(name))
+                    return variable(name, SciDAVis::TypeDouble);
+                if (name == "i")
+                    return QString("_i");
+                return name;
+            });
+    if (!d_error.isEmpty())
+        return;
+    d_formula = formula;
+    if (!CompiledFormula::cached(d_formula, d_variables, &d_error) && d_error.isEmpty())
+        d_error = QObject::tr("Invalid condition.");
+}
+
+QString RowPredicate::operand(const QString &column, bool is_text, const QString &text)
+{
+    int index = 0;
+    while (index < d_operands.size()
+           && !(d_operands.at(index).column == column && d_operands.at(index).is_text == is_text
+                && d_operands.at(index).text == text))
+        index++;
+    if (index == d_operands.size()) {
+        d_operands << Operand { column, text, is_text };
+        d_variables << QString("_v%1").arg(index);
+    }
+    return d_variables.at(index + 1);
+}
+
+bool RowPredicate::refersTo(const QString &column_name) const
+{
+    for (const Operand &operand : d_operands)
+        if (operand.column == column_name)
+            return true;
+    return false;
+}
+
+QVector<char> RowPredicate::evaluate(const future::Table *table, int first, int last) const
+{
+    const int rows = qMax(last - first + 1, 0);
+    QVector<char> result(rows, 0);
+    if (!isValid() || rows == 0)
+        return result;
+
+    struct Snapshot
+    {
+        QVector<qreal> values;
+        QStringList texts;
+        //! Invalid flags of the rows first, ..., last
+        QVector<bool> invalid;
+    };
+    QVector<Snapshot> snapshots(d_operands.size());
+    for (int j = 0; j < d_operands.size(); j++) {
+        const Column *column = table->column(d_operands.at(j).column, false);
+        if (!column)
+            return result;
+        Snapshot &snapshot = snapshots[j];
+        if (d_operands.at(j).is_text)
+            snapshot.texts = column->texts();
+        else
+            snapshot.values = column->values();
+        snapshot.invalid.fill(false, rows);
+        for (const Interval<int> &invalid : column->invalidIntervals())
+            for (int row = qMax(invalid.start(), first); row <= qMin(invalid.end(), last); row++)
+                snapshot.invalid[row - first] = true;
+    }
+
+    QVector<int> blocks((rows + BlockRows - 1) / BlockRows);
+    for (int i = 0; i < blocks.size(); i++)
+        blocks[i] = i;
+    char *flags = result.data();
+    const Snapshot *operands = snapshots.constData();
+    QtConcurrent::blockingMap(blocks, [&](int block) {
+        // compiled once per thread
+        QSharedPointer<CompiledFormula> formula = CompiledFormula::cached(d_formula, d_variables);
+        if (!formula)
+            return;
+        double *variables = formula->variables();
+        const int end = qMin(rows, (block + 1) * BlockRows);
+        for (int i = block * BlockRows; i < end; i++) {
+            const int row = first + i;
+            variables[0] = row + 1;
+            for (int j = 0; j < d_operands.size(); j++) {
+                const Snapshot &operand = operands[j];
+                if (d_operands.at(j).is_text)
+                    variables[j + 1] = !operand.invalid.at(i) && row < operand.texts.size()
+                                    && operand.texts.at(row) == d_operands.at(j).text
+                            ? 1.0
+                            : 0.0;
+                else
+                    variables[j + 1] = !operand.invalid.at(i) && row < operand.values.size()
+                            ? operand.values.at(row)
+                            : std::numeric_limits<double>::quiet_NaN();
+            }
+            const double value = formula->evaluate();
+            flags[i] = value != 0.0 && !std::isnan(value);
+        }
+    });
+    return result;
+}
@@ -0,0 +1,94 @@
+/***************************************************************************
+    File                 : RowPredicate.h
+    Project              : SciDAVis
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 SciDAVis developers
+    Description          : Condition selecting rows of a table
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef ROWPREDICATE_H
+#define ROWPREDICATE_H
+
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+namespace future {
+class Table;
+}
+
+//! A condition on the cells of a row, like temp > 300 && status == "ok"
+/**
+  Columns are referred to by their names (if they are valid identifiers) or as
+  col("name"), i is the row number, starting at 1. Numeric columns can be used
+  in any expression of MyParser; text columns can only be compared with a
+  string by == or !=. Invalid cells have the value NaN (or equal no string).
+  A row is selected if the condition evaluates to a number other than 0.
+
+  The condition is translated into a CompiledFormula in one variable per
+  column, which is evaluated in parallel on blocks of rows.
+  */
+class RowPredicate
+{
+public:
+    RowPredicate() { }
+    //! Compile 'condition' for the columns of 'table'; see isValid()
+    RowPredicate(const QString &condition, const future::Table *table);
+
+    bool isValid() const { return d_error.isEmpty() && !d_formula.isEmpty(); }
+    //! Return why the condition could not be compiled
+    QString errorString() const { return d_error; }
+    const QString &condition() const { return d_condition; }
+    //! Whether the condition refers to the column with the given name
+    bool refersTo(const QString &column_name) const;
+    //! Return a flag per row first, ..., last of 'table' telling whether it satisfies the condition
+    /**
+     * The columns are snapshot on the calling thread. Rows beyond the end of the columns are
+     * evaluated as if all of their cells were invalid.
+     */
+    QVector<char> evaluate(const future::Table *table, int first, int last) const;
+
+private:
+    //! A column of the table the condition refers to
+    struct Operand
+    {
+        QString column;
+        //! For text columns: the string the cells are compared with
+        QString text;
+        bool is_text;
+    };
+
+    //! Return the operand for 'column' (and 'text'), adding it if needed; returns its variable
+    QString operand(const QString &column, bool is_text, const QString &text = QString());
+
+    QString d_condition;
+    //! The condition, as formula in the variables d_variables
+    QString d_formula;
+    //! The row number, followed by one variable per operand
+    QStringList d_variables;
+    QList<Operand> d_operands;
+    QString d_error;
+};
+
+#endif // ifndef ROWPREDICATE_H
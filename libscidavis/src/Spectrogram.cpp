@@ -39,7 +39,8 @@ Spectrogram::Spectrogram()
       d_matrix(0),
       color_axis(QwtPlot::yRight),
       color_map_policy(Default),
-      color_map(QwtLinearColorMap())
+      color_map(QwtLinearColorMap()),
+      d_contour_version(0)
 {
 }
 
@@ -48,7 +49,8 @@ Spectrogram::Spectrogram(Matrix *m)
       d_matrix(m),
       color_axis(QwtPlot::yRight),
       color_map_policy(Default),
-      color_map(QwtLinearColorMap())
+      color_map(QwtLinearColorMap()),
+      d_contour_version(0)
 {
     setData(MatrixData(m));
     double step = fabs(data().range().maxValue() - data().range().minValue()) / 5.0;
@@ -294,13 +296,30 @@ QString Spectrogram::saveToString()
     return s + "</spectrogram>\n";
 }
 
-double MatrixData::value(double x, double y) const
+QImage Spectrogram::renderImage(const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+                                const QwtDoubleRect &area) const
 {
-    int i = abs((int)floor((y - y_start) / dy - 1));
-    int j = abs((int)floor((x - x_start) / dx));
+    const MatrixData *matrix_data = dynamic_cast<const MatrixData *>(&data());
+    if (!matrix_data)
+        return QwtPlotSpectrogram::renderImage(xMap, yMap, area);
+    if (area.isEmpty())
+        return QImage();
+    return d_tiles.render(matrix_data->raster(), colorMap(), xMap, yMap,
+                          transform(xMap, yMap, area));
+}
 
-    if (d_m && i < n_rows && j < n_cols)
-        return d_m[i][j];
-    else
-        return 0.0;
+QwtRasterData::ContourLines Spectrogram::renderContourLines(const QwtDoubleRect &rect,
+                                                            const QSize &raster) const
+{
+    const MatrixData *matrix_data = dynamic_cast<const MatrixData *>(&data());
+    if (!matrix_data)
+        return QwtPlotSpectrogram::renderContourLines(rect, raster);
+
+    const QwtValueList levels = contourLevels();
+    if (matrix_data->raster().version() != d_contour_version || levels != d_contour_levels) {
+        d_contour_lines = matrix_data->raster().contourLines(levels);
+        d_contour_version = matrix_data->raster().version();
+        d_contour_levels = levels;
+    }
+    return d_contour_lines;
 }
@@ -30,6 +30,7 @@
 #define SPECTROGRAM_H
 
 #include "Matrix.h"
+#include "MatrixRaster.h"
 #include <qwt_raster_data.h>
 #include <qwt_plot.h>
 #include <qwt_plot_spectrogram.h>
@@ -73,6 +74,17 @@ public:
     ColorMapPolicy colorMapPolicy() { return color_map_policy; };
 
 protected:
+    //! Render the image from tiles cached across repaints, see MatrixRasterTiles
+    QImage renderImage(const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+                       const QwtDoubleRect &area) const override;
+    //! Return the isolines of the whole matrix, cached per matrix version and set of levels
+    /**
+     * The lines do not depend on the visible area, so replots only transform them. Qwt 5 draws
+     * the isolines without labels, so there is no label placement to derive from them.
+     */
+    QwtRasterData::ContourLines renderContourLines(const QwtDoubleRect &rect,
+                                                   const QSize &raster) const override;
+
     //! Pointer to the source data matrix
     Matrix *d_matrix;
 
@@ -83,90 +95,44 @@ protected:
     ColorMapPolicy color_map_policy;
 
     QwtLinearColorMap color_map;
+
+    //! Color mapped tiles of the image
+    mutable MatrixRasterTiles d_tiles;
+    //! Cached isolines, with the matrix version and levels they were computed for
+    mutable QwtRasterData::ContourLines d_contour_lines;
+    mutable quint64 d_contour_version;
+    mutable QwtValueList d_contour_levels;
 };
 
+//! Raster data of a spectrogram, backed by a shared MatrixRaster snapshot
+/**
+ * Copies share the snapshot, so copy() (which Qwt calls e.g. in setData()) is cheap.
+ */
 class MatrixData : public QwtRasterData
 {
 public:
-    MatrixData(Matrix *m) : QwtRasterData(m->boundingRect()), d_matrix(m)
+    MatrixData(Matrix *m) : MatrixData(MatrixRaster::snapshot(m)) { }
+    MatrixData(const QSharedPointer<const MatrixRaster> &raster)
+        : QwtRasterData(raster->boundingRect()), d_raster(raster)
     {
-        n_rows = d_matrix->numRows();
-        n_cols = d_matrix->numCols();
-
-        d_m = new double *[n_rows];
-        for (int l = 0; l < n_rows; ++l)
-            d_m[l] = new double[n_cols];
-
-        min_z = std::numeric_limits<double>::max();
-        max_z = -std::numeric_limits<double>::max();
-        for (int i = 0; i < n_rows; i++)
-            for (int j = 0; j < n_cols; j++) {
-                // replace NaNs and Infs with average of neighbours
-                if (std::isfinite(d_matrix->cell(i, j)))
-                    d_m[i][j] = d_matrix->cell(i, j);
-                else {
-                    double av = 0;
-                    unsigned cnt = 0;
-                    for (int ii = -1; ii <= 1; ii += 2)
-                        for (int jj = -1; jj <= 1; jj += 2)
-                            if (std::isfinite(d_matrix->cell(i + ii, j + jj))) {
-                                av += d_matrix->cell(i + ii, j + jj);
-                                cnt++;
-                            }
-                    if (cnt > 0)
-                        av /= cnt;
-                    d_m[i][j] = av;
-                }
-                min_z = std::min(min_z, d_m[i][j]);
-                max_z = std::max(max_z, d_m[i][j]);
-            }
-
-        // m->range(&min_z, &max_z);
-
-        x_start = d_matrix->xStart();
-        dx = (d_matrix->xEnd() - x_start) / (double)n_cols;
-
-        y_start = d_matrix->yStart();
-        dy = (d_matrix->yEnd() - y_start) / (double)n_rows;
     }
 
-    ~MatrixData()
-    {
-        for (int i = 0; i < n_rows; i++)
-            delete[] d_m[i];
-
-        delete[] d_m;
-    };
+    virtual QwtRasterData *copy() const { return new MatrixData(d_raster); }
 
-    virtual QwtRasterData *copy() const { return new MatrixData(d_matrix); }
+    virtual QwtDoubleInterval range() const { return d_raster->range(); }
 
-    virtual QwtDoubleInterval range() const { return QwtDoubleInterval(min_z, max_z); }
+    virtual QSize rasterHint(const QwtDoubleRect &) const
+    {
+        return QSize(d_raster->columnCount(), d_raster->rowCount());
+    }
 
-    virtual QSize rasterHint(const QwtDoubleRect &) const { return QSize(n_cols, n_rows); }
+    virtual double value(double x, double y) const { return d_raster->value(x, y); }
 
-    virtual double value(double x, double y) const;
+    const MatrixRaster &raster() const { return *d_raster; }
 
 private:
-    //! Pointer to the source data matrix
-    Matrix *d_matrix;
-
-    //! Vector used to store in memory the data from the source matrix window
-    double **d_m;
-
-    //! Data size
-    int n_rows, n_cols;
-
-    //! Min and max values in the source data matrix
-    double min_z, max_z;
-
-    //! Data resolution in x(columns) and y(rows)
-    double dx, dy;
-
-    //! X axis left value in the data matrix
-    double x_start;
-
-    //! Y axis bottom value in the data matrix
-    double y_start;
+    //! Snapshot of the source data matrix
+    QSharedPointer<const MatrixRaster> d_raster;
 };
 
 #endif
@@ -37,6 +37,7 @@
 #include <QLabel>
 #include <QLineEdit>
 #include <QComboBox>
+#include <QCheckBox>
 
 SurfaceDialog::SurfaceDialog(QWidget *parent, Qt::WindowFlags fl) : QDialog(parent, fl)
 {
@@ -101,6 +102,10 @@ SurfaceDialog::SurfaceDialog(QWidget *parent, Qt::WindowFlags fl) : QDialog(pare
     bl3->addWidget(gb2);
     bl3->addWidget(gb3);
 
+    boxAdaptive = new QCheckBox(tr("&Adaptive mesh"));
+    boxAdaptive->setToolTip(tr("Sample the function at full resolution only where the surface "
+                               "is curved and interpolate elsewhere"));
+
     buttonClear = new QPushButton(tr("Clear &list"));
     buttonOk = new QPushButton(tr("&OK"));
     buttonOk->setDefault(true);
@@ -116,6 +121,7 @@ SurfaceDialog::SurfaceDialog(QWidget *parent, Qt::WindowFlags fl) : QDialog(pare
     QVBoxLayout *vl = new QVBoxLayout(this);
     vl->addLayout(bl1);
     vl->addLayout(bl3);
+    vl->addWidget(boxAdaptive);
     vl->addLayout(bl2);
 
     resize(vl->minimumSize());
@@ -147,6 +153,11 @@ void SurfaceDialog::setLimits(double xs, double xe, double ys, double ye, double
     boxZTo->setText(QString::number(ze));
 }
 
+void SurfaceDialog::setAdaptiveRefinement(bool on)
+{
+    boxAdaptive->setChecked(on);
+}
+
 void SurfaceDialog::accept()
 {
     QString Xfrom = boxXFrom->text().toLower();
@@ -242,7 +253,8 @@ void SurfaceDialog::accept()
     }
 
     if (!error) {
-        emit options(boxFunction->currentText(), fromX, toX, fromY, toY, fromZ, toZ);
+        emit options(boxFunction->currentText(), fromX, toX, fromY, toY, fromZ, toZ,
+                     boxAdaptive->isChecked());
         emit custom3DToolBar();
 
         ApplicationWindow *app = (ApplicationWindow *)this->parent();
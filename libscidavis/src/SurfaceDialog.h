@@ -35,6 +35,7 @@
 class QPushButton;
 class QLineEdit;
 class QComboBox;
+class QCheckBox;
 
 //! Define surface plot dialog
 class SurfaceDialog : public QDialog
@@ -51,9 +52,10 @@ public slots:
     void clearList();
     void setFunction(const QString &s);
     void setLimits(double xs, double xe, double ys, double ye, double zs, double ze);
+    void setAdaptiveRefinement(bool on);
 
 signals:
-    void options(const QString &, double, double, double, double, double, double);
+    void options(const QString &, double, double, double, double, double, double, bool);
     void clearFunctionsList();
     void custom3DToolBar();
 
@@ -68,6 +70,7 @@ private:
     QLineEdit *boxYTo;
     QLineEdit *boxZFrom;
     QLineEdit *boxZTo;
+    QCheckBox *boxAdaptive;
 };
 
 #endif
@@ -128,7 +128,8 @@ void Table::init()
             SLOT(handleColumnsAboutToBeRemoved(int, int)));
     connect(d_future_table, SIGNAL(columnsRemoved(int, int)), this,
             SLOT(handleColumnsRemoved(int, int)));
-    connect(d_future_table, SIGNAL(rowsInserted(int, int)), this, SLOT(handleRowChange()));
+    connect(d_future_table, SIGNAL(rowsInserted(int, int)), this,
+            SLOT(handleRowsInserted(int, int)));
     connect(d_future_table, SIGNAL(rowsRemoved(int, int)), this, SLOT(handleRowChange()));
     connect(d_future_table, SIGNAL(dataChanged(int, int, int, int)), this,
             SLOT(handleColumnChange(int, int, int, int)));
@@ -151,6 +152,30 @@ void Table::init()
             SLOT(handleAspectDescriptionAboutToChange(const AbstractAspect *)));
 }
 
+void Table::setReadOnly()
+{
+#ifdef LEGACY_CODE_0_2_x
+    static_cast<TableModel *>(d_view_widget->model())->setReadOnly(true);
+    d_hide_button->hide();
+    d_control_tabs->hide();
+
+    future::Table *t = d_future_table;
+    for (QAction *action :
+         { t->action_cut_selection, t->action_paste_into_selection,
+           t->action_paste_into_selection_transposed, t->action_set_formula,
+           t->action_clear_selection, t->action_recalculate, t->action_fill_row_numbers,
+           t->action_fill_random, t->action_add_column, t->action_clear_table,
+           t->action_sort_table, t->action_dimensions_dialog, t->action_insert_columns,
+           t->action_remove_columns, t->action_clear_columns, t->action_add_columns,
+           t->action_normalize_columns, t->action_normalize_selection, t->action_normalize_sum,
+           t->action_standardize, t->action_scale_columns, t->action_cumulative_sum,
+           t->action_difference, t->action_column_arithmetic, t->action_sort_columns,
+           t->action_type_format, t->action_insert_rows, t->action_remove_rows,
+           t->action_clear_rows, t->action_add_rows })
+        action->setEnabled(false);
+#endif
+}
+
 void Table::handleChange()
 {
     emit modifiedWindow(this);
@@ -164,8 +189,8 @@ void Table::handleColumnChange(int first, int count)
 
 void Table::handleColumnChange(int top, int left, int bottom, int right)
 {
-    Q_UNUSED(top);
-    Q_UNUSED(bottom);
+    for (int i = left; i <= right; i++)
+        emit modifiedRows(this, colName(i), top, bottom);
     handleColumnChange(left, right - left + 1);
 }
 
@@ -187,6 +212,15 @@ void Table::handleRowChange()
         emit modifiedData(this, colName(i));
 }
 
+void Table::handleRowsInserted(int before, int count)
+{
+    // rows are only appended to the table, the columns announce their own changes
+    for (int i = 0; i < numCols(); i++) {
+        emit modifiedRows(this, colName(i), before, before + count - 1);
+        emit modifiedData(this, colName(i));
+    }
+}
+
 void Table::setBackgroundColor(const QColor &col)
 {
     QPalette palette;
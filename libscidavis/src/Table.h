@@ -129,6 +129,7 @@ public slots:
     void setNumCols(int cols);
     void handleChange();
     void handleRowChange();
+    void handleRowsInserted(int before, int count);
     void handleColumnChange(int, int);
     void handleColumnChange(int, int, int, int);
     void handleColumnsAboutToBeRemoved(int, int);
@@ -291,9 +292,15 @@ signals:
     void aboutToRemoveCol(const QString &);
     void removedCol(const QString &);
     void modifiedData(Table *, const QString &);
+    //! Emitted before modifiedData() if only the given rows of the column have changed
+    void modifiedRows(Table *, const QString &, int first, int last);
     void resizedTable(QWidget *);
     void showContextMenu(bool selection);
 
+protected:
+    //! Hide the controls and disable all actions changing the data, for tables derived from others
+    void setReadOnly();
+
 protected slots:
     void applyFormula();
     void addFunction();
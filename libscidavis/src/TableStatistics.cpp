@@ -38,47 +38,18 @@
 #include <QList>
 #include <QMenu>
 #include <QContextMenuEvent>
-#include <gsl/gsl_vector.h>
-#include <gsl/gsl_statistics.h>
+#include <QtConcurrentMap>
 
 TableStatistics::TableStatistics(ScriptingEnv *env, QWidget *parent, Table *base, Type t,
                                  QList<int> targets)
     : Table(env, 1, 1, "", parent, ""), d_base(base), d_type(t), d_targets(targets)
 {
+    setReadOnly();
 #ifdef LEGACY_CODE_0_2_x
-    static_cast<TableModel *>(d_view_widget->model())->setReadOnly(true);
-    d_hide_button->hide();
-    d_control_tabs->hide();
-
-    d_future_table->action_cut_selection->setEnabled(false);
-    d_future_table->action_paste_into_selection->setEnabled(false);
-    d_future_table->action_paste_into_selection_transposed->setEnabled(false);
-    d_future_table->action_set_formula->setEnabled(false);
-    d_future_table->action_clear_selection->setEnabled(false);
-    d_future_table->action_recalculate->setEnabled(false);
-    d_future_table->action_fill_row_numbers->setEnabled(false);
-    d_future_table->action_fill_random->setEnabled(false);
-    d_future_table->action_add_column->setEnabled(false);
-    d_future_table->action_clear_table->setEnabled(false);
-    d_future_table->action_sort_table->setEnabled(false);
-    d_future_table->action_dimensions_dialog->setEnabled(false);
-    d_future_table->action_insert_columns->setEnabled(false);
-    d_future_table->action_remove_columns->setEnabled(false);
-    d_future_table->action_clear_columns->setEnabled(false);
-    d_future_table->action_add_columns->setEnabled(false);
-    d_future_table->action_normalize_columns->setEnabled(false);
-    d_future_table->action_normalize_selection->setEnabled(false);
-    d_future_table->action_sort_columns->setEnabled(false);
     d_future_table->action_statistics_columns->setEnabled(false);
-    d_future_table->action_type_format->setEnabled(false);
     d_future_table->action_edit_description->setEnabled(false);
-    d_future_table->action_insert_rows->setEnabled(false);
-    d_future_table->action_remove_rows->setEnabled(false);
-    d_future_table->action_clear_rows->setEnabled(false);
-    d_future_table->action_add_rows->setEnabled(false);
     d_future_table->action_statistics_rows->setEnabled(false);
     d_future_table->action_toggle_tabbar->setEnabled(false);
-
 #endif
     setCaptionPolicy(MyWidget::Both);
     if (d_type == TableStatistics::StatRow) {
@@ -151,8 +122,11 @@ TableStatistics::TableStatistics(ScriptingEnv *env, QWidget *parent, Table *base
         pFilter->setNumDigits(0);
         pFilter->setNumericFormat('f');
 
+        d_column_blocks.resize(d_targets.size());
+        QList<int> destRows;
         for (int i = 0; i < d_targets.size(); i++)
-            update(d_base, d_base->colName(d_targets.at(i)));
+            destRows << i;
+        updateColumnStatistics(destRows, QHash<int, Interval<int>>());
     }
     setColPlotDesignation(0, SciDAVis::X);
 }
@@ -162,125 +136,182 @@ void TableStatistics::update(Table *t, const QString &colName)
     if (t != d_base)
         return;
 
+    // rows announced by markModifiedRows(), or all rows
+    Interval<int> changed = d_modified_rows.take(colName);
+
     if (d_type == TableStatistics::StatRow) {
-        int columns = d_base->numCols();
-        if (columns > 0) {
-
-            for (int destRow = 0; destRow < d_targets.size(); destRow++) {
-                int srcRow = d_targets[destRow];
-
-                QList<int> validCells;
-                for (int col = 0; col < columns; col++) {
-                    if (d_base->column(col)->rowCount() > srcRow
-                        && d_base->column(col)->columnMode() == SciDAVis::ColumnMode::Numeric
-                        && !d_base->column(col)->isInvalid(srcRow))
-                        validCells.append(col);
-                }
-
-                column(0)->setValueAt(destRow, srcRow + 1);
-                column(1)->setValueAt(destRow, columns);
-                if (validCells.count() > 0) {
-                    double *data = new double[validCells.count()];
-                    gsl_vector *y = gsl_vector_alloc(validCells.count());
-
-                    int index = 0;
-                    foreach (int col, validCells) {
-                        double val = d_base->column(col)->valueAt(srcRow);
-                        gsl_vector_set(y, index, val);
-                        data[index++] = val;
-                    }
-                    double mean = gsl_stats_mean(data, 1, validCells.count());
-                    double min, max;
-                    gsl_vector_minmax(y, &min, &max);
-
-                    column(2)->setValueAt(destRow, mean);
-                    column(3)->setValueAt(destRow, gsl_stats_sd(data, 1, validCells.count()));
-                    column(4)->setValueAt(destRow, gsl_stats_variance(data, 1, validCells.count()));
-                    column(5)->setValueAt(destRow, mean * validCells.count());
-                    column(6)->setValueAt(destRow, max);
-                    column(7)->setValueAt(destRow, min);
-                    column(8)->setValueAt(destRow, validCells.count());
-
-                    gsl_vector_free(y);
-                    delete[] data;
-                } else {
-                    for (int i = 2; i < 8; i++)
-                        column(i)->setInvalid(destRow, true);
-                    column(8)->setValueAt(destRow, 0);
-                }
-            }
+        // adding, removing or converting a column changes the counts shown in all rows
+        QList<int> numeric;
+        for (int col = 0; col < d_base->numCols(); col++)
+            if (d_base->column(col)->columnMode() == SciDAVis::ColumnMode::Numeric)
+                numeric << col;
+        if (d_base->numCols() != d_columns || numeric != d_numeric_columns) {
+            changed = Interval<int>();
+            d_columns = d_base->numCols();
+            d_numeric_columns = numeric;
         }
+
+        QVector<int> destRows;
+        for (int destRow = 0; destRow < d_targets.size(); destRow++)
+            if (!changed.isValid() || changed.contains(d_targets.at(destRow)))
+                destRows << destRow;
+        updateRowStatistics(destRows);
     } else if (d_type == TableStatistics::StatColumn) {
-        for (int destRow = 0; destRow < d_targets.size(); destRow++) {
+        QList<int> destRows;
+        QHash<int, Interval<int>> changedRows;
+        for (int destRow = 0; destRow < d_targets.size(); destRow++)
             if (colName == QString(d_base->name()) + "_" + d_base->colLabel(d_targets[destRow])) {
-                int colIndex = d_base->colIndex(colName);
-                Column *col = d_base->column(colIndex);
-
-                if (col->columnMode() != SciDAVis::ColumnMode::Numeric)
-                    return;
-
-                int rows = col->rowCount();
-                if (rows == 0)
-                    return;
-
-                QList<int> validCells;
-                for (int row = 0; row < rows; ++row) {
-                    if (!col->isInvalid(row))
-                        validCells.append(row);
-                }
-                if (validCells.count() == 0)
-                    return;
-
-                double *data = new double[validCells.count()];
-                gsl_vector *y = gsl_vector_alloc(validCells.count());
-
-                int minIndex = validCells.at(0);
-                int maxIndex = validCells.at(0);
-                double val = col->valueAt(validCells.at(0));
-                gsl_vector_set(y, 0, val);
-                data[0] = val;
-                double min = val, max = val;
-                int index = 0;
-                foreach (int row, validCells) {
-                    if (index > 0) {
-                        val = col->valueAt(row);
-                        gsl_vector_set(y, index, val);
-                        data[index] = val;
-                        if (val < min) {
-                            min = val;
-                            minIndex = row;
-                        }
-                        if (val > max) {
-                            max = val;
-                            maxIndex = row;
-                        }
-                    }
-                    index++;
-                }
-                double mean = gsl_stats_mean(data, 1, validCells.count());
-
-                column(0)->setTextAt(destRow, d_base->colLabel(colIndex));
-                column(1)->setTextAt(destRow, "[1:" + QString::number(rows) + "]");
-                column(2)->setValueAt(destRow, mean);
-                column(3)->setValueAt(destRow, gsl_stats_sd(data, 1, validCells.count()));
-                column(4)->setValueAt(destRow, gsl_stats_variance(data, 1, validCells.count()));
-                column(5)->setValueAt(destRow, mean * validCells.count());
-                column(6)->setValueAt(destRow, maxIndex + 1);
-                column(7)->setValueAt(destRow, max);
-                column(8)->setValueAt(destRow, minIndex + 1);
-                column(9)->setValueAt(destRow, min);
-                column(10)->setValueAt(destRow, validCells.count());
-
-                gsl_vector_free(y);
-                delete[] data;
+                destRows << destRow;
+                changedRows[destRow] = changed;
             }
-        }
+        updateColumnStatistics(destRows, changedRows);
     }
 
     for (int i = 0; i < numCols(); i++)
         emit modifiedData(this, Table::colName(i));
 }
 
+void TableStatistics::markModifiedRows(Table *t, const QString &colName, int first, int last)
+{
+    if (t != d_base)
+        return;
+    Interval<int> rows(first, last);
+    if (d_modified_rows.contains(colName))
+        rows = Interval<int>(qMin(first, d_modified_rows[colName].start()),
+                             qMax(last, d_modified_rows[colName].end()));
+    d_modified_rows[colName] = rows;
+}
+
+void TableStatistics::updateColumnStatistics(const QList<int> &destRows,
+                                             const QHash<int, Interval<int>> &changed)
+{
+    struct Job
+    {
+        int destRow;
+        Column *col;
+        QVector<qreal> values;
+        QList<Interval<int>> invalid;
+        DescriptiveStatistics result;
+    };
+    QVector<Job> jobs;
+    for (int destRow : destRows) {
+        Column *col = d_base->column(d_targets.at(destRow));
+        if (!col || col->columnMode() != SciDAVis::ColumnMode::Numeric || col->rowCount() == 0)
+            continue;
+        jobs << Job { destRow, col, col->values(), col->invalidIntervals(),
+                      DescriptiveStatistics() };
+    }
+
+    // statistics of different columns are independent of each other, and the blocks
+    // of one column are computed in parallel as well
+    ColumnBlocks *caches = d_column_blocks.data();
+    auto compute = [&](Job &job) {
+        ColumnBlocks &cache = caches[job.destRow];
+        const int rows = job.values.size();
+        Interval<int> rows_changed = changed.value(job.destRow);
+        if (cache.column == job.col && cache.rows == rows && rows_changed.isValid())
+            DescriptiveStatistics::updateBlocks(cache.blocks, job.values.constData(), rows,
+                                                job.invalid, rows_changed.start(),
+                                                rows_changed.end());
+        else {
+            cache.column = job.col;
+            cache.rows = rows;
+            cache.blocks = DescriptiveStatistics::blocks(job.values.constData(), rows, job.invalid);
+        }
+        job.result = DescriptiveStatistics::merge(cache.blocks);
+    };
+    if (jobs.size() > 1)
+        QtConcurrent::blockingMap(jobs, compute);
+    else if (jobs.size() == 1)
+        compute(jobs.first());
+
+    for (const Job &job : jobs) {
+        const DescriptiveStatistics &stats = job.result;
+        if (stats.count() == 0)
+            continue;
+        int destRow = job.destRow;
+        column(0)->setTextAt(destRow, d_base->colLabel(d_targets.at(destRow)));
+        column(1)->setTextAt(destRow, "[1:" + QString::number(job.values.size()) + "]");
+        column(2)->setValueAt(destRow, stats.mean());
+        column(3)->setValueAt(destRow, stats.standardDeviation());
+        column(4)->setValueAt(destRow, stats.variance());
+        column(5)->setValueAt(destRow, stats.sum());
+        column(6)->setValueAt(destRow, stats.maximumRow() + 1);
+        column(7)->setValueAt(destRow, stats.maximum());
+        column(8)->setValueAt(destRow, stats.minimumRow() + 1);
+        column(9)->setValueAt(destRow, stats.minimum());
+        column(10)->setValueAt(destRow, stats.count());
+    }
+}
+
+void TableStatistics::updateRowStatistics(const QVector<int> &destRows)
+{
+    int columns = d_base->numCols();
+    if (columns == 0 || destRows.isEmpty())
+        return;
+
+    // snapshot the numeric columns once instead of going through valueAt() for every cell
+    struct Source
+    {
+        int col;
+        QVector<qreal> values;
+        QVector<Interval<int>> valid;
+    };
+    QVector<Source> sources;
+    for (int col = 0; col < columns; col++) {
+        Column *c = d_base->column(col);
+        if (c->columnMode() == SciDAVis::ColumnMode::Numeric)
+            sources << Source { col, c->values(),
+                                DescriptiveStatistics::validIntervals(c->rowCount(),
+                                                                      c->invalidIntervals()) };
+    }
+
+    QVector<DescriptiveStatistics> stats(destRows.size());
+    DescriptiveStatistics *results = stats.data();
+    QVector<int> indices(destRows.size());
+    for (int i = 0; i < indices.size(); i++)
+        indices[i] = i;
+    auto compute = [&](int i) {
+        int srcRow = d_targets.at(destRows.at(i));
+        for (const Source &source : sources)
+            if (DescriptiveStatistics::contains(source.valid, srcRow))
+                results[i].add(source.values.at(srcRow), source.col);
+    };
+    if (indices.size() > 1)
+        QtConcurrent::blockingMap(indices, compute);
+    else
+        compute(0);
+
+    // write the results for each run of consecutive rows at once
+    for (int runStart = 0; runStart < destRows.size();) {
+        int runEnd = runStart;
+        while (runEnd + 1 < destRows.size() && destRows.at(runEnd + 1) == destRows.at(runEnd) + 1)
+            runEnd++;
+
+        QVector<QVector<qreal>> output(9);
+        for (int i = runStart; i <= runEnd; i++) {
+            const DescriptiveStatistics &s = stats.at(i);
+            output[0] << d_targets.at(destRows.at(i)) + 1;
+            output[1] << columns;
+            output[2] << s.mean();
+            output[3] << s.standardDeviation();
+            output[4] << s.variance();
+            output[5] << s.sum();
+            output[6] << s.maximum();
+            output[7] << s.minimum();
+            output[8] << s.count();
+        }
+        for (int c = 0; c < 9; c++)
+            column(c)->replaceValues(destRows.at(runStart), output.at(c));
+        for (int i = runStart; i <= runEnd; i++)
+            if (stats.at(i).count() == 0)
+                for (int c = 2; c < 8; c++)
+                    column(c)->setInvalid(destRows.at(i), true);
+
+        runStart = runEnd + 1;
+    }
+}
+
 void TableStatistics::renameCol(const QString &from, const QString &to)
 {
     if (d_type == TableStatistics::StatRow)
@@ -301,6 +332,7 @@ void TableStatistics::removeCol(const QString &col)
     for (int c = 0; c < d_targets.size(); c++)
         if (col == QString(d_base->name()) + "_" + text(c, 0)) {
             d_targets.removeAll(d_targets.at(c));
+            d_column_blocks.remove(c);
             d_future_table->removeRows(c, 1);
             return;
         }
@@ -31,6 +31,10 @@
 #define TABLE_STATISTICS_H
 
 #include "Table.h"
+#include "lib/DescriptiveStatistics.h"
+
+#include <QHash>
+#include <QVector>
 
 /*!\brief Table that computes and displays statistics on another Table.
  *
@@ -55,6 +59,9 @@ public:
 public slots:
     //! update statistics after a column has changed (to be connected with Table::modifiedData)
     void update(Table *, const QString &colName);
+    //! remember which rows the next update() of a column has to consider (to be connected with
+    //! Table::modifiedRows)
+    void markModifiedRows(Table *, const QString &colName, int first, int last);
     //! handle renaming of columns (to be connected with Table::changedColHeader)
     void renameCol(const QString &, const QString &);
     //! remove statistics of removed columns (to be connected with Table::removedCol)
@@ -64,9 +71,29 @@ protected:
     bool eventFilter(QObject *watched, QEvent *event);
 
 private:
+    //! Blockwise statistics of a monitored column, so that changes of a few rows are cheap
+    struct ColumnBlocks
+    {
+        const Column *column = nullptr;
+        int rows = 0;
+        QVector<DescriptiveStatistics> blocks;
+    };
+
+    //! recompute the statistics shown in the given rows of a column statistics table
+    void updateColumnStatistics(const QList<int> &destRows, const QHash<int, Interval<int>> &changed);
+    //! recompute the statistics shown in the given rows of a row statistics table
+    void updateRowStatistics(const QVector<int> &destRows);
+
     Table *d_base;
     Type d_type;
     QList<int> d_targets;
+    //! changed rows announced by markModifiedRows(), by column name
+    QHash<QString, Interval<int>> d_modified_rows;
+    //! cached block statistics for StatColumn, indexed like d_targets
+    QVector<ColumnBlocks> d_column_blocks;
+    //! number of columns and numeric columns of the base table at the last StatRow update
+    int d_columns = 0;
+    QList<int> d_numeric_columns;
 };
 
 #endif
@@ -32,6 +32,7 @@
 #include <qwt_double_rect.h>
 #include <QPainter>
 #include <QLocale>
+#include <QSet>
 
 VectorCurve::VectorCurve(VectorStyle style, Table *t, const QString &xColName, QString name,
                          const QString &endCol1, const QString &endCol2, int startRow, int endRow)
@@ -86,73 +87,115 @@ void VectorCurve::draw(QPainter *painter, const QwtScaleMap &xMap, const QwtScal
 void VectorCurve::drawVector(QPainter *painter, const QwtScaleMap &xMap, const QwtScaleMap &yMap,
                              int from, int to) const
 {
-    if (d_type == Graph::VectXYAM) {
-        for (int i = from; i <= to; i++) {
+    // Arrows are collected in batches and drawn with one call per batch. Arrows outside of the
+    // visible part of the device are skipped. For fields of more than one batch, arrows which
+    // have the same start and end pixels as one drawn before are skipped as well (dense vector
+    // fields at low zoom levels). This only drops exact duplicates and leaves the result
+    // unchanged; arrows differing by a pixel are all drawn.
+    const int margin = d_headLength + pen.width() + 1;
+    const QRect visible = visibleRect(painter).adjusted(-margin, -margin, margin, margin);
+    const int batchSize = 16384;
+    const bool thin = to - from + 1 > batchSize && visible.width() <= 0xffff
+            && visible.height() <= 0xffff;
+    QSet<quint64> drawn;
+
+    const double pi = 4 * atan(1.0);
+    const double d = qRound(d_headLength * tan(pi * (double)d_headAngle / 180.0));
+    if (filledArrow)
+        painter->setBrush(QBrush(pen.color(), Qt::SolidPattern));
+
+    QVector<QLine> lines;
+    QVector<QPolygon> heads;
+    lines.reserve(qMin(to - from + 1, batchSize));
+    heads.reserve(qMin(to - from + 1, batchSize));
+    auto flush = [&]() {
+        drawLines(painter, lines);
+        drawPolygons(painter, heads);
+        lines.clear();
+        heads.clear();
+    };
+
+    for (int i = from; i <= to; i++) {
+        int xs, ys, xe, ye;
+        if (d_type == Graph::VectXYAM) {
             const double x0 = x(i);
             const double y0 = y(i);
             const double angle = vectorEnd->x(i);
             const double mag = vectorEnd->y(i);
+            const double dx = mag * cos(angle);
+            const double dy = mag * sin(angle);
 
-            int xs = 0, ys = 0, xe = 0, ye = 0;
             switch (d_position) {
-            case Tail:
-                xs = xMap.transform(x0);
-                ys = yMap.transform(y0);
-                xe = xMap.transform(x0 + mag * cos(angle));
-                ye = yMap.transform(y0 + mag * sin(angle));
+            case Middle:
+                xs = xMap.transform(x0 - 0.5 * dx);
+                ys = yMap.transform(y0 - 0.5 * dy);
+                xe = xMap.transform(x0 + 0.5 * dx);
+                ye = yMap.transform(y0 + 0.5 * dy);
                 break;
 
-            case Middle: {
-                double dxh = 0.5 * mag * cos(angle);
-                double dyh = 0.5 * mag * sin(angle);
-                xs = xMap.transform(x0 - dxh);
-                ys = yMap.transform(y0 - dyh);
-                xe = xMap.transform(x0 + dxh);
-                ye = yMap.transform(y0 + dyh);
-            } break;
-
             case Head:
-                xs = xMap.transform(x0 - mag * cos(angle));
-                ys = yMap.transform(y0 - mag * sin(angle));
+                xs = xMap.transform(x0 - dx);
+                ys = yMap.transform(y0 - dy);
                 xe = xMap.transform(x0);
                 ye = yMap.transform(y0);
                 break;
+
+            case Tail:
+            default:
+                xs = xMap.transform(x0);
+                ys = yMap.transform(y0);
+                xe = xMap.transform(x0 + dx);
+                ye = yMap.transform(y0 + dy);
+                break;
             }
-            QwtPainter::drawLine(painter, xs, ys, xe, ye);
-            drawArrowHead(painter, xs, ys, xe, ye);
+        } else {
+            xs = xMap.transform(x(i));
+            ys = yMap.transform(y(i));
+            xe = xMap.transform(vectorEnd->x(i));
+            ye = yMap.transform(vectorEnd->y(i));
         }
-    } else {
-        for (int i = from; i <= to; i++) {
-            const int xs = xMap.transform(x(i));
-            const int ys = yMap.transform(y(i));
-            const int xe = xMap.transform(vectorEnd->x(i));
-            const int ye = yMap.transform(vectorEnd->y(i));
-            QwtPainter::drawLine(painter, xs, ys, xe, ye);
-            drawArrowHead(painter, xs, ys, xe, ye);
+
+        if (qMax(xs, xe) < visible.left() || qMin(xs, xe) > visible.right()
+            || qMax(ys, ye) < visible.top() || qMin(ys, ye) > visible.bottom())
+            continue;
+        if (thin && visible.contains(xs, ys) && visible.contains(xe, ye)) {
+            const quint64 key = (quint64(xs - visible.left()) << 48)
+                    | (quint64(ys - visible.top()) << 32) | (quint64(xe - visible.left()) << 16)
+                    | quint64(ye - visible.top());
+            if (drawn.contains(key))
+                continue;
+            drawn.insert(key);
         }
+
+        lines.append(QLine(xs, ys, xe, ye));
+        heads.append(arrowHead(xs, ys, xe, ye, d));
+        if (lines.size() == batchSize)
+            flush();
     }
+    if (!lines.isEmpty())
+        flush();
 }
 
-void VectorCurve::drawArrowHead(QPainter *p, int xs, int ys, int xe, int ye) const
+QPolygon VectorCurve::arrowHead(int xs, int ys, int xe, int ye, double d) const
 {
-    p->save();
-    p->translate(xe, ye);
-    double t = theta(xs, ys, xe, ye);
-    p->rotate(-t);
-
-    double pi = 4 * atan(-1.0);
-    int d = qRound(d_headLength * tan(pi * (double)d_headAngle / 180.0));
-
-    QPolygon endArray(3);
-    endArray[0] = QPoint(0, 0);
-    endArray[1] = QPoint(-d_headLength, d);
-    endArray[2] = QPoint(-d_headLength, -d);
-
-    if (filledArrow)
-        p->setBrush(QBrush(pen.color(), Qt::SolidPattern));
-
-    QwtPainter::drawPolygon(p, endArray);
-    p->restore();
+    // unit vector in the direction of the arrow and its normal, in device coordinates
+    double ux = xe - xs, uy = ye - ys;
+    const double length = sqrt(ux * ux + uy * uy);
+    if (length > 0) {
+        ux /= length;
+        uy /= length;
+    } else { // as drawn by theta() for an arrow of length 0
+        ux = 0;
+        uy = 1;
+    }
+    const double bx = xe - d_headLength * ux;
+    const double by = ye - d_headLength * uy;
+
+    QPolygon head(3);
+    head[0] = QPoint(xe, ye);
+    head[1] = QPoint(qRound(bx - d * uy), qRound(by + d * ux));
+    head[2] = QPoint(qRound(bx + d * uy), qRound(by - d * ux));
+    return head;
 }
 
 double VectorCurve::theta(int x0, int y0, int x1, int y1) const
@@ -56,7 +56,11 @@ public:
     void drawVector(QPainter *painter, const QwtScaleMap &xMap, const QwtScaleMap &yMap, int from,
                     int to) const;
 
-    void drawArrowHead(QPainter *p, int xs, int ys, int xe, int ye) const;
+    //! Return the head of the arrow from (xs, ys) to (xe, ye)
+    /**
+     * \param d half width of the head at its base, in pixels
+     */
+    QPolygon arrowHead(int xs, int ys, int xe, int ye, double d) const;
     double theta(int x0, int y0, int x1, int y1) const;
 
     QString vectorEndXAColName() { return d_end_x_a; };
@@ -84,6 +88,10 @@ public:
 
     bool updateData(Table *t, const QString &colName);
     virtual bool loadData();
+    QStringList columnNames()
+    {
+        return DataCurve::columnNames() << d_end_x_a << d_end_y_m;
+    }
 
     QString plotAssociation();
     void updateColumnNames(const QString &oldName, const QString &newName, bool updateTableName);
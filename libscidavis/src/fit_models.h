@@ -0,0 +1,329 @@
+/***************************************************************************
+    File                 : fit_models.h
+    Project              : SciDAVis
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 SciDAVis developers
+    Description          : Native implementations of the built-in fit models
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+#ifndef FIT_MODELS_H
+#define FIT_MODELS_H
+
+#include "fit_gsl.h"
+
+#include <QVarLengthArray>
+
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_matrix.h>
+#include <cmath>
+
+/*!\brief Built-in fit models as inlinable function objects.
+ *
+ * A model is constructed once per evaluation of the residuals from the current parameter vector
+ * (which is where anything independent of x, like reciprocals, is computed) and then called for
+ * every data point. value(x) returns the model function, value(x, gradient) additionally stores
+ * its partial derivatives with respect to the parameters (in the order of the parameter vector).
+ *
+ * FitModel turns a model into the callbacks expected by GSL, see fit_gsl.h.
+ */
+namespace FitModels {
+
+//! A * exp(-lambda * x) + b; parameters (A, lambda, b)
+class Exponential
+{
+public:
+    Exponential(const gsl_vector *p, size_t)
+        : A(gsl_vector_get(p, 0)), lambda(gsl_vector_get(p, 1)), b(gsl_vector_get(p, 2))
+    {
+    }
+    double value(double x) const { return A * exp(-lambda * x) + b; }
+    double value(double x, double *gradient) const
+    {
+        const double e = exp(-lambda * x);
+        gradient[0] = e;
+        gradient[1] = -x * A * e;
+        gradient[2] = 1.0;
+        return A * e + b;
+    }
+
+private:
+    const double A, lambda, b;
+};
+
+//! Sum of 'Terms' exponentials A_i * exp(-l_i * x) + y0; parameters (A1, l1, A2, l2, ..., y0)
+template<int Terms>
+class MultiExponential
+{
+public:
+    MultiExponential(const gsl_vector *p, size_t) : y0(gsl_vector_get(p, 2 * Terms))
+    {
+        for (int i = 0; i < Terms; i++) {
+            A[i] = gsl_vector_get(p, 2 * i);
+            l[i] = gsl_vector_get(p, 2 * i + 1);
+        }
+    }
+    double value(double x) const
+    {
+        double result = y0;
+        for (int i = 0; i < Terms; i++)
+            result += A[i] * exp(-x * l[i]);
+        return result;
+    }
+    double value(double x, double *gradient) const
+    {
+        double result = y0;
+        for (int i = 0; i < Terms; i++) {
+            const double e = exp(-x * l[i]);
+            gradient[2 * i] = e;
+            gradient[2 * i + 1] = -x * A[i] * e;
+            result += A[i] * e;
+        }
+        gradient[2 * Terms] = 1.0;
+        return result;
+    }
+
+private:
+    double A[Terms], l[Terms];
+    const double y0;
+};
+
+//! (A1 - A2) / (1 + exp((x - x0) / dx)) + A2; parameters (A1, A2, x0, dx)
+class Boltzmann
+{
+public:
+    Boltzmann(const gsl_vector *p, size_t)
+        : A1(gsl_vector_get(p, 0)),
+          A2(gsl_vector_get(p, 1)),
+          x0(gsl_vector_get(p, 2)),
+          dx(gsl_vector_get(p, 3))
+    {
+    }
+    double value(double x) const { return (A1 - A2) / (1 + exp((x - x0) / dx)) + A2; }
+    double value(double x, double *gradient) const
+    {
+        const double diff = x - x0;
+        const double e = exp(diff / dx);
+        const double r = 1 / (1 + e);
+        const double aux = (A1 - A2) * e * r * r / dx;
+        gradient[0] = r;
+        gradient[1] = 1 - r;
+        gradient[2] = aux;
+        gradient[3] = aux * diff / dx;
+        return (A1 - A2) * r + A2;
+    }
+
+private:
+    const double A1, A2, x0, dx;
+};
+
+//! A * exp(-(x - C)^2 / (2 * w^2)) + Y0; parameters (Y0, A, C, w)
+class Gauss
+{
+public:
+    Gauss(const gsl_vector *p, size_t)
+        : Y0(gsl_vector_get(p, 0)),
+          A(gsl_vector_get(p, 1)),
+          C(gsl_vector_get(p, 2)),
+          w(gsl_vector_get(p, 3)),
+          inv_w2(1.0 / (w * w))
+    {
+    }
+    double value(double x) const
+    {
+        const double diff = x - C;
+        return A * exp(-0.5 * diff * diff * inv_w2) + Y0;
+    }
+    double value(double x, double *gradient) const
+    {
+        const double diff = x - C;
+        const double e = exp(-0.5 * diff * diff * inv_w2);
+        gradient[0] = 1.0;
+        gradient[1] = e;
+        gradient[2] = diff * A * e * inv_w2;
+        gradient[3] = diff * diff * A * e * inv_w2 / w;
+        return A * e + Y0;
+    }
+
+private:
+    const double Y0, A, C, w, inv_w2;
+};
+
+//! Common part of the multi-peak models: per-peak parameters (A_i, xc_i, w_i), offset last
+class MultiPeak
+{
+protected:
+    MultiPeak(const gsl_vector *p, size_t count)
+        : peaks(int((count - 1) / 3)),
+          offset(gsl_vector_get(p, count - 1)),
+          A(peaks),
+          xc(peaks),
+          w(peaks)
+    {
+        for (int i = 0; i < peaks; i++) {
+            A[i] = gsl_vector_get(p, 3 * i);
+            xc[i] = gsl_vector_get(p, 3 * i + 1);
+            w[i] = gsl_vector_get(p, 3 * i + 2);
+        }
+    }
+
+    const int peaks;
+    const double offset;
+    QVarLengthArray<double, 16> A, xc, w;
+};
+
+//! offset + sum of sqrt(2/pi) * A_i / w_i * exp(-2 * (x - xc_i)^2 / w_i^2)
+class GaussPeaks : public MultiPeak
+{
+public:
+    GaussPeaks(const gsl_vector *p, size_t count)
+        : MultiPeak(p, count), c(peaks), a(peaks), inv_w2(peaks)
+    {
+        for (int i = 0; i < peaks; i++) {
+            c[i] = sqrt(M_2_PI) / w[i];
+            a[i] = c[i] * A[i];
+            inv_w2[i] = 1.0 / (w[i] * w[i]);
+        }
+    }
+    double value(double x) const
+    {
+        double result = offset;
+        for (int i = 0; i < peaks; i++) {
+            const double diff = x - xc[i];
+            result += a[i] * exp(-2 * diff * diff * inv_w2[i]);
+        }
+        return result;
+    }
+    double value(double x, double *gradient) const
+    {
+        double result = offset;
+        for (int i = 0; i < peaks; i++) {
+            const double diff = x - xc[i];
+            const double e = exp(-2 * diff * diff * inv_w2[i]);
+            const double y = a[i] * e;
+            gradient[3 * i] = c[i] * e;
+            gradient[3 * i + 1] = 4 * diff * y * inv_w2[i];
+            gradient[3 * i + 2] = y / w[i] * (4 * diff * diff * inv_w2[i] - 1);
+            result += y;
+        }
+        gradient[3 * peaks] = 1.0;
+        return result;
+    }
+
+private:
+    //! sqrt(2/pi) / w_i and the amplitudes c_i * A_i
+    QVarLengthArray<double, 16> c, a, inv_w2;
+};
+
+//! offset + sum of A_i * w_i / (4 * (x - xc_i)^2 + w_i^2)
+class LorentzPeaks : public MultiPeak
+{
+public:
+    LorentzPeaks(const gsl_vector *p, size_t count) : MultiPeak(p, count) { }
+    double value(double x) const
+    {
+        double result = offset;
+        for (int i = 0; i < peaks; i++) {
+            const double diff = x - xc[i];
+            result += A[i] * w[i] / (4 * diff * diff + w[i] * w[i]);
+        }
+        return result;
+    }
+    double value(double x, double *gradient) const
+    {
+        double result = offset;
+        for (int i = 0; i < peaks; i++) {
+            const double diff = x - xc[i];
+            const double w2 = w[i] * w[i];
+            const double r = 1.0 / (4 * diff * diff + w2);
+            gradient[3 * i] = w[i] * r;
+            gradient[3 * i + 1] = 8 * diff * A[i] * w[i] * r * r;
+            gradient[3 * i + 2] = (4 * diff * diff - w2) * A[i] * r * r;
+            result += A[i] * w[i] * r;
+        }
+        gradient[3 * peaks] = 1.0;
+        return result;
+    }
+};
+
+} // namespace FitModels
+
+//! GSL callbacks evaluating the weighted residuals (Y(x_i) - y_i) / sigma_i of a model
+/**
+ * The Jacobian is computed analytically, together with the residuals in a single pass over the
+ * data for fdf().
+ */
+template<class Model>
+struct FitModel
+{
+    static int f(const gsl_vector *x, void *params, gsl_vector *f)
+    {
+        const FitData *data = static_cast<const FitData *>(params);
+        const Model model(x, data->p);
+        for (size_t i = 0; i < data->n; i++)
+            gsl_vector_set(f, i, (model.value(data->X[i]) - data->Y[i]) / data->sigma[i]);
+        return GSL_SUCCESS;
+    }
+
+    static double d(const gsl_vector *x, void *params)
+    {
+        const FitData *data = static_cast<const FitData *>(params);
+        const Model model(x, data->p);
+        double result = 0.0;
+        for (size_t i = 0; i < data->n; i++) {
+            const double residual = (model.value(data->X[i]) - data->Y[i]) / data->sigma[i];
+            result += residual * residual;
+        }
+        return result;
+    }
+
+    static int df(const gsl_vector *x, void *params, gsl_matrix *J)
+    {
+        const FitData *data = static_cast<const FitData *>(params);
+        const Model model(x, data->p);
+        QVarLengthArray<double, 64> gradient(int(data->p));
+        for (size_t i = 0; i < data->n; i++) {
+            model.value(data->X[i], gradient.data());
+            const double weight = 1.0 / data->sigma[i];
+            for (size_t j = 0; j < data->p; j++)
+                gsl_matrix_set(J, i, j, gradient[int(j)] * weight);
+        }
+        return GSL_SUCCESS;
+    }
+
+    static int fdf(const gsl_vector *x, void *params, gsl_vector *f, gsl_matrix *J)
+    {
+        const FitData *data = static_cast<const FitData *>(params);
+        const Model model(x, data->p);
+        QVarLengthArray<double, 64> gradient(int(data->p));
+        for (size_t i = 0; i < data->n; i++) {
+            const double y = model.value(data->X[i], gradient.data());
+            const double weight = 1.0 / data->sigma[i];
+            gsl_vector_set(f, i, (y - data->Y[i]) * weight);
+            for (size_t j = 0; j < data->p; j++)
+                gsl_matrix_set(J, i, j, gradient[int(j)] * weight);
+        }
+        return GSL_SUCCESS;
+    }
+};
+
+#endif // FIT_MODELS_H
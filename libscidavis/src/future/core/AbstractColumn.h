@@ -397,6 +397,19 @@ signals:
      * one handler for lots of columns.
      */
     void dataChanged(const AbstractColumn *source);
+    //! Data (including validity) in a range of rows has changed
+    /**
+     * This is emitted directly before dataChanged() when the change
+     * is known to be restricted to the rows first to last. Objects
+     * that can update incrementally remember the range here and use it
+     * when handling dataChanged(); a dataChanged() not preceded by this
+     * signal may affect all rows.
+     *
+     *	\param source the column that emitted the signal
+     *	\param first the first changed row
+     *	\param last the last changed row
+     */
+    void rowsChanged(const AbstractColumn *source, int first, int last);
     //! The column will be replaced
     /**
      * This is used then a column is replaced by another
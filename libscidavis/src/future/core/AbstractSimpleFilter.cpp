@@ -30,6 +30,7 @@
 
 #include "AbstractSimpleFilter.h"
 #include <QtDebug>
+#include <QtConcurrentMap>
 
 // TODO: should simple filters have a name argument?
 AbstractSimpleFilter::AbstractSimpleFilter()
@@ -38,6 +39,17 @@ AbstractSimpleFilter::AbstractSimpleFilter()
     addChild(d_output_column);
 }
 
+void AbstractSimpleFilter::convertBlocks(int rows, const std::function<void(int, int)> &convert)
+{
+    // large enough to outweigh the scheduling, small enough to balance slow rows
+    const int block = 16384;
+    QVector<int> starts;
+    for (int first = 0; first < rows; first += block)
+        starts << first;
+    QtConcurrent::blockingMap(starts,
+                              [&](int first) { convert(first, qMin(first + block, rows)); });
+}
+
 void AbstractSimpleFilter::clearMasks()
 {
     emit d_output_column->maskingAboutToChange(d_output_column);
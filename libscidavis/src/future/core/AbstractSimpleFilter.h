@@ -37,6 +37,8 @@
 #include <QUndoCommand>
 #include <QXmlStreamWriter>
 
+#include <functional>
+
 // forward declaration - class follows
 class SimpleFilterColumn;
 
@@ -248,6 +250,25 @@ public:
     {
         return d_inputs.value(0) ? d_inputs.at(0)->invalidIntervals() : QList<Interval<int>>();
     }
+    //! Convert a whole column at once
+    /**
+     * 'input' is the data of a column of the input type (QVector<double>, QStringList or
+     * QList<QDateTime>) with 'rows' rows, 'output' the data of the result, of dataType() and
+     * already resized to 'rows'. 'invalid' holds a flag per row which is set for invalid input
+     * rows; implementations update it to the validity of the result.
+     *
+     * Column::Private::setColumnMode() uses this instead of reading output(0) row by row.
+     * Implementations convert blocks of rows in parallel (see convertBlocks()), so they must be
+     * thread safe. Returns false if the filter has no batch conversion (the default).
+     */
+    virtual bool convertRows(const void *input, void *output, char *invalid, int rows) const
+    {
+        Q_UNUSED(input)
+        Q_UNUSED(output)
+        Q_UNUSED(invalid)
+        Q_UNUSED(rows)
+        return false;
+    }
 
     //! \name XML related functions
     //@{
@@ -260,6 +281,9 @@ public:
     //@}
 
 protected:
+    //! Call convert(first, last) for consecutive blocks of the rows [0, rows) on the global thread pool
+    static void convertBlocks(int rows, const std::function<void(int, int)> &convert);
+
     IntervalAttribute<bool> d_masking;
 
     //!\name signal handlers
@@ -36,6 +36,7 @@
 #include "globals.h"
 #include "lib/XmlStreamReader.h"
 #include "core/ProjectConfigPage.h"
+#include "core/UndoStorage.h"
 #include <QUndoStack>
 #include <QString>
 #include <QKeySequence>
@@ -83,10 +84,12 @@ Project::Project() : future::Folder(tr("Unnamed")), d(new Private())
     QString engine_name = ScriptingEngineManager::instance()->engineNames()[0];
     d->scripting_engine = ScriptingEngineManager::instance()->engine(engine_name);
 #endif
+    UndoStorage::instance()->addStack(&d->undo_stack);
 }
 
 Project::~Project()
 {
+    UndoStorage::instance()->removeStack(&d->undo_stack);
     delete d;
 }
 
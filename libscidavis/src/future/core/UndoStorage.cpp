@@ -0,0 +1,433 @@
+/***************************************************************************
+    File                 : UndoStorage.cpp
+    Project              : SciDAVis
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 SciDAVis developers
+    Description          : Compressed storage for undo information
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "core/UndoStorage.h"
+
+#include <QDir>
+#include <QUndoCommand>
+#include <QUndoStack>
+#include <QtConcurrentMap>
+
+#include <cstring>
+#include <limits>
+
+namespace {
+//! Group the n-th bytes of all elements, which lets zlib find the redundancy in numbers
+QByteArray shuffle(const QByteArray &data, int element_size)
+{
+    if (element_size <= 1)
+        return data;
+    const int count = data.size() / element_size;
+    const int whole = count * element_size;
+    QByteArray result(data.size(), Qt::Uninitialized);
+    const char *in = data.constData();
+    char *out = result.data();
+    for (int byte = 0; byte < element_size; byte++)
+        for (int i = 0; i < count; i++)
+            out[byte * count + i] = in[i * element_size + byte];
+    memcpy(out + whole, in + whole, data.size() - whole);
+    return result;
+}
+
+//! Inverse of shuffle()
+QByteArray unshuffle(const QByteArray &data, int element_size)
+{
+    if (element_size <= 1)
+        return data;
+    const int count = data.size() / element_size;
+    const int whole = count * element_size;
+    QByteArray result(data.size(), Qt::Uninitialized);
+    const char *in = data.constData();
+    char *out = result.data();
+    for (int byte = 0; byte < element_size; byte++)
+        for (int i = 0; i < count; i++)
+            out[i * element_size + byte] = in[byte * count + i];
+    memcpy(out + whole, in + whole, data.size() - whole);
+    return result;
+}
+
+const quint64 NoSerial = std::numeric_limits<quint64>::max();
+} // namespace
+
+UndoStorage *UndoStorage::instance()
+{
+    static UndoStorage storage;
+    return &storage;
+}
+
+UndoStorage::UndoStorage()
+    : d_last_serial(0),
+      d_memory_usage(0),
+      d_budget(0),
+      d_spilling(false),
+      d_file(QDir::tempPath() + "/scidavis-undo-XXXXXX"),
+      d_spilled_count(0),
+      d_file_garbage(0)
+{
+    d_clock.start();
+    d_timer.setSingleShot(true);
+    connect(&d_timer, SIGNAL(timeout()), this, SLOT(maintain()));
+    connect(&d_watcher, SIGNAL(finished()), this, SLOT(compressionFinished()));
+}
+
+UndoStorage::~UndoStorage()
+{
+    d_watcher.waitForFinished();
+}
+
+void UndoStorage::addStack(QUndoStack *stack)
+{
+    if (!d_stacks.contains(stack))
+        d_stacks << stack;
+}
+
+void UndoStorage::removeStack(QUndoStack *stack)
+{
+    d_stacks.removeAll(stack);
+}
+
+bool UndoStorage::canUndo(const QUndoStack *stack)
+{
+    if (!stack->canUndo())
+        return false;
+#if QT_VERSION >= QT_VERSION_CHECK(5, 9, 0)
+    return !stack->command(stack->index() - 1)->isObsolete();
+#else
+    return true;
+#endif
+}
+
+void UndoStorage::setBudget(qint64 bytes)
+{
+    d_budget = bytes;
+    scheduleMaintenance(0);
+}
+
+void UndoStorage::setSpillingEnabled(bool enabled)
+{
+    d_spilling = enabled;
+    scheduleMaintenance(0);
+}
+
+UndoStorage::Entry *UndoStorage::add(const QUndoCommand *owner, const QByteArray &data,
+                                     int element_size)
+{
+    Entry *entry = new Entry;
+    entry->owner = owner;
+    entry->serial = ++d_last_serial;
+    entry->element_size = element_size;
+    entry->last_use = d_clock.elapsed();
+    entry->raw = data;
+    entry->file_offset = -1;
+    entry->file_size = 0;
+    entry->file_compressed = false;
+    entry->incompressible = false;
+    entry->discarded = false;
+    d_entries.insert(entry->serial, entry);
+    d_owned.insert(owner, entry);
+    d_memory_usage += footprint(entry);
+    // the budget is checked once the command is on the stack
+    scheduleMaintenance(0);
+    return entry;
+}
+
+void UndoStorage::remove(Entry *entry)
+{
+    releaseSpilled(entry);
+    d_memory_usage -= footprint(entry);
+    d_entries.remove(entry->serial);
+    d_owned.remove(entry->owner, entry);
+    delete entry;
+}
+
+QByteArray UndoStorage::load(Entry *entry)
+{
+    entry->last_use = d_clock.elapsed();
+    if (entry->discarded || (entry->compressed.isEmpty() && entry->file_offset < 0))
+        return entry->raw;
+
+    QByteArray packed = entry->compressed;
+    bool compressed = true;
+    if (entry->file_offset >= 0) {
+        d_file.seek(entry->file_offset);
+        packed = d_file.read(entry->file_size);
+        compressed = entry->file_compressed;
+        releaseSpilled(entry);
+    }
+    d_memory_usage -= footprint(entry);
+    entry->raw = compressed ? unpack(packed, entry->element_size) : packed;
+    entry->compressed = QByteArray();
+    d_memory_usage += footprint(entry);
+    scheduleMaintenance(ColdAge);
+    return entry->raw;
+}
+
+void UndoStorage::dropData(Entry *entry)
+{
+    d_memory_usage -= footprint(entry);
+    entry->raw = QByteArray();
+    entry->compressed = QByteArray();
+}
+
+void UndoStorage::scheduleMaintenance(int msec)
+{
+    if (!d_timer.isActive() || d_timer.remainingTime() > msec)
+        d_timer.start(msec);
+}
+
+void UndoStorage::maintain()
+{
+    enforceBudget();
+    if (d_file_garbage > 0 && 2 * d_file_garbage >= d_file.size())
+        compactFile();
+    if (d_watcher.isRunning())
+        return; // continued by compressionFinished()
+
+    const qint64 now = d_clock.elapsed();
+    qint64 next = -1;
+    d_jobs.clear();
+    for (Entry *entry : qAsConst(d_entries)) {
+        if (entry->raw.isEmpty() || entry->incompressible)
+            continue;
+        const qint64 age = now - entry->last_use;
+        if (age >= ColdAge)
+            d_jobs << Job{ entry->serial, entry->raw, entry->element_size };
+        else if (next < 0 || ColdAge - age < next)
+            next = ColdAge - age;
+    }
+    if (!d_jobs.isEmpty())
+        d_watcher.setFuture(QtConcurrent::mapped(d_jobs, compress));
+    else if (next >= 0)
+        scheduleMaintenance(int(next));
+}
+
+void UndoStorage::compressionFinished()
+{
+    const QFuture<QByteArray> results = d_watcher.future();
+    const qint64 now = d_clock.elapsed();
+    for (int i = 0; i < d_jobs.size(); i++) {
+        Entry *entry = d_entries.value(d_jobs.at(i).serial);
+        // skip entries removed, discarded or used in the meantime
+        if (!entry || entry->raw.constData() != d_jobs.at(i).data.constData()
+            || now - entry->last_use < ColdAge)
+            continue;
+        const QByteArray compressed = results.resultAt(i);
+        if (compressed.size() > entry->raw.size() - entry->raw.size() / 8) {
+            entry->incompressible = true;
+            continue;
+        }
+        d_memory_usage -= footprint(entry);
+        entry->compressed = compressed;
+        entry->raw = QByteArray();
+        d_memory_usage += footprint(entry);
+    }
+    d_jobs.clear();
+    scheduleMaintenance(0);
+}
+
+void UndoStorage::enforceBudget()
+{
+    if (d_budget <= 0 || d_memory_usage <= d_budget)
+        return;
+    if (d_spilling) {
+        for (Entry *entry : qAsConst(d_entries)) {
+            if (d_memory_usage <= d_budget)
+                break;
+            spill(entry);
+        }
+    }
+    while (d_memory_usage > d_budget && discardOldest())
+        ;
+}
+
+bool UndoStorage::spill(Entry *entry)
+{
+    const bool compressed = !entry->compressed.isEmpty();
+    const QByteArray data = compressed ? entry->compressed : entry->raw;
+    if (data.isEmpty())
+        return false;
+    if (!d_file.isOpen() && !d_file.open())
+        return false;
+    const qint64 offset = d_file.size();
+    if (!d_file.seek(offset) || d_file.write(data) != data.size())
+        return false;
+    entry->file_offset = offset;
+    entry->file_size = data.size();
+    entry->file_compressed = compressed;
+    d_spilled_count++;
+    dropData(entry);
+    return true;
+}
+
+void UndoStorage::releaseSpilled(Entry *entry)
+{
+    if (entry->file_offset < 0)
+        return;
+    entry->file_offset = -1;
+    if (--d_spilled_count == 0) {
+        d_file.resize(0);
+        d_file_garbage = 0;
+    } else {
+        d_file_garbage += entry->file_size;
+        scheduleMaintenance(0);
+    }
+}
+
+void UndoStorage::compactFile()
+{
+    QMap<qint64, Entry *> spilled;
+    for (Entry *entry : qAsConst(d_entries))
+        if (entry->file_offset >= 0)
+            spilled.insert(entry->file_offset, entry);
+
+    // moving the data in the order of the offsets overwrites only unused parts of the file
+    qint64 end = 0, used = 0;
+    for (Entry *entry : qAsConst(spilled)) {
+        // data overlapping its new position is left in place, so that a failed write loses nothing
+        if (entry->file_offset >= end + entry->file_size && d_file.seek(entry->file_offset)) {
+            const QByteArray data = d_file.read(entry->file_size);
+            if (data.size() == entry->file_size && d_file.seek(end)
+                && d_file.write(data) == data.size())
+                entry->file_offset = end;
+        }
+        end = entry->file_offset + entry->file_size;
+        used += entry->file_size;
+    }
+    d_file.resize(end);
+    d_file_garbage = end - used;
+}
+
+bool UndoStorage::discardOldest()
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 9, 0)
+    QUndoStack *oldest_stack = 0;
+    int oldest_index = -1;
+    quint64 oldest_serial = NoSerial;
+    for (QUndoStack *stack : qAsConst(d_stacks)) {
+        // the command executed last is kept
+        for (int i = 0; i < stack->index() - 1; i++) {
+            const QUndoCommand *command = stack->command(i);
+            if (command->isObsolete())
+                continue;
+            const quint64 serial = oldestSerial(command);
+            if (serial == NoSerial)
+                continue;
+            if (serial < oldest_serial) {
+                oldest_stack = stack;
+                oldest_index = i;
+                oldest_serial = serial;
+            }
+            break;
+        }
+    }
+    if (!oldest_stack)
+        return false;
+    // commands can only be undone in order, so everything before goes as well
+    for (int i = 0; i <= oldest_index; i++) {
+        QUndoCommand *command = const_cast<QUndoCommand *>(oldest_stack->command(i));
+        if (!command->isObsolete()) {
+            command->setObsolete(true);
+            command->setText(tr("%1 (discarded)").arg(command->text()));
+        }
+        discard(command);
+    }
+    emit historyDiscarded(oldest_stack);
+    return true;
+#else
+    return false;
+#endif
+}
+
+quint64 UndoStorage::oldestSerial(const QUndoCommand *command) const
+{
+    quint64 result = NoSerial;
+    for (const Entry *entry : d_owned.values(command))
+        result = qMin(result, entry->serial);
+    for (int i = 0; i < command->childCount(); i++)
+        result = qMin(result, oldestSerial(command->child(i)));
+    return result;
+}
+
+void UndoStorage::discard(const QUndoCommand *command)
+{
+    for (Entry *entry : d_owned.values(command)) {
+        releaseSpilled(entry);
+        dropData(entry);
+        entry->discarded = true;
+    }
+    for (int i = 0; i < command->childCount(); i++)
+        discard(command->child(i));
+}
+
+QByteArray UndoStorage::pack(const QByteArray &data, int element_size)
+{
+    return qCompress(shuffle(data, element_size));
+}
+
+QByteArray UndoStorage::unpack(const QByteArray &packed, int element_size)
+{
+    return unshuffle(qUncompress(packed), element_size);
+}
+
+/* ========================== UndoBlob ====================== */
+
+void UndoBlob::store(const QUndoCommand *owner, const QByteArray &data, int element_size)
+{
+    clear();
+    d_entry = UndoStorage::instance()->add(owner, data, element_size);
+}
+
+void UndoBlob::storeValues(const QUndoCommand *owner, const QVector<qreal> &values)
+{
+    store(owner,
+          QByteArray(reinterpret_cast<const char *>(values.constData()),
+                     values.size() * int(sizeof(qreal))),
+          sizeof(qreal));
+}
+
+QByteArray UndoBlob::data() const
+{
+    return d_entry ? UndoStorage::instance()->load(d_entry) : QByteArray();
+}
+
+QVector<qreal> UndoBlob::values() const
+{
+    const QByteArray bytes = data();
+    QVector<qreal> result(bytes.size() / int(sizeof(qreal)));
+    memcpy(result.data(), bytes.constData(), result.size() * sizeof(qreal));
+    return result;
+}
+
+void UndoBlob::clear()
+{
+    if (d_entry) {
+        UndoStorage::instance()->remove(d_entry);
+        d_entry = 0;
+    }
+}
@@ -0,0 +1,210 @@
+/***************************************************************************
+    File                 : UndoStorage.h
+    Project              : SciDAVis
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 SciDAVis developers
+    Description          : Compressed storage for undo information
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef UNDOSTORAGE_H
+#define UNDOSTORAGE_H
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QFutureWatcher>
+#include <QList>
+#include <QMap>
+#include <QMultiHash>
+#include <QObject>
+#include <QTemporaryFile>
+#include <QTimer>
+#include <QVector>
+
+class QUndoCommand;
+class QUndoStack;
+
+//! Keeps the data undo commands need to restore overwritten cells
+/**
+  Undo commands store backups of cells in UndoBlob objects instead of keeping
+  plain copies. The storage compresses blobs which have not been used for a
+  while on the global thread pool and keeps track of the memory they use.
+
+  If a memory budget is set and exceeded, compressed blobs are spilled to a
+  temporary file (if enabled) and, if that does not suffice, the oldest
+  commands of the registered undo stacks are made obsolete (see
+  QUndoCommand::setObsolete()). This discards their data. QUndoStack cannot
+  remove commands from its oldest end, so they stay on the stack, labeled as
+  discarded, and canUndo() tells the user interface not to offer them; the
+  stack deletes them instead of undoing them if it gets there anyway, e.g.
+  through the history view. The command executed last is never discarded.
+
+  The temporary file is compacted once at least half of it holds data which
+  is not needed anymore.
+
+  All methods must be called from the GUI thread.
+  */
+class UndoStorage : public QObject
+{
+    Q_OBJECT
+
+public:
+    static UndoStorage *instance();
+    ~UndoStorage();
+
+    //! Discard the oldest commands of 'stack' if the budget is exceeded
+    void addStack(QUndoStack *stack);
+    void removeStack(QUndoStack *stack);
+    //! Set the memory budget in bytes (0 for no limit)
+    void setBudget(qint64 bytes);
+    qint64 budget() const { return d_budget; }
+    //! Enable/disable moving compressed blobs into a temporary file when over budget
+    void setSpillingEnabled(bool enabled);
+    bool isSpillingEnabled() const { return d_spilling; }
+    //! Return the memory (in bytes) used by the blobs
+    qint64 memoryUsage() const { return d_memory_usage; }
+    //! Return the size (in bytes) of the file holding the spilled blobs
+    qint64 spillFileSize() const { return d_file.size(); }
+    //! Whether the next command to undo on 'stack' has not been discarded
+    static bool canUndo(const QUndoStack *stack);
+
+signals:
+    //! The oldest commands of 'stack' have been discarded
+    void historyDiscarded(QUndoStack *stack);
+
+private slots:
+    //! Enforce the budget and compress cold blobs
+    void maintain();
+    void compressionFinished();
+
+private:
+    friend class UndoBlob;
+
+    struct Entry
+    {
+        //! The undo command the data belongs to
+        const QUndoCommand *owner;
+        //! Creation order; also identifies the entry in d_entries
+        quint64 serial;
+        //! Size of the elements of the data, for shuffling before compression
+        int element_size;
+        //! Time of creation or last use (see d_clock)
+        qint64 last_use;
+        //! The data, if held uncompressed
+        QByteArray raw;
+        //! The compressed data, if held compressed
+        QByteArray compressed;
+        //! Position and size of the data in d_file, or -1
+        qint64 file_offset;
+        int file_size;
+        //! Whether the data in the file is compressed
+        bool file_compressed;
+        //! Compression did not reduce the size, don't try again
+        bool incompressible;
+        //! The data has been dropped, because the owner has been discarded
+        bool discarded;
+    };
+
+    //! Blobs not used for this long (in milliseconds) are compressed
+    static constexpr int ColdAge = 5000;
+
+    UndoStorage();
+    Entry *add(const QUndoCommand *owner, const QByteArray &data, int element_size);
+    void remove(Entry *entry);
+    QByteArray load(Entry *entry);
+    //! Return the memory used by the data of 'entry'
+    static qint64 footprint(const Entry *entry)
+    {
+        return entry->raw.size() + entry->compressed.size();
+    }
+    //! Drop the data held in memory, adjusting d_memory_usage
+    void dropData(Entry *entry);
+    void scheduleMaintenance(int msec);
+    void enforceBudget();
+    bool spill(Entry *entry);
+    //! Mark the data of 'entry' in d_file as unused
+    void releaseSpilled(Entry *entry);
+    //! Move the spilled data to the start of d_file and truncate it
+    void compactFile();
+    //! Discard the oldest commands up to the oldest one holding data in any stack
+    bool discardOldest();
+    //! Return the smallest serial of the entries of 'command' and its children
+    quint64 oldestSerial(const QUndoCommand *command) const;
+    void discard(const QUndoCommand *command);
+
+    static QByteArray pack(const QByteArray &data, int element_size);
+    static QByteArray unpack(const QByteArray &packed, int element_size);
+
+    //! All entries, by serial (i.e. oldest first)
+    QMap<quint64, Entry *> d_entries;
+    QMultiHash<const QUndoCommand *, Entry *> d_owned;
+    QList<QUndoStack *> d_stacks;
+    quint64 d_last_serial;
+    qint64 d_memory_usage;
+    qint64 d_budget;
+    bool d_spilling;
+    QElapsedTimer d_clock;
+    QTimer d_timer;
+    //! Spilled data; the file is truncated when no entry is spilled anymore
+    QTemporaryFile d_file;
+    int d_spilled_count;
+    //! Bytes of d_file not holding data of spilled entries
+    qint64 d_file_garbage;
+    //! Data of an entry to compress
+    struct Job
+    {
+        quint64 serial;
+        QByteArray data;
+        int element_size;
+    };
+    static QByteArray compress(const Job &job) { return pack(job.data, job.element_size); }
+    //! The running compression, if any
+    QVector<Job> d_jobs;
+    QFutureWatcher<QByteArray> d_watcher;
+};
+
+//! Data of an undo command held by the UndoStorage
+class UndoBlob
+{
+public:
+    UndoBlob() : d_entry(0) {}
+    ~UndoBlob() { clear(); }
+
+    //! Store 'data', which belongs to the undo command 'owner'
+    /**
+     * 'element_size' is the size of the items in 'data', which are compressed better if known.
+     */
+    void store(const QUndoCommand *owner, const QByteArray &data, int element_size = 1);
+    //! Store the values of a numeric vector
+    void storeValues(const QUndoCommand *owner, const QVector<qreal> &values);
+    QByteArray data() const;
+    QVector<qreal> values() const;
+    void clear();
+    bool isNull() const { return d_entry == 0; }
+
+private:
+    Q_DISABLE_COPY(UndoBlob)
+    UndoStorage::Entry *d_entry;
+};
+
+#endif // ifndef UNDOSTORAGE_H
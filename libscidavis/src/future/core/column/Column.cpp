@@ -244,6 +244,12 @@ void Column::replaceValues(int first, const QVector<qreal> &new_values)
         exec(new ColumnReplaceValuesCmd(d_column_private, first, new_values));
 }
 
+void Column::permuteRows(const QVector<int> &permutation)
+{
+    if (!permutation.isEmpty())
+        exec(new ColumnPermuteRowsCmd(d_column_private, permutation));
+}
+
 QString Column::textAt(int row) const
 {
     return d_column_private->textAt(row);
@@ -269,6 +275,26 @@ double Column::valueAt(int row) const
     return d_column_private->valueAt(row);
 }
 
+QVector<qreal> Column::values() const
+{
+    return d_column_private->values();
+}
+
+QStringList Column::texts() const
+{
+    return d_column_private->texts();
+}
+
+QList<QDateTime> Column::dateTimes() const
+{
+    return d_column_private->dateTimes();
+}
+
+quint64 Column::version() const
+{
+    return d_column_private->version();
+}
+
 QIcon Column::icon() const
 {
     switch (dataType()) {
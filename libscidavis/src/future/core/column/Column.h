@@ -291,6 +291,34 @@ public:
     void replaceDateTimes(int first, const QList<QDateTime> &new_values) override;
     //! Return the double value in row 'row'
     double valueAt(int row) const override;
+    //! Return the numeric data of the column
+    /**
+     * Use this only when dataType() is double. The vector is implicitly
+     * shared with the column, so no values are copied and it stays a
+     * consistent snapshot if the column is modified later on. Keep it
+     * short-lived, though: writing to the column while a snapshot exists
+     * makes the column detach, i.e. copy its data once.
+     */
+    QVector<qreal> values() const;
+    //! Return the strings of the column
+    /**
+     * Use this only when dataType() is QString. Like values(), the list is an
+     * implicitly shared snapshot.
+     */
+    QStringList texts() const;
+    //! Return the date-time values of the column
+    /**
+     * Use this only when dataType() is QDateTime. Like values(), the list is
+     * an implicitly shared snapshot.
+     */
+    QList<QDateTime> dateTimes() const;
+    //! Return the version of the column content
+    /**
+     * The version changes whenever data, validity, masking, row count or mode
+     * of the column change. Versions are never shared between columns, so
+     * they can be used as cache keys for values derived from the column.
+     */
+    quint64 version() const;
     //! Set the content of row 'row'
     /**
      * Use this only when dataType() is double
@@ -301,6 +329,13 @@ public:
      * Use this only when dataType() is double
      */
     virtual void replaceValues(int first, const QVector<qreal> &new_values) override;
+    //! Reorder the rows 0 to permutation.size()-1
+    /**
+     * Row i receives the content of row permutation[i]: data, validity, masking and formulas
+     * are all moved along. If the column has fewer rows, it is extended by invalid rows first.
+     * The command stores only the permutation and undoes it by applying the inverse one.
+     */
+    void permuteRows(const QVector<int> &permutation);
     //@}
 
     //! \name XML related functions
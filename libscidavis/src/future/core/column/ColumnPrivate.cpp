@@ -48,11 +48,18 @@
 #include "ApplicationWindow.h"
 #include <QtDebug>
 
+#include <atomic>
 #include <stdexcept>
 using namespace std;
 
+namespace {
+//! Source of column versions; shared by all columns, so that versions are never reused
+std::atomic<quint64> last_version(0);
+} // namespace
+
 Column::Private::Private(Column *owner, SciDAVis::ColumnMode mode) : d_owner(owner)
 {
+    touch();
     Q_ASSERT(owner != 0); // a Column::Private without owner is not allowed
                           // because the owner must become the parent aspect of the input and output
                           // filters
@@ -125,6 +132,7 @@ Column::Private::Private(Column *owner, SciDAVis::ColumnDataType type, SciDAVis:
                          void *data, IntervalAttribute<bool> validity)
     : d_owner(owner)
 {
+    touch();
     d_data_type = type;
     d_column_mode = mode;
     d_data = data;
@@ -416,9 +424,11 @@ void Column::Private::setColumnMode(SciDAVis::ColumnMode new_mode, AbstractFilte
     {
         // copy the filtered, i.e. converted, column
         converter->input(0, temp_col.data());
-        copy(converter->output(0));
+        if (!convert(converter, temp_col.data(), old_data))
+            copy(converter->output(0));
     }
 
+    touch();
     emit d_owner->modeChanged(d_owner);
     if (filter_is_temporary)
         delete converter;
@@ -474,6 +484,7 @@ void Column::Private::replaceModeData(SciDAVis::ColumnMode mode, SciDAVis::Colum
     }
 
     d_validity = validity;
+    touch();
     emit d_owner->modeChanged(d_owner);
 }
 
@@ -482,6 +493,7 @@ void Column::Private::replaceData(void *data, IntervalAttribute<bool> validity)
     emit d_owner->dataAboutToChange(d_owner);
     d_data = data;
     d_validity = validity;
+    touch();
     emit d_owner->dataChanged(d_owner);
 }
 
@@ -516,6 +528,41 @@ bool Column::Private::copy(const AbstractColumn *other)
     // copy the validity information
     d_validity = other->invalidIntervals();
 
+    touch();
+    emit d_owner->dataChanged(d_owner);
+
+    return true;
+}
+
+bool Column::Private::convert(const AbstractFilter *converter, const AbstractColumn *source,
+                              const void *source_data)
+{
+    auto filter = qobject_cast<const AbstractSimpleFilter *>(converter);
+    if (!filter || filter->input(0) != source || filter->dataType() != dataType())
+        return false;
+    const int num_rows = source->rowCount();
+    QVector<char> invalid(num_rows, 0);
+    forEachRow(source->invalidIntervals(), 0, num_rows - 1, [&invalid](int i) { invalid[i] = 1; });
+
+    // the filter writes the rows concurrently, so they have to exist beforehand
+    resizeTo(num_rows);
+    if (!filter->convertRows(source_data, d_data, invalid.data(), num_rows))
+        return false;
+
+    emit d_owner->dataAboutToChange(d_owner);
+    QList<Interval<int>> invalid_intervals;
+    for (int i = 0, start = -1; i <= num_rows; i++) {
+        if (i < num_rows && invalid.at(i)) {
+            if (start < 0)
+                start = i;
+        } else if (start >= 0) {
+            invalid_intervals << Interval<int>(start, i - 1);
+            start = -1;
+        }
+    }
+    d_validity = IntervalAttribute<bool>(invalid_intervals);
+
+    touch();
     emit d_owner->dataChanged(d_owner);
 
     return true;
@@ -530,6 +577,7 @@ bool Column::Private::copy(const AbstractColumn *source, int source_start, int d
         return true;
 
     emit d_owner->dataAboutToChange(d_owner);
+    int first_changed = qMin(dest_start, rowCount());
     if (dest_start + 1 - rowCount() > 1)
         d_validity.setValue(Interval<int>(rowCount(), dest_start - 1), true);
     if (dest_start + num_rows > rowCount())
@@ -558,6 +606,8 @@ bool Column::Private::copy(const AbstractColumn *source, int source_start, int d
     for (int i = 0; i < num_rows; i++)
         d_validity.setValue(dest_start + i, source->isInvalid(source_start + i));
 
+    touch();
+    emit d_owner->rowsChanged(d_owner, first_changed, dest_start + num_rows - 1);
     emit d_owner->dataChanged(d_owner);
 
     return true;
@@ -594,6 +644,7 @@ bool Column::Private::copy(const Private *other)
     // copy the validity information
     d_validity = other->invalidIntervals();
 
+    touch();
     emit d_owner->dataChanged(d_owner);
 
     return true;
@@ -607,6 +658,7 @@ bool Column::Private::copy(const Private *source, int source_start, int dest_sta
         return true;
 
     emit d_owner->dataAboutToChange(d_owner);
+    int first_changed = qMin(dest_start, rowCount());
     if (dest_start + 1 - rowCount() > 1)
         d_validity.setValue(Interval<int>(rowCount(), dest_start - 1), true);
     if (dest_start + num_rows > rowCount())
@@ -635,6 +687,8 @@ bool Column::Private::copy(const Private *source, int source_start, int dest_sta
     for (int i = 0; i < num_rows; i++)
         d_validity.setValue(dest_start + i, source->isInvalid(source_start + i));
 
+    touch();
+    emit d_owner->rowsChanged(d_owner, first_changed, dest_start + num_rows - 1);
     emit d_owner->dataChanged(d_owner);
 
     return true;
@@ -715,6 +769,7 @@ void Column::Private::insertRows(int before, int count)
             break;
         }
     }
+    touch();
     emit d_owner->rowsInserted(d_owner, before, count);
 }
 
@@ -747,6 +802,7 @@ void Column::Private::removeRows(int first, int count)
             break;
         }
     }
+    touch();
     emit d_owner->rowsRemoved(d_owner, first, count);
 }
 
@@ -766,6 +822,7 @@ void Column::Private::clearValidity()
 {
     emit d_owner->dataAboutToChange(d_owner);
     d_validity.clear();
+    touch();
     emit d_owner->dataChanged(d_owner);
 }
 
@@ -773,6 +830,7 @@ void Column::Private::clearMasks()
 {
     emit d_owner->maskingAboutToChange(d_owner);
     d_masking.clear();
+    touch();
     emit d_owner->maskingChanged(d_owner);
 }
 
@@ -780,6 +838,8 @@ void Column::Private::setInvalid(Interval<int> i, bool invalid)
 {
     emit d_owner->dataAboutToChange(d_owner);
     d_validity.setValue(i, invalid);
+    touch();
+    emit d_owner->rowsChanged(d_owner, i.start(), i.end());
     emit d_owner->dataChanged(d_owner);
 }
 
@@ -792,6 +852,7 @@ void Column::Private::setMasked(Interval<int> i, bool mask)
 {
     emit d_owner->maskingAboutToChange(d_owner);
     d_masking.setValue(i, mask);
+    touch();
     emit d_owner->maskingChanged(d_owner);
 }
 
@@ -846,12 +907,39 @@ double Column::Private::valueAt(int row) const
     return static_cast<QVector<double> *>(d_data)->value(row);
 }
 
+void Column::Private::touch()
+{
+    d_version = ++last_version;
+}
+
+QVector<qreal> Column::Private::values() const
+{
+    if (d_data_type != SciDAVis::TypeDouble)
+        return QVector<qreal>();
+    return *static_cast<QVector<double> *>(d_data);
+}
+
+QStringList Column::Private::texts() const
+{
+    if (d_data_type != SciDAVis::TypeQString)
+        return QStringList();
+    return *static_cast<QStringList *>(d_data);
+}
+
+QList<QDateTime> Column::Private::dateTimes() const
+{
+    if (d_data_type != SciDAVis::TypeQDateTime)
+        return QList<QDateTime>();
+    return *static_cast<QList<QDateTime> *>(d_data);
+}
+
 void Column::Private::setTextAt(int row, const QString &new_value)
 {
     if (d_data_type != SciDAVis::TypeQString)
         return;
 
     emit d_owner->dataAboutToChange(d_owner);
+    int first_changed = qMin(row, rowCount());
     if (row >= rowCount()) {
         if (row + 1 - rowCount() > 1) // we are adding more than one row in resizeTo()
             d_validity.setValue(Interval<int>(rowCount(), row - 1), true);
@@ -860,6 +948,8 @@ void Column::Private::setTextAt(int row, const QString &new_value)
 
     static_cast<QStringList *>(d_data)->replace(row, new_value);
     d_validity.setValue(Interval<int>(row, row), false);
+    touch();
+    emit d_owner->rowsChanged(d_owner, first_changed, row);
     emit d_owner->dataChanged(d_owner);
 }
 
@@ -870,6 +960,7 @@ void Column::Private::replaceTexts(int first, const QStringList &new_values)
 
     emit d_owner->dataAboutToChange(d_owner);
     int num_rows = new_values.size();
+    int first_changed = qMin(first, rowCount());
     if (first + 1 - rowCount() > 1)
         d_validity.setValue(Interval<int>(rowCount(), first - 1), true);
     if (first + num_rows > rowCount())
@@ -878,6 +969,8 @@ void Column::Private::replaceTexts(int first, const QStringList &new_values)
     for (int i = 0; i < num_rows; i++)
         static_cast<QStringList *>(d_data)->replace(first + i, new_values.at(i));
     d_validity.setValue(Interval<int>(first, first + num_rows - 1), false);
+    touch();
+    emit d_owner->rowsChanged(d_owner, first_changed, first + num_rows - 1);
     emit d_owner->dataChanged(d_owner);
 }
 
@@ -903,6 +996,7 @@ void Column::Private::setDateTimeAt(int row, const QDateTime &new_value)
         return;
 
     emit d_owner->dataAboutToChange(d_owner);
+    int first_changed = qMin(row, rowCount());
     if (row >= rowCount()) {
         if (row + 1 - rowCount() > 1) // we are adding more than one row in resizeTo()
             d_validity.setValue(Interval<int>(rowCount(), row - 1), true);
@@ -911,6 +1005,8 @@ void Column::Private::setDateTimeAt(int row, const QDateTime &new_value)
 
     static_cast<QList<QDateTime> *>(d_data)->replace(row, new_value);
     d_validity.setValue(Interval<int>(row, row), !new_value.isValid());
+    touch();
+    emit d_owner->rowsChanged(d_owner, first_changed, row);
     emit d_owner->dataChanged(d_owner);
 }
 
@@ -921,6 +1017,7 @@ void Column::Private::replaceDateTimes(int first, const QList<QDateTime> &new_va
 
     emit d_owner->dataAboutToChange(d_owner);
     int num_rows = new_values.size();
+    int first_changed = qMin(first, rowCount());
     if (first + 1 - rowCount() > 1)
         d_validity.setValue(Interval<int>(rowCount(), first - 1), true);
     if (first + num_rows > rowCount())
@@ -930,6 +1027,8 @@ void Column::Private::replaceDateTimes(int first, const QList<QDateTime> &new_va
         static_cast<QList<QDateTime> *>(d_data)->replace(first + i, new_values.at(i));
         d_validity.setValue(i, !new_values.at(i).isValid());
     }
+    touch();
+    emit d_owner->rowsChanged(d_owner, first_changed, first + num_rows - 1);
     emit d_owner->dataChanged(d_owner);
 }
 
@@ -939,6 +1038,7 @@ void Column::Private::setValueAt(int row, double new_value)
         return;
 
     emit d_owner->dataAboutToChange(d_owner);
+    int first_changed = qMin(row, rowCount());
     if (row >= rowCount()) {
         if (row + 1 - rowCount() > 1) // we are adding more than one row in resizeTo()
             d_validity.setValue(Interval<int>(rowCount(), row - 1), true);
@@ -947,6 +1047,8 @@ void Column::Private::setValueAt(int row, double new_value)
 
     static_cast<QVector<double> *>(d_data)->replace(row, new_value);
     d_validity.setValue(Interval<int>(row, row), false);
+    touch();
+    emit d_owner->rowsChanged(d_owner, first_changed, row);
     emit d_owner->dataChanged(d_owner);
 }
 
@@ -957,6 +1059,7 @@ void Column::Private::replaceValues(int first, const QVector<qreal> &new_values)
 
     emit d_owner->dataAboutToChange(d_owner);
     int num_rows = new_values.size();
+    int first_changed = qMin(first, rowCount());
     if (first + 1 - rowCount() > 1)
         d_validity.setValue(Interval<int>(rowCount(), first - 1), true);
     if (first + num_rows > rowCount())
@@ -966,9 +1069,128 @@ void Column::Private::replaceValues(int first, const QVector<qreal> &new_values)
     for (int i = 0; i < num_rows; i++)
         ptr[first + i] = new_values.at(i);
     d_validity.setValue(Interval<int>(first, first + num_rows - 1), false);
+    touch();
+    emit d_owner->rowsChanged(d_owner, first_changed, first + num_rows - 1);
     emit d_owner->dataChanged(d_owner);
 }
 
+namespace {
+//! Return the runs of rows i < flags.size() for which flags[permutation[i]] is set
+QList<Interval<int>> permutedRuns(const QVector<bool> &flags, const QVector<int> &permutation)
+{
+    QList<Interval<int>> runs;
+    int start = -1;
+    for (int i = 0; i < permutation.size(); i++) {
+        if (flags.at(permutation.at(i))) {
+            if (start < 0)
+                start = i;
+        } else if (start >= 0) {
+            runs << Interval<int>(start, i - 1);
+            start = -1;
+        }
+    }
+    if (start >= 0)
+        runs << Interval<int>(start, permutation.size() - 1);
+    return runs;
+}
+
+//! Apply 'permutation' to the first permutation.size() rows of a bool attribute
+IntervalAttribute<bool> permuted(const IntervalAttribute<bool> &attribute,
+                                 const QVector<int> &permutation)
+{
+    const int rows = permutation.size();
+    const QList<Interval<int>> intervals = attribute.intervals();
+    if (intervals.isEmpty())
+        return attribute;
+
+    QVector<bool> flags(rows, false);
+    QList<Interval<int>> beyond;
+    for (const Interval<int> &iv : intervals) {
+        for (int row = iv.start(); row <= qMin(iv.end(), rows - 1); row++)
+            flags[row] = true;
+        if (iv.end() >= rows)
+            beyond << Interval<int>(qMax(iv.start(), rows), iv.end());
+    }
+    QList<Interval<int>> result = permutedRuns(flags, permutation);
+    for (const Interval<int> &iv : beyond)
+        Interval<int>::mergeIntervalIntoList(&result, iv);
+    return IntervalAttribute<bool>(result);
+}
+
+//! Apply 'permutation' to the first permutation.size() rows of the formulas
+IntervalAttribute<QString> permuted(const IntervalAttribute<QString> &attribute,
+                                    const QVector<int> &permutation)
+{
+    const int rows = permutation.size();
+    const QList<Interval<int>> intervals = attribute.intervals();
+    if (intervals.isEmpty())
+        return attribute;
+
+    QVector<QString> formulas(rows);
+    for (int c = 0; c < intervals.size(); c++)
+        for (int row = intervals.at(c).start(); row <= qMin(intervals.at(c).end(), rows - 1);
+             row++)
+            formulas[row] = attribute.values().at(c);
+
+    // runs of equal formulas, ignoring rows without one
+    QList<Interval<int>> runs;
+    QList<QString> values;
+    for (int i = 0; i < rows;) {
+        const QString &formula = formulas.at(permutation.at(i));
+        int end = i + 1;
+        while (end < rows && formulas.at(permutation.at(end)) == formula)
+            end++;
+        if (!formula.isEmpty()) {
+            runs << Interval<int>(i, end - 1);
+            values << formula;
+        }
+        i = end;
+    }
+    IntervalAttribute<QString> result(runs, values);
+    for (int c = 0; c < intervals.size(); c++)
+        if (intervals.at(c).end() >= rows)
+            result.setValue(Interval<int>(qMax(intervals.at(c).start(), rows), intervals.at(c).end()),
+                            attribute.values().at(c));
+    return result;
+}
+
+//! Move element permutation[i] of 'list' to position i
+template<class List>
+void permuteList(List *list, const QVector<int> &permutation)
+{
+    const List old = *list;
+    for (int i = 0; i < permutation.size(); i++)
+        (*list)[i] = old.at(permutation.at(i));
+}
+} // namespace
+
+void Column::Private::permuteRows(const QVector<int> &permutation)
+{
+    if (permutation.isEmpty())
+        return;
+
+    emit d_owner->dataAboutToChange(d_owner);
+    emit d_owner->maskingAboutToChange(d_owner);
+    switch (d_data_type) {
+    case SciDAVis::TypeDouble:
+        permuteList(static_cast<QVector<double> *>(d_data), permutation);
+        break;
+    case SciDAVis::TypeQString:
+        permuteList(static_cast<QStringList *>(d_data), permutation);
+        break;
+    case SciDAVis::TypeQDateTime:
+        permuteList(static_cast<QList<QDateTime> *>(d_data), permutation);
+        break;
+    }
+    d_validity = permuted(d_validity, permutation);
+    d_masking = permuted(d_masking, permutation);
+    d_formulas = permuted(d_formulas, permutation);
+    touch();
+    emit d_owner->rowsChanged(d_owner, 0, permutation.size() - 1);
+    emit d_owner->dataChanged(d_owner);
+    emit d_owner->maskingChanged(d_owner);
+}
+
 NumericDateTimeBaseFilter *Column::Private::getNumericDateTimeFilter()
 {
     return d_numeric_datetime_filter.data();
@@ -983,6 +1205,7 @@ void Column::Private::replaceMasking(IntervalAttribute<bool> masking)
 {
     emit d_owner->maskingAboutToChange(d_owner);
     d_masking = masking;
+    touch();
     emit d_owner->maskingChanged(d_owner);
 }
 
@@ -81,6 +81,14 @@ public:
      * Use a filter to convert a column to another type.
      */
     bool copy(const AbstractColumn *other);
+    //! Replace the data by 'source' converted by 'converter' (connected to 'source')
+    /**
+     * Converts all rows at once using AbstractSimpleFilter::convertRows(), which is much faster
+     * than copy(converter->output(0)). 'source_data' is the data vector of 'source'. Returns
+     * false, without changing the data, if the converter does not support this.
+     */
+    bool convert(const AbstractFilter *converter, const AbstractColumn *source,
+                 const void *source_data);
     //! Copies a part of another column of the same type
     /**
      * This function will return false if the data type
@@ -283,6 +291,21 @@ public:
     void replaceDateTimes(int first, const QList<QDateTime> &new_values);
     //! Return the double value in row 'row'
     double valueAt(int row) const;
+    //! Return the (implicitly shared) data vector
+    /**
+     * Use this only when dataType() is double
+     */
+    QVector<qreal> values() const;
+    //! Return the (implicitly shared) list of strings
+    /**
+     * Use this only when dataType() is QString
+     */
+    QStringList texts() const;
+    //! Return the (implicitly shared) list of date-time values
+    /**
+     * Use this only when dataType() is QDateTime
+     */
+    QList<QDateTime> dateTimes() const;
     //! Set the content of row 'row'
     /**
      * Use this only when dataType() is double
@@ -294,12 +317,23 @@ public:
      */
     void replaceValues(int first, const QVector<qreal> &new_values);
     //@}
+    //! Move the content of row permutation[i] to row i, for all rows i < permutation.size()
+    /**
+     * Data, validity, masking and formulas are moved. The column must have at least
+     * permutation.size() rows.
+     */
+    void permuteRows(const QVector<int> &permutation);
     //! Get current conversion filter from DateTime to double
     NumericDateTimeBaseFilter *getNumericDateTimeFilter();
     //! Set current conversion filter from DateTime to double with taking an ownership
     void setNumericDateTimeFilter(NumericDateTimeBaseFilter *const);
+    //! Return the current version of data, validity, masking and mode
+    quint64 version() const { return d_version; }
 
 private:
+    //! Assign a new version, to be called after every modification
+    void touch();
+
     //! \name data members
     //@{
     //! Data type string
@@ -333,6 +367,8 @@ private:
     SciDAVis::PlotDesignation d_plot_designation;
     //! The owner column
     Column *d_owner;
+    //! Changes on every modification; unique among all columns
+    quint64 d_version;
     //@}
 };
 
@@ -29,6 +29,71 @@
 
 #include "ColumnPrivate.h"
 #include "columncommands.h"
+#include "lib/RowSorter.h"
+
+#include <cstring>
+
+namespace {
+//! Move the values of a numeric backup column into the undo storage
+void storeBackup(const QUndoCommand *owner, Column::Private *backup, UndoBlob *blob)
+{
+    if (backup->dataType() != SciDAVis::TypeDouble)
+        return;
+    QVector<qreal> *values = static_cast<QVector<qreal> *>(backup->dataPointer());
+    blob->storeValues(owner, *values);
+    QVector<qreal>().swap(*values);
+}
+
+//! Inverse of storeBackup()
+void restoreBackup(Column::Private *backup, UndoBlob *blob)
+{
+    if (blob->isNull())
+        return;
+    *static_cast<QVector<qreal> *>(backup->dataPointer()) = blob->values();
+    blob->clear();
+}
+
+//! Number of rows per block compared by ColumnReplaceValuesCmd
+const int ValueBlock = 1024;
+
+//! Return the indices of the blocks of ValueBlock values which differ between a and b
+QVector<int> changedBlocks(const QVector<qreal> &a, const QVector<qreal> &b)
+{
+    Q_ASSERT(a.size() == b.size());
+    QVector<int> result;
+    for (int first = 0; first < a.size(); first += ValueBlock) {
+        const int count = qMin(ValueBlock, a.size() - first);
+        // compare bitwise, so that NaNs are equal and 0.0 and -0.0 are not
+        if (memcmp(a.constData() + first, b.constData() + first, count * sizeof(qreal)) != 0)
+            result << first / ValueBlock;
+    }
+    return result;
+}
+
+//! Return the values of the given blocks, concatenated
+QVector<qreal> gatherBlocks(const QVector<qreal> &values, const QVector<int> &blocks)
+{
+    QVector<qreal> result;
+    for (int block : blocks) {
+        const int first = block * ValueBlock;
+        result << values.mid(first, qMin(ValueBlock, values.size() - first));
+    }
+    return result;
+}
+
+//! Inverse of gatherBlocks()
+void scatterBlocks(QVector<qreal> &values, const QVector<int> &blocks,
+                   const QVector<qreal> &gathered)
+{
+    const qreal *source = gathered.constData();
+    for (int block : blocks) {
+        const int first = block * ValueBlock;
+        const int count = qMin(ValueBlock, values.size() - first);
+        memcpy(values.data() + first, source, count * sizeof(qreal));
+        source += count;
+    }
+}
+} // namespace
 
 ///////////////////////////////////////////////////////////////////////////
 // class ColumnSetModeCmd
@@ -133,21 +198,25 @@ void ColumnFullCopyCmd::redo()
         d_backup->copy(d_col);
         d_col->copy(d_src);
     } else {
+        restoreBackup(d_backup, &d_backup_values);
         // swap data + validity of orig. column and backup
         IntervalAttribute<bool> val_temp = d_col->invalidIntervals();
         void *data_temp = d_col->dataPointer();
         d_col->replaceData(d_backup->dataPointer(), d_backup->validityAttribute());
         d_backup->replaceData(data_temp, val_temp);
     }
+    storeBackup(this, d_backup, &d_backup_values);
 }
 
 void ColumnFullCopyCmd::undo()
 {
+    restoreBackup(d_backup, &d_backup_values);
     // swap data + validity of orig. column and backup
     IntervalAttribute<bool> val_temp = d_col->validityAttribute();
     void *data_temp = d_col->dataPointer();
     d_col->replaceData(d_backup->dataPointer(), d_backup->validityAttribute());
     d_backup->replaceData(data_temp, val_temp);
+    storeBackup(this, d_backup, &d_backup_values);
 }
 
 ///////////////////////////////////////////////////////////////////////////
@@ -265,6 +334,7 @@ void ColumnRemoveRowsCmd::redo()
         d_backup_owner = new Column("temp", d_col->columnMode());
         d_backup = new Column::Private(d_backup_owner, d_col->columnMode());
         d_backup->copy(d_col, d_first, 0, d_data_row_count);
+        storeBackup(this, d_backup, &d_backup_values);
         d_masking = d_col->maskingAttribute();
         d_formulas = d_col->formulaAttribute();
     }
@@ -274,7 +344,9 @@ void ColumnRemoveRowsCmd::redo()
 void ColumnRemoveRowsCmd::undo()
 {
     d_col->insertRows(d_first, d_count);
+    restoreBackup(d_backup, &d_backup_values);
     d_col->copy(d_backup, 0, d_first, d_data_row_count);
+    storeBackup(this, d_backup, &d_backup_values);
     d_col->resizeTo(d_old_size);
     d_col->replaceMasking(d_masking);
     d_col->replaceFormulas(d_formulas);
@@ -701,7 +773,11 @@ void ColumnReplaceTextsCmd::undo()
 ColumnReplaceValuesCmd::ColumnReplaceValuesCmd(Column::Private *col, int first,
                                                const QVector<qreal> &new_values,
                                                QUndoCommand *parent)
-    : QUndoCommand(parent), d_col(col), d_first(first), d_new_values(new_values)
+    : QUndoCommand(parent),
+      d_col(col),
+      d_first(first),
+      d_count(new_values.count()),
+      d_new_values(new_values)
 {
     setText(QObject::tr("%1: replace the values for rows %2 to %3")
                     .arg(col->name())
@@ -712,21 +788,38 @@ ColumnReplaceValuesCmd::ColumnReplaceValuesCmd(Column::Private *col, int first,
 
 ColumnReplaceValuesCmd::~ColumnReplaceValuesCmd() { }
 
+QVector<qreal> ColumnReplaceValuesCmd::patchedValues(const UndoBlob &blocks) const
+{
+    QVector<qreal> result =
+            static_cast<QVector<qreal> *>(d_col->dataPointer())->mid(d_first, d_count);
+    // rows beyond the end of the column compare as 0.0, see redo()
+    result.resize(d_count);
+    scatterBlocks(result, d_changed_blocks, blocks.values());
+    return result;
+}
+
 void ColumnReplaceValuesCmd::redo()
 {
     if (!d_copied) {
-        d_old_values = static_cast<QVector<qreal> *>(d_col->dataPointer())
-                               ->mid(d_first, d_new_values.count());
+        // only keep the blocks of rows which actually change
+        QVector<qreal> old_values =
+                static_cast<QVector<qreal> *>(d_col->dataPointer())->mid(d_first, d_count);
+        old_values.resize(d_count);
+        d_changed_blocks = changedBlocks(old_values, d_new_values);
+        d_old_blocks.storeValues(this, gatherBlocks(old_values, d_changed_blocks));
+        d_new_blocks.storeValues(this, gatherBlocks(d_new_values, d_changed_blocks));
         d_row_count = d_col->rowCount();
         d_validity = d_col->validityAttribute();
         d_copied = true;
-    }
-    d_col->replaceValues(d_first, d_new_values);
+        d_col->replaceValues(d_first, d_new_values);
+        d_new_values = QVector<qreal>();
+    } else
+        d_col->replaceValues(d_first, patchedValues(d_new_blocks));
 }
 
 void ColumnReplaceValuesCmd::undo()
 {
-    d_col->replaceValues(d_first, d_old_values);
+    d_col->replaceValues(d_first, patchedValues(d_old_blocks));
     d_col->resizeTo(d_row_count);
     d_col->replaceData(d_col->dataPointer(), d_validity);
 }
@@ -774,3 +867,48 @@ void ColumnReplaceDateTimesCmd::undo()
 ///////////////////////////////////////////////////////////////////////////
 // end of class ColumnReplaceDateTimesCmd
 ///////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////
+// class ColumnPermuteRowsCmd
+///////////////////////////////////////////////////////////////////////////
+ColumnPermuteRowsCmd::ColumnPermuteRowsCmd(Column::Private *col, const QVector<int> &permutation,
+                                           QUndoCommand *parent)
+    : QUndoCommand(parent), d_col(col), d_permutation(permutation)
+{
+    setText(QObject::tr("%1: reorder rows").arg(col->name()));
+    d_copied = false;
+}
+
+ColumnPermuteRowsCmd::~ColumnPermuteRowsCmd() { }
+
+void ColumnPermuteRowsCmd::redo()
+{
+    if (!d_copied) {
+        d_row_count = d_col->rowCount();
+        d_validity = d_col->validityAttribute();
+        d_copied = true;
+    }
+    if (d_row_count < d_permutation.size()) {
+        // the missing rows are moved around as invalid ones
+        IntervalAttribute<bool> validity = d_validity;
+        validity.setValue(Interval<int>(d_row_count, d_permutation.size() - 1), true);
+        d_col->resizeTo(d_permutation.size());
+        d_col->replaceData(d_col->dataPointer(), validity);
+    }
+    d_col->permuteRows(d_permutation);
+}
+
+void ColumnPermuteRowsCmd::undo()
+{
+    if (d_inverse.isEmpty())
+        d_inverse = RowSorter::inverse(d_permutation);
+    d_col->permuteRows(d_inverse);
+    if (d_row_count < d_permutation.size()) {
+        d_col->resizeTo(d_row_count);
+        d_col->replaceData(d_col->dataPointer(), d_validity);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////
+// end of class ColumnPermuteRowsCmd
+///////////////////////////////////////////////////////////////////////////
@@ -34,6 +34,7 @@
 #include <QStringList>
 #include "core/column/Column.h"
 #include "core/AbstractSimpleFilter.h"
+#include "core/UndoStorage.h"
 #include "lib/IntervalAttribute.h"
 
 ///////////////////////////////////////////////////////////////////////////
@@ -123,6 +124,8 @@ private:
      * replacement without too much copying.
      */
     Column *d_backup_owner;
+    //! The values of a numeric backup column, while not needed
+    UndoBlob d_backup_values;
 };
 ///////////////////////////////////////////////////////////////////////////
 // end of class ColumnFullCopyCmd
@@ -250,6 +253,8 @@ private:
      * replacement without too much copying.
      */
     Column *d_backup_owner;
+    //! The values of a numeric backup column, while not needed
+    UndoBlob d_backup_values;
     //! Backup of the masking attribute
     IntervalAttribute<bool> d_masking;
     //! Backup of the formula attribute
@@ -679,12 +684,21 @@ public:
 private:
     //! The private column data to modify
     Column::Private *d_col;
+    //! Return the values of rows d_first to d_first + d_count - 1 with 'blocks' applied
+    QVector<qreal> patchedValues(const UndoBlob &blocks) const;
+
     //! The first row to replace
     int d_first;
-    //! The new values
+    //! The number of rows to replace
+    int d_count;
+    //! The new values, until the command is executed the first time
     QVector<qreal> d_new_values;
-    //! The old values
-    QVector<qreal> d_old_values;
+    //! The blocks of rows which actually change (see changedBlocks())
+    QVector<int> d_changed_blocks;
+    //! The new values of the changed blocks
+    UndoBlob d_new_blocks;
+    //! The old values of the changed blocks
+    UndoBlob d_old_blocks;
     //! Status flag
     bool d_copied;
     //! The old number of rows
@@ -734,4 +748,40 @@ private:
 // end of class ColumnReplaceDateTimesCmd
 ///////////////////////////////////////////////////////////////////////////
 
+///////////////////////////////////////////////////////////////////////////
+// class ColumnPermuteRowsCmd
+///////////////////////////////////////////////////////////////////////////
+//! Reorder the rows of a column
+class ColumnPermuteRowsCmd : public QUndoCommand
+{
+public:
+    //! Ctor
+    ColumnPermuteRowsCmd(Column::Private *col, const QVector<int> &permutation,
+                         QUndoCommand *parent = 0);
+    //! Dtor
+    ~ColumnPermuteRowsCmd();
+
+    //! Execute the command
+    virtual void redo();
+    //! Undo the command
+    virtual void undo();
+
+private:
+    //! The private column data to modify
+    Column::Private *d_col;
+    //! Row i receives the content of row d_permutation[i]
+    QVector<int> d_permutation;
+    //! The inverse of d_permutation (computed on first undo)
+    QVector<int> d_inverse;
+    //! Status flag
+    bool d_copied;
+    //! The old number of rows
+    int d_row_count;
+    //! The old validity
+    IntervalAttribute<bool> d_validity;
+};
+///////////////////////////////////////////////////////////////////////////
+// end of class ColumnPermuteRowsCmd
+///////////////////////////////////////////////////////////////////////////
+
 #endif
@@ -52,6 +52,17 @@ public:
         QDateTime input_value = d_inputs.value(0)->dateTimeAt(row);
         return offsetToDouble(input_value);
     }
+    virtual bool convertRows(const void *input, void *output, char *invalid, int rows) const
+    {
+        Q_UNUSED(invalid)
+        const QList<QDateTime> &dates = *static_cast<const QList<QDateTime> *>(input);
+        double *values = static_cast<QVector<double> *>(output)->data();
+        convertBlocks(rows, [&](int first, int last) {
+            for (int row = first; row < last; row++)
+                values[row] = offsetToDouble(dates.at(row));
+        });
+        return true;
+    }
 
     //! Return the data type of the column
     virtual SciDAVis::ColumnDataType dataType() const { return SciDAVis::TypeDouble; }
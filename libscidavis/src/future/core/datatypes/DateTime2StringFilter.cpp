@@ -29,6 +29,7 @@
  ***************************************************************************/
 
 #include "DateTime2StringFilter.h"
+#include "FixedDateTimeFormat.h"
 #include "lib/XmlStreamReader.h"
 #include <QXmlStreamWriter>
 
@@ -62,6 +63,25 @@ void DateTime2StringFilterSetFormatCmd::undo()
     redo();
 }
 
+bool DateTime2StringFilter::convertRows(const void *input, void *output, char *invalid,
+                                        int rows) const
+{
+    Q_UNUSED(invalid)
+    const QList<QDateTime> &dates = *static_cast<const QList<QDateTime> *>(input);
+    QStringList::iterator texts = static_cast<QStringList *>(output)->begin();
+    const FixedDateTimeFormat fixed_format(d_format);
+    convertBlocks(rows, [&](int first, int last) {
+        for (int row = first; row < last; row++) {
+            QDateTime input_value = dates.at(row);
+            if (!input_value.date().isValid() && input_value.time().isValid())
+                input_value.setDate(QDate(1900, 1, 1));
+            QString result = fixed_format.format(input_value);
+            texts[row] = result.isNull() ? dateTimeToString(input_value) : result;
+        }
+    });
+    return true;
+}
+
 void DateTime2StringFilter::writeExtraAttributes(QXmlStreamWriter *writer) const
 {
     writer->writeAttribute("format", format());
@@ -66,12 +66,9 @@ private:
     //! The format string.
     QString d_format;
 
-public:
-    virtual QString textAt(int row) const
+    //! Convert a single date-time using d_format
+    QString dateTimeToString(QDateTime input_value) const
     {
-        if (!d_inputs.value(0))
-            return QString();
-        QDateTime input_value = d_inputs.value(0)->dateTimeAt(row);
         if (!input_value.date().isValid() && input_value.time().isValid())
             input_value.setDate(QDate(1900, 1, 1));
 #if QT_VERSION < 0x040302 // the bug seems to be fixed in Qt 4.3.2
@@ -90,6 +87,15 @@ public:
 #endif
     }
 
+public:
+    virtual QString textAt(int row) const
+    {
+        if (!d_inputs.value(0))
+            return QString();
+        return dateTimeToString(d_inputs.value(0)->dateTimeAt(row));
+    }
+    virtual bool convertRows(const void *input, void *output, char *invalid, int rows) const;
+
     //! \name XML related functions
     //@{
     virtual void writeExtraAttributes(QXmlStreamWriter *writer) const;
@@ -58,6 +58,17 @@ public:
         double input_value = d_inputs.value(0)->valueAt(row);
         return makeDateTime(input_value);
     }
+    virtual bool convertRows(const void *input, void *output, char *invalid, int rows) const
+    {
+        Q_UNUSED(invalid)
+        const QVector<double> &values = *static_cast<const QVector<double> *>(input);
+        QList<QDateTime>::iterator dates = static_cast<QList<QDateTime> *>(output)->begin();
+        convertBlocks(rows, [&](int first, int last) {
+            for (int row = first; row < last; row++)
+                dates[row] = makeDateTime(values.at(row));
+        });
+        return true;
+    }
 
     //! Return the data type of the column
     virtual SciDAVis::ColumnDataType dataType() const { return SciDAVis::TypeQDateTime; }
@@ -44,9 +44,7 @@ public:
     {
         if (!d_inputs.value(0))
             return QDate();
-        // Don't use Julian days here since support for years < 1 is bad
-        // Use 1900-01-01 instead (a Monday)
-        return QDate(1900, 1, 1).addDays(qRound(d_inputs.value(0)->valueAt(row) - 1.0));
+        return dayOfWeekDate(d_inputs.value(0)->valueAt(row));
     }
     virtual QTime timeAt(int row) const
     {
@@ -54,11 +52,29 @@ public:
         return QTime(0, 0, 0, 0);
     }
     virtual QDateTime dateTimeAt(int row) const { return QDateTime(dateAt(row), timeAt(row)); }
+    virtual bool convertRows(const void *input, void *output, char *invalid, int rows) const
+    {
+        Q_UNUSED(invalid)
+        const QVector<double> &values = *static_cast<const QVector<double> *>(input);
+        QList<QDateTime>::iterator dates = static_cast<QList<QDateTime> *>(output)->begin();
+        convertBlocks(rows, [&](int first, int last) {
+            for (int row = first; row < last; row++)
+                dates[row] = QDateTime(dayOfWeekDate(values.at(row)), QTime(0, 0, 0, 0));
+        });
+        return true;
+    }
 
     //! Return the data type of the column
     virtual SciDAVis::ColumnDataType dataType() const { return SciDAVis::TypeQDateTime; }
 
 protected:
+    static QDate dayOfWeekDate(double input_value)
+    {
+        // Don't use Julian days here since support for years < 1 is bad
+        // Use 1900-01-01 instead (a Monday)
+        return QDate(1900, 1, 1).addDays(qRound(input_value - 1.0));
+    }
+
     //! Using typed ports: only double inputs are accepted.
     virtual bool inputAcceptable(int, const AbstractColumn *source)
     {
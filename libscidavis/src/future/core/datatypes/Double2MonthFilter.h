@@ -47,7 +47,26 @@ public:
     {
         if (!d_inputs.value(0))
             return QDateTime();
-        double input_value = d_inputs.value(0)->valueAt(row);
+        return monthDateTime(d_inputs.value(0)->valueAt(row));
+    }
+    virtual bool convertRows(const void *input, void *output, char *invalid, int rows) const
+    {
+        Q_UNUSED(invalid)
+        const QVector<double> &values = *static_cast<const QVector<double> *>(input);
+        QList<QDateTime>::iterator dates = static_cast<QList<QDateTime> *>(output)->begin();
+        convertBlocks(rows, [&](int first, int last) {
+            for (int row = first; row < last; row++)
+                dates[row] = monthDateTime(values.at(row));
+        });
+        return true;
+    }
+
+    //! Return the data type of the column
+    virtual SciDAVis::ColumnDataType dataType() const { return SciDAVis::TypeQDateTime; }
+
+protected:
+    static QDateTime monthDateTime(double input_value)
+    {
         // Don't use Julian days here since support for years < 1 is bad
         // Use 1900-01-01 instead
         QDate result_date = QDate(1900, 1, 1).addMonths(qRound(input_value - 1.0));
@@ -55,10 +74,6 @@ public:
         return QDateTime(result_date, result_time);
     }
 
-    //! Return the data type of the column
-    virtual SciDAVis::ColumnDataType dataType() const { return SciDAVis::TypeQDateTime; }
-
-protected:
     virtual bool inputAcceptable(int, const AbstractColumn *source)
     {
         return source->dataType() == SciDAVis::TypeDouble;
@@ -85,6 +85,18 @@ public:
             return QString();
         return QLocale().toString(d_inputs.value(0)->valueAt(row), d_format, d_digits);
     }
+    virtual bool convertRows(const void *input, void *output, char *invalid, int rows) const
+    {
+        const QVector<double> &values = *static_cast<const QVector<double> *>(input);
+        QStringList::iterator texts = static_cast<QStringList *>(output)->begin();
+        const QLocale locale;
+        convertBlocks(rows, [&](int first, int last) {
+            for (int row = first; row < last; row++)
+                if (!invalid[row])
+                    texts[row] = locale.toString(values.at(row), d_format, d_digits);
+        });
+        return true;
+    }
 
 protected:
     //! Using typed ports: only double inputs are accepted.
@@ -0,0 +1,115 @@
+/***************************************************************************
+    File                 : FixedDateTimeFormat.cpp
+    Project              : SciDAVis
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 SciDAVis developers
+    Description          : Fast conversion of fixed width date-time strings
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "FixedDateTimeFormat.h"
+
+FixedDateTimeFormat::FixedDateTimeFormat(const QString &format) : d_length(0), d_valid(true)
+{
+    for (int i = 0; i < format.size() && d_valid;) {
+        const QChar c = format.at(i);
+        int run = 1;
+        while (i + run < format.size() && format.at(i + run) == c)
+            run++;
+        Token token = { Literal, 1, c };
+        if (c == 'y' && run == 4)
+            token.field = Year;
+        else if (c == 'M' && run == 2)
+            token.field = Month;
+        else if (c == 'd' && run == 2)
+            token.field = Day;
+        else if ((c == 'h' || c == 'H') && run == 2)
+            token.field = Hour;
+        else if (c == 'm' && run == 2)
+            token.field = Minute;
+        else if (c == 's' && run == 2)
+            token.field = Second;
+        else if (c == 'z' && run == 3)
+            token.field = Millisecond;
+        else if (c.isLetter() || c == '\'')
+            d_valid = false;
+        else
+            run = 1;
+        if (token.field != Literal)
+            token.width = run;
+        d_tokens << token;
+        d_length += token.width;
+        i += run;
+    }
+}
+
+QDateTime FixedDateTimeFormat::parse(const QString &text) const
+{
+    if (!d_valid || text.size() != d_length)
+        return QDateTime();
+    int fields[Millisecond + 1] = { 0, 1900, 1, 1, 0, 0, 0, 0 };
+    const QChar *c = text.constData();
+    for (const Token &token : d_tokens) {
+        if (token.field == Literal) {
+            if (*c++ != token.literal)
+                return QDateTime();
+            continue;
+        }
+        int value = 0;
+        for (int i = 0; i < token.width; ++i, ++c) {
+            const ushort digit = c->unicode() - '0';
+            if (digit > 9)
+                return QDateTime();
+            value = 10 * value + digit;
+        }
+        fields[token.field] = value;
+    }
+    const QDate date(fields[Year], fields[Month], fields[Day]);
+    const QTime time(fields[Hour], fields[Minute], fields[Second], fields[Millisecond]);
+    if (!date.isValid() || !time.isValid())
+        return QDateTime();
+    return QDateTime(date, time);
+}
+
+QString FixedDateTimeFormat::format(const QDateTime &date_time) const
+{
+    const QDate date = date_time.date();
+    const QTime time = date_time.time();
+    if (!d_valid || !date.isValid() || !time.isValid() || date.year() < 0 || date.year() > 9999)
+        return QString();
+    const int fields[Millisecond + 1] = { 0,           date.year(),   date.month(), date.day(),
+                                          time.hour(), time.minute(), time.second(), time.msec() };
+    QString result(d_length, Qt::Uninitialized);
+    QChar *c = result.data();
+    for (const Token &token : d_tokens) {
+        if (token.field == Literal) {
+            *c++ = token.literal;
+            continue;
+        }
+        int value = fields[token.field];
+        for (int i = token.width - 1; i >= 0; --i, value /= 10)
+            c[i] = QChar('0' + value % 10);
+        c += token.width;
+    }
+    return result;
+}
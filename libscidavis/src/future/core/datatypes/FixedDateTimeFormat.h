@@ -0,0 +1,85 @@
+/***************************************************************************
+    File                 : FixedDateTimeFormat.h
+    Project              : SciDAVis
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 SciDAVis developers
+    Description          : Fast conversion of fixed width date-time strings
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef FIXED_DATE_TIME_FORMAT_H
+#define FIXED_DATE_TIME_FORMAT_H
+
+#include <QDateTime>
+#include <QString>
+#include <QVector>
+
+//! Date-time format with fields of fixed width, converted without QDateTime::fromString()
+/**
+  Formats built only of the fields yyyy, MM, dd, hh, HH, mm, ss and zzz and of
+  literal characters other than letters and quotes (e.g. the default
+  "yyyy-MM-dd hh:mm:ss.zzz") are compiled once into a list of fields, which
+  converts much faster than parsing the format string for every row.
+
+  parse() and format() only handle the simple cases and return null values
+  otherwise, so that the caller falls back to QDateTime.
+  */
+class FixedDateTimeFormat
+{
+public:
+    //! Compile the format string (see QDateTime::toString())
+    explicit FixedDateTimeFormat(const QString &format);
+
+    //! Whether the format consists of fixed width fields only
+    bool isValid() const { return d_valid; }
+    //! Return the date-time 'text' represents in this format
+    /**
+     * Returns an invalid QDateTime if 'text' doesn't match the format exactly or the date or time
+     * is invalid; QDateTime::fromString() may still accept it (e.g. with missing leading zeros).
+     * As with QDateTime::fromString(), fields missing in the format default to 1900-01-01
+     * 00:00:00.000.
+     */
+    QDateTime parse(const QString &text) const;
+    //! Return 'date_time' in this format, same as QDateTime::toString()
+    /**
+     * Returns a null string if the date or time is invalid or the year is outside 0..9999.
+     */
+    QString format(const QDateTime &date_time) const;
+
+private:
+    enum Field { Literal, Year, Month, Day, Hour, Minute, Second, Millisecond };
+    struct Token
+    {
+        Field field;
+        //! The number of digits, or 1 for literals
+        int width;
+        QChar literal;
+    };
+
+    QVector<Token> d_tokens;
+    //! Length of the formatted strings
+    int d_length;
+    bool d_valid;
+};
+
+#endif // ifndef FIXED_DATE_TIME_FORMAT_H
@@ -51,6 +51,17 @@ public:
             return 0;
         return double(d_inputs.value(0)->dateAt(row).month());
     }
+    virtual bool convertRows(const void *input, void *output, char *invalid, int rows) const
+    {
+        Q_UNUSED(invalid)
+        const QList<QDateTime> &dates = *static_cast<const QList<QDateTime> *>(input);
+        double *values = static_cast<QVector<double> *>(output)->data();
+        convertBlocks(rows, [&](int first, int last) {
+            for (int row = first; row < last; row++)
+                values[row] = double(dates.at(row).date().month());
+        });
+        return true;
+    }
 
     //! Return the data type of the column
     virtual SciDAVis::ColumnDataType dataType() const { return SciDAVis::TypeDouble; }
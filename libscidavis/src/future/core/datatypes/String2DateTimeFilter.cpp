@@ -28,6 +28,7 @@
  *                                                                         *
  ***************************************************************************/
 #include "String2DateTimeFilter.h"
+#include "FixedDateTimeFormat.h"
 #include <QStringList>
 #include "lib/XmlStreamReader.h"
 #include <QXmlStreamWriter>
@@ -52,7 +53,31 @@ QDateTime String2DateTimeFilter::dateTimeAt(int row) const
 {
     if (!d_inputs.value(0))
         return QDateTime();
-    QString input_value = d_inputs.value(0)->textAt(row);
+    return dateTimeFromString(d_inputs.value(0)->textAt(row));
+}
+
+bool String2DateTimeFilter::convertRows(const void *input, void *output, char *invalid,
+                                        int rows) const
+{
+    const QStringList &texts = *static_cast<const QStringList *>(input);
+    QList<QDateTime>::iterator dates = static_cast<QList<QDateTime> *>(output)->begin();
+    // usually all rows are in the selected format, so parse it without QDateTime::fromString()
+    // if possible and only fall back to the full conversion for the others
+    const FixedDateTimeFormat fixed_format(d_format);
+    convertBlocks(rows, [&](int first, int last) {
+        for (int row = first; row < last; row++) {
+            QDateTime result = fixed_format.parse(texts.at(row));
+            if (!result.isValid())
+                result = dateTimeFromString(texts.at(row));
+            dates[row] = result;
+            invalid[row] = invalid[row] || !result.isValid();
+        }
+    });
+    return true;
+}
+
+QDateTime String2DateTimeFilter::dateTimeFromString(const QString &input_value) const
+{
     if (input_value.isEmpty())
         return QDateTime();
 
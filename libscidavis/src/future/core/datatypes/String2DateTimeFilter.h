@@ -81,10 +81,14 @@ private:
     static const QStringList date_formats;
     static const QStringList time_formats;
 
+    //! Convert a single string, trying d_format first and the common formats as fallback
+    QDateTime dateTimeFromString(const QString &input_value) const;
+
 public:
     virtual QDateTime dateTimeAt(int row) const;
     virtual QDate dateAt(int row) const { return dateTimeAt(row).date(); }
     virtual QTime timeAt(int row) const { return dateTimeAt(row).time(); }
+    virtual bool convertRows(const void *input, void *output, char *invalid, int rows) const;
     virtual bool isInvalid(int row) const
     {
         const AbstractColumn *col = d_inputs.value(0);
@@ -51,38 +51,19 @@ public:
         if (!d_inputs.value(0))
             return QDateTime();
 
-        QString input_value = d_inputs.value(0)->textAt(row);
-        if (input_value.isEmpty())
-            return QDateTime();
-        bool ok;
-        int day_value = input_value.toInt(&ok);
-        if (!ok) {
-#if QT_VERSION <= 0x040300
-            // workaround for Qt bug #171920
-            QDate temp = QDate(1900, 1, 1);
-            for (int i = 1; i <= 7; i++)
-                if ((input_value.toLower() == QDate::longDayName(i).toLower())
-                    || (input_value.toLower() == QDate::shortDayName(i).toLower())) {
-                    temp = QDate(1900, 1, i);
-                    break;
-                }
-
-#else
-            QDate temp = QDate::fromString(input_value, "ddd");
-            if (!temp.isValid())
-                temp = QDate::fromString(input_value, "dddd");
-#endif
-            if (!temp.isValid())
-                return QDateTime();
-            else
-                day_value = temp.dayOfWeek();
-        }
-
-        // Don't use Julian days here since support for years < 1 is bad
-        // Use 1900-01-01 instead (a Monday)
-        QDate result_date = QDate(1900, 1, 1).addDays(day_value - 1);
-        QTime result_time = QTime(0, 0, 0, 0);
-        return QDateTime(result_date, result_time);
+        return dayOfWeekFromString(d_inputs.value(0)->textAt(row));
+    }
+    virtual bool convertRows(const void *input, void *output, char *invalid, int rows) const
+    {
+        const QStringList &texts = *static_cast<const QStringList *>(input);
+        QList<QDateTime>::iterator dates = static_cast<QList<QDateTime> *>(output)->begin();
+        convertBlocks(rows, [&](int first, int last) {
+            for (int row = first; row < last; row++) {
+                dates[row] = dayOfWeekFromString(texts.at(row));
+                invalid[row] = invalid[row] || !dates[row].isValid();
+            }
+        });
+        return true;
     }
     virtual bool isInvalid(int row) const
     {
@@ -116,6 +97,41 @@ public:
     virtual SciDAVis::ColumnDataType dataType() const { return SciDAVis::TypeQDateTime; }
 
 protected:
+    static QDateTime dayOfWeekFromString(const QString &input_value)
+    {
+        if (input_value.isEmpty())
+            return QDateTime();
+        bool ok;
+        int day_value = input_value.toInt(&ok);
+        if (!ok) {
+#if QT_VERSION <= 0x040300
+            // workaround for Qt bug #171920
+            QDate temp = QDate(1900, 1, 1);
+            for (int i = 1; i <= 7; i++)
+                if ((input_value.toLower() == QDate::longDayName(i).toLower())
+                    || (input_value.toLower() == QDate::shortDayName(i).toLower())) {
+                    temp = QDate(1900, 1, i);
+                    break;
+                }
+
+#else
+            QDate temp = QDate::fromString(input_value, "ddd");
+            if (!temp.isValid())
+                temp = QDate::fromString(input_value, "dddd");
+#endif
+            if (!temp.isValid())
+                return QDateTime();
+            else
+                day_value = temp.dayOfWeek();
+        }
+
+        // Don't use Julian days here since support for years < 1 is bad
+        // Use 1900-01-01 instead (a Monday)
+        QDate result_date = QDate(1900, 1, 1).addDays(day_value - 1);
+        QTime result_time = QTime(0, 0, 0, 0);
+        return QDateTime(result_date, result_time);
+    }
+
     virtual bool inputAcceptable(int, const AbstractColumn *source)
     {
         return source->dataType() == SciDAVis::TypeQString;
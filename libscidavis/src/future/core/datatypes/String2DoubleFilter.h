@@ -82,6 +82,21 @@ public:
         return validity.intervals();
     }
 
+    virtual bool convertRows(const void *input, void *output, char *invalid, int rows) const
+    {
+        const QStringList &texts = *static_cast<const QStringList *>(input);
+        double *values = static_cast<QVector<double> *>(output)->data();
+        // the settings may only be read from the GUI thread
+        const QLocale locale = getLocale();
+        const bool allowForeignSeparator = isAnyDecimalSeparatorAllowed();
+        convertBlocks(rows, [&](int first, int last) {
+            for (int row = first; row < last; row++)
+                invalid[row] = !convertToDouble(texts.at(row), values[row], locale,
+                                                allowForeignSeparator);
+        });
+        return true;
+    }
+
     //! Checks if it is possible to convert an input QString to number
     bool isInvalid(const QString &str) const
     {
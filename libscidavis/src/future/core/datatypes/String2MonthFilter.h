@@ -51,24 +51,19 @@ public:
         if (!d_inputs.value(0))
             return QDateTime();
 
-        QString input_value = d_inputs.value(0)->textAt(row);
-        bool ok;
-        int month_value = input_value.toInt(&ok);
-        if (!ok) {
-            QDate temp = QDate::fromString(input_value, "MMM");
-            if (!temp.isValid())
-                temp = QDate::fromString(input_value, "MMMM");
-            if (!temp.isValid())
-                return QDateTime();
-            else
-                month_value = temp.month();
-        }
-
-        // Don't use Julian days here since support for years < 1 is bad
-        // Use 1900-01-01 instead
-        QDate result_date = QDate(1900, 1, 1).addMonths(month_value - 1);
-        QTime result_time = QTime(0, 0, 0, 0);
-        return QDateTime(result_date, result_time);
+        return monthFromString(d_inputs.value(0)->textAt(row));
+    }
+    virtual bool convertRows(const void *input, void *output, char *invalid, int rows) const
+    {
+        const QStringList &texts = *static_cast<const QStringList *>(input);
+        QList<QDateTime>::iterator dates = static_cast<QList<QDateTime> *>(output)->begin();
+        convertBlocks(rows, [&](int first, int last) {
+            for (int row = first; row < last; row++) {
+                dates[row] = monthFromString(texts.at(row));
+                invalid[row] = invalid[row] || !dates[row].isValid();
+            }
+        });
+        return true;
     }
     virtual bool isInvalid(int row) const
     {
@@ -102,6 +97,27 @@ public:
     virtual SciDAVis::ColumnDataType dataType() const { return SciDAVis::TypeQDateTime; }
 
 protected:
+    static QDateTime monthFromString(const QString &input_value)
+    {
+        bool ok;
+        int month_value = input_value.toInt(&ok);
+        if (!ok) {
+            QDate temp = QDate::fromString(input_value, "MMM");
+            if (!temp.isValid())
+                temp = QDate::fromString(input_value, "MMMM");
+            if (!temp.isValid())
+                return QDateTime();
+            else
+                month_value = temp.month();
+        }
+
+        // Don't use Julian days here since support for years < 1 is bad
+        // Use 1900-01-01 instead
+        QDate result_date = QDate(1900, 1, 1).addMonths(month_value - 1);
+        QTime result_time = QTime(0, 0, 0, 0);
+        return QDateTime(result_date, result_time);
+    }
+
     virtual bool inputAcceptable(int, const AbstractColumn *source)
     {
         return source->dataType() == SciDAVis::TypeQString;
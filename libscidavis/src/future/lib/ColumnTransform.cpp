@@ -0,0 +1,156 @@
+/***************************************************************************
+    File                 : ColumnTransform.cpp
+    Project              : SciDAVis
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 SciDAVis developers
+    Description          : Kernels for transforming the values of columns
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "ColumnTransform.h"
+
+#include <cmath>
+#include <limits>
+#include <random>
+
+void ColumnTransform::scale(double *values, int count, double factor, double offset)
+{
+    for (int i = 0; i < count; i++)
+        values[i] = factor * values[i] + offset;
+}
+
+bool ColumnTransform::normalize(double *values, int count, Normalization method)
+{
+    switch (method) {
+    case NormalizeMax: {
+        double max = 0.0;
+        for (int i = 0; i < count; i++)
+            max = values[i] > max ? values[i] : max;
+        if (max == 0.0 || !std::isfinite(max))
+            return false;
+        for (int i = 0; i < count; i++)
+            values[i] /= max;
+        return true;
+    }
+    case NormalizeSum: {
+        double sum = 0.0;
+        for (int i = 0; i < count; i++)
+            sum += std::isfinite(values[i]) ? values[i] : 0.0;
+        if (sum == 0.0)
+            return false;
+        for (int i = 0; i < count; i++)
+            values[i] /= sum;
+        return true;
+    }
+    case NormalizeZScore: {
+        double sum = 0.0;
+        int n = 0;
+        for (int i = 0; i < count; i++)
+            if (std::isfinite(values[i])) {
+                sum += values[i];
+                n++;
+            }
+        if (n < 2)
+            return false;
+        const double mean = sum / n;
+        double squares = 0.0;
+        for (int i = 0; i < count; i++)
+            if (std::isfinite(values[i]))
+                squares += (values[i] - mean) * (values[i] - mean);
+        const double deviation = std::sqrt(squares / (n - 1));
+        if (deviation == 0.0)
+            return false;
+        for (int i = 0; i < count; i++)
+            values[i] = (values[i] - mean) / deviation;
+        return true;
+    }
+    }
+    return false;
+}
+
+void ColumnTransform::cumulativeSum(double *values, int count)
+{
+    double sum = 0.0;
+    for (int i = 0; i < count; i++)
+        if (std::isfinite(values[i])) {
+            sum += values[i];
+            values[i] = sum;
+        }
+}
+
+void ColumnTransform::difference(double *values, int count)
+{
+    double previous = std::numeric_limits<double>::quiet_NaN();
+    for (int i = 0; i < count; i++)
+        if (std::isfinite(values[i])) {
+            const double value = values[i];
+            values[i] = value - previous;
+            previous = value;
+        }
+}
+
+void ColumnTransform::fillSequence(double *values, int count, double start, double step)
+{
+    for (int i = 0; i < count; i++)
+        values[i] = start + i * step;
+}
+
+void ColumnTransform::fillRandom(double *values, int count, quint64 seed)
+{
+    std::mt19937_64 generator(seed);
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+    for (int i = 0; i < count; i++)
+        values[i] = distribution(generator);
+}
+
+quint64 ColumnTransform::streamSeed(quint64 seed, int stream)
+{
+    // splitmix64, which maps consecutive inputs to uncorrelated outputs
+    quint64 z = seed + (quint64(stream) + 1) * Q_UINT64_C(0x9E3779B97F4A7C15);
+    z = (z ^ (z >> 30)) * Q_UINT64_C(0xBF58476D1CE4E5B9);
+    z = (z ^ (z >> 27)) * Q_UINT64_C(0x94D049BB133111EB);
+    return z ^ (z >> 31);
+}
+
+void ColumnTransform::combine(double *values, const double *operand, int count,
+                              Operation operation)
+{
+    switch (operation) {
+    case Add:
+        for (int i = 0; i < count; i++)
+            values[i] += operand[i];
+        break;
+    case Subtract:
+        for (int i = 0; i < count; i++)
+            values[i] -= operand[i];
+        break;
+    case Multiply:
+        for (int i = 0; i < count; i++)
+            values[i] *= operand[i];
+        break;
+    case Divide:
+        for (int i = 0; i < count; i++)
+            values[i] /= operand[i];
+        break;
+    }
+}
@@ -0,0 +1,84 @@
+/***************************************************************************
+    File                 : ColumnTransform.h
+    Project              : SciDAVis
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 SciDAVis developers
+    Description          : Kernels for transforming the values of columns
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef COLUMNTRANSFORM_H
+#define COLUMNTRANSFORM_H
+
+#include <QtGlobal>
+
+//! Transformations of the values of numeric columns
+/**
+  The kernels work in place on contiguous spans of values, e.g. the data of a
+  QVector<qreal> taken from Column::values(). They are written as simple loops
+  without calls, which the compiler can vectorize, and are independent of each
+  other, so that several columns can be transformed in parallel (see
+  future::Table::transformColumns()).
+
+  Reductions (maximum, sum, mean, ...), cumulative sums and differences skip
+  NaN and infinite values, which are left unchanged or propagated according to
+  the arithmetic. Invalid cells are passed as NaN, so they do not affect the
+  others.
+  */
+class ColumnTransform
+{
+public:
+    enum Normalization {
+        NormalizeMax, //!< divide by the maximum (at least 0, for compatibility)
+        NormalizeSum, //!< divide by the sum
+        NormalizeZScore, //!< subtract the mean and divide by the standard deviation
+    };
+    enum Operation { Add, Subtract, Multiply, Divide };
+
+    //! Replace each value v by factor * v + offset
+    static void scale(double *values, int count, double factor, double offset);
+    //! Normalize the values
+    /**
+     * Returns false, leaving the values unchanged, if the maximum, the sum or the standard
+     * deviation is 0.
+     */
+    static bool normalize(double *values, int count, Normalization method);
+    //! Replace each finite value by the sum of all finite values up to it
+    static void cumulativeSum(double *values, int count);
+    //! Replace each finite value by its difference to the previous finite one (the first by NaN)
+    static void difference(double *values, int count);
+    //! Fill with start, start + step, start + 2 * step, ...
+    static void fillSequence(double *values, int count, double start, double step);
+    //! Fill with uniformly distributed random numbers in [0, 1)
+    /**
+     * The same seed always gives the same numbers. Use streamSeed() to derive the seeds of
+     * several columns filled in parallel from one seed.
+     */
+    static void fillRandom(double *values, int count, quint64 seed);
+    //! Return the seed of the random stream with the given index, derived from 'seed'
+    static quint64 streamSeed(quint64 seed, int stream);
+    //! Combine each value with the operand at the same position
+    static void combine(double *values, const double *operand, int count, Operation operation);
+};
+
+#endif // ifndef COLUMNTRANSFORM_H
@@ -0,0 +1,262 @@
+/***************************************************************************
+    File                 : DescriptiveStatistics.cpp
+    Project              : SciDAVis
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 SciDAVis developers
+    Description          : Single-pass descriptive statistics kernel
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "lib/DescriptiveStatistics.h"
+
+#include <QtConcurrentMap>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+//! Number of values whose partial results are kept in registers/L1 cache
+const int TileSize = 256;
+} // namespace
+
+DescriptiveStatistics::DescriptiveStatistics()
+    : d_count(0),
+      d_mean(0.0),
+      d_m2(0.0),
+      d_min(std::numeric_limits<double>::quiet_NaN()),
+      d_max(std::numeric_limits<double>::quiet_NaN()),
+      d_min_row(-1),
+      d_max_row(-1)
+{
+}
+
+void DescriptiveStatistics::add(double value, int row)
+{
+    DescriptiveStatistics single;
+    single.d_count = 1;
+    single.d_mean = value;
+    single.d_min = single.d_max = value;
+    single.d_min_row = single.d_max_row = row;
+    merge(single);
+}
+
+void DescriptiveStatistics::addRange(const double *data, int first, int last)
+{
+    for (int start = first; start <= last; start += TileSize) {
+        const int n = qMin(TileSize, last - start + 1);
+        const double *x = data + start;
+
+        // first sweep: sum and extrema (no data dependent branches)
+        double sum = 0.0, lo = x[0], hi = x[0];
+        for (int i = 0; i < n; i++) {
+            sum += x[i];
+            lo = x[i] < lo ? x[i] : lo;
+            hi = x[i] > hi ? x[i] : hi;
+        }
+        // second sweep over the (cached) tile: squared deviations from the tile mean
+        const double mean = sum / n;
+        double m2 = 0.0;
+        for (int i = 0; i < n; i++) {
+            const double delta = x[i] - mean;
+            m2 += delta * delta;
+        }
+
+        DescriptiveStatistics tile;
+        tile.d_count = n;
+        tile.d_mean = mean;
+        tile.d_m2 = m2;
+        tile.d_min = lo;
+        tile.d_max = hi;
+        // only locate the extrema if they could replace the current ones
+        tile.d_min_row = tile.d_max_row = start;
+        if (d_count == 0 || lo < d_min)
+            for (int i = 0; i < n; i++)
+                if (x[i] == lo) {
+                    tile.d_min_row = start + i;
+                    break;
+                }
+        if (d_count == 0 || hi > d_max)
+            for (int i = 0; i < n; i++)
+                if (x[i] == hi) {
+                    tile.d_max_row = start + i;
+                    break;
+                }
+        merge(tile);
+    }
+}
+
+void DescriptiveStatistics::addValid(const double *data, int first, int last,
+                                     const QVector<Interval<int>> &valid)
+{
+    for (const Interval<int> &iv : valid) {
+        if (iv.end() < first)
+            continue;
+        if (iv.start() > last)
+            break;
+        addRange(data, qMax(first, iv.start()), qMin(last, iv.end()));
+    }
+}
+
+void DescriptiveStatistics::merge(const DescriptiveStatistics &other)
+{
+    if (other.d_count == 0)
+        return;
+    if (d_count == 0) {
+        *this = other;
+        return;
+    }
+
+    const double n1 = d_count, n2 = other.d_count, n = n1 + n2;
+    const double delta = other.d_mean - d_mean;
+    d_mean += delta * n2 / n;
+    d_m2 += other.d_m2 + delta * delta * n1 * n2 / n;
+    d_count += other.d_count;
+
+    if (other.d_min < d_min) {
+        d_min = other.d_min;
+        d_min_row = other.d_min_row;
+    }
+    if (other.d_max > d_max) {
+        d_max = other.d_max;
+        d_max_row = other.d_max_row;
+    }
+}
+
+double DescriptiveStatistics::standardDeviation() const
+{
+    return std::sqrt(variance());
+}
+
+QVector<Interval<int>> DescriptiveStatistics::validIntervals(int rows,
+                                                             const QList<Interval<int>> &invalid)
+{
+    QVector<Interval<int>> sorted_invalid;
+    sorted_invalid.reserve(invalid.size());
+    for (const Interval<int> &iv : invalid)
+        sorted_invalid << iv;
+    std::sort(sorted_invalid.begin(), sorted_invalid.end(),
+              [](const Interval<int> &a, const Interval<int> &b) { return a.start() < b.start(); });
+
+    QVector<Interval<int>> result;
+    int next = 0;
+    for (const Interval<int> &iv : sorted_invalid) {
+        if (iv.start() >= rows)
+            break;
+        if (iv.start() > next)
+            result << Interval<int>(next, iv.start() - 1);
+        next = qMax(next, iv.end() + 1);
+    }
+    if (next < rows)
+        result << Interval<int>(next, rows - 1);
+    return result;
+}
+
+bool DescriptiveStatistics::contains(const QVector<Interval<int>> &intervals, int row)
+{
+    auto it = std::upper_bound(intervals.constBegin(), intervals.constEnd(), row,
+                               [](int r, const Interval<int> &iv) { return r < iv.start(); });
+    return it != intervals.constBegin() && (it - 1)->contains(row);
+}
+
+DescriptiveStatistics DescriptiveStatistics::compute(const double *data, int rows,
+                                                     const QList<Interval<int>> &invalid)
+{
+    return merge(blocks(data, rows, invalid));
+}
+
+QVector<DescriptiveStatistics> DescriptiveStatistics::blocks(const double *data, int rows,
+                                                             const QList<Interval<int>> &invalid)
+{
+    QVector<DescriptiveStatistics> result((rows + BlockSize - 1) / BlockSize);
+    updateBlocks(result, data, rows, invalid, 0, rows - 1);
+    return result;
+}
+
+void DescriptiveStatistics::updateBlocks(QVector<DescriptiveStatistics> &blocks,
+                                         const double *data, int rows,
+                                         const QList<Interval<int>> &invalid, int first, int last)
+{
+    first = qMax(first, 0);
+    last = qMin(last, rows - 1);
+    if (first > last)
+        return;
+
+    const QVector<Interval<int>> valid = validIntervals(rows, invalid);
+    QVector<int> indices;
+    for (int b = first / BlockSize; b <= last / BlockSize; b++)
+        indices << b;
+
+    DescriptiveStatistics *results = blocks.data(); // detach before going parallel
+    auto compute_block = [&](int b) {
+        DescriptiveStatistics stats;
+        stats.addValid(data, b * BlockSize, qMin((b + 1) * BlockSize, rows) - 1, valid);
+        results[b] = stats;
+    };
+    if (indices.size() > 1)
+        QtConcurrent::blockingMap(indices, compute_block);
+    else
+        compute_block(indices.first());
+}
+
+DescriptiveStatistics DescriptiveStatistics::merge(const QVector<DescriptiveStatistics> &blocks)
+{
+    DescriptiveStatistics result;
+    for (const DescriptiveStatistics &block : blocks)
+        result.merge(block);
+    return result;
+}
+
+QVector<double> DescriptiveStatistics::quantiles(QVector<double> &values,
+                                                 const QVector<double> &probabilities)
+{
+    const int n = values.size();
+    QVector<double> result(probabilities.size(), std::numeric_limits<double>::quiet_NaN());
+    if (n == 0)
+        return result;
+
+    // process the probabilities in ascending order, so that each selection only has to
+    // consider the values above the previously selected rank
+    QVector<int> order(probabilities.size());
+    for (int i = 0; i < order.size(); i++)
+        order[i] = i;
+    std::sort(order.begin(), order.end(),
+              [&](int a, int b) { return probabilities.at(a) < probabilities.at(b); });
+
+    double *begin = values.data(), *end = values.data() + n;
+    double *lower_bound = begin;
+    for (int i : order) {
+        const double p = qBound(0.0, probabilities.at(i), 1.0);
+        const double index = p * (n - 1);
+        const int lhs = int(index);
+        const double delta = index - lhs;
+
+        double *nth = begin + lhs;
+        std::nth_element(lower_bound, nth, end);
+        lower_bound = nth;
+        double value = *nth;
+        if (delta > 0 && lhs + 1 < n)
+            value = (1 - delta) * value + delta * *std::min_element(nth + 1, end);
+        result[i] = value;
+    }
+    return result;
+}
@@ -0,0 +1,136 @@
+/***************************************************************************
+    File                 : DescriptiveStatistics.h
+    Project              : SciDAVis
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 SciDAVis developers
+    Description          : Single-pass descriptive statistics kernel
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef DESCRIPTIVESTATISTICS_H
+#define DESCRIPTIVESTATISTICS_H
+
+#include "lib/Interval.h"
+
+#include <QList>
+#include <QVector>
+
+//! Count, moments and extrema of a set of double values
+/**
+  The statistics are accumulated in a single pass over contiguous data. Values
+  are processed in small tiles whose sum, extrema and squared deviations are
+  computed by branch-free loops (which the compiler can vectorize) and then
+  combined with the running result using the pairwise update formulas of Chan
+  et al. The same formulas are used by merge(), so statistics of disjoint
+  blocks of a column can be computed independently (in parallel) and combined
+  afterwards.
+
+  Row indices are tracked for the minimum and maximum; when several rows hold
+  the extreme value, the first one is reported, provided that values are added
+  and blocks merged in ascending row order.
+  */
+class DescriptiveStatistics
+{
+public:
+    //! Number of rows summarized by one block in blockwise computations
+    static const int BlockSize = 16384;
+
+    DescriptiveStatistics();
+
+    //! Add a single value located in row 'row'
+    void add(double value, int row);
+    //! Add the values data[first] to data[last]
+    /**
+     * The values are taken to be located in the rows first to last.
+     */
+    void addRange(const double *data, int first, int last);
+    //! Add the values of those rows between first and last which are contained in 'valid'
+    /**
+     * \param valid sorted list of valid row intervals as returned by validIntervals()
+     */
+    void addValid(const double *data, int first, int last, const QVector<Interval<int>> &valid);
+    //! Combine with the statistics of another, disjoint set of values
+    void merge(const DescriptiveStatistics &other);
+
+    //! Return the number of values
+    int count() const { return d_count; }
+    //! Return the sum of the values
+    double sum() const { return d_mean * d_count; }
+    //! Return the arithmetic mean
+    double mean() const { return d_mean; }
+    //! Return the sample variance
+    double variance() const { return d_m2 / (d_count - 1); }
+    //! Return the sample standard deviation
+    double standardDeviation() const;
+    //! Return the smallest value
+    double minimum() const { return d_min; }
+    //! Return the largest value
+    double maximum() const { return d_max; }
+    //! Return the row containing the smallest value
+    int minimumRow() const { return d_min_row; }
+    //! Return the row containing the largest value
+    int maximumRow() const { return d_max_row; }
+
+    //! Turn a list of invalid row intervals into a sorted list of valid intervals
+    /**
+     * Only the rows 0 to rows-1 are considered.
+     */
+    static QVector<Interval<int>> validIntervals(int rows, const QList<Interval<int>> &invalid);
+    //! Return whether 'row' is contained in a sorted list of intervals
+    static bool contains(const QVector<Interval<int>> &intervals, int row);
+
+    //! Compute the statistics of the valid values in data[0] to data[rows-1]
+    /**
+     * Large data sets are split into blocks which are processed on the global thread pool.
+     */
+    static DescriptiveStatistics compute(const double *data, int rows,
+                                         const QList<Interval<int>> &invalid);
+    //! Compute the statistics of each block of BlockSize rows separately
+    static QVector<DescriptiveStatistics> blocks(const double *data, int rows,
+                                                 const QList<Interval<int>> &invalid);
+    //! Recompute those elements of 'blocks' which cover the rows first to last
+    static void updateBlocks(QVector<DescriptiveStatistics> &blocks, const double *data, int rows,
+                             const QList<Interval<int>> &invalid, int first, int last);
+    //! Combine a list of block statistics (in ascending row order)
+    static DescriptiveStatistics merge(const QVector<DescriptiveStatistics> &blocks);
+
+    //! Return the p-quantiles of 'values', partially reordering them in the process
+    /**
+     * Quantiles are interpolated linearly between the closest ranks, like
+     * gsl_stats_quantile_from_sorted_data() does, but are found by selection
+     * instead of fully sorting a copy of the data.
+     * \param probabilities values between 0 and 1
+     */
+    static QVector<double> quantiles(QVector<double> &values, const QVector<double> &probabilities);
+
+private:
+    int d_count;
+    double d_mean;
+    //! Sum of squared deviations from the mean
+    double d_m2;
+    double d_min;
+    double d_max;
+    int d_min_row;
+    int d_max_row;
+};
+
+#endif // ifndef DESCRIPTIVESTATISTICS_H
@@ -0,0 +1,366 @@
+/***************************************************************************
+    File                 : GroupAggregation.cpp
+    Project              : SciDAVis
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 SciDAVis developers
+    Description          : Groups table rows by key columns and aggregates
+                           the values of each group
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "lib/GroupAggregation.h"
+#include "lib/DescriptiveStatistics.h"
+#include "core/column/Column.h"
+
+#include <QDateTime>
+#include <QHash>
+#include <QtConcurrentMap>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace {
+//! Number of rows hashed or accumulated by one task
+const int BlockRows = DescriptiveStatistics::BlockSize;
+
+QVector<int> indexList(int n)
+{
+    QVector<int> result(n);
+    for (int i = 0; i < n; i++)
+        result[i] = i;
+    return result;
+}
+
+//! Map the keys of the rows 0 to rows-1 to dense codes in the order of their first appearance
+/**
+ * key(row, k) stores the key of a row in k and returns false if the row has no key (its code
+ * is -1 then). The first row of each code is appended to 'first_rows'.
+ */
+template<class K, class F>
+QVector<int> factorize(int rows, F key, QVector<int> &first_rows)
+{
+    struct Block
+    {
+        QHash<K, int> codes;
+        //! key and first row of each local code
+        QVector<K> keys;
+        QVector<int> first_rows;
+    };
+    const int block_count = (rows + BlockRows - 1) / BlockRows;
+    QVector<int> block_indices = indexList(block_count);
+    QVector<Block> blocks(block_count);
+    QVector<int> codes(rows, -1);
+    Block *local_tables = blocks.data();
+    int *row_codes = codes.data();
+    QtConcurrent::blockingMap(block_indices, [&](int block) {
+        Block &local = local_tables[block];
+        K k;
+        for (int row = block * BlockRows; row < qMin(rows, (block + 1) * BlockRows); row++) {
+            if (!key(row, k))
+                continue;
+            auto code = local.codes.constFind(k);
+            if (code == local.codes.constEnd()) {
+                code = local.codes.insert(k, local.keys.size());
+                local.keys << k;
+                local.first_rows << row;
+            }
+            row_codes[row] = code.value();
+        }
+    });
+
+    // merge the tables in block order and translate the local codes
+    QHash<K, int> global;
+    QVector<QVector<int>> translations(block_count);
+    for (int block = 0; block < block_count; block++) {
+        Block &local = blocks[block];
+        QVector<int> &translation = translations[block];
+        translation.resize(local.keys.size());
+        for (int i = 0; i < local.keys.size(); i++) {
+            auto code = global.constFind(local.keys.at(i));
+            if (code == global.constEnd()) {
+                code = global.insert(local.keys.at(i), first_rows.size());
+                first_rows << local.first_rows.at(i);
+            }
+            translation[i] = code.value();
+        }
+        local = Block();
+    }
+    QtConcurrent::blockingMap(block_indices, [&](int block) {
+        const QVector<int> &translation = translations.at(block);
+        for (int row = block * BlockRows; row < qMin(rows, (block + 1) * BlockRows); row++)
+            if (row_codes[row] >= 0)
+                row_codes[row] = translation.at(row_codes[row]);
+    });
+    return codes;
+}
+
+//! Return the codes of the key cells of 'column' (see factorize())
+QVector<int> keyCodes(const AbstractColumn *column, int rows, QVector<int> &first_rows)
+{
+    const QVector<bool> valid =
+            rowFlags(column->invalidIntervals(), rows, column->rowCount(), false);
+    QVector<int> codes;
+    switch (column->dataType()) {
+    case SciDAVis::TypeDouble: {
+        const Column *c = dynamic_cast<const Column *>(column);
+        QVector<qreal> values(rows, std::numeric_limits<qreal>::quiet_NaN());
+        if (c)
+            values = c->values();
+        else
+            for (int row = 0; row < qMin(rows, column->rowCount()); row++)
+                values[row] = column->valueAt(row);
+        codes = factorize<quint64>(
+                rows,
+                [&](int row, quint64 &k) {
+                    if (!valid.at(row) || std::isnan(values.at(row)))
+                        return false;
+                    // 0 and -0 are the same key
+                    const double value = values.at(row) == 0.0 ? 0.0 : values.at(row);
+                    std::memcpy(&k, &value, sizeof(k));
+                    return true;
+                },
+                first_rows);
+        break;
+    }
+    case SciDAVis::TypeQDateTime: {
+        QVector<qint64> times(rows);
+        QVector<bool> valid_times = valid;
+        for (int row = 0; row < rows; row++)
+            if (valid.at(row)) {
+                const QDateTime value = column->dateTimeAt(row);
+                valid_times[row] = value.isValid();
+                times[row] = value.isValid() ? value.toMSecsSinceEpoch() : 0;
+            }
+        codes = factorize<qint64>(
+                rows,
+                [&](int row, qint64 &k) {
+                    k = times.at(row);
+                    return valid_times.at(row);
+                },
+                first_rows);
+        break;
+    }
+    case SciDAVis::TypeQString: {
+        const Column *c = dynamic_cast<const Column *>(column);
+        QStringList texts;
+        if (c)
+            texts = c->texts();
+        else
+            for (int row = 0; row < qMin(rows, column->rowCount()); row++)
+                texts << column->textAt(row);
+        codes = factorize<QString>(
+                rows,
+                [&](int row, QString &k) {
+                    if (!valid.at(row))
+                        return false;
+                    k = texts.at(row);
+                    return true;
+                },
+                first_rows);
+        break;
+    }
+    }
+    return codes;
+}
+} // namespace
+
+GroupAggregation::GroupAggregation(int rows) : d_rows(qMax(rows, 0)) { }
+
+void GroupAggregation::addKey(const AbstractColumn *column)
+{
+    if (column)
+        d_keys << column;
+}
+
+void GroupAggregation::group()
+{
+    d_first_rows.clear();
+    if (d_keys.isEmpty()) {
+        d_groups.fill(0, d_rows);
+        if (d_rows > 0)
+            d_first_rows << 0;
+        return;
+    }
+
+    d_groups = keyCodes(d_keys.first(), d_rows, d_first_rows);
+    for (int k = 1; k < d_keys.size(); k++) {
+        // combine the groups found so far with the codes of the next key
+        QVector<int> first_rows;
+        const QVector<int> codes = keyCodes(d_keys.at(k), d_rows, first_rows);
+        const QVector<int> groups = d_groups;
+        first_rows.clear();
+        d_groups = factorize<quint64>(
+                d_rows,
+                [&](int row, quint64 &key) {
+                    if (groups.at(row) < 0 || codes.at(row) < 0)
+                        return false;
+                    key = (quint64(groups.at(row)) << 32) | quint64(codes.at(row));
+                    return true;
+                },
+                first_rows);
+        d_first_rows = first_rows;
+    }
+}
+
+QVector<double> GroupAggregation::groupSizes() const
+{
+    QVector<double> sizes(groupCount(), 0.0);
+    for (int group : d_groups)
+        if (group >= 0)
+            sizes[group]++;
+    return sizes;
+}
+
+QVector<QVector<double>> GroupAggregation::aggregate(const AbstractColumn *column,
+                                                     const QVector<Aggregate> &aggregates) const
+{
+    const int groups = groupCount();
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    QVector<QVector<double>> result(aggregates.size(), QVector<double>(groups, nan));
+
+    // the values of the cells which count (NaN for the others), and whether they count
+    const QVector<bool> valid =
+            rowFlags(column->invalidIntervals(), d_rows, column->rowCount(), false);
+    QVector<double> values(d_rows, nan);
+    QVector<bool> present = valid;
+    const bool numeric = column->dataType() == SciDAVis::TypeDouble;
+    if (numeric) {
+        const Column *c = dynamic_cast<const Column *>(column);
+        const QVector<qreal> data = c ? c->values() : QVector<qreal>();
+        for (int row = 0; row < qMin(d_rows, column->rowCount()); row++)
+            if (valid.at(row)) {
+                values[row] = c ? data.at(row) : column->valueAt(row);
+                present[row] = !std::isnan(values.at(row));
+            }
+    } else
+        for (int row = 0; row < qMin(d_rows, column->rowCount()); row++)
+            if (valid.at(row))
+                present[row] = column->dataType() == SciDAVis::TypeQString
+                        ? !column->textAt(row).isEmpty()
+                        : column->dateTimeAt(row).isValid();
+
+    // accumulate blockwise in parallel, as long as the partial results are not larger than
+    // the column
+    struct Partial
+    {
+        QVector<int> counts;
+        QVector<DescriptiveStatistics> statistics;
+    };
+    const int block_count = (d_rows + BlockRows - 1) / BlockRows;
+    const int partial_count =
+            qint64(groups) * block_count <= qint64(d_rows) ? qMax(block_count, 1) : 1;
+    const int rows_per_partial = (d_rows + partial_count - 1) / qMax(partial_count, 1);
+    QVector<Partial> partials(partial_count);
+    Partial *partial_results = partials.data();
+    QVector<int> partial_indices = indexList(partial_count);
+    auto accumulate = [&](int partial) {
+        Partial &p = partial_results[partial];
+        p.counts.fill(0, groups);
+        if (numeric)
+            p.statistics.resize(groups);
+        for (int row = partial * rows_per_partial;
+             row < qMin(d_rows, (partial + 1) * rows_per_partial); row++) {
+            const int group = d_groups.at(row);
+            if (group < 0 || !present.at(row))
+                continue;
+            p.counts[group]++;
+            if (numeric)
+                p.statistics[group].add(values.at(row), row);
+        }
+    };
+    if (partial_count > 1)
+        QtConcurrent::blockingMap(partial_indices, accumulate);
+    else
+        accumulate(0);
+    Partial &total = partials.first();
+    for (int partial = 1; partial < partial_count; partial++)
+        for (int group = 0; group < groups; group++) {
+            total.counts[group] += partials.at(partial).counts.at(group);
+            if (numeric)
+                total.statistics[group].merge(partials.at(partial).statistics.at(group));
+        }
+
+    QVector<double> probabilities;
+    for (int a = 0; a < aggregates.size(); a++) {
+        QVector<double> &r = result[a];
+        for (int group = 0; group < groups; group++) {
+            const int count = total.counts.at(group);
+            if (aggregates.at(a).function == Count) {
+                r[group] = count;
+                continue;
+            }
+            if (!numeric)
+                continue;
+            const DescriptiveStatistics &s = total.statistics.at(group);
+            switch (aggregates.at(a).function) {
+            case Sum:
+                r[group] = count > 0 ? s.sum() : 0.0;
+                break;
+            case Mean:
+                r[group] = count > 0 ? s.mean() : nan;
+                break;
+            case Minimum:
+                r[group] = s.minimum();
+                break;
+            case Maximum:
+                r[group] = s.maximum();
+                break;
+            case StandardDeviation:
+                r[group] = count > 1 ? s.standardDeviation() : nan;
+                break;
+            default:
+                break;
+            }
+        }
+        if (aggregates.at(a).function == Quantile)
+            probabilities << aggregates.at(a).probability;
+    }
+    if (probabilities.isEmpty() || !numeric || groups == 0)
+        return result;
+
+    // sort the values by group (counting sort), then select the quantiles of each group
+    QVector<int> offsets(groups + 1, 0);
+    for (int group = 0; group < groups; group++)
+        offsets[group + 1] = offsets.at(group) + total.counts.at(group);
+    QVector<double> sorted(offsets.last());
+    QVector<int> next = offsets;
+    for (int row = 0; row < d_rows; row++)
+        if (d_groups.at(row) >= 0 && present.at(row))
+            sorted[next[d_groups.at(row)]++] = values.at(row);
+    QVector<QVector<double>> quantiles(groups);
+    QVector<double> *group_quantiles = quantiles.data();
+    QVector<int> group_indices = indexList(groups);
+    QtConcurrent::blockingMap(group_indices, [&](int group) {
+        QVector<double> group_values(offsets.at(group + 1) - offsets.at(group));
+        std::copy(sorted.constBegin() + offsets.at(group),
+                  sorted.constBegin() + offsets.at(group + 1), group_values.begin());
+        group_quantiles[group] = DescriptiveStatistics::quantiles(group_values, probabilities);
+    });
+    for (int a = 0, q = 0; a < aggregates.size(); a++)
+        if (aggregates.at(a).function == Quantile) {
+            for (int group = 0; group < groups; group++)
+                result[a][group] = quantiles.at(group).at(q);
+            q++;
+        }
+    return result;
+}
@@ -0,0 +1,101 @@
+/***************************************************************************
+    File                 : GroupAggregation.h
+    Project              : SciDAVis
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 SciDAVis developers
+    Description          : Groups table rows by key columns and aggregates
+                           the values of each group
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef GROUPAGGREGATION_H
+#define GROUPAGGREGATION_H
+
+#include <QList>
+#include <QVector>
+
+class AbstractColumn;
+
+//! Groups the rows of a table by one or more key columns and aggregates values per group
+/**
+  Rows belong to the same group if their cells are equal in all key columns;
+  rows with an invalid key cell (or NaN, or beyond the end of a key column)
+  belong to no group. Groups are numbered in the order of their first rows.
+  Without key columns, all rows form a single group.
+
+  Grouping is a hash aggregation over the column storage. Each key column is
+  mapped to dense codes (numbers and date-times by their bits, texts by a
+  dictionary); the codes of further key columns are combined with the groups
+  found so far and mapped again. Every mapping hashes blocks of rows in
+  parallel, each block into a table of its own, and merges the tables in
+  block order, which keeps the numbering by first appearance.
+
+  Aggregates are computed by accumulating DescriptiveStatistics per group,
+  on blocks of rows in parallel which are merged afterwards. Quantiles are
+  selected from the values of each group, for all groups in parallel.
+  */
+class GroupAggregation
+{
+public:
+    enum Function { Count, Sum, Mean, Minimum, Maximum, StandardDeviation, Quantile };
+
+    //! An aggregate of the values of a column
+    struct Aggregate
+    {
+        Function function;
+        //! For Quantile: the probability, between 0 and 1
+        double probability;
+    };
+
+    //! Group the rows 0 to rows-1
+    explicit GroupAggregation(int rows);
+
+    //! Add a key column
+    void addKey(const AbstractColumn *column);
+    //! Assign the rows to groups by the keys added so far
+    void group();
+
+    //! Return the number of groups
+    int groupCount() const { return d_first_rows.size(); }
+    //! Return the group of each row, or -1 for rows which belong to no group
+    const QVector<int> &groups() const { return d_groups; }
+    //! Return the first row of each group
+    const QVector<int> &firstRows() const { return d_first_rows; }
+    //! Return the number of rows in each group
+    QVector<double> groupSizes() const;
+    //! Return the given aggregates of the values of 'column', with one element per group each
+    /**
+     * Invalid cells and NaN are skipped. Count counts the cells which are neither invalid nor
+     * empty (or NaN); the other aggregates are only defined for numeric columns and are NaN
+     * for groups without values (Sum is 0).
+     */
+    QVector<QVector<double>> aggregate(const AbstractColumn *column,
+                                       const QVector<Aggregate> &aggregates) const;
+
+private:
+    int d_rows;
+    QList<const AbstractColumn *> d_keys;
+    QVector<int> d_groups;
+    QVector<int> d_first_rows;
+};
+
+#endif // ifndef GROUPAGGREGATION_H
@@ -32,6 +32,8 @@
 
 #include "Interval.h"
 #include <QList>
+#include <QVector>
+#include <climits>
 
 //! A class representing an interval-based attribute
 template<class T>
@@ -39,6 +41,11 @@ class IntervalAttribute
 {
 public:
     IntervalAttribute<T>() { }
+    //! Construct from disjoint, non-touching intervals and their values
+    IntervalAttribute<T>(QList<Interval<int>> intervals, QList<T> values)
+        : d_values(values), d_intervals(intervals)
+    {
+    }
     IntervalAttribute<T>(const IntervalAttribute<T> &other)
     {
         d_intervals.clear();
@@ -281,4 +288,48 @@ private:
     QList<Interval<int>> d_intervals;
 };
 
+//! Call f(row) for each row between first and last which lies in one of 'intervals'
+template<class Function>
+void forEachRow(const QList<Interval<int>> &intervals, int first, int last, Function f)
+{
+    for (const Interval<int> &iv : intervals)
+        for (int row = qMax(iv.start(), first); row <= qMin(iv.end(), last); row++)
+            f(row);
+}
+
+//! Return for each of the rows 0 to rows-1 whether it lies in one of 'intervals'
+/**
+ * The rows from 'end' on are flagged as well, e.g. to treat the rows beyond the end of a column
+ * like its invalid ones. The flagged rows are set to 'flag', the others to !flag.
+ */
+inline QVector<bool> rowFlags(const QList<Interval<int>> &intervals, int rows, int end = INT_MAX,
+                              bool flag = true)
+{
+    QVector<bool> flags(qMax(rows, 0), !flag);
+    forEachRow(intervals, 0, rows - 1, [&flags, flag](int row) { flags[row] = flag; });
+    for (int row = qMax(end, 0); row < rows; row++)
+        flags[row] = flag;
+    return flags;
+}
+
+//! Return the runs of consecutive rows among 0 to rows-1 for which flagged(row) is true
+/**
+ * The inverse of rowFlags(), for marking many rows (e.g. as invalid) one interval at a time.
+ */
+template<class Predicate>
+QList<Interval<int>> flaggedIntervals(int rows, Predicate flagged)
+{
+    QList<Interval<int>> result;
+    for (int start = 0; start < rows; start++) {
+        if (!flagged(start))
+            continue;
+        int end = start;
+        while (end + 1 < rows && flagged(end + 1))
+            end++;
+        result << Interval<int>(start, end);
+        start = end;
+    }
+    return result;
+}
+
 #endif
@@ -0,0 +1,222 @@
+/***************************************************************************
+    File                 : PeakDetection.cpp
+    Project              : SciDAVis
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 SciDAVis developers
+    Description          : Peak finding in sampled data
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "lib/PeakDetection.h"
+#include "lib/DescriptiveStatistics.h"
+
+#include <QPair>
+#include <QtConcurrentMap>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+//! Number of candidates above which prominences are computed on the thread pool
+const int ParallelCandidates = 64;
+} // namespace
+
+QVector<double> PeakDetection::smooth(const double *y, int n, int points)
+{
+    const int half = qMax(points, 1) / 2;
+    QVector<double> prefix(n + 1);
+    prefix[0] = 0.0;
+    for (int i = 0; i < n; i++)
+        prefix[i + 1] = prefix[i] + y[i];
+
+    QVector<double> result(n);
+    for (int i = 0; i < n; i++) {
+        // the window shrinks symmetrically at the ends, so that maxima are not shifted
+        const int h = qMin(half, qMin(i, n - 1 - i));
+        result[i] = (prefix[i + h + 1] - prefix[i - h]) / (2 * h + 1);
+    }
+    return result;
+}
+
+double PeakDetection::noiseLevel(const double *y, int n, int smoothingPoints)
+{
+    if (n < 3)
+        return 0.0;
+    const QVector<double> s = smooth(y, n, qMax(smoothingPoints, 3));
+    QVector<double> residuals(n);
+    for (int i = 0; i < n; i++)
+        residuals[i] = y[i] - s[i];
+    const double median = DescriptiveStatistics::quantiles(residuals, QVector<double>() << 0.5)[0];
+    for (int i = 0; i < n; i++)
+        residuals[i] = fabs(residuals[i] - median);
+    // scale factor relating the median absolute deviation to the standard deviation of a normal
+    // distribution
+    return 1.4826 * DescriptiveStatistics::quantiles(residuals, QVector<double>() << 0.5)[0];
+}
+
+QVector<PeakDetection::Peak> PeakDetection::find(const double *x, const double *y, int n,
+                                                 const Options &options)
+{
+    QVector<Peak> result;
+    if (n < 3)
+        return result;
+
+    const QVector<double> s = smooth(y, n, options.smoothingPoints);
+
+    // local maxima of the smoothed data; for flat tops the middle point is taken
+    QVector<Peak> candidates;
+    for (int i = 1; i < n - 1;) {
+        if (s[i - 1] < s[i]) {
+            int ahead = i + 1;
+            while (ahead < n - 1 && s[ahead] == s[i])
+                ahead++;
+            if (s[ahead] < s[i]) {
+                Peak peak;
+                peak.index = (i + ahead - 1) / 2;
+                peak.position = x[peak.index];
+                peak.height = s[peak.index];
+                peak.prominence = peak.width = 0.0;
+                candidates << peak;
+            }
+            i = ahead;
+        } else
+            i++;
+    }
+
+    // prominence and width of each candidate
+    const double *smoothed = s.constData();
+    auto measure = [=](Peak &peak) {
+        const int p = peak.index;
+        const double top = smoothed[p];
+
+        int left_base = p;
+        double left_min = top;
+        for (int i = p - 1; i >= 0 && smoothed[i] <= top; i--)
+            if (smoothed[i] < left_min) {
+                left_min = smoothed[i];
+                left_base = i;
+            }
+        int right_base = p;
+        double right_min = top;
+        for (int i = p + 1; i < n && smoothed[i] <= top; i++)
+            if (smoothed[i] < right_min) {
+                right_min = smoothed[i];
+                right_base = i;
+            }
+        peak.prominence = top - qMax(left_min, right_min);
+
+        // crossings of the half prominence level, interpolated linearly
+        const double level = top - 0.5 * peak.prominence;
+        int i = p;
+        while (i > left_base && smoothed[i] > level)
+            i--;
+        double left = x[i];
+        if (smoothed[i] < level && smoothed[i + 1] != smoothed[i])
+            left += (x[i + 1] - x[i]) * (level - smoothed[i]) / (smoothed[i + 1] - smoothed[i]);
+        i = p;
+        while (i < right_base && smoothed[i] > level)
+            i++;
+        double right = x[i];
+        if (smoothed[i] < level && smoothed[i - 1] != smoothed[i])
+            right -= (x[i] - x[i - 1]) * (level - smoothed[i]) / (smoothed[i - 1] - smoothed[i]);
+        peak.width = right - left;
+    };
+    if (candidates.size() > ParallelCandidates)
+        QtConcurrent::blockingMap(candidates, measure);
+    else
+        for (Peak &peak : candidates)
+            measure(peak);
+
+    double min_prominence = options.minProminence;
+    if (min_prominence < 0)
+        min_prominence = 5.0 * noiseLevel(y, n, options.smoothingPoints);
+    for (const Peak &peak : candidates)
+        if (peak.prominence > 0 && peak.prominence >= min_prominence
+            && peak.width >= options.minWidth)
+            result << peak;
+
+    if (options.maxPeaks > 0 && result.size() > options.maxPeaks) {
+        std::sort(result.begin(), result.end(),
+                  [](const Peak &a, const Peak &b) { return a.prominence > b.prominence; });
+        result.resize(options.maxPeaks);
+        std::sort(result.begin(), result.end(),
+                  [](const Peak &a, const Peak &b) { return a.index < b.index; });
+    }
+    return result;
+}
+
+QVector<PeakDetection::Region> PeakDetection::regions(const double *x, int n,
+                                                      const QVector<double> &centers,
+                                                      const QVector<double> &reach)
+{
+    QVector<Region> result;
+    if (n <= 0 || centers.isEmpty())
+        return result;
+
+    QVector<int> order(centers.size());
+    for (int i = 0; i < order.size(); i++)
+        order[i] = i;
+    std::sort(order.begin(), order.end(),
+              [&](int a, int b) { return centers.at(a) < centers.at(b); });
+
+    // group peaks whose ranges overlap; 'ends' holds the x range of each group
+    QVector<QPair<double, double>> ends;
+    for (int i : order) {
+        const double low = centers.at(i) - fabs(reach.at(i));
+        const double high = centers.at(i) + fabs(reach.at(i));
+        if (!ends.isEmpty() && low <= ends.last().second) {
+            ends.last().second = qMax(ends.last().second, high);
+            result.last().peaks << i;
+        } else {
+            ends << qMakePair(low, high);
+            Region region;
+            region.peaks << i;
+            result << region;
+        }
+    }
+
+    // split the data halfway between the groups; groups without data points of their own are
+    // merged into the following one
+    const QVector<Region> groups = result;
+    result.clear();
+    QVector<int> pending;
+    int first = 0;
+    for (int r = 0; r < groups.size(); r++) {
+        pending << groups.at(r).peaks;
+        int last = n - 1;
+        if (r + 1 < groups.size()) {
+            const double boundary = 0.5 * (ends.at(r).second + ends.at(r + 1).first);
+            last = int(std::lower_bound(x, x + n, boundary) - x) - 1;
+        }
+        if (last < first)
+            continue;
+        Region region;
+        region.points = Interval<int>(first, last);
+        region.peaks = pending;
+        result << region;
+        pending.clear();
+        first = last + 1;
+    }
+    if (!pending.isEmpty())
+        result.last().peaks << pending;
+    return result;
+}
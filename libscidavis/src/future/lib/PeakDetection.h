@@ -0,0 +1,112 @@
+/***************************************************************************
+    File                 : PeakDetection.h
+    Project              : SciDAVis
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 SciDAVis developers
+    Description          : Peak finding in sampled data
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef PEAKDETECTION_H
+#define PEAKDETECTION_H
+
+#include "lib/Interval.h"
+
+#include <QVector>
+
+//! Detection of peaks in a sampled signal y(x)
+/**
+  Peaks are the local maxima of a moving average of the data (i.e. the points
+  where its derivative changes sign), filtered by their prominence and width
+  as defined by the topographic notion of prominence: the prominence of a
+  peak is its height above the higher of the two minima between it and the
+  next higher point on either side, its width is measured at half of the
+  prominence.
+
+  The x values must be sorted in ascending order.
+  */
+class PeakDetection
+{
+public:
+    //! Parameters of the detection
+    struct Options
+    {
+        Options() : smoothingPoints(5), minProminence(-1.0), minWidth(0.0), maxPeaks(0) { }
+
+        //! Number of points of the moving average applied before searching maxima
+        int smoothingPoints;
+        //! Minimum prominence of a peak; a negative value selects five times the noise level
+        double minProminence;
+        //! Minimum width (full width at half prominence, in units of x)
+        double minWidth;
+        //! Maximum number of peaks; the most prominent ones are kept, 0 means no limit
+        int maxPeaks;
+    };
+
+    //! A detected peak
+    struct Peak
+    {
+        //! Index of the data point at the maximum
+        int index;
+        double position;
+        //! Height of the (smoothed) data at the maximum
+        double height;
+        double prominence;
+        //! Full width at half prominence
+        double width;
+    };
+
+    //! A part of the data set whose peaks do not overlap with those of other regions
+    struct Region
+    {
+        //! Indices of the data points belonging to the region
+        Interval<int> points;
+        //! Indices of the peaks located in the region
+        QVector<int> peaks;
+    };
+
+    //! Return the peaks of y(x) sorted by position
+    static QVector<Peak> find(const double *x, const double *y, int n,
+                              const Options &options = Options());
+
+    //! Split the data into regions which can be fitted independently
+    /**
+     * Peak i is assumed to influence the data between centers[i] - reach[i] and
+     * centers[i] + reach[i]. Peaks whose ranges overlap are put into the same
+     * region, the boundaries between regions are placed halfway between the
+     * ranges. The regions cover all data points.
+     */
+    static QVector<Region> regions(const double *x, int n, const QVector<double> &centers,
+                                   const QVector<double> &reach);
+
+    //! Estimate the standard deviation of the noise in y
+    /**
+     * Uses the median absolute deviation of the residuals of a moving average.
+     */
+    static double noiseLevel(const double *y, int n, int smoothingPoints);
+
+private:
+    //! Return the centered moving average of y over 'points' points
+    static QVector<double> smooth(const double *y, int n, int points);
+};
+
+#endif // ifndef PEAKDETECTION_H
@@ -0,0 +1,322 @@
+/***************************************************************************
+    File                 : PolynomialLeastSquares.cpp
+    Project              : SciDAVis
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 SciDAVis developers
+    Description          : Streaming (robust) least squares fit of polynomials
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "lib/PolynomialLeastSquares.h"
+#include "lib/DescriptiveStatistics.h"
+
+#include <QtConcurrentMap>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+//! Maximum number of reweighting iterations of robust fits
+const int MaxIterations = 100;
+//! Relative change of the coefficients below which robust fits are considered converged
+const double Tolerance = 1e-10;
+
+//! Tuning constants giving 95% efficiency for normally distributed errors
+const double HuberConstant = 1.345;
+const double BisquareConstant = 4.685;
+
+//! Value at t of the Chebyshev series with coefficients c, by Clenshaw's recurrence
+double chebyshev(const QVector<double> &c, double t)
+{
+    double b1 = 0.0, b2 = 0.0;
+    for (int k = c.size() - 1; k >= 1; k--) {
+        const double b = c.at(k) + 2 * t * b1 - b2;
+        b2 = b1;
+        b1 = b;
+    }
+    return c.at(0) + t * b1 - b2;
+}
+
+//! Indices of the blocks the n points are divided into
+QVector<int> blockIndices(int n)
+{
+    QVector<int> result((n + DescriptiveStatistics::BlockSize - 1)
+                        / DescriptiveStatistics::BlockSize);
+    for (int b = 0; b < result.size(); b++)
+        result[b] = b;
+    return result;
+}
+} // namespace
+
+//! Upper triangular factor R of the QR decomposition of a weighted design matrix
+/**
+ * The right-hand side is appended as the last column, so that the last diagonal element holds
+ * the square root of the residual sum of squares.
+ */
+class PolynomialLeastSquares::Triangle
+{
+public:
+    explicit Triangle(int size = 0) : d_size(size), d_r(size * size, 0.0) { }
+
+    //! Rotate 'row' (of length size(), overwritten in the process) into the triangle
+    void addRow(double *row)
+    {
+        for (int k = 0; k < d_size; k++) {
+            if (row[k] == 0.0)
+                continue;
+            double *r = d_r.data() + k * d_size;
+            const double h = hypot(r[k], row[k]);
+            const double c = r[k] / h, s = row[k] / h;
+            r[k] = h;
+            for (int j = k + 1; j < d_size; j++) {
+                const double t = r[j];
+                r[j] = c * t + s * row[j];
+                row[j] = c * row[j] - s * t;
+            }
+        }
+    }
+
+    //! Combine with the triangle of another, disjoint set of rows
+    void merge(const Triangle &other)
+    {
+        QVector<double> row(d_size);
+        for (int k = 0; k < d_size; k++) {
+            std::copy(other.d_r.constData() + k * d_size, other.d_r.constData() + (k + 1) * d_size,
+                      row.begin());
+            addRow(row.data());
+        }
+    }
+
+    int size() const { return d_size; }
+    double at(int i, int j) const { return d_r.at(i * d_size + j); }
+
+private:
+    int d_size;
+    QVector<double> d_r;
+};
+
+QVector<double> PolynomialLeastSquares::solve(const double *x, const double *y,
+                                              const double *weights, const double *robustWeights,
+                                              int n, int order, double center, double halfWidth,
+                                              QVector<double> *covariance,
+                                              double *weightedChiSquare)
+{
+    const int p = order + 1;
+    const QVector<int> blocks = blockIndices(n);
+    auto reduce = [=](int b) {
+        Triangle triangle(p + 1);
+        QVector<double> row(p + 1);
+        const int end = qMin((b + 1) * DescriptiveStatistics::BlockSize, n);
+        for (int i = b * DescriptiveStatistics::BlockSize; i < end; i++) {
+            double w = weights ? weights[i] : 1.0;
+            if (robustWeights)
+                w *= robustWeights[i];
+            if (!(w > 0))
+                continue;
+            const double sw = sqrt(w);
+            const double t = (x[i] - center) / halfWidth;
+            // Chebyshev polynomials T_k(t)
+            row[0] = sw;
+            if (p > 1)
+                row[1] = sw * t;
+            for (int k = 2; k < p; k++)
+                row[k] = 2 * t * row[k - 1] - row[k - 2];
+            row[p] = sw * y[i];
+            triangle.addRow(row.data());
+        }
+        return triangle;
+    };
+    const QVector<Triangle> partial = blocks.size() > 1
+            ? QtConcurrent::blockingMapped<QVector<Triangle>>(blocks, reduce)
+            : QVector<Triangle>() << reduce(0);
+    Triangle triangle = partial.first();
+    for (int b = 1; b < partial.size(); b++)
+        triangle.merge(partial.at(b));
+
+    // back substitution; parameters not determined by the data (zero pivots) are set to 0
+    double max_pivot = 0.0;
+    for (int k = 0; k < p; k++)
+        max_pivot = qMax(max_pivot, fabs(triangle.at(k, k)));
+    const double min_pivot = max_pivot * p * std::numeric_limits<double>::epsilon();
+    QVector<bool> determined(p);
+    QVector<double> c(p, 0.0);
+    for (int k = p - 1; k >= 0; k--) {
+        determined[k] = fabs(triangle.at(k, k)) > min_pivot;
+        if (!determined.at(k))
+            continue;
+        double sum = triangle.at(k, p);
+        for (int j = k + 1; j < p; j++)
+            sum -= triangle.at(k, j) * c.at(j);
+        c[k] = sum / triangle.at(k, k);
+    }
+    *weightedChiSquare = triangle.at(p, p) * triangle.at(p, p);
+
+    // (R^T R)^-1 = R^-1 R^-T
+    QVector<double> inverse(p * p, 0.0);
+    for (int j = 0; j < p; j++) {
+        if (!determined.at(j))
+            continue;
+        inverse[j * p + j] = 1.0 / triangle.at(j, j);
+        for (int i = j - 1; i >= 0; i--) {
+            if (!determined.at(i))
+                continue;
+            double sum = 0.0;
+            for (int k = i + 1; k <= j; k++)
+                sum += triangle.at(i, k) * inverse.at(k * p + j);
+            inverse[i * p + j] = -sum / triangle.at(i, i);
+        }
+    }
+    covariance->fill(0.0, p * p);
+    for (int i = 0; i < p; i++)
+        for (int j = 0; j < p; j++) {
+            double sum = 0.0;
+            for (int k = qMax(i, j); k < p; k++)
+                sum += inverse.at(i * p + k) * inverse.at(j * p + k);
+            (*covariance)[i * p + j] = sum;
+        }
+    return c;
+}
+
+PolynomialLeastSquares::Result PolynomialLeastSquares::fit(const double *x, const double *y,
+                                                           const double *weights, int n,
+                                                           int order, Robustness robustness)
+{
+    Result result;
+    const int p = order + 1;
+    if (order < 0 || n < p)
+        return result;
+
+    double low = x[0], high = x[0];
+    for (int i = 1; i < n; i++) {
+        low = qMin(low, x[i]);
+        high = qMax(high, x[i]);
+    }
+    const double center = 0.5 * (low + high);
+    const double half_width = high > low ? 0.5 * (high - low) : 1.0;
+
+    QVector<double> covariance;
+    QVector<double> c = solve(x, y, weights, nullptr, n, order, center, half_width, &covariance,
+                              &result.weightedChiSquare);
+
+    // scaled residuals sqrt(w_i) * (y_i - f(x_i)) of the current coefficients
+    QVector<double> residuals(n);
+    double *residual = residuals.data();
+    QVector<int> blocks = blockIndices(n);
+    auto computeResiduals = [&](int b) {
+        const int end = qMin((b + 1) * DescriptiveStatistics::BlockSize, n);
+        for (int i = b * DescriptiveStatistics::BlockSize; i < end; i++)
+            residual[i] = (y[i] - chebyshev(c, (x[i] - center) / half_width))
+                    * sqrt(weights ? weights[i] : 1.0);
+    };
+
+    if (robustness != Ordinary) {
+        QVector<double> robust_weights(n, 1.0);
+        QVector<double> spread(n);
+        while (result.iterations < MaxIterations) {
+            QtConcurrent::blockingMap(blocks, computeResiduals);
+            for (int i = 0; i < n; i++)
+                spread[i] = fabs(residual[i]);
+            const double scale =
+                    DescriptiveStatistics::quantiles(spread, QVector<double>() << 0.5)[0] / 0.6745;
+            if (!(scale > 0))
+                break;
+            for (int i = 0; i < n; i++) {
+                const double u = fabs(residual[i]) / scale;
+                if (robustness == Huber)
+                    robust_weights[i] = u <= HuberConstant ? 1.0 : HuberConstant / u;
+                else {
+                    const double v = u / BisquareConstant;
+                    robust_weights[i] = v < 1 ? (1 - v * v) * (1 - v * v) : 0.0;
+                }
+            }
+
+            QVector<double> next_covariance;
+            double weighted_chi_square;
+            const QVector<double> next =
+                    solve(x, y, weights, robust_weights.constData(), n, order, center, half_width,
+                          &next_covariance, &weighted_chi_square);
+            double change = 0.0, size = 0.0;
+            for (int k = 0; k < p; k++) {
+                change = qMax(change, fabs(next.at(k) - c.at(k)));
+                size = qMax(size, fabs(next.at(k)));
+            }
+            c = next;
+            covariance = next_covariance;
+            result.weightedChiSquare = weighted_chi_square;
+            result.iterations++;
+            if (change <= Tolerance * size)
+                break;
+        }
+        QtConcurrent::blockingMap(blocks, computeResiduals);
+        result.chiSquare = 0.0;
+        for (int i = 0; i < n; i++)
+            result.chiSquare += residual[i] * residual[i];
+    } else
+        result.chiSquare = result.weightedChiSquare;
+
+    // a_i = sum_j m(i,j) c_j, where m(i,j) is the coefficient of x^i in T_j((x - center) / half_width)
+    QVector<double> chebyshev_powers(p * p, 0.0); // coefficient of t^k in T_j at [j * p + k]
+    chebyshev_powers[0] = 1.0;
+    if (p > 1)
+        chebyshev_powers[p + 1] = 1.0;
+    for (int j = 2; j < p; j++)
+        for (int k = 0; k < p; k++)
+            chebyshev_powers[j * p + k] =
+                    (k > 0 ? 2 * chebyshev_powers.at((j - 1) * p + k - 1) : 0.0)
+                    - chebyshev_powers.at((j - 2) * p + k);
+    QVector<double> binomial(p * p, 0.0); // binomial coefficient (k over i) at [k * p + i]
+    for (int k = 0; k < p; k++) {
+        binomial[k * p] = 1.0;
+        for (int i = 1; i <= k; i++)
+            binomial[k * p + i] = binomial.at((k - 1) * p + i - 1)
+                    + (i < k ? binomial.at((k - 1) * p + i) : 0.0);
+    }
+    // t^k = sum_i (k over i) x^i (-center)^(k-i) / half_width^k
+    QVector<double> m(p * p, 0.0);
+    for (int j = 0; j < p; j++)
+        for (int k = 0; k < p; k++) {
+            const double b = chebyshev_powers.at(j * p + k);
+            if (b == 0.0)
+                continue;
+            for (int i = 0; i <= k; i++)
+                m[i * p + j] += b * binomial.at(k * p + i) * pow(-center, k - i)
+                        / pow(half_width, k);
+        }
+
+    result.coefficients.fill(0.0, p);
+    for (int i = 0; i < p; i++)
+        for (int j = 0; j < p; j++)
+            result.coefficients[i] += m.at(i * p + j) * c.at(j);
+    // covariance of the powers: M C M^T
+    QVector<double> mc(p * p, 0.0);
+    for (int i = 0; i < p; i++)
+        for (int j = 0; j < p; j++)
+            for (int k = 0; k < p; k++)
+                mc[i * p + j] += m.at(i * p + k) * covariance.at(k * p + j);
+    result.covariance.fill(0.0, p * p);
+    for (int i = 0; i < p; i++)
+        for (int j = 0; j < p; j++)
+            for (int k = 0; k < p; k++)
+                result.covariance[i * p + j] += mc.at(i * p + k) * m.at(j * p + k);
+    return result;
+}
@@ -0,0 +1,98 @@
+/***************************************************************************
+    File                 : PolynomialLeastSquares.h
+    Project              : SciDAVis
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 SciDAVis developers
+    Description          : Streaming (robust) least squares fit of polynomials
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef POLYNOMIALLEASTSQUARES_H
+#define POLYNOMIALLEASTSQUARES_H
+
+#include <QVector>
+
+//! Weighted least squares fit of a polynomial y = a0 + a1*x + ... + an*x^n
+/**
+  The design matrix is never stored. The data are processed in blocks of
+  DescriptiveStatistics::BlockSize points, and each block is reduced to the
+  triangular factor R of a QR decomposition by Givens rotations, one row at a
+  time. The blocks are reduced on the global thread pool. Their triangles are
+  then merged by rotating them into a single triangle. The memory needed is
+  independent of the number of points (apart from the residuals kept for
+  robust fits).
+
+  To keep the problem well conditioned for higher orders, x is mapped to
+  [-1, 1] and the polynomial is expanded in Chebyshev polynomials of the
+  mapped variable. The coefficients and their covariance are transformed back
+  to powers of x at the end.
+
+  Robust fits use iteratively reweighted least squares. The residuals are
+  scaled by a robust estimate of their spread: the median absolute residual
+  divided by 0.6745. Then Huber's or Tukey's bisquare weight function is
+  applied to them, multiplied with the weights given for the points.
+  */
+class PolynomialLeastSquares
+{
+public:
+    //! Weight function applied to the scaled residuals
+    enum Robustness {
+        //! Ordinary (weighted) least squares
+        Ordinary,
+        //! Huber weights min(1, k/|u|) with k = 1.345
+        Huber,
+        //! Tukey's bisquare weights (1 - (u/k)^2)^2 for |u| < k = 4.685, 0 otherwise
+        Bisquare
+    };
+
+    struct Result
+    {
+        //! a0 ... an; empty if the fit failed
+        QVector<double> coefficients;
+        //! The matrix (X^T W X)^-1 in row-major order, where W holds the final weights
+        QVector<double> covariance;
+        //! Sum of the squared residuals, multiplied by the given weights of the points
+        double chiSquare = 0.0;
+        //! Sum of the squared residuals, multiplied by the final weights (the minimized quantity)
+        double weightedChiSquare = 0.0;
+        //! Number of reweighting iterations (0 for ordinary least squares)
+        int iterations = 0;
+    };
+
+    //! Fit a polynomial of degree 'order' to the n points (x[i], y[i])
+    /**
+     * \param weights weights of the points (usually 1/sigma^2), or 0 for equal weights
+     */
+    static Result fit(const double *x, const double *y, const double *weights, int n, int order,
+                      Robustness robustness = Ordinary);
+
+private:
+    class Triangle;
+
+    //! Map x to t = (x - center) / halfWidth and return the Chebyshev coefficients
+    static QVector<double> solve(const double *x, const double *y, const double *weights,
+                                 const double *robustWeights, int n, int order, double center,
+                                 double halfWidth, QVector<double> *covariance,
+                                 double *weightedChiSquare);
+};
+
+#endif // ifndef POLYNOMIALLEASTSQUARES_H
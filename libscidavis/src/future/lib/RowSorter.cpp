@@ -0,0 +1,295 @@
+/***************************************************************************
+    File                 : RowSorter.cpp
+    Project              : SciDAVis
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 SciDAVis developers
+    Description          : Multi-key sorting of table rows
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "lib/RowSorter.h"
+#include "core/column/Column.h"
+
+#include <QThread>
+#include <QtConcurrentMap>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+namespace {
+//! Sorts with fewer elements are not split among threads
+const int ParallelThreshold = 1 << 16;
+
+//! Return the number of blocks a range of n elements is split into for parallel processing
+int blockCount(int n)
+{
+    if (n < ParallelThreshold)
+        return 1;
+    return qBound(1, QThread::idealThreadCount(), n / (ParallelThreshold / 4));
+}
+
+//! Return the list 0, 1, ..., n-1
+QVector<int> indexList(int n)
+{
+    QVector<int> indices(n);
+    std::iota(indices.begin(), indices.end(), 0);
+    return indices;
+}
+
+//! Map a double to an unsigned integer of the same order
+/**
+ * Negative numbers have all bits inverted, positive ones only the sign bit, so that the integers
+ * compare like the doubles did. The results for finite and infinite values never are 0 or ~0.
+ */
+quint64 orderedBits(double value)
+{
+    if (value == 0)
+        value = 0; // -0 and 0 compare equal
+    quint64 bits;
+    memcpy(&bits, &value, sizeof(bits));
+    const quint64 sign = quint64(1) << 63;
+    return (bits & sign) ? ~bits : (bits | sign);
+}
+
+//! Stable least significant digit radix sort of 'keys', moving 'rows' along
+void radixSort(QVector<quint64> &keys, QVector<int> &rows)
+{
+    const int n = keys.size();
+    if (n < 2)
+        return;
+
+    // digits which are equal for all keys need not be sorted by
+    quint64 differing = 0;
+    const quint64 first = keys.first();
+    for (quint64 key : keys)
+        differing |= key ^ first;
+    if (differing == 0)
+        return;
+
+    const int blocks = blockCount(n);
+    const int block_size = (n + blocks - 1) / blocks;
+    QVector<int> block_indices = indexList(blocks);
+    QVector<std::array<int, 256>> offsets(blocks);
+    QVector<quint64> keys_buffer(n);
+    QVector<int> rows_buffer(n);
+
+    for (int shift = 0; shift < 64; shift += 8) {
+        if (((differing >> shift) & 0xff) == 0)
+            continue;
+        const quint64 *src_keys = keys.constData();
+        const int *src_rows = rows.constData();
+        quint64 *dest_keys = keys_buffer.data();
+        int *dest_rows = rows_buffer.data();
+        std::array<int, 256> *block_offsets = offsets.data();
+
+        // count the digits in each block
+        auto count = [&](int b) {
+            std::array<int, 256> &counts = block_offsets[b];
+            counts.fill(0);
+            const int end = qMin(n, (b + 1) * block_size);
+            for (int i = b * block_size; i < end; i++)
+                counts[(src_keys[i] >> shift) & 0xff]++;
+        };
+        // turn the counts into the positions of the first element of each digit and block
+        auto scan = [&]() {
+            int position = 0;
+            for (int digit = 0; digit < 256; digit++)
+                for (int b = 0; b < blocks; b++) {
+                    const int c = block_offsets[b][digit];
+                    block_offsets[b][digit] = position;
+                    position += c;
+                }
+        };
+        // move the elements of each block to their positions
+        auto scatter = [&](int b) {
+            std::array<int, 256> &positions = block_offsets[b];
+            const int end = qMin(n, (b + 1) * block_size);
+            for (int i = b * block_size; i < end; i++) {
+                const int p = positions[(src_keys[i] >> shift) & 0xff]++;
+                dest_keys[p] = src_keys[i];
+                dest_rows[p] = src_rows[i];
+            }
+        };
+
+        if (blocks > 1) {
+            QtConcurrent::blockingMap(block_indices, count);
+            scan();
+            QtConcurrent::blockingMap(block_indices, scatter);
+        } else {
+            count(0);
+            scan();
+            scatter(0);
+        }
+        keys.swap(keys_buffer);
+        rows.swap(rows_buffer);
+    }
+}
+
+//! Stable merge sort of [begin, end), sorting and merging blocks in parallel
+template<class Less>
+void parallelStableSort(int *begin, int *end, Less less)
+{
+    const int n = int(end - begin);
+    const int blocks = blockCount(n);
+    if (blocks == 1) {
+        std::stable_sort(begin, end, less);
+        return;
+    }
+
+    const int block_size = (n + blocks - 1) / blocks;
+    QVector<int> bounds;
+    for (int b = 0; b < blocks; b++)
+        bounds << qMin(n, b * block_size);
+    bounds << n;
+    QVector<int> block_indices = indexList(blocks);
+    QtConcurrent::blockingMap(block_indices, [&](int b) {
+        std::stable_sort(begin + bounds[b], begin + bounds[b + 1], less);
+    });
+
+    // merge pairs of neighbouring runs until only one is left; the left run wins ties
+    QVector<int> buffer(n);
+    int *src = begin, *dest = buffer.data();
+    while (bounds.size() > 2) {
+        const int runs = bounds.size() - 1;
+        QVector<int> merged_bounds;
+        for (int r = 0; r < runs; r += 2)
+            merged_bounds << bounds[r];
+        merged_bounds << n;
+        QVector<int> merges = indexList(merged_bounds.size() - 1);
+        QtConcurrent::blockingMap(merges, [&](int m) {
+            const int first = bounds[2 * m];
+            const int middle = bounds[qMin(2 * m + 1, runs)];
+            const int last = bounds[qMin(2 * m + 2, runs)];
+            std::merge(src + first, src + middle, src + middle, src + last, dest + first, less);
+        });
+        bounds = merged_bounds;
+        std::swap(src, dest);
+    }
+    if (src != begin)
+        std::copy(src, src + n, begin);
+}
+
+} // namespace
+
+RowSorter::RowSorter(int rows) : d_rows(qMax(rows, 0)), d_invalid_placement(InvalidLast) { }
+
+void RowSorter::addKey(const AbstractColumn *column, bool ascending)
+{
+    if (column)
+        d_keys << Key { column, ascending };
+}
+
+QVector<int> RowSorter::permutation() const
+{
+    QVector<int> rows = indexList(d_rows);
+    // stable sorts by the least significant key first leave rows with equal keys in the order
+    // established by the less significant keys
+    for (int k = d_keys.size() - 1; k >= 0; k--) {
+        if (d_keys.at(k).column->dataType() == SciDAVis::TypeQString)
+            sortText(d_keys.at(k), rows);
+        else
+            sortNumeric(d_keys.at(k), rows);
+    }
+    return rows;
+}
+
+QVector<int> RowSorter::inverse(const QVector<int> &permutation)
+{
+    QVector<int> result(permutation.size());
+    for (int i = 0; i < permutation.size(); i++)
+        result[permutation.at(i)] = i;
+    return result;
+}
+
+bool RowSorter::isIdentity(const QVector<int> &permutation)
+{
+    for (int i = 0; i < permutation.size(); i++)
+        if (permutation.at(i) != i)
+            return false;
+    return true;
+}
+
+void RowSorter::sortNumeric(const Key &key, QVector<int> &rows) const
+{
+    const AbstractColumn *column = key.column;
+    const QVector<bool> invalid =
+            rowFlags(column->invalidIntervals(), d_rows, column->rowCount());
+    const quint64 invalid_key = d_invalid_placement == InvalidLast ? ~quint64(0) : 0;
+
+    // the key of each row, in the order of the rows
+    QVector<quint64> row_keys(d_rows);
+    const int valid_rows = qMin(d_rows, column->rowCount());
+    if (column->dataType() == SciDAVis::TypeDouble) {
+        const Column *c = dynamic_cast<const Column *>(column);
+        const QVector<qreal> values = c ? c->values() : QVector<qreal>();
+        for (int row = 0; row < valid_rows; row++) {
+            const double value = c ? values.at(row) : column->valueAt(row);
+            row_keys[row] = invalid.at(row) || std::isnan(value) ? invalid_key : orderedBits(value);
+        }
+    } else {
+        const quint64 sign = quint64(1) << 63;
+        for (int row = 0; row < valid_rows; row++) {
+            const QDateTime value = column->dateTimeAt(row);
+            row_keys[row] = invalid.at(row) || !value.isValid()
+                    ? invalid_key
+                    : quint64(value.toMSecsSinceEpoch()) ^ sign;
+        }
+    }
+    for (int row = valid_rows; row < d_rows; row++)
+        row_keys[row] = invalid_key;
+
+    QVector<quint64> keys(d_rows);
+    for (int i = 0; i < d_rows; i++) {
+        const quint64 k = row_keys.at(rows.at(i));
+        keys[i] = key.ascending || k == invalid_key ? k : ~k;
+    }
+    radixSort(keys, rows);
+}
+
+void RowSorter::sortText(const Key &key, QVector<int> &rows) const
+{
+    const AbstractColumn *column = key.column;
+    const QVector<bool> invalid =
+            rowFlags(column->invalidIntervals(), d_rows, column->rowCount());
+    QVector<QString> texts(d_rows);
+    for (int row = 0; row < qMin(d_rows, column->rowCount()); row++)
+        if (!invalid.at(row))
+            texts[row] = column->textAt(row);
+
+    // move the invalid rows aside, then sort the valid ones
+    int *begin = rows.data(), *end = begin + rows.size();
+    int *valid_begin = begin, *valid_end = end;
+    auto is_valid = [&](int row) { return !invalid.at(row); };
+    if (d_invalid_placement == InvalidLast)
+        valid_end = std::stable_partition(begin, end, is_valid);
+    else
+        valid_begin = std::stable_partition(begin, end, [&](int row) { return invalid.at(row); });
+
+    const QString *t = texts.constData();
+    if (key.ascending)
+        parallelStableSort(valid_begin, valid_end, [t](int a, int b) { return t[a] < t[b]; });
+    else
+        parallelStableSort(valid_begin, valid_end, [t](int a, int b) { return t[b] < t[a]; });
+}
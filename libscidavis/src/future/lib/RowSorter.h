@@ -0,0 +1,93 @@
+/***************************************************************************
+    File                 : RowSorter.h
+    Project              : SciDAVis
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 SciDAVis developers
+    Description          : Multi-key sorting of table rows
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef ROWSORTER_H
+#define ROWSORTER_H
+
+#include <QList>
+#include <QVector>
+
+class AbstractColumn;
+
+//! Computes the permutation of rows which sorts a set of columns by one or more keys
+/**
+  The permutation is computed once and can then be applied to any number of
+  columns (see Column::permuteRows()). Keys are added in order of decreasing
+  significance; rows which compare equal on all keys keep their relative order.
+
+  Each key is sorted in one stable pass over the current permutation, starting
+  with the least significant key. Numeric and date-time keys are mapped to
+  unsigned integers of the same order and sorted by a least significant digit
+  radix sort, whose counting and scattering passes run on the global thread
+  pool for large tables. Text keys are sorted by a merge sort whose blocks are
+  sorted and merged in parallel.
+
+  Invalid rows, rows beyond the end of a key column and NaN values are placed
+  according to invalidPlacement(), independently of the sort order.
+  */
+class RowSorter
+{
+public:
+    enum InvalidPlacement { InvalidLast, InvalidFirst };
+
+    //! Sort the rows 0 to rows-1
+    explicit RowSorter(int rows);
+
+    //! Add a sort key which is less significant than the keys added before
+    void addKey(const AbstractColumn *column, bool ascending = true);
+    InvalidPlacement invalidPlacement() const { return d_invalid_placement; }
+    void setInvalidPlacement(InvalidPlacement placement) { d_invalid_placement = placement; }
+
+    //! Return the sorted order of the rows
+    /**
+     * Element i is the row which is to be moved to row i.
+     */
+    QVector<int> permutation() const;
+    //! Return the permutation which reverts 'permutation'
+    static QVector<int> inverse(const QVector<int> &permutation);
+    //! Return whether 'permutation' leaves all rows in place
+    static bool isIdentity(const QVector<int> &permutation);
+
+private:
+    struct Key
+    {
+        const AbstractColumn *column;
+        bool ascending;
+    };
+
+    //! Stably sort 'rows' by the numeric or date-time values of 'key'
+    void sortNumeric(const Key &key, QVector<int> &rows) const;
+    //! Stably sort 'rows' by the texts of 'key'
+    void sortText(const Key &key, QVector<int> &rows) const;
+
+    int d_rows;
+    QList<Key> d_keys;
+    InvalidPlacement d_invalid_placement;
+};
+
+#endif // ifndef ROWSORTER_H
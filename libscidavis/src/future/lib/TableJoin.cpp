@@ -0,0 +1,440 @@
+/***************************************************************************
+    File                 : TableJoin.cpp
+    Project              : SciDAVis
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 SciDAVis developers
+    Description          : Matches the rows of two tables on key columns
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "lib/TableJoin.h"
+#include "core/column/Column.h"
+
+#include <QDateTime>
+#include <QHash>
+#include <QPair>
+#include <QtConcurrentMap>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace {
+//! Number of rows processed by one task
+const int BlockRows = 16384;
+
+//! Return the list of indices of the blocks of 'rows' rows
+QVector<int> blockList(int rows)
+{
+    QVector<int> result((rows + BlockRows - 1) / BlockRows);
+    for (int i = 0; i < result.size(); i++)
+        result[i] = i;
+    return result;
+}
+
+//! Return the values of a numeric or date-time column (in ms), NaN for invalid rows
+QVector<double> keyValues(const AbstractColumn *column, int rows)
+{
+    const QVector<bool> valid =
+            rowFlags(column->invalidIntervals(), rows, column->rowCount(), false);
+    QVector<double> values(rows, std::numeric_limits<double>::quiet_NaN());
+    if (column->dataType() == SciDAVis::TypeDouble) {
+        const Column *c = dynamic_cast<const Column *>(column);
+        const QVector<qreal> data = c ? c->values() : QVector<qreal>();
+        for (int row = 0; row < rows; row++)
+            if (valid.at(row))
+                values[row] = c ? data.at(row) : column->valueAt(row);
+    } else
+        for (int row = 0; row < rows; row++)
+            if (valid.at(row)) {
+                const QDateTime value = column->dateTimeAt(row);
+                if (value.isValid())
+                    values[row] = value.toMSecsSinceEpoch();
+            }
+    return values;
+}
+
+//! Return the bits of the keys of a numeric or date-time column; valid tells which rows have one
+QVector<quint64> keyBits(const AbstractColumn *column, int rows, QVector<bool> &valid)
+{
+    valid = rowFlags(column->invalidIntervals(), rows, column->rowCount(), false);
+    QVector<quint64> bits(rows, 0);
+    if (column->dataType() == SciDAVis::TypeDouble) {
+        const QVector<double> values = keyValues(column, rows);
+        for (int row = 0; row < rows; row++) {
+            valid[row] = !std::isnan(values.at(row));
+            // 0 and -0 are the same key
+            const double value = values.at(row) == 0.0 ? 0.0 : values.at(row);
+            std::memcpy(&bits[row], &value, sizeof(value));
+        }
+    } else
+        for (int row = 0; row < rows; row++)
+            if (valid.at(row)) {
+                const QDateTime value = column->dateTimeAt(row);
+                valid[row] = value.isValid();
+                bits[row] = quint64(value.toMSecsSinceEpoch());
+            }
+    return bits;
+}
+
+//! Return the texts of a text column; valid tells which rows have one
+QVector<QString> keyTexts(const AbstractColumn *column, int rows, QVector<bool> &valid)
+{
+    valid = rowFlags(column->invalidIntervals(), rows, column->rowCount(), false);
+    QVector<QString> texts(rows);
+    const Column *c = dynamic_cast<const Column *>(column);
+    const QStringList data = c ? c->texts() : QStringList();
+    for (int row = 0; row < rows; row++)
+        if (valid.at(row))
+            texts[row] = c ? data.at(row) : column->textAt(row);
+    return texts;
+}
+
+//! Return the cells of the pairs of rows and mark the invalid ones in 'invalid'
+/**
+ * The cell of a pair comes from 'left' if it is given and the left row is not -1, otherwise
+ * from 'right' under the same conditions; if there is none, the cell is invalid. The valid
+ * vectors are as long as the columns, rows beyond them are invalid.
+ */
+template<class D>
+D gather(const D *left, const QVector<bool> &left_valid, const QVector<int> &left_rows,
+         const D *right, const QVector<bool> &right_valid, const QVector<int> &right_rows,
+         const typename D::value_type &empty, IntervalAttribute<bool> &invalid)
+{
+    const int pairs = left_rows.size();
+    D result;
+    result.reserve(pairs);
+    QVector<bool> invalid_pairs(pairs, true);
+    for (int pair = 0; pair < pairs; pair++) {
+        const int l = left ? left_rows.at(pair) : -1;
+        const int r = right ? right_rows.at(pair) : -1;
+        bool valid = false;
+        if (l >= 0) {
+            valid = l < left_valid.size() && left_valid.at(l);
+            result << (valid ? left->at(l) : empty);
+        } else if (r >= 0) {
+            valid = r < right_valid.size() && right_valid.at(r);
+            result << (valid ? right->at(r) : empty);
+        } else
+            result << empty;
+        invalid_pairs[pair] = !valid;
+    }
+    // mark each run of invalid cells at once
+    for (const Interval<int> &iv :
+         flaggedIntervals(pairs, [&invalid_pairs](int pair) { return invalid_pairs.at(pair); }))
+        invalid.setValue(iv, true);
+    return result;
+}
+
+//! Number the pairs of ids and keys of the right rows, and look up those of the left rows
+/**
+ * Returns the number of ids. Rows with an id of -1 or an invalid key get the id -1.
+ */
+template<class K>
+int combine(QVector<int> &left_ids, const QVector<K> &left_keys, const QVector<bool> &left_valid,
+            QVector<int> &right_ids, const QVector<K> &right_keys,
+            const QVector<bool> &right_valid)
+{
+    QHash<QPair<int, K>, int> index;
+    for (int row = 0; row < right_ids.size(); row++) {
+        int &id = right_ids[row];
+        if (id < 0)
+            continue;
+        if (!right_valid.at(row)) {
+            id = -1;
+            continue;
+        }
+        const QPair<int, K> key(id, right_keys.at(row));
+        auto entry = index.constFind(key);
+        if (entry == index.constEnd())
+            entry = index.insert(key, index.size());
+        id = entry.value();
+    }
+
+    // the index is only read from now on, which is safe from several threads
+    const int rows = left_ids.size();
+    int *ids = left_ids.data();
+    QVector<int> blocks = blockList(rows);
+    QtConcurrent::blockingMap(blocks, [&](int block) {
+        for (int row = block * BlockRows; row < qMin(rows, (block + 1) * BlockRows); row++) {
+            if (ids[row] >= 0)
+                ids[row] = left_valid.at(row)
+                        ? index.value(QPair<int, K>(ids[row], left_keys.at(row)), -1)
+                        : -1;
+        }
+    });
+    return index.size();
+}
+} // namespace
+
+TableJoin::TableJoin(int left_rows, int right_rows, Type type)
+    : d_left_row_count(qMax(left_rows, 0)),
+      d_right_row_count(qMax(right_rows, 0)),
+      d_type(type),
+      d_tolerance(-1.0)
+{
+}
+
+void TableJoin::addKey(const AbstractColumn *left, const AbstractColumn *right)
+{
+    if (left && right)
+        d_keys << Key { left, right };
+}
+
+void TableJoin::matchExactKeys(QVector<int> &left_ids, QVector<int> &right_ids, int &ids) const
+{
+    left_ids.fill(0, d_left_row_count);
+    right_ids.fill(0, d_right_row_count);
+    ids = 1;
+    const int exact_keys = d_type == Nearest ? d_keys.size() - 1 : d_keys.size();
+    for (int k = 0; k < exact_keys; k++) {
+        const Key &key = d_keys.at(k);
+        QVector<bool> left_valid, right_valid;
+        if (key.left->dataType() == SciDAVis::TypeQString) {
+            const QVector<QString> left = keyTexts(key.left, d_left_row_count, left_valid);
+            const QVector<QString> right = keyTexts(key.right, d_right_row_count, right_valid);
+            ids = combine(left_ids, left, left_valid, right_ids, right, right_valid);
+        } else {
+            const QVector<quint64> left = keyBits(key.left, d_left_row_count, left_valid);
+            const QVector<quint64> right = keyBits(key.right, d_right_row_count, right_valid);
+            ids = combine(left_ids, left, left_valid, right_ids, right, right_valid);
+        }
+    }
+}
+
+void TableJoin::join()
+{
+    d_left_rows.clear();
+    d_right_rows.clear();
+    if (d_type == Nearest && d_keys.isEmpty())
+        return;
+
+    QVector<int> left_ids, right_ids;
+    int ids = 0;
+    matchExactKeys(left_ids, right_ids, ids);
+
+    // the right rows of each id in their order (by counting sort)
+    QVector<int> offsets(ids + 1, 0);
+    for (int id : right_ids)
+        if (id >= 0)
+            offsets[id + 1]++;
+    for (int id = 0; id < ids; id++)
+        offsets[id + 1] += offsets.at(id);
+    QVector<int> order(offsets.last());
+    QVector<int> next = offsets;
+    for (int row = 0; row < d_right_row_count; row++)
+        if (right_ids.at(row) >= 0)
+            order[next[right_ids.at(row)]++] = row;
+
+    // for nearest matches, sort the right rows of each id by the last key, leaving out
+    // those whose key is invalid
+    QVector<double> left_values, right_values;
+    QVector<int> ends = offsets.mid(1);
+    int *sorted = order.data();
+    if (d_type == Nearest) {
+        left_values = keyValues(d_keys.last().left, d_left_row_count);
+        right_values = keyValues(d_keys.last().right, d_right_row_count);
+        const double *values = right_values.constData();
+        int *end = ends.data();
+        QVector<int> id_list(ids);
+        for (int id = 0; id < ids; id++)
+            id_list[id] = id;
+        QtConcurrent::blockingMap(id_list, [&](int id) {
+            int *first = sorted + offsets.at(id);
+            int *last = std::stable_partition(sorted + offsets.at(id), sorted + offsets.at(id + 1),
+                                              [&](int row) { return !std::isnan(values[row]); });
+            std::stable_sort(first, last, [&](int a, int b) { return values[a] < values[b]; });
+            end[id] = last - sorted;
+        });
+    }
+
+    // the number of pairs of each left row, and its nearest match
+    const int rows = d_left_row_count;
+    QVector<int> counts(rows + 1, 0);
+    QVector<int> nearest(d_type == Nearest ? rows : 0, -1);
+    int *count = counts.data();
+    int *nearest_rows = nearest.data();
+    QVector<int> blocks = blockList(rows);
+    QtConcurrent::blockingMap(blocks, [&](int block) {
+        for (int row = block * BlockRows; row < qMin(rows, (block + 1) * BlockRows); row++) {
+            const int id = left_ids.at(row);
+            int matches = id >= 0 ? offsets.at(id + 1) - offsets.at(id) : 0;
+            if (d_type == Nearest) {
+                matches = 0;
+                const double value = id >= 0 ? left_values.at(row) : std::nan("");
+                if (!std::isnan(value) && ends.at(id) > offsets.at(id)) {
+                    const int *first = sorted + offsets.at(id), *last = sorted + ends.at(id);
+                    const int *above = std::lower_bound(first, last, value, [&](int r, double v) {
+                        return right_values.at(r) < v;
+                    });
+                    // the smaller key wins ties
+                    const int *match = above;
+                    if (above == last
+                        || (above != first
+                            && value - right_values.at(*(above - 1))
+                                    <= right_values.at(*above) - value))
+                        match = above - 1;
+                    if (d_tolerance < 0
+                        || std::fabs(right_values.at(*match) - value) <= d_tolerance) {
+                        nearest_rows[row] = *match;
+                        matches = 1;
+                    }
+                }
+            }
+            count[row + 1] = d_type == Inner ? matches : qMax(matches, 1);
+        }
+    });
+    for (int row = 0; row < rows; row++)
+        counts[row + 1] += counts.at(row);
+
+    // right rows without match
+    QVector<int> unmatched;
+    if (d_type == Outer) {
+        QVector<bool> id_matched(ids, false);
+        for (int id : left_ids)
+            if (id >= 0)
+                id_matched[id] = true;
+        for (int row = 0; row < d_right_row_count; row++)
+            if (right_ids.at(row) < 0 || !id_matched.at(right_ids.at(row)))
+                unmatched << row;
+    }
+
+    // write the pairs, each left row at its offset
+    const int pairs = counts.at(rows);
+    d_left_rows.resize(pairs + unmatched.size());
+    d_right_rows.resize(pairs + unmatched.size());
+    int *left_rows = d_left_rows.data();
+    int *right_rows = d_right_rows.data();
+    QtConcurrent::blockingMap(blocks, [&](int block) {
+        for (int row = block * BlockRows; row < qMin(rows, (block + 1) * BlockRows); row++) {
+            int pair = counts.at(row);
+            const int id = left_ids.at(row);
+            if (d_type == Nearest) {
+                left_rows[pair] = row;
+                right_rows[pair] = nearest_rows[row];
+            } else if (id >= 0 && offsets.at(id + 1) > offsets.at(id)) {
+                for (int i = offsets.at(id); i < offsets.at(id + 1); i++, pair++) {
+                    left_rows[pair] = row;
+                    right_rows[pair] = sorted[i];
+                }
+            } else if (pair < counts.at(row + 1)) {
+                left_rows[pair] = row;
+                right_rows[pair] = -1;
+            }
+        }
+    });
+    for (int i = 0; i < unmatched.size(); i++) {
+        left_rows[pairs + i] = -1;
+        right_rows[pairs + i] = unmatched.at(i);
+    }
+}
+
+QList<Column *> TableJoin::columns(const QList<Output> &outputs) const
+{
+    // snapshot the source columns on this thread
+    struct Job
+    {
+        const Column *left, *right;
+        SciDAVis::ColumnDataType type;
+        QVector<qreal> left_values, right_values, values;
+        QStringList left_texts, right_texts, texts;
+        QList<QDateTime> left_date_times, right_date_times, date_times;
+        QList<Interval<int>> left_invalid, right_invalid;
+        IntervalAttribute<bool> invalid;
+    };
+    QVector<Job> jobs;
+    for (const Output &output : outputs) {
+        Job job;
+        job.left = output.left;
+        job.right = output.right;
+        job.type = (output.left ? output.left : output.right)->dataType();
+        for (const Column *column : { output.left, output.right }) {
+            if (!column)
+                continue;
+            const bool is_left = column == output.left;
+            (is_left ? job.left_invalid : job.right_invalid) = column->invalidIntervals();
+            switch (job.type) {
+            case SciDAVis::TypeDouble:
+                (is_left ? job.left_values : job.right_values) = column->values();
+                break;
+            case SciDAVis::TypeQString:
+                (is_left ? job.left_texts : job.right_texts) = column->texts();
+                break;
+            case SciDAVis::TypeQDateTime:
+                (is_left ? job.left_date_times : job.right_date_times) = column->dateTimes();
+                break;
+            }
+        }
+        jobs << job;
+    }
+
+    auto valid_rows = [](const Column *column, const QList<Interval<int>> &invalid) {
+        return rowFlags(invalid, column ? column->rowCount() : 0, INT_MAX, false);
+    };
+    QtConcurrent::blockingMap(jobs, [&](Job &job) {
+        const QVector<bool> left_valid = valid_rows(job.left, job.left_invalid);
+        const QVector<bool> right_valid = valid_rows(job.right, job.right_invalid);
+        switch (job.type) {
+        case SciDAVis::TypeDouble:
+            job.values = gather(job.left ? &job.left_values : nullptr, left_valid, d_left_rows,
+                                job.right ? &job.right_values : nullptr, right_valid,
+                                d_right_rows, std::numeric_limits<qreal>::quiet_NaN(),
+                                job.invalid);
+            break;
+        case SciDAVis::TypeQString:
+            job.texts = gather(job.left ? &job.left_texts : nullptr, left_valid, d_left_rows,
+                               job.right ? &job.right_texts : nullptr, right_valid, d_right_rows,
+                               QString(), job.invalid);
+            break;
+        case SciDAVis::TypeQDateTime:
+            job.date_times = gather(job.left ? &job.left_date_times : nullptr, left_valid,
+                                    d_left_rows, job.right ? &job.right_date_times : nullptr,
+                                    right_valid, d_right_rows, QDateTime(), job.invalid);
+            break;
+        }
+    });
+
+    QList<Column *> result;
+    for (int i = 0; i < jobs.size(); i++) {
+        Job &job = jobs[i];
+        const Column *source = job.left ? job.left : job.right;
+        const QString &name = outputs.at(i).name;
+        Column *column = nullptr;
+        switch (job.type) {
+        case SciDAVis::TypeDouble:
+            column = new Column(name, job.values, job.invalid);
+            break;
+        case SciDAVis::TypeQString:
+            column = new Column(name, job.texts, job.invalid);
+            break;
+        case SciDAVis::TypeQDateTime:
+            column = new Column(name, job.date_times, job.invalid);
+            break;
+        }
+        if (column->columnMode() != source->columnMode())
+            column->setColumnMode(source->columnMode());
+        column->setPlotDesignation(source->plotDesignation());
+        result << column;
+    }
+    return result;
+}
@@ -0,0 +1,126 @@
+/***************************************************************************
+    File                 : TableJoin.h
+    Project              : SciDAVis
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 SciDAVis developers
+    Description          : Matches the rows of two tables on key columns
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef TABLEJOIN_H
+#define TABLEJOIN_H
+
+#include <QList>
+#include <QString>
+#include <QVector>
+
+class AbstractColumn;
+class Column;
+
+//! Matches the rows of two tables by the cells of pairs of key columns
+/**
+  The result is a list of pairs of rows, one of the left and one of the right
+  table (see leftRows() and rightRows()), in the order of the left rows; the
+  right rows matching the same left row keep their order. Rows with an
+  invalid key cell (or NaN) match no row.
+
+  Exact keys are matched by a hash index: the right table is hashed once per
+  key column, combining each key with the matches of the keys before it;
+  the left rows then look up their keys in blocks in parallel, and the pairs
+  are written in parallel as well, at offsets known from counting the
+  matches first.
+
+  columns() then builds the columns of the joined table in bulk.
+
+  A Nearest join matches the last key column to the row with the nearest
+  value (a number or a date-time) among the right rows whose other keys are
+  equal, like an "as-of" join of time series. Each left row matches at most
+  one right row, the smaller key winning ties; optionally, keys further apart
+  than a tolerance do not match.
+  */
+class TableJoin
+{
+public:
+    enum Type {
+        //! Pairs of matching rows
+        Inner,
+        //! Pairs of matching rows, and left rows without match
+        Left,
+        //! Pairs of matching rows, and rows of both tables without match
+        Outer,
+        //! Each left row with the right row nearest in the last key, if any
+        Nearest
+    };
+
+    //! Match the rows 0 to left_rows-1 of the left table with 0 to right_rows-1 of the right one
+    TableJoin(int left_rows, int right_rows, Type type);
+
+    //! Add a pair of key columns of the same data type
+    void addKey(const AbstractColumn *left, const AbstractColumn *right);
+    //! For Nearest joins: the largest difference of matching keys (milliseconds for date-times)
+    /**
+     * A negative tolerance (the default) matches keys at any distance.
+     */
+    void setTolerance(double tolerance) { d_tolerance = tolerance; }
+    //! Match the rows by the keys added so far
+    void join();
+
+    //! Return the left row of each pair, or -1 for right rows without match
+    const QVector<int> &leftRows() const { return d_left_rows; }
+    //! Return the right row of each pair, or -1 for left rows without match
+    const QVector<int> &rightRows() const { return d_right_rows; }
+
+    //! A column of the joined table
+    struct Output
+    {
+        QString name;
+        //! The column of the left table providing the cells, or 0
+        const Column *left;
+        //! The column of the right table providing the cells where there is no left row, or 0
+        const Column *right;
+    };
+    //! Return new columns holding the cells of the pairs of rows
+    /**
+     * The cells of each column are gathered in parallel (for all columns at once) and moved
+     * into the columns, which are created on the calling thread.
+     */
+    QList<Column *> columns(const QList<Output> &outputs) const;
+
+private:
+    struct Key
+    {
+        const AbstractColumn *left;
+        const AbstractColumn *right;
+    };
+
+    //! Number the combinations of exact keys of the right rows, and look up those of the left
+    void matchExactKeys(QVector<int> &left_ids, QVector<int> &right_ids, int &ids) const;
+
+    int d_left_row_count, d_right_row_count;
+    Type d_type;
+    double d_tolerance;
+    QList<Key> d_keys;
+    QVector<int> d_left_rows;
+    QVector<int> d_right_rows;
+};
+
+#endif // ifndef TABLEJOIN_H
@@ -0,0 +1,255 @@
+/***************************************************************************
+    File                 : MatrixOperations.cpp
+    Project              : SciDAVis
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 SciDAVis developers
+    Description          : Linear algebra and arithmetic on matrix cells
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "matrix/MatrixOperations.h"
+
+#include <QtConcurrentMap>
+
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_linalg.h>
+
+#include <cstring>
+#include <vector>
+
+namespace {
+typedef MatrixOperations::Cells Cells;
+
+//! Number of result columns computed by one task
+const int ColumnBlock = 64;
+
+//! Call task(first, last) for blocks of ColumnBlock columns, on the global thread pool
+template<class Task>
+void forColumnBlocks(int columns, Task task)
+{
+    QVector<int> blocks;
+    for (int first = 0; first < columns; first += ColumnBlock)
+        blocks << first;
+    auto run = [&](int first) { task(first, qMin(first + ColumnBlock, columns)); };
+    if (blocks.size() > 1)
+        QtConcurrent::blockingMap(blocks, run);
+    else if (!blocks.isEmpty())
+        run(blocks.first());
+}
+
+//! Return zero initialized cells of the given dimensions
+Cells newCells(int rows, int columns)
+{
+    Cells cells(columns);
+    for (QVector<qreal> &column : cells)
+        column = QVector<qreal>(rows, 0.0);
+    return cells;
+}
+
+//! Return pointers to the cells of each column
+/**
+ * This detaches the columns, so it has to be done before writing to them in parallel.
+ */
+QVector<double *> columnData(Cells &cells)
+{
+    QVector<double *> result;
+    result.reserve(cells.size());
+    for (QVector<qreal> &column : cells)
+        result << column.data();
+    return result;
+}
+
+//! Copy the cells into a contiguous row-major array
+std::vector<double> rowMajor(const Cells &cells, int rows)
+{
+    const int columns = cells.size();
+    std::vector<double> result(size_t(rows) * columns);
+    double *data = result.data();
+    forColumnBlocks(columns, [&](int first, int last) {
+        // transpose in blocks of rows, so that the rows written to stay in cache
+        for (int first_row = 0; first_row < rows; first_row += ColumnBlock) {
+            const int last_row = qMin(first_row + ColumnBlock, rows);
+            for (int col = first; col < last; col++) {
+                const double *source = cells.at(col).constData();
+                for (int row = first_row; row < last_row; row++)
+                    data[size_t(row) * columns + col] = source[row];
+            }
+        }
+    });
+    return result;
+}
+
+//! LU decomposition of a non-empty square matrix, in the form used by gsl_linalg_LU_*()
+class LUDecomposition
+{
+public:
+    LUDecomposition(const Cells &a)
+        : d_cells(rowMajor(a, a.size())),
+          d_view(gsl_matrix_view_array(d_cells.data(), a.size(), a.size())),
+          d_permutation(gsl_permutation_alloc(a.size()))
+    {
+        gsl_linalg_LU_decomp(&d_view.matrix, d_permutation, &d_signum);
+    }
+    ~LUDecomposition() { gsl_permutation_free(d_permutation); }
+
+    bool isSingular() const
+    {
+        for (size_t i = 0; i < d_view.matrix.size1; i++)
+            if (gsl_matrix_get(&d_view.matrix, i, i) == 0.0)
+                return true;
+        return false;
+    }
+    double determinant() { return gsl_linalg_LU_det(&d_view.matrix, d_signum); }
+    //! Overwrite b (of length n) with the solution of a * x = b
+    void solve(double *b) const
+    {
+        gsl_vector_view x = gsl_vector_view_array(b, d_view.matrix.size1);
+        gsl_linalg_LU_svx(&d_view.matrix, d_permutation, &x.vector);
+    }
+
+private:
+    std::vector<double> d_cells;
+    gsl_matrix_view d_view;
+    gsl_permutation *d_permutation;
+    int d_signum;
+};
+
+//! Solve a * x = b for 'columns' right hand sides, which rhs(col, b) writes into b
+template<class RightHandSide>
+bool solveColumns(const Cells &a, int columns, RightHandSide rhs, Cells *result)
+{
+    const int n = a.size();
+    Cells x = newCells(n, columns);
+    if (n > 0) {
+        const LUDecomposition lu(a);
+        if (lu.isSingular())
+            return false;
+        const QVector<double *> x_data = columnData(x);
+        forColumnBlocks(columns, [&](int first, int last) {
+            for (int col = first; col < last; col++) {
+                rhs(col, x_data[col]);
+                lu.solve(x_data[col]);
+            }
+        });
+    }
+    *result = x;
+    return true;
+}
+} // namespace
+
+double MatrixOperations::determinant(const Cells &a)
+{
+    if (a.isEmpty())
+        return 1.0;
+    LUDecomposition lu(a);
+    return lu.determinant();
+}
+
+bool MatrixOperations::inverse(const Cells &a, Cells *result)
+{
+    if (rowCount(a) != a.size())
+        return false;
+    return solveColumns(
+            a, a.size(), [](int col, double *b) { b[col] = 1.0; }, result);
+}
+
+bool MatrixOperations::solve(const Cells &a, const Cells &b, Cells *result)
+{
+    const int n = a.size();
+    if (rowCount(a) != n || rowCount(b) != n)
+        return false;
+    return solveColumns(
+            a, b.size(),
+            [&](int col, double *x) { memcpy(x, b.at(col).constData(), n * sizeof(double)); },
+            result);
+}
+
+bool MatrixOperations::product(const Cells &a, const Cells &b, Cells *result)
+{
+    const int m = rowCount(a), k = a.size(), n = b.size();
+    if (rowCount(b) != k)
+        return false;
+
+    Cells c = newCells(m, n);
+    if (m > 0 && n > 0 && k > 0) {
+        // a column-major copy of a is a row-major copy of its transpose, and c^T = b^T a^T
+        std::vector<double> a_t(size_t(k) * m);
+        for (int col = 0; col < k; col++)
+            memcpy(a_t.data() + size_t(col) * m, a.at(col).constData(), m * sizeof(double));
+        const gsl_matrix_const_view a_view = gsl_matrix_const_view_array(a_t.data(), k, m);
+
+        const QVector<double *> c_data = columnData(c);
+        forColumnBlocks(n, [&](int first, int last) {
+            const int count = last - first;
+            std::vector<double> b_t(size_t(count) * k), c_t(size_t(count) * m);
+            for (int col = first; col < last; col++)
+                memcpy(b_t.data() + size_t(col - first) * k, b.at(col).constData(),
+                       k * sizeof(double));
+            gsl_matrix_const_view b_view = gsl_matrix_const_view_array(b_t.data(), count, k);
+            gsl_matrix_view c_view = gsl_matrix_view_array(c_t.data(), count, m);
+            gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, &b_view.matrix, &a_view.matrix, 0.0,
+                           &c_view.matrix);
+            for (int col = first; col < last; col++)
+                memcpy(c_data[col], c_t.data() + size_t(col - first) * m, m * sizeof(double));
+        });
+    }
+    *result = c;
+    return true;
+}
+
+bool MatrixOperations::elementwise(const Cells &a, const Cells &b, ElementwiseOperation operation,
+                                   Cells *result)
+{
+    const int rows = rowCount(a), columns = a.size();
+    if (b.size() != columns || rowCount(b) != rows)
+        return false;
+
+    Cells c = newCells(rows, columns);
+    const QVector<double *> c_data = columnData(c);
+    forColumnBlocks(columns, [&](int first, int last) {
+        for (int col = first; col < last; col++) {
+            const double *x = a.at(col).constData();
+            const double *y = b.at(col).constData();
+            double *z = c_data[col];
+            switch (operation) {
+            case Add:
+                for (int row = 0; row < rows; row++)
+                    z[row] = x[row] + y[row];
+                break;
+            case Subtract:
+                for (int row = 0; row < rows; row++)
+                    z[row] = x[row] - y[row];
+                break;
+            case Multiply:
+                for (int row = 0; row < rows; row++)
+                    z[row] = x[row] * y[row];
+                break;
+            case Divide:
+                for (int row = 0; row < rows; row++)
+                    z[row] = x[row] / y[row];
+                break;
+            }
+        }
+    });
+    *result = c;
+    return true;
+}
@@ -0,0 +1,82 @@
+/***************************************************************************
+    File                 : MatrixOperations.h
+    Project              : SciDAVis
+    --------------------------------------------------------------------
+    Copyright            : (C) 2026 SciDAVis developers
+    Description          : Linear algebra and arithmetic on matrix cells
+
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *  This program is free software; you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation; either version 2 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the Free Software           *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor,                    *
+ *   Boston, MA  02110-1301  USA                                           *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef MATRIXOPERATIONS_H
+#define MATRIXOPERATIONS_H
+
+#include <QVector>
+
+//! Linear algebra and element-wise arithmetic on the cells of matrices
+/**
+  Matrices are given and returned like future::Matrix stores them: as one
+  vector of cells per column, all of the same length. Results are computed
+  into new vectors, so the operands are not modified and can be kept as undo
+  information without copying them.
+
+  LU decompositions, triangular solves and products are done by GSL's BLAS
+  backed routines on contiguous copies of the cells. The independent parts of
+  the work (blocks of result columns) are distributed over the global thread
+  pool.
+  */
+class MatrixOperations
+{
+public:
+    typedef QVector<QVector<qreal>> Cells;
+    enum ElementwiseOperation { Add, Subtract, Multiply, Divide };
+
+    //! Return the determinant of the square matrix 'a'
+    static double determinant(const Cells &a);
+    //! Compute the inverse of the square matrix 'a'
+    /**
+     * Returns false if 'a' is singular.
+     */
+    static bool inverse(const Cells &a, Cells *result);
+    //! Compute the solution x of a * x = b for the square matrix 'a'
+    /**
+     * Each column of 'b' is a right hand side. Returns false if 'a' is singular or the number of
+     * rows does not match.
+     */
+    static bool solve(const Cells &a, const Cells &b, Cells *result);
+    //! Compute the matrix product a * b
+    /**
+     * Returns false if the number of columns of 'a' does not match the number of rows of 'b'.
+     */
+    static bool product(const Cells &a, const Cells &b, Cells *result);
+    //! Combine the cells of two matrices of the same dimensions
+    /**
+     * Returns false if the dimensions differ.
+     */
+    static bool elementwise(const Cells &a, const Cells &b, ElementwiseOperation operation,
+                            Cells *result);
+
+private:
+    //! Return the number of rows of 'cells'
+    static int rowCount(const Cells &cells) { return cells.isEmpty() ? 0 : cells.first().size(); }
+};
+
+#endif // ifndef MATRIXOPERATIONS_H
@@ -43,13 +43,20 @@
 #include <QFileDialog>
 #include <QProgressDialog>
 
+#include <atomic>
 #include <stdlib.h>
 #include <math.h>
 #include <stdio.h>
+#include <string.h>
 
 #include <gsl/gsl_linalg.h>
 #include <gsl/gsl_math.h>
 
+namespace {
+//! Source of matrix versions; shared by all matrices, so that versions are never reused
+std::atomic<quint64> last_version(0);
+} // namespace
+
 namespace future {
 
 #define WAIT_CURSOR QApplication::setOverrideCursor(QCursor(Qt::WaitCursor))
@@ -964,6 +971,11 @@ void Matrix::setCells(const QVector<qreal> &data)
     d_matrix_private->setCells(data);
 }
 
+void Matrix::replaceCells(const QVector<QVector<qreal>> &columns)
+{
+    exec(new MatrixReplaceCellsCmd(d_matrix_private, columns, tr("replace cells")));
+}
+
 void Matrix::dimensionsDialog()
 {
     bool ok;
@@ -1119,6 +1131,21 @@ void Matrix::setDisplayedDigits(int digits)
     RESET_CURSOR;
 }
 
+QVector<QVector<qreal>> Matrix::columns() const
+{
+    return d_matrix_private->columns();
+}
+
+quint64 Matrix::version() const
+{
+    return d_matrix_private->version();
+}
+
+void Matrix::copyCells(double *destination, int rowStride, int columnStride) const
+{
+    d_matrix_private->copyCells(destination, rowStride, columnStride);
+}
+
 double Matrix::xStart() const
 {
     return d_matrix_private->xStart();
@@ -1471,6 +1498,62 @@ void Matrix::setRowCells(int row, int first_column, int last_column, const QVect
     RESET_CURSOR;
 }
 
+double Matrix::determinant() const
+{
+    return MatrixOperations::determinant(d_matrix_private->columns());
+}
+
+bool Matrix::invert()
+{
+    WAIT_CURSOR;
+    MatrixOperations::Cells result;
+    bool ok = MatrixOperations::inverse(d_matrix_private->columns(), &result);
+    if (ok)
+        exec(new MatrixReplaceCellsCmd(d_matrix_private, result, tr("invert")));
+    RESET_CURSOR;
+    return ok;
+}
+
+bool Matrix::multiply(const Matrix *other)
+{
+    WAIT_CURSOR;
+    MatrixOperations::Cells result;
+    bool ok = MatrixOperations::product(d_matrix_private->columns(), other->columns(), &result);
+    if (ok)
+        exec(new MatrixReplaceCellsCmd(d_matrix_private, result,
+                                       tr("multiply by %1").arg(other->name())));
+    RESET_CURSOR;
+    return ok;
+}
+
+bool Matrix::solve(const Matrix *a)
+{
+    WAIT_CURSOR;
+    MatrixOperations::Cells result;
+    bool ok = MatrixOperations::solve(a->columns(), d_matrix_private->columns(), &result);
+    if (ok)
+        exec(new MatrixReplaceCellsCmd(d_matrix_private, result,
+                                       tr("solve with %1").arg(a->name())));
+    RESET_CURSOR;
+    return ok;
+}
+
+bool Matrix::combine(const Matrix *other, MatrixOperations::ElementwiseOperation operation)
+{
+    static const char *texts[] = { QT_TR_NOOP("add %1"), QT_TR_NOOP("subtract %1"),
+                                   QT_TR_NOOP("multiply element-wise by %1"),
+                                   QT_TR_NOOP("divide element-wise by %1") };
+    WAIT_CURSOR;
+    MatrixOperations::Cells result;
+    bool ok = MatrixOperations::elementwise(d_matrix_private->columns(), other->columns(),
+                                            operation, &result);
+    if (ok)
+        exec(new MatrixReplaceCellsCmd(d_matrix_private, result,
+                                       tr(texts[operation]).arg(other->name())));
+    RESET_CURSOR;
+    return ok;
+}
+
 void Matrix::transpose()
 {
     WAIT_CURSOR;
@@ -1598,6 +1681,12 @@ Matrix::Private::Private(Matrix *owner) : d_owner(owner), d_column_count(0), d_r
     d_x_end = 1.0;
     d_y_start = 0.0;
     d_y_end = 1.0;
+    touch();
+}
+
+void Matrix::Private::touch()
+{
+    d_version = ++last_version;
 }
 
 void Matrix::Private::insertColumns(int before, int count)
@@ -1612,6 +1701,7 @@ void Matrix::Private::insertColumns(int before, int count)
     }
 
     d_column_count += count;
+    touch();
     emit d_owner->columnsInserted(before, count);
 }
 
@@ -1624,6 +1714,7 @@ void Matrix::Private::removeColumns(int first, int count)
     for (int i = 0; i < count; i++)
         d_column_widths.removeAt(first);
     d_column_count -= count;
+    touch();
     emit d_owner->columnsRemoved(first, count);
 }
 
@@ -1639,6 +1730,7 @@ void Matrix::Private::insertRows(int before, int count)
         d_row_heights.insert(before + i, Matrix::defaultRowHeight());
 
     d_row_count += count;
+    touch();
     emit d_owner->rowsInserted(before, count);
 }
 
@@ -1653,6 +1745,7 @@ void Matrix::Private::removeRows(int first, int count)
         d_row_heights.removeAt(first);
 
     d_row_count -= count;
+    touch();
     emit d_owner->rowsRemoved(first, count);
 }
 
@@ -1663,11 +1756,37 @@ double Matrix::Private::cell(int row, int col) const
     return d_data.at(col).at(row);
 }
 
+void Matrix::Private::copyCells(double *destination, int rowStride, int columnStride) const
+{
+    if (rowStride == 1) {
+        for (int col = 0; col < d_column_count; col++)
+            memcpy(destination + qint64(col) * columnStride, d_data.at(col).constData(),
+                   d_row_count * sizeof(double));
+        return;
+    }
+
+    // transpose in blocks, so that the rows written to and the columns read from stay in cache
+    const int block = 64;
+    for (int first_row = 0; first_row < d_row_count; first_row += block) {
+        const int last_row = qMin(first_row + block, d_row_count);
+        for (int first_col = 0; first_col < d_column_count; first_col += block) {
+            const int last_col = qMin(first_col + block, d_column_count);
+            for (int col = first_col; col < last_col; col++) {
+                const double *source = d_data.at(col).constData();
+                double *target = destination + qint64(col) * columnStride;
+                for (int row = first_row; row < last_row; row++)
+                    target[qint64(row) * rowStride] = source[row];
+            }
+        }
+    }
+}
+
 void Matrix::Private::setCell(int row, int col, double value)
 {
     Q_ASSERT(row >= 0 && row < d_row_count);
     Q_ASSERT(col >= 0 && col < d_column_count);
     d_data[col][row] = value;
+    touch();
     if (!d_block_change_signals)
         emit d_owner->dataChanged(row, col, row, col);
 }
@@ -1682,6 +1801,28 @@ void Matrix::Private::setCells(const QVector<qreal> &data)
             d_data[i][j] = data[k++];
         }
     }
+    touch();
+}
+
+void Matrix::Private::replaceCells(const QVector<QVector<qreal>> &columns)
+{
+    const int cols = columns.size();
+    const int rows = columns.isEmpty() ? d_row_count : columns.first().size();
+
+    // rows and columns are only added or removed at the end, which does not move any cells
+    if (cols < d_column_count)
+        removeColumns(cols, d_column_count - cols);
+    else if (cols > d_column_count)
+        insertColumns(d_column_count, cols - d_column_count);
+    if (rows < d_row_count)
+        removeRows(rows, d_row_count - rows);
+    else if (rows > d_row_count)
+        insertRows(d_row_count, rows - d_row_count);
+
+    d_data = columns;
+    touch();
+    if (!d_block_change_signals && rows > 0 && cols > 0)
+        emit d_owner->dataChanged(0, 0, rows - 1, cols - 1);
 }
 
 QVector<qreal> Matrix::Private::columnCells(int col, int first_row, int last_row)
@@ -1708,6 +1849,7 @@ void Matrix::Private::setColumnCells(int col, int first_row, int last_row,
     if (first_row == 0 && last_row == d_row_count - 1) {
         d_data[col] = values;
         d_data[col].resize(d_row_count); // values may be larger
+        touch();
         if (!d_block_change_signals)
             emit d_owner->dataChanged(first_row, col, last_row, col);
         return;
@@ -1715,6 +1857,7 @@ void Matrix::Private::setColumnCells(int col, int first_row, int last_row,
 
     for (int i = first_row; i <= last_row; i++)
         d_data[col][i] = values.at(i - first_row);
+    touch();
     if (!d_block_change_signals)
         emit d_owner->dataChanged(first_row, col, last_row, col);
 }
@@ -1739,6 +1882,7 @@ void Matrix::Private::setRowCells(int row, int first_column, int last_column,
 
     for (int i = first_column; i <= last_column; i++)
         d_data[i][row] = values.at(i - first_column);
+    touch();
     if (!d_block_change_signals)
         emit d_owner->dataChanged(row, first_column, row, last_column);
 }
@@ -1746,6 +1890,7 @@ void Matrix::Private::setRowCells(int row, int first_column, int last_column,
 void Matrix::Private::clearColumn(int col)
 {
     d_data[col].fill(0.0);
+    touch();
     if (!d_block_change_signals)
         emit d_owner->dataChanged(0, col, d_row_count - 1, col);
 }
@@ -1773,24 +1918,28 @@ double Matrix::Private::yEnd() const
 void Matrix::Private::setXStart(double x)
 {
     d_x_start = x;
+    touch();
     emit d_owner->coordinatesChanged();
 }
 
 void Matrix::Private::setXEnd(double x)
 {
     d_x_end = x;
+    touch();
     emit d_owner->coordinatesChanged();
 }
 
 void Matrix::Private::setYStart(double y)
 {
     d_y_start = y;
+    touch();
     emit d_owner->coordinatesChanged();
 }
 
 void Matrix::Private::setYEnd(double y)
 {
     d_y_end = y;
+    touch();
     emit d_owner->coordinatesChanged();
 }
 
@@ -1838,6 +1987,7 @@ void Matrix::Private::setCells(const int startRow, const int startCol,
         }
     }
     blockChangeSignals(false);
+    touch();
     auto endRow = startRow + values.size() - 1;
     auto endCol = startCol + std::max_element(
             values.cbegin(), values.cend(),
@@ -36,6 +36,7 @@
 #endif
 #include "core/AbstractPart.h"
 #include "matrix/MatrixView.h"
+#include "matrix/MatrixOperations.h"
 #include "lib/macros.h"
 
 #include <QPointer>
@@ -151,6 +152,12 @@ public:
     void setCell(int row, int col, double value);
     //! Set the value of all cells
     void setCells(const QVector<qreal> &data);
+    //! Replace all cells, resizing the matrix to the dimensions of 'columns'
+    /**
+     * 'columns' holds one vector per column, all of the same length. They are
+     * shared, not copied.
+     */
+    void replaceCells(const QVector<QVector<qreal>> &columns);
     //! Return the values in the given cells as double vector
     QVector<qreal> columnCells(int col, int first_row, int last_row);
     //! Set the values in the given cells from a double vector
@@ -159,6 +166,51 @@ public:
     QVector<qreal> rowCells(int row, int first_column, int last_column);
     //! Set the values in the given cells from a double vector
     void setRowCells(int row, int first_column, int last_column, const QVector<qreal> &values);
+    //! Return all cells, one vector per column
+    /**
+     * The vectors are implicitly shared with the matrix, so no values are
+     * copied and they stay a consistent snapshot if the matrix is modified
+     * later on (which then copies the modified columns once).
+     */
+    QVector<QVector<qreal>> columns() const;
+    //! Return the version of the matrix content
+    /**
+     * The version changes whenever cells, dimensions or coordinates of the
+     * matrix change. Versions are never shared between matrices, so they can
+     * be used as cache keys for values derived from the matrix.
+     */
+    quint64 version() const;
+    //! Copy all cells to 'destination'
+    /**
+     * Cell (row, col) is written to destination[row * rowStride + col * columnStride], so
+     * copyCells(data, numCols(), 1) fills a row-major and copyCells(data, 1, numRows()) a
+     * column-major array. The latter copies whole columns at once; other layouts are
+     * transposed in blocks to stay cache friendly.
+     */
+    void copyCells(double *destination, int rowStride, int columnStride) const;
+    //! Return the determinant of the (square) matrix
+    double determinant() const;
+    //! Replace the (square) matrix by its inverse
+    /**
+     * Returns false and leaves the matrix unchanged if it is singular.
+     * Like the other operations below, this is a single undo step.
+     */
+    bool invert();
+    //! Replace the matrix M by M * other
+    /**
+     * Returns false if the number of columns does not match the number of rows of 'other'.
+     */
+    bool multiply(const Matrix *other);
+    //! Replace the matrix B by the solution X of A * X = B
+    /**
+     * Returns false if 'a' is not square, is singular or has a different number of rows.
+     */
+    bool solve(const Matrix *a);
+    //! Combine the cells with those of a matrix of the same dimensions
+    /**
+     * Returns false if the dimensions differ.
+     */
+    bool combine(const Matrix *other, MatrixOperations::ElementwiseOperation operation);
     //! Return the text displayed in the given cell
     QString text(int row, int col);
     using AbstractPart::copy;
@@ -416,6 +468,12 @@ public:
     void setCell(int row, int col, double value);
     //! Set the value of all cells
     void setCells(const QVector<qreal> &data);
+    //! Replace all cells, resizing the matrix to the dimensions of 'columns'
+    /**
+     * 'columns' holds one vector per column, all of the same length. They are
+     * shared, not copied.
+     */
+    void replaceCells(const QVector<QVector<qreal>> &columns);
     //! Return the values in the given cells as double vector
     QVector<qreal> columnCells(int col, int first_row, int last_row);
     //! Set the values in the given cells from a double vector
@@ -424,6 +482,11 @@ public:
     QVector<qreal> rowCells(int row, int first_column, int last_column);
     //! Set the values in the given cells from a double vector
     void setRowCells(int row, int first_column, int last_column, const QVector<qreal> &values);
+    //! Return all cells, one (implicitly shared) vector per column
+    QVector<QVector<qreal>> columns() const { return d_data; }
+    //! Return the current version of cells, dimensions and coordinates
+    quint64 version() const { return d_version; }
+    void copyCells(double *destination, int rowStride, int columnStride) const;
     char numericFormat() const { return d_numeric_format; }
     void setNumericFormat(char format)
     {
@@ -476,10 +539,14 @@ public:
     //! Access to the dataChanged signal for commands
     void emitDataChanged(int top, int left, int bottom, int right)
     {
+        touch();
         emit d_owner->dataChanged(top, left, bottom, right);
     }
 
 private:
+    //! Assign a new version, to be called after every modification
+    void touch();
+
     //! The owner aspect
     Matrix *d_owner;
     //! The number of columns
@@ -503,6 +570,7 @@ private:
             d_y_start, //!< Y value corresponding to row 1
             d_y_end; //!< Y value corresponding to the last row
     bool d_block_change_signals;
+    quint64 d_version;
 };
 
 } // namespace
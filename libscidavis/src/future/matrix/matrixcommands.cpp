@@ -29,6 +29,50 @@
 
 #include "matrixcommands.h"
 
+#include <cstring>
+
+namespace {
+typedef std::vector<std::vector<std::pair<double, bool>>> CellValues;
+
+//! Store the numbers of 'cells' in 'values' and row lengths and validity flags in 'layout'
+void storeCells(const QUndoCommand *owner, const CellValues &cells, UndoBlob *values,
+                UndoBlob *layout)
+{
+    QVector<qreal> numbers;
+    QByteArray flags;
+    for (const auto &row : cells) {
+        const qint32 size = qint32(row.size());
+        flags.append(reinterpret_cast<const char *>(&size), sizeof(size));
+        for (const auto &cell : row) {
+            numbers << cell.first;
+            flags.append(char(cell.second));
+        }
+    }
+    values->storeValues(owner, numbers);
+    layout->store(owner, flags);
+}
+
+//! Inverse of storeCells()
+CellValues loadCells(const UndoBlob &values, const UndoBlob &layout)
+{
+    const QVector<qreal> numbers = values.values();
+    const QByteArray flags = layout.data();
+    CellValues cells;
+    int number = 0;
+    for (int pos = 0; pos < flags.size();) {
+        qint32 size;
+        memcpy(&size, flags.constData() + pos, sizeof(size));
+        pos += sizeof(size);
+        std::vector<std::pair<double, bool>> row;
+        row.reserve(size);
+        for (int i = 0; i < size; i++)
+            row.emplace_back(numbers.at(number++), flags.at(pos++) != 0);
+        cells.push_back(std::move(row));
+    }
+    return cells;
+}
+} // namespace
+
 ///////////////////////////////////////////////////////////////////////////
 // class MatrixInsertColumnsCmd
 ///////////////////////////////////////////////////////////////////////////
@@ -541,19 +585,49 @@ MatrixSetCellsCmd::MatrixSetCellsCmd(
       d_first_row{ first_row },
       d_last_row{ last_row },
       d_first_column{ first_column },
-      d_last_column{ last_column },
-      d_values{ values },
-      d_old_values{ private_obj->getCells(first_row, last_row, first_column, last_column) }
+      d_last_column{ last_column }
 {
     setText(QObject::tr("%1: set values for multiple cells").arg(d_private_obj->name()));
+    storeCells(this, values, &d_values, &d_value_layout);
+    storeCells(this, private_obj->getCells(first_row, last_row, first_column, last_column),
+               &d_old_values, &d_old_value_layout);
 }
 
 void MatrixSetCellsCmd::redo() 
 {
-    d_private_obj->setCells(d_first_row, d_first_column, d_values);
+    d_private_obj->setCells(d_first_row, d_first_column, loadCells(d_values, d_value_layout));
 }
 
 void MatrixSetCellsCmd::undo() 
 {
-    d_private_obj->setCells(d_first_row, d_first_column, d_old_values);
+    d_private_obj->setCells(d_first_row, d_first_column,
+                            loadCells(d_old_values, d_old_value_layout));
+}
+
+///////////////////////////////////////////////////////////////////////////
+// class MatrixReplaceCellsCmd
+///////////////////////////////////////////////////////////////////////////
+MatrixReplaceCellsCmd::MatrixReplaceCellsCmd(future::Matrix::Private *private_obj,
+                                             const QVector<QVector<qreal>> &cells,
+                                             const QString &text, QUndoCommand *parent)
+    : QUndoCommand(parent), d_private_obj(private_obj), d_cells(cells)
+{
+    setText(QObject::tr("%1: %2").arg(d_private_obj->name()).arg(text));
 }
+
+MatrixReplaceCellsCmd::~MatrixReplaceCellsCmd() { }
+
+void MatrixReplaceCellsCmd::redo()
+{
+    d_old_cells = d_private_obj->columns();
+    d_private_obj->replaceCells(d_cells);
+}
+
+void MatrixReplaceCellsCmd::undo()
+{
+    d_private_obj->replaceCells(d_old_cells);
+    d_old_cells.clear();
+}
+///////////////////////////////////////////////////////////////////////////
+// end of class MatrixReplaceCellsCmd
+///////////////////////////////////////////////////////////////////////////
@@ -32,6 +32,7 @@
 
 #include <QUndoCommand>
 #include "matrix/future_Matrix.h"
+#include "core/UndoStorage.h"
 
 ///////////////////////////////////////////////////////////////////////////
 // class MatrixInsertColumnsCmd
@@ -412,10 +413,10 @@ private:
     const int d_first_column;
     //! The index of the last column
     const int d_last_column;
-    //! New cell values
-    const std::vector<std::vector<std::pair<double, bool>>> d_values;
+    //! New cell values, stored as numbers and a layout of row lengths and validity flags
+    UndoBlob d_values, d_value_layout;
     //! Backup of the changed values
-    const std::vector<std::vector<std::pair<double, bool>>> d_old_values;
+    UndoBlob d_old_values, d_old_value_layout;
 };
 
 ///////////////////////////////////////////////////////////////////////////
@@ -488,4 +489,36 @@ private:
 // end of class MatrixMirrorVerticallyCmd
 ///////////////////////////////////////////////////////////////////////////
 
+///////////////////////////////////////////////////////////////////////////
+// class MatrixReplaceCellsCmd
+///////////////////////////////////////////////////////////////////////////
+//! Replace all cells (and the dimensions) of the matrix by the result of an operation
+/**
+  Both the new and the old cells are kept as implicitly shared column vectors,
+  so the whole operation is a single undo step without copying any cells.
+  */
+class MatrixReplaceCellsCmd : public QUndoCommand
+{
+public:
+    MatrixReplaceCellsCmd(future::Matrix::Private *private_obj,
+                          const QVector<QVector<qreal>> &cells, const QString &text,
+                          QUndoCommand *parent = 0);
+    ~MatrixReplaceCellsCmd();
+
+    virtual void redo();
+    virtual void undo();
+
+private:
+    //! The private object to modify
+    future::Matrix::Private *d_private_obj;
+    //! The new cells, one vector per column
+    QVector<QVector<qreal>> d_cells;
+    //! The replaced cells
+    QVector<QVector<qreal>> d_old_cells;
+};
+
+///////////////////////////////////////////////////////////////////////////
+// end of class MatrixReplaceCellsCmd
+///////////////////////////////////////////////////////////////////////////
+
 #endif // MATRIX_COMMANDS_H
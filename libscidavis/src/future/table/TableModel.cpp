@@ -28,17 +28,29 @@
  ***************************************************************************/
 
 #include "core/column/Column.h"
+#include "core/AbstractSimpleFilter.h"
 #include "table/future_Table.h"
 #include "table/TableModel.h"
 #include <QString>
 #include <QBrush>
 #include <QIcon>
 #include <QPixmap>
+#include <QSet>
+
+namespace {
+//! Set 'flag' for the rows in 'intervals', where flags[i] belongs to row first + i
+void markRows(QVector<char> &flags, const QList<Interval<int>> &intervals, int first, char flag)
+{
+    forEachRow(intervals, first, first + flags.size() - 1,
+               [&flags, first, flag](int row) { flags[row - first] |= flag; });
+}
+} // namespace
 
 TableModel::TableModel(future::Table *table)
     : QAbstractItemModel(0),
       d_table(table),
-      d_formula_mode(false)
+      d_formula_mode(false),
+      d_text_cache(1024 * CacheBlockRows)
 #ifdef LEGACY_CODE_0_2_x
       ,
       d_read_only(false)
@@ -92,42 +104,56 @@ QVariant TableModel::data(const QModelIndex &index, int role) const
     if (!col_ptr)
         return QVariant();
 
+    switch (role) {
+    case Qt::ToolTipRole:
+    case Qt::EditRole:
+    case Qt::DisplayRole:
+    case Qt::ForegroundRole:
+    case MaskingRole:
+        break;
+    case FormulaRole:
+        return QVariant(col_ptr->formula(row));
+    case Qt::DecorationRole:
+        if (d_formula_mode)
+            return QIcon(QPixmap(":/equals.png"));
+        return QVariant();
+    default:
+        return QVariant();
+    }
+
+    const CachedBlock *block = cachedBlock(col_ptr, row);
+    const int offset = row % CacheBlockRows;
+    const bool invalid = block->flags.at(offset) & InvalidCell;
     QString postfix;
     switch (role) {
     case Qt::ToolTipRole:
-        if (col_ptr->isMasked(row))
+        if (block->flags.at(offset) & MaskedCell)
             postfix = " " + tr("(masked)");
-        if (col_ptr->isInvalid(row))
+        if (invalid)
             return QVariant(tr("invalid cell (ignored in all operations)",
                                "tooltip string for invalid rows")
                             + postfix);
         [[fallthrough]];
     case Qt::EditRole:
-        if (!d_formula_mode && col_ptr->isInvalid(row))
+        if (!d_formula_mode && invalid)
             return QVariant();
         [[fallthrough]];
     case Qt::DisplayRole: {
         if (d_formula_mode)
             return QVariant(col_ptr->formula(row));
-        if (col_ptr->isInvalid(row))
+        if (invalid)
             return QVariant(tr("-", "string for invalid rows"));
 
-        return QVariant(col_ptr->asStringColumn()->textAt(row) + postfix);
+        return QVariant(block->texts.at(offset) + postfix);
     }
     case Qt::ForegroundRole: {
-        if (col_ptr->isInvalid(index.row()))
+        if (invalid)
             return QVariant(QBrush(QColor(0xff, 0, 0))); // invalid -> red letters
         else
             return QVariant(QBrush(QColor(0, 0, 0)));
     }
     case MaskingRole:
-        return QVariant(col_ptr->isMasked(row));
-    case FormulaRole:
-        return QVariant(col_ptr->formula(row));
-    case Qt::DecorationRole:
-        if (d_formula_mode)
-            return QIcon(QPixmap(":/equals.png"));
-        break;
+        return QVariant(bool(block->flags.at(offset) & MaskedCell));
     }
 
     return QVariant();
@@ -241,9 +267,131 @@ void TableModel::handleRowsRemoved(int first, int count)
 
 void TableModel::handleDataChanged(int top, int left, int bottom, int right)
 {
+    // changes of the content also change the version of the column, but changes of the display
+    // format don't
+    invalidateCache(top, left, bottom, right);
     emit dataChanged(index(top, left), index(bottom, right));
 }
 
+void TableModel::prefetch(int first_row, int last_row, int first_column, int last_column) const
+{
+    if (!d_table || d_formula_mode)
+        return;
+    first_row = qMax(first_row, 0);
+    last_row = qMin(last_row, d_table->rowCount() - 1);
+    if (first_row > last_row)
+        return;
+    for (int col = qMax(first_column, 0); col <= qMin(last_column, d_table->columnCount() - 1);
+         col++) {
+        Column *col_ptr = d_table->column(col);
+        if (col_ptr)
+            formatBlocks(col_ptr, first_row / CacheBlockRows, last_row / CacheBlockRows);
+    }
+}
+
+const TableModel::CachedBlock *TableModel::cachedBlock(Column *col, int row) const
+{
+    const int block = row / CacheBlockRows;
+    formatBlocks(col, block, block);
+    return d_text_cache.object(CacheKey(col, block));
+}
+
+void TableModel::formatBlocks(Column *col, int first_block, int last_block) const
+{
+    const quint64 version = col->version();
+    const QLocale locale;
+    auto isCached = [&](int block) {
+        const CachedBlock *cached = d_text_cache.object(CacheKey(col, block));
+        return cached && cached->version == version && cached->locale == locale;
+    };
+    // format consecutive blocks which are missing at once
+    for (int block = first_block; block <= last_block; block++) {
+        if (isCached(block))
+            continue;
+        int end = block;
+        while (end < last_block && !isCached(end + 1))
+            end++;
+        formatRows(col, block, end);
+        block = end;
+    }
+}
+
+void TableModel::formatRows(Column *col, int first_block, int last_block) const
+{
+    const int first = first_block * CacheBlockRows;
+    const int count = (last_block - first_block + 1) * CacheBlockRows;
+    // the rows of the table may extend beyond the end of the column
+    const int filled = qBound(0, col->rowCount() - first, count);
+
+    QVector<char> flags(count, 0);
+    markRows(flags, col->invalidIntervals(), first, InvalidCell);
+    markRows(flags, col->maskedIntervals(), first, MaskedCell);
+
+    // format all rows in one go if the output filter supports it
+    QStringList texts;
+    texts.reserve(count);
+    for (int i = 0; i < filled; i++)
+        texts << QString();
+    QVector<char> invalid(filled);
+    for (int i = 0; i < filled; i++)
+        invalid[i] = flags.at(i) & InvalidCell;
+    bool converted = false;
+    switch (col->dataType()) {
+    case SciDAVis::TypeDouble: {
+        const QVector<qreal> values = col->values().mid(first, filled);
+        converted = col->outputFilter()->convertRows(&values, &texts, invalid.data(), filled);
+        break;
+    }
+    case SciDAVis::TypeQDateTime: {
+        QList<QDateTime> date_times;
+        date_times.reserve(filled);
+        for (int i = 0; i < filled; i++)
+            date_times << col->dateTimeAt(first + i);
+        converted = col->outputFilter()->convertRows(&date_times, &texts, invalid.data(), filled);
+        break;
+    }
+    case SciDAVis::TypeQString:
+        break;
+    }
+    if (!converted)
+        for (int i = 0; i < filled; i++)
+            texts[i] = col->asStringColumn()->textAt(first + i);
+    for (int i = filled; i < count; i++)
+        texts << QString();
+
+    const quint64 version = col->version();
+    for (int block = first_block; block <= last_block; block++) {
+        const int offset = (block - first_block) * CacheBlockRows;
+        auto cached = new CachedBlock;
+        cached->version = version;
+        cached->locale = QLocale();
+        cached->texts = texts.mid(offset, CacheBlockRows);
+        cached->flags = flags.mid(offset, CacheBlockRows);
+        d_text_cache.insert(CacheKey(col, block), cached, CacheBlockRows);
+    }
+}
+
+void TableModel::clearCache()
+{
+    d_text_cache.clear();
+    if (d_table && d_table->rowCount() > 0 && d_table->columnCount() > 0)
+        emit dataChanged(index(0, 0), index(d_table->rowCount() - 1, d_table->columnCount() - 1));
+}
+
+void TableModel::invalidateCache(int top, int left, int bottom, int right)
+{
+    if (!d_table)
+        return;
+    QSet<const Column *> columns;
+    for (int col = left; col <= right; col++)
+        columns << d_table->column(col);
+    for (const CacheKey &key : d_text_cache.keys()) {
+        const int first = key.second * CacheBlockRows;
+        if (columns.contains(key.first) && first <= bottom && first + CacheBlockRows > top)
+            d_text_cache.remove(key);
+    }
+}
+
 Column *TableModel::column(int index)
 {
     return d_table ? d_table->column(index) : nullptr;
@@ -31,8 +31,12 @@
 #define TABLEMODEL_H
 
 #include <QAbstractItemModel>
+#include <QCache>
 #include <QList>
+#include <QLocale>
+#include <QPair>
 #include <QStringList>
+#include <QVector>
 #include "core/AbstractFilter.h"
 #include <QColor>
 #include <QPointer>
@@ -51,6 +55,12 @@ class Table;
         in the public API of Table. In many cases a pointer to the addressed column
         is obtained by calling Table::column() and the manipulation is done using the
         public API of column.
+
+        The texts displayed are formatted in blocks of rows, which are cached until
+        the column changes (see Column::version()), the table reports the cells
+        as changed (e.g. after a change of the display format) or the default
+        locale changes. Views can format the cells about to be shown in advance
+        using prefetch().
   */
 class TableModel : public QAbstractItemModel
 {
@@ -91,6 +101,11 @@ public:
     void activateFormulaMode(bool on) { d_formula_mode = on; }
     bool formulaModeActive() const { return d_formula_mode; }
 
+    //! Format the texts of the given cells which aren't cached yet, all columns at once
+    void prefetch(int first_row, int last_row, int first_column, int last_column) const;
+    //! Discard all formatted texts, e.g. after a change of the locale
+    void clearCache();
+
 private slots:
     //! \name Handlers for events from Table
     //@{
@@ -106,9 +121,38 @@ private slots:
     //@}
 
 private:
+    //! Rows per block of the text cache
+    static constexpr int CacheBlockRows = 256;
+    //! Flags of a row in a CachedBlock
+    enum CellFlag { InvalidCell = 1, MaskedCell = 2 };
+    //! The displayed texts and the state of a block of rows of one column
+    struct CachedBlock
+    {
+        //! Version of the column the block was formatted from
+        quint64 version;
+        //! The default locale when the block was formatted
+        QLocale locale;
+        QStringList texts;
+        //! Combination of CellFlag values for each row
+        QVector<char> flags;
+    };
+    //! A column and the index of a block of its rows
+    typedef QPair<const Column *, int> CacheKey;
+
+    //! Return the cached block containing 'row' of 'col', formatting it if necessary
+    const CachedBlock *cachedBlock(Column *col, int row) const;
+    //! Format the blocks first_block to last_block of 'col' which aren't cached yet
+    void formatBlocks(Column *col, int first_block, int last_block) const;
+    //! Format the blocks first_block to last_block of 'col' at once
+    void formatRows(Column *col, int first_block, int last_block) const;
+    //! Discard the cached blocks of the given cells
+    void invalidateCache(int top, int left, int bottom, int right);
+
     QPointer<future::Table> d_table;
     //! Toggle flag for formula mode
     bool d_formula_mode;
+    //! Formatted blocks, with their number of rows as cost
+    mutable QCache<CacheKey, CachedBlock> d_text_cache;
 
 #ifdef LEGACY_CODE_0_2_x
     bool d_read_only;
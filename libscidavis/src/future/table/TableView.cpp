@@ -54,6 +54,7 @@
 #include <QItemSelectionModel>
 #include <QItemSelection>
 #include <QShortcut>
+#include <QScrollBar>
 #include <QModelIndex>
 #include <QGridLayout>
 #include <QScrollArea>
@@ -160,6 +161,9 @@ void TableView::init()
             SLOT(handleHorizontalSectionMoved(int, int, int)));
     connect(d_horizontal_header, SIGNAL(sectionDoubleClicked(int)), this,
             SLOT(handleHorizontalHeaderDoubleClicked(int)));
+    d_last_scroll_value = 0;
+    connect(d_view_widget->verticalScrollBar(), SIGNAL(valueChanged(int)), this,
+            SLOT(prefetchRows(int)));
 
     d_horizontal_header->setDefaultSectionSize(future::Table::defaultColumnWidth());
 
@@ -205,6 +209,29 @@ void TableView::init()
     connect(ui.button_set_type, SIGNAL(pressed()), this, SLOT(applyType()));
 }
 
+void TableView::prefetchRows(int scroll_value)
+{
+    const QRect rect = d_view_widget->viewport()->rect();
+    int first_row = d_view_widget->rowAt(rect.top());
+    int last_row = d_view_widget->rowAt(rect.bottom());
+    int first_column = d_view_widget->columnAt(rect.left());
+    int last_column = d_view_widget->columnAt(rect.right());
+    if (first_row < 0 || first_column < 0)
+        return;
+    if (last_row < 0)
+        last_row = d_model->rowCount() - 1;
+    if (last_column < 0)
+        last_column = d_model->columnCount() - 1;
+    // the visible rows and the next page in the direction of scrolling
+    const int page = last_row - first_row + 1;
+    if (scroll_value >= d_last_scroll_value)
+        last_row += page;
+    else
+        first_row -= page;
+    d_last_scroll_value = scroll_value;
+    d_model->prefetch(first_row, last_row, first_column, last_column);
+}
+
 void TableView::rereadSectionSizes()
 {
     disconnect(d_horizontal_header, SIGNAL(sectionResized(int, int, int)), this,
@@ -252,6 +279,9 @@ void TableView::changeEvent(QEvent *event)
 {
     if (event->type() == QEvent::LanguageChange)
         retranslateStrings();
+    // the cached texts are formatted with the old locale
+    if (event->type() == QEvent::LocaleChange)
+        d_model->clearCache();
     MyWidget::changeEvent(event);
 }
 
@@ -216,6 +216,8 @@ protected slots:
     void selectionChanged(const QItemSelection &selected, const QItemSelection &deselected);
     void applyDescription();
     void applyType();
+    //! Format the rows about to be scrolled into view in advance (see TableModel::prefetch())
+    void prefetchRows(int scroll_value);
 
 protected:
     //! Pointer to the item delegate
@@ -240,6 +242,8 @@ protected:
     QHBoxLayout *d_main_layout;
     TableDoubleHeaderView *d_horizontal_header;
     QPointer<future::Table> d_table;
+    //! Position of the vertical scroll bar at the last call of prefetchRows()
+    int d_last_scroll_value;
 
     //! Initialization
     void init();
@@ -64,7 +64,11 @@ SortDialog::SortDialog(QWidget *parent, Qt::WindowFlags fl) : QDialog(parent, fl
     top_layout->addWidget(new QLabel(tr("Leading column")), 2, 0);
     ui.columns_list = new QComboBox();
     top_layout->addWidget(ui.columns_list, 2, 1);
-    top_layout->setRowStretch(3, 1);
+
+    top_layout->addWidget(new QLabel(tr("Then by")), 3, 0);
+    ui.secondary_list = new QComboBox();
+    top_layout->addWidget(ui.secondary_list, 3, 1);
+    top_layout->setRowStretch(4, 1);
 
     ui.button_ok = new QPushButton(tr("&Sort"));
     ui.button_ok->setDefault(true);
@@ -84,29 +88,34 @@ SortDialog::SortDialog(QWidget *parent, Qt::WindowFlags fl) : QDialog(parent, fl
 
 void SortDialog::accept()
 {
-    Column *leading;
-    if (ui.box_type->currentIndex() == Together)
-        leading = d_columns_list.at(ui.columns_list->currentIndex());
-    else
-        leading = 0;
-    emit sort(leading, d_columns_list, ui.box_order->currentIndex() == Ascending);
+    QList<Column *> keys;
+    if (ui.box_type->currentIndex() == Together) {
+        keys << d_columns_list.at(ui.columns_list->currentIndex());
+        // the first entry of the secondary list is "none"
+        int secondary = ui.secondary_list->currentIndex() - 1;
+        if (secondary >= 0 && !keys.contains(d_columns_list.at(secondary)))
+            keys << d_columns_list.at(secondary);
+    }
+    emit sort(keys, d_columns_list, ui.box_order->currentIndex() == Ascending);
 }
 
 void SortDialog::setColumnsList(QList<Column *> list)
 {
     d_columns_list = list;
 
-    for (int i = 0; i < list.size(); i++)
+    ui.secondary_list->addItem(tr("(none)"));
+    for (int i = 0; i < list.size(); i++) {
         ui.columns_list->addItem(list.at(i)->name());
+        ui.secondary_list->addItem(list.at(i)->name());
+    }
     ui.columns_list->setCurrentIndex(0);
+    ui.secondary_list->setCurrentIndex(0);
 }
 
 void SortDialog::changeType(int Type)
 {
-    if (Type == Together)
-        ui.columns_list->setEnabled(true);
-    else
-        ui.columns_list->setEnabled(false);
+    ui.columns_list->setEnabled(Type == Together);
+    ui.secondary_list->setEnabled(Type == Together);
 }
 
 } // namespace
@@ -54,7 +54,8 @@ private slots:
     void changeType(int index);
 
 signals:
-    void sort(Column *leading, QList<Column *> cols, bool ascending);
+    //! Sort 'cols' by 'keys' (most significant first), or each column separately if 'keys' is empty
+    void sort(QList<Column *> keys, QList<Column *> cols, bool ascending);
 
 private:
     QList<Column *> d_columns_list;
@@ -66,6 +67,7 @@ private:
         QComboBox *box_type;
         QComboBox *box_order;
         QComboBox *columns_list;
+        QComboBox *secondary_list;
     } ui;
 };
 
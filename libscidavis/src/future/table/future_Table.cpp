@@ -39,6 +39,9 @@
 #include <QApplication>
 #include <QContextMenuEvent>
 #include <climits> // for RAND_MAX
+#include <cfloat>
+#include <limits>
+#include <cmath>
 #include <QMenu>
 #include <QItemSelection>
 #include <QModelIndex>
@@ -51,6 +54,7 @@
 #include <QToolBar>
 #include <QtDebug>
 #include <QMimeData>
+#include <QtConcurrentMap>
 #include "ApplicationWindow.h"
 #if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
 #include <QRandomGenerator>
@@ -62,6 +66,7 @@
 #include "table/future_SortDialog.h"
 #include "core/column/Column.h"
 #include "core/AbstractFilter.h"
+#include "lib/RowSorter.h"
 #include "core/datatypes/String2DoubleFilter.h"
 #include "core/datatypes/Double2StringFilter.h"
 #include "core/datatypes/DateTime2StringFilter.h"
@@ -623,6 +628,16 @@ void Table::recalculateSelectedCells()
 #endif
 }
 
+void Table::keepUnselectedValues(Column *col_ptr, int col, int first, QVector<qreal> *values) const
+{
+    if (d_view->isColumnSelected(col, true))
+        return;
+    const QVector<qreal> old_values = col_ptr->values();
+    for (int i = 0; i < values->size(); i++)
+        if (!d_view->isCellSelected(first + i, col))
+            (*values)[i] = old_values.value(first + i);
+}
+
 void Table::fillSelectedCellsWithRowNumbers()
 {
     if (!d_view)
@@ -640,13 +655,10 @@ void Table::fillSelectedCellsWithRowNumbers()
         int col = columnIndex(col_ptr);
         switch (col_ptr->columnMode()) {
         case SciDAVis::ColumnMode::Numeric: {
-            QVector<qreal> results(last - first + 1);
-            for (int row = first; row <= last; row++)
-                if (d_view->isCellSelected(row, col))
-                    results[row - first] = row + 1;
-                else
-                    results[row - first] = col_ptr->valueAt(row);
-            col_ptr->replaceValues(first, results);
+            QVector<qreal> numbers(last - first + 1);
+            ColumnTransform::fillSequence(numbers.data(), numbers.size(), first + 1, 1);
+            keepUnselectedValues(col_ptr, col, first, &numbers);
+            col_ptr->replaceValues(first, numbers);
             break;
         }
         case SciDAVis::ColumnMode::Text: {
@@ -681,26 +693,21 @@ void Table::fillSelectedCellsWithRandomNumbers()
     WAIT_CURSOR;
     beginMacro(tr("%1: fill cells with random values").arg(name()));
 #if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
-    QRandomGenerator(QTime::currentTime().msec());
+    const quint64 seed = QRandomGenerator::global()->generate64();
 #else
     qsrand(QTime::currentTime().msec());
+    const quint64 seed = (quint64(qrand()) << 32) ^ quint64(qrand());
 #endif
+    int stream = 0;
     foreach (Column *col_ptr, d_view->selectedColumns()) {
         int col = columnIndex(col_ptr);
         switch (col_ptr->columnMode()) {
         case SciDAVis::ColumnMode::Numeric: {
-            QVector<qreal> results(last - first + 1);
-            for (int row = first; row <= last; row++)
-                if (d_view->isCellSelected(row, col))
-                    results[row - first] =
-#if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
-                            QRandomGenerator::global()->generateDouble();
-#else
-                            double(qrand()) / double(RAND_MAX);
-#endif
-                else
-                    results[row - first] = col_ptr->valueAt(row);
-            col_ptr->replaceValues(first, results);
+            QVector<qreal> numbers(last - first + 1);
+            ColumnTransform::fillRandom(numbers.data(), numbers.size(),
+                                        ColumnTransform::streamSeed(seed, stream++));
+            keepUnselectedValues(col_ptr, col, first, &numbers);
+            col_ptr->replaceValues(first, numbers);
             break;
         }
         case SciDAVis::ColumnMode::Text: {
@@ -876,31 +883,153 @@ void Table::setSelectedColumnsAsNone()
     setSelectionAs(SciDAVis::noDesignation);
 }
 
-void Table::normalizeColumns(QList<Column *> cols)
+void Table::transformColumns(const QList<Column *> &cols, const QString &description,
+                             const std::function<bool(QVector<qreal> &, int)> &transform,
+                             bool keep_invalid, const QList<Interval<int>> &invalid)
 {
-    if (!d_view)
+    QList<Column *> numeric;
+    for (Column *col : cols)
+        if (col && col->dataType() == SciDAVis::TypeDouble)
+            numeric << col;
+    if (numeric.isEmpty())
         return;
 
     WAIT_CURSOR;
-    beginMacro(QObject::tr("%1: normalize column(s)").arg(name()));
-    foreach (Column *col, cols) {
-        if (col->dataType() == SciDAVis::TypeDouble) {
-            double max = 0.0;
-            for (int row = 0; row < col->rowCount(); row++) {
-                if (col->valueAt(row) > max)
-                    max = col->valueAt(row);
-            }
-            QVector<qreal> results(col->rowCount());
-            if (max != 0.0) // avoid division by zero
-                for (int row = 0; row < col->rowCount(); row++)
-                    results[row] = col->valueAt(row) / max;
-            col->replaceValues(0, results);
-        }
+    // the values are shared with the columns until the transformation (on the worker threads)
+    // writes to them
+    QVector<QVector<qreal>> values(numeric.size());
+    QVector<QList<Interval<int>>> invalid_rows(numeric.size());
+    QVector<char> changed(numeric.size(), 0);
+    QVector<int> indices(numeric.size());
+    for (int i = 0; i < numeric.size(); i++) {
+        values[i] = numeric.at(i)->values();
+        invalid_rows[i] = numeric.at(i)->invalidIntervals();
+        indices[i] = i;
+    }
+    QtConcurrent::blockingMap(indices, [&](int i) {
+        QVector<qreal> &column_values = values[i];
+        forEachRow(invalid_rows.at(i), 0, column_values.size() - 1, [&column_values](int row) {
+            column_values[row] = std::numeric_limits<qreal>::quiet_NaN();
+        });
+        changed[i] = transform(column_values, i);
+    });
+
+    beginMacro(description);
+    for (int i = 0; i < numeric.size(); i++) {
+        if (!changed.at(i))
+            continue;
+        Column *col = numeric.at(i);
+        // replaceValues() marks all written cells valid
+        col->replaceValues(0, values.at(i));
+        if (!keep_invalid)
+            continue;
+        const int last = values.at(i).size() - 1;
+        for (const Interval<int> &iv : invalid_rows.at(i) + invalid)
+            if (iv.start() <= last)
+                col->setInvalid(Interval<int>(iv.start(), qMin(iv.end(), last)));
     }
     endMacro();
     RESET_CURSOR;
 }
 
+void Table::normalizeColumns(QList<Column *> cols, ColumnTransform::Normalization method)
+{
+    transformColumns(cols, QObject::tr("%1: normalize column(s)").arg(name()),
+                     [method](QVector<qreal> &values, int) {
+                         return ColumnTransform::normalize(values.data(), values.size(), method);
+                     });
+}
+
+void Table::scaleColumns(QList<Column *> cols, double factor, double offset)
+{
+    transformColumns(cols, QObject::tr("%1: scale column(s)").arg(name()),
+                     [factor, offset](QVector<qreal> &values, int) {
+                         ColumnTransform::scale(values.data(), values.size(), factor, offset);
+                         return true;
+                     });
+}
+
+void Table::cumulativeSumColumns(QList<Column *> cols)
+{
+    transformColumns(cols, QObject::tr("%1: cumulative sum of column(s)").arg(name()),
+                     [](QVector<qreal> &values, int) {
+                         ColumnTransform::cumulativeSum(values.data(), values.size());
+                         return true;
+                     });
+}
+
+void Table::differenceColumns(QList<Column *> cols)
+{
+    // the first finite value of a column has no predecessor, so its row becomes invalid
+    QList<QPair<Column *, int>> first_rows;
+    for (Column *col : cols) {
+        if (!col || col->dataType() != SciDAVis::TypeDouble)
+            continue;
+        for (int row = 0; row < col->rowCount(); row++)
+            if (!col->isInvalid(row) && std::isfinite(col->valueAt(row))) {
+                first_rows << qMakePair(col, row);
+                break;
+            }
+    }
+
+    const QString description = QObject::tr("%1: differences of column(s)").arg(name());
+    beginMacro(description);
+    transformColumns(cols, description, [](QVector<qreal> &values, int) {
+        ColumnTransform::difference(values.data(), values.size());
+        return true;
+    });
+    for (const QPair<Column *, int> &first : first_rows)
+        first.first->setInvalid(first.second);
+    endMacro();
+}
+
+void Table::fillColumnsWithSequence(QList<Column *> cols, double start, double step)
+{
+    const int rows = rowCount();
+    transformColumns(cols, QObject::tr("%1: fill column(s) with a sequence").arg(name()),
+                     [=](QVector<qreal> &values, int) {
+                         values.resize(qMax(rows, values.size()));
+                         ColumnTransform::fillSequence(values.data(), rows, start, step);
+                         return true;
+                     },
+                     false);
+}
+
+void Table::fillColumnsWithRandomNumbers(QList<Column *> cols, quint64 seed)
+{
+    const int rows = rowCount();
+    transformColumns(cols, QObject::tr("%1: fill column(s) with random values").arg(name()),
+                     [=](QVector<qreal> &values, int index) {
+                         values.resize(qMax(rows, values.size()));
+                         ColumnTransform::fillRandom(values.data(), rows,
+                                                     ColumnTransform::streamSeed(seed, index));
+                         return true;
+                     },
+                     false);
+}
+
+void Table::combineColumns(QList<Column *> cols, const Column *operand,
+                           ColumnTransform::Operation operation)
+{
+    if (!operand || operand->dataType() != SciDAVis::TypeDouble)
+        return;
+    // rows beyond the end of the operand are left unchanged, those where it is invalid become
+    // invalid
+    QVector<qreal> operand_values = operand->values();
+    const QList<Interval<int>> operand_invalid = operand->invalidIntervals();
+    forEachRow(operand_invalid, 0, operand_values.size() - 1, [&operand_values](int row) {
+        operand_values[row] = std::numeric_limits<qreal>::quiet_NaN();
+    });
+    transformColumns(cols, QObject::tr("%1: column arithmetic").arg(name()),
+                     [&operand_values, operation](QVector<qreal> &values, int) {
+                         ColumnTransform::combine(values.data(), operand_values.constData(),
+                                                  qMin(values.size(), operand_values.size()),
+                                                  operation);
+                         return true;
+                     },
+                     true, operand_invalid);
+}
+
 void Table::normalizeSelectedColumns()
 {
     normalizeColumns(d_view->selectedColumns());
@@ -941,6 +1070,75 @@ void Table::normalizeSelection()
     RESET_CURSOR;
 }
 
+void Table::normalizeSelectedColumnsToSum()
+{
+    if (!d_view)
+        return;
+    normalizeColumns(d_view->selectedColumns(), ColumnTransform::NormalizeSum);
+}
+
+void Table::standardizeSelectedColumns()
+{
+    if (!d_view)
+        return;
+    normalizeColumns(d_view->selectedColumns(), ColumnTransform::NormalizeZScore);
+}
+
+void Table::scaleSelectedColumns()
+{
+    if (!d_view)
+        return;
+    bool ok;
+    double factor = QInputDialog::getDouble(0, tr("Scale Columns"), tr("Multiply by"), 1.0,
+                                            -DBL_MAX, DBL_MAX, 6, &ok);
+    if (!ok)
+        return;
+    double offset = QInputDialog::getDouble(0, tr("Scale Columns"), tr("Then add"), 0.0, -DBL_MAX,
+                                            DBL_MAX, 6, &ok);
+    if (!ok)
+        return;
+    scaleColumns(d_view->selectedColumns(), factor, offset);
+}
+
+void Table::cumulativeSumSelectedColumns()
+{
+    if (!d_view)
+        return;
+    cumulativeSumColumns(d_view->selectedColumns());
+}
+
+void Table::differenceSelectedColumns()
+{
+    if (!d_view)
+        return;
+    differenceColumns(d_view->selectedColumns());
+}
+
+void Table::combineSelectedColumns()
+{
+    if (!d_view)
+        return;
+    QStringList operand_names;
+    for (int i = 0; i < columnCount(); i++)
+        if (column(i)->dataType() == SciDAVis::TypeDouble)
+            operand_names << column(i)->name();
+    if (operand_names.isEmpty())
+        return;
+    const QStringList operations = { tr("Add"), tr("Subtract"), tr("Multiply by"),
+                                     tr("Divide by") };
+    bool ok;
+    QString operation = QInputDialog::getItem(0, tr("Column Arithmetic"), tr("Operation"),
+                                              operations, 0, false, &ok);
+    if (!ok)
+        return;
+    QString operand = QInputDialog::getItem(0, tr("Column Arithmetic"), tr("Column"),
+                                            operand_names, 0, false, &ok);
+    if (!ok)
+        return;
+    combineColumns(d_view->selectedColumns(), column(operand, false),
+                   ColumnTransform::Operation(operations.indexOf(operation)));
+}
+
 void Table::sortSelectedColumns()
 {
     if (!d_view)
@@ -1085,6 +1283,9 @@ bool Table::fillProjectMenu(QMenu *menu)
     submenu->addAction(action_fill_row_numbers);
     submenu->addAction(action_fill_random);
     menu->addMenu(submenu);
+    submenu = new QMenu(tr("&Transform Columns"));
+    fillTransformMenu(submenu);
+    menu->addMenu(submenu);
     menu->addSeparator();
 
     connect(menu, SIGNAL(aboutToShow()), this, SLOT(adjustActionNames()));
@@ -1348,6 +1549,19 @@ void Table::createActions()
     actionManager()->addAction(action_normalize_selection, "normalize_selection");
     delete icon_temp;
 
+    action_normalize_sum = new QAction(tr("Normalize to &Sum"), this);
+    actionManager()->addAction(action_normalize_sum, "normalize_sum");
+    action_standardize = new QAction(tr("&Standardize (Z-Score)"), this);
+    actionManager()->addAction(action_standardize, "standardize");
+    action_scale_columns = new QAction(tr("S&cale Columns..."), this);
+    actionManager()->addAction(action_scale_columns, "scale_columns");
+    action_cumulative_sum = new QAction(tr("C&umulative Sum"), this);
+    actionManager()->addAction(action_cumulative_sum, "cumulative_sum");
+    action_difference = new QAction(tr("&Differences"), this);
+    actionManager()->addAction(action_difference, "difference");
+    action_column_arithmetic = new QAction(tr("Column &Arithmetic..."), this);
+    actionManager()->addAction(action_column_arithmetic, "column_arithmetic");
+
     icon_temp = new QIcon();
     icon_temp->addPixmap(QPixmap(":/16x16/sort.png"));
     icon_temp->addPixmap(QPixmap(":/32x32/sort.png"));
@@ -1452,6 +1666,14 @@ void Table::connectActions()
     connect(action_set_as_none, SIGNAL(triggered()), this, SLOT(setSelectedColumnsAsNone()));
     connect(action_normalize_columns, SIGNAL(triggered()), this, SLOT(normalizeSelectedColumns()));
     connect(action_normalize_selection, SIGNAL(triggered()), this, SLOT(normalizeSelection()));
+    connect(action_normalize_sum, SIGNAL(triggered()), this,
+            SLOT(normalizeSelectedColumnsToSum()));
+    connect(action_standardize, SIGNAL(triggered()), this, SLOT(standardizeSelectedColumns()));
+    connect(action_scale_columns, SIGNAL(triggered()), this, SLOT(scaleSelectedColumns()));
+    connect(action_cumulative_sum, SIGNAL(triggered()), this,
+            SLOT(cumulativeSumSelectedColumns()));
+    connect(action_difference, SIGNAL(triggered()), this, SLOT(differenceSelectedColumns()));
+    connect(action_column_arithmetic, SIGNAL(triggered()), this, SLOT(combineSelectedColumns()));
     connect(action_sort_columns, SIGNAL(triggered()), this, SLOT(sortSelectedColumns()));
     connect(action_statistics_columns, SIGNAL(triggered()), this,
             SLOT(statisticsOnSelectedColumns()));
@@ -1510,6 +1732,12 @@ void Table::addActionsToView()
     d_view->addAction(action_set_as_none);
     d_view->addAction(action_normalize_columns);
     d_view->addAction(action_normalize_selection);
+    d_view->addAction(action_normalize_sum);
+    d_view->addAction(action_standardize);
+    d_view->addAction(action_scale_columns);
+    d_view->addAction(action_cumulative_sum);
+    d_view->addAction(action_difference);
+    d_view->addAction(action_column_arithmetic);
     d_view->addAction(action_sort_columns);
     d_view->addAction(action_statistics_columns);
     d_view->addAction(action_type_format);
@@ -1557,6 +1785,12 @@ void Table::translateActionsStrings()
     action_set_as_none->setText(tr("None", "plot designation"));
     action_normalize_columns->setText(tr("&Normalize Columns"));
     action_normalize_selection->setText(tr("&Normalize Selection"));
+    action_normalize_sum->setText(tr("Normalize to &Sum"));
+    action_standardize->setText(tr("&Standardize (Z-Score)"));
+    action_scale_columns->setText(tr("S&cale Columns..."));
+    action_cumulative_sum->setText(tr("C&umulative Sum"));
+    action_difference->setText(tr("&Differences"));
+    action_column_arithmetic->setText(tr("Column &Arithmetic..."));
     action_sort_columns->setText(tr("&Sort Columns"));
     action_statistics_columns->setText(tr("Column Statisti&cs"));
     action_type_format->setText(tr("Change &Type && Format"));
@@ -1805,6 +2039,9 @@ QMenu *Table::createColumnMenu(QMenu *append_to)
     menu->addSeparator();
 
     menu->addAction(action_normalize_columns);
+    submenu = new QMenu(tr("&Transform Columns"));
+    fillTransformMenu(submenu);
+    menu->addMenu(submenu);
     menu->addAction(action_sort_columns);
     menu->addSeparator();
 
@@ -1819,6 +2056,19 @@ QMenu *Table::createColumnMenu(QMenu *append_to)
     return menu;
 }
 
+void Table::fillTransformMenu(QMenu *menu)
+{
+    menu->addAction(action_normalize_columns);
+    menu->addAction(action_normalize_sum);
+    menu->addAction(action_standardize);
+    menu->addSeparator();
+    menu->addAction(action_scale_columns);
+    menu->addAction(action_column_arithmetic);
+    menu->addSeparator();
+    menu->addAction(action_cumulative_sum);
+    menu->addAction(action_difference);
+}
+
 QMenu *Table::createTableMenu(QMenu *append_to)
 {
     QMenu *menu = append_to;
@@ -2000,218 +2250,46 @@ void Table::sortDialog(QList<Column *> cols)
 
     SortDialog *sortd = new future::SortDialog();
     sortd->setAttribute(Qt::WA_DeleteOnClose);
-    connect(sortd, SIGNAL(sort(Column *, QList<Column *>, bool)), this,
-            SLOT(sortColumns(Column *, QList<Column *>, bool)));
+    connect(sortd, SIGNAL(sort(QList<Column *>, QList<Column *>, bool)), this,
+            SLOT(sortColumns(QList<Column *>, QList<Column *>, bool)));
     sortd->setColumnsList(cols);
     sortd->exec();
 }
 
 void Table::sortColumns(Column *leading, QList<Column *> cols, bool ascending)
+{
+    sortColumns(leading ? QList<Column *>() << leading : QList<Column *>(), cols, ascending);
+}
+
+void Table::sortColumns(QList<Column *> keys, QList<Column *> cols, bool ascending)
 {
     if (cols.isEmpty())
         return;
 
-    // the normal QPair comparison does not work properly with descending sorting
-    // thefore we use our own compare functions
-    class CompareFunctions
-    {
-    public:
-        static bool doubleLess(const QPair<double, int> &a, const QPair<double, int> &b)
-        {
-            return a.first < b.first;
-        }
-        static bool doubleGreater(const QPair<double, int> &a, const QPair<double, int> &b)
-        {
-            return a.first > b.first;
-        }
-        static bool QStringLess(const QPair<QString, int> &a, const QPair<QString, int> &b)
-        {
-            return a < b;
-        }
-        static bool QStringGreater(const QPair<QString, int> &a, const QPair<QString, int> &b)
-        {
-            return a > b;
-        }
-        static bool QDateTimeLess(const QPair<QDateTime, int> &a, const QPair<QDateTime, int> &b)
-        {
-            return a < b;
-        }
-        static bool QDateTimeGreater(const QPair<QDateTime, int> &a, const QPair<QDateTime, int> &b)
-        {
-            return a > b;
-        }
-    };
-
     WAIT_CURSOR;
     beginMacro(tr("%1: sort column(s)").arg(name()));
 
-    if (leading == 0) // sort separately
+    if (keys.isEmpty()) // sort separately
     {
-        for (int i = 0; i < cols.size(); i++) {
-            Column *col = cols.at(i);
-
-            if (col->dataType() == SciDAVis::TypeDouble) {
-                int rows = col->rowCount();
-                QList<QPair<double, int>> map;
-
-                for (int j = 0; j < rows; j++)
-                    map.append(QPair<double, int>(col->valueAt(j), j));
-
-                if (ascending)
-                    std::stable_sort(map.begin(), map.end(), CompareFunctions::doubleLess);
-                else
-                    std::stable_sort(map.begin(), map.end(), CompareFunctions::doubleGreater);
-
-                QListIterator<QPair<double, int>> it(map);
-                Column *temp_col = new Column("temp", col->columnMode());
-
-                int k = 0;
-                // put the values in the right order into temp_col
-                while (it.hasNext()) {
-                    temp_col->copy(col, it.peekNext().second, k, 1);
-                    temp_col->setMasked(col->isMasked(it.next().second));
-                    k++;
-                }
-                // copy the sorted column
-                col->copy(temp_col, 0, 0, rows);
-                delete temp_col;
-            } else if (col->dataType() == SciDAVis::TypeQString) {
-                int rows = col->rowCount();
-                QList<QPair<QString, int>> map;
-
-                for (int j = 0; j < rows; j++)
-                    map.append(QPair<QString, int>(col->textAt(j), j));
-
-                if (ascending)
-                    std::stable_sort(map.begin(), map.end(), CompareFunctions::QStringLess);
-                else
-                    std::stable_sort(map.begin(), map.end(), CompareFunctions::QStringGreater);
-
-                QListIterator<QPair<QString, int>> it(map);
-                Column *temp_col = new Column("temp", col->columnMode());
-
-                int k = 0;
-                // put the values in the right order into temp_col
-                while (it.hasNext()) {
-                    temp_col->copy(col, it.peekNext().second, k, 1);
-                    temp_col->setMasked(col->isMasked(it.next().second));
-                    k++;
-                }
-                // copy the sorted column
-                col->copy(temp_col, 0, 0, rows);
-                delete temp_col;
-            } else if (col->dataType() == SciDAVis::TypeQDateTime) {
-                int rows = col->rowCount();
-                QList<QPair<QDateTime, int>> map;
-
-                for (int j = 0; j < rows; j++)
-                    map.append(QPair<QDateTime, int>(col->dateTimeAt(j), j));
-
-                if (ascending)
-                    std::stable_sort(map.begin(), map.end(), CompareFunctions::QDateTimeLess);
-                else
-                    std::stable_sort(map.begin(), map.end(), CompareFunctions::QDateTimeGreater);
-
-                QListIterator<QPair<QDateTime, int>> it(map);
-                Column *temp_col = new Column("temp", col->columnMode());
-
-                int k = 0;
-                // put the values in the right order into temp_col
-                while (it.hasNext()) {
-                    temp_col->copy(col, it.peekNext().second, k, 1);
-                    temp_col->setMasked(col->isMasked(it.next().second));
-                    k++;
-                }
-                // copy the sorted column
-                col->copy(temp_col, 0, 0, rows);
-                delete temp_col;
-            }
+        for (Column *col : cols) {
+            RowSorter sorter(col->rowCount());
+            sorter.addKey(col, ascending);
+            const QVector<int> permutation = sorter.permutation();
+            if (!RowSorter::isIdentity(permutation))
+                col->permuteRows(permutation);
         }
-
-    } else // sort with leading column
+    } else // sort all columns by the same keys
     {
-        if (leading->dataType() == SciDAVis::TypeDouble) {
-            QList<QPair<double, int>> map;
-            int rows = leading->rowCount();
-
-            for (int i = 0; i < rows; i++)
-                map.append(QPair<double, int>(leading->valueAt(i), i));
-
-            if (ascending)
-                std::stable_sort(map.begin(), map.end(), CompareFunctions::doubleLess);
-            else
-                std::stable_sort(map.begin(), map.end(), CompareFunctions::doubleGreater);
-            QListIterator<QPair<double, int>> it(map);
-
-            for (int i = 0; i < cols.size(); i++) {
-                Column *temp_col = new Column("temp", cols.at(i)->columnMode());
-                it.toFront();
-                int j = 0;
-                // put the values in the right order into temp_col
-                while (it.hasNext()) {
-                    temp_col->copy(cols.at(i), it.peekNext().second, j, 1);
-                    temp_col->setMasked(cols.at(i)->isMasked(it.next().second));
-                    j++;
-                }
-                // copy the sorted column
-                cols.at(i)->copy(temp_col, 0, 0, rows);
-                delete temp_col;
-            }
-        } else if (leading->dataType() == SciDAVis::TypeQString) {
-            QList<QPair<QString, int>> map;
-            int rows = leading->rowCount();
-
-            for (int i = 0; i < rows; i++)
-                map.append(QPair<QString, int>(leading->textAt(i), i));
-
-            if (ascending)
-                std::stable_sort(map.begin(), map.end(), CompareFunctions::QStringLess);
-            else
-                std::stable_sort(map.begin(), map.end(), CompareFunctions::QStringGreater);
-            QListIterator<QPair<QString, int>> it(map);
-
-            for (int i = 0; i < cols.size(); i++) {
-                Column *temp_col = new Column("temp", cols.at(i)->columnMode());
-                it.toFront();
-                int j = 0;
-                // put the values in the right order into temp_col
-                while (it.hasNext()) {
-                    temp_col->copy(cols.at(i), it.peekNext().second, j, 1);
-                    temp_col->setMasked(cols.at(i)->isMasked(it.next().second));
-                    j++;
-                }
-                // copy the sorted column
-                cols.at(i)->copy(temp_col, 0, 0, rows);
-                delete temp_col;
-            }
-        } else if (leading->dataType() == SciDAVis::TypeQDateTime) {
-            QList<QPair<QDateTime, int>> map;
-            int rows = leading->rowCount();
-
-            for (int i = 0; i < rows; i++)
-                map.append(QPair<QDateTime, int>(leading->dateTimeAt(i), i));
-
-            if (ascending)
-                std::stable_sort(map.begin(), map.end(), CompareFunctions::QDateTimeLess);
-            else
-                std::stable_sort(map.begin(), map.end(), CompareFunctions::QDateTimeGreater);
-            QListIterator<QPair<QDateTime, int>> it(map);
-
-            for (int i = 0; i < cols.size(); i++) {
-                Column *temp_col = new Column("temp", cols.at(i)->columnMode());
-                it.toFront();
-                int j = 0;
-                // put the values in the right order into temp_col
-                while (it.hasNext()) {
-                    temp_col->copy(cols.at(i), it.peekNext().second, j, 1);
-                    temp_col->setMasked(cols.at(i)->isMasked(it.next().second));
-                    j++;
-                }
-                // copy the sorted column
-                cols.at(i)->copy(temp_col, 0, 0, rows);
-                delete temp_col;
-            }
-        }
+        int rows = 0;
+        for (Column *key : keys)
+            rows = qMax(rows, key->rowCount());
+        RowSorter sorter(rows);
+        for (Column *key : keys)
+            sorter.addKey(key, ascending);
+        const QVector<int> permutation = sorter.permutation();
+        if (!RowSorter::isIdentity(permutation))
+            for (Column *col : cols)
+                col->permuteRows(permutation);
     }
     endMacro();
     RESET_CURSOR;
@@ -2269,14 +2347,28 @@ void Table::handlePlotDesignationChange(const AbstractColumn *col)
 
 void Table::handleDataChange(const AbstractColumn *col)
 {
+    int first = 0, last = col->rowCount() - 1;
+    if (col == d_changed_column) {
+        first = d_changed_first;
+        last = d_changed_last;
+        d_changed_column = nullptr;
+    }
     int index = columnIndex(static_cast<const Column *>(col));
     if (index != -1) {
         if (col->rowCount() > rowCount())
             setRowCount(col->rowCount());
-        emit dataChanged(0, index, col->rowCount() - 1, index);
+        emit dataChanged(first, index, last, index);
     }
 }
 
+void Table::handleRowsChanged(const AbstractColumn *col, int first, int last)
+{
+    // remember the range for the dataChanged() signal following immediately
+    d_changed_column = col;
+    d_changed_first = first;
+    d_changed_last = last;
+}
+
 void Table::handleRowsAboutToBeInserted(const AbstractColumn *col, int before, int count)
 {
     int new_size = col->rowCount() + count;
@@ -2315,6 +2407,8 @@ void Table::connectColumn(const Column *col)
             SLOT(handlePlotDesignationChange(const AbstractColumn *)));
     connect(col, SIGNAL(modeChanged(const AbstractColumn *)), this,
             SLOT(handleDataChange(const AbstractColumn *)));
+    connect(col, SIGNAL(rowsChanged(const AbstractColumn *, int, int)), this,
+            SLOT(handleRowsChanged(const AbstractColumn *, int, int)));
     connect(col, SIGNAL(dataChanged(const AbstractColumn *)), this,
             SLOT(handleDataChange(const AbstractColumn *)));
     connect(col, SIGNAL(modeChanged(const AbstractColumn *)), this,
@@ -36,10 +36,13 @@
 #include "AbstractScriptingEngine.h"
 #endif
 #include "globals.h"
+#include "lib/ColumnTransform.h"
 #include <QList>
 #include <QStringList>
 #include <QPointer>
 
+#include <functional>
+
 class TableView;
 class QUndoStack;
 class QMenu;
@@ -285,9 +288,39 @@ public slots:
     void setSelectedColumnsAsXError();
     void setSelectedColumnsAsYError();
     void setSelectedColumnsAsNone();
-    void normalizeColumns(QList<Column *> cols);
+    void normalizeColumns(QList<Column *> cols,
+                          ColumnTransform::Normalization method = ColumnTransform::NormalizeMax);
     void normalizeSelectedColumns();
     void normalizeSelection();
+    //! \name Transformations of whole numeric columns
+    /**
+     * Each transformation is one undo step. Non-numeric columns are ignored.
+     * \sa ColumnTransform
+     */
+    //@{
+    //! Replace each value v by factor * v + offset
+    void scaleColumns(QList<Column *> cols, double factor, double offset = 0.0);
+    //! Replace each value by the sum of all values up to it
+    void cumulativeSumColumns(QList<Column *> cols);
+    //! Replace each value by its difference to the previous one (the first row becomes invalid)
+    void differenceColumns(QList<Column *> cols);
+    //! Fill the columns (up to rowCount()) with start, start + step, ...
+    void fillColumnsWithSequence(QList<Column *> cols, double start = 1.0, double step = 1.0);
+    //! Fill the columns (up to rowCount()) with uniform random numbers in [0, 1)
+    /**
+     * Each column gets its own stream of random numbers derived from 'seed'.
+     */
+    void fillColumnsWithRandomNumbers(QList<Column *> cols, quint64 seed);
+    //! Combine the values of the columns with the values of 'operand' in the same row
+    void combineColumns(QList<Column *> cols, const Column *operand,
+                        ColumnTransform::Operation operation);
+    //@}
+    void normalizeSelectedColumnsToSum();
+    void standardizeSelectedColumns();
+    void scaleSelectedColumns();
+    void cumulativeSumSelectedColumns();
+    void differenceSelectedColumns();
+    void combineSelectedColumns();
     void sortSelectedColumns();
     void statisticsOnSelectedColumns();
     void statisticsOnSelectedRows();
@@ -304,6 +337,13 @@ public slots:
      * If 'leading' is a null pointer, each column is sorted separately.
      */
     void sortColumns(Column *leading, QList<Column *> cols, bool ascending);
+    //! Sort the rows of the given columns by one or more key columns
+    /*
+     * The first key is the most significant one. Invalid rows and NaN values of a key are sorted
+     * last. If 'keys' is empty, each column is sorted separately. All columns are reordered by a
+     * single permutation; the whole sort is one undo step.
+     */
+    void sortColumns(QList<Column *> keys, QList<Column *> cols, bool ascending);
     //! Show a context menu for the selected cells
     /**
      * \param pos global position of the event
@@ -365,6 +405,7 @@ private slots:
     void handleModeChange(const AbstractColumn *col);
     void handlePlotDesignationChange(const AbstractColumn *col);
     void handleDataChange(const AbstractColumn *col);
+    void handleRowsChanged(const AbstractColumn *col, int first, int last);
     void handleRowsAboutToBeInserted(const AbstractColumn *col, int before, int count);
     void handleRowsInserted(const AbstractColumn *col, int before, int count);
     void handleRowsAboutToBeRemoved(const AbstractColumn *col, int first, int count);
@@ -392,12 +433,31 @@ signals:
 #endif
 
 private:
+    //! Replace the values of the numeric columns in 'cols' by the results of 'transform'
+    /**
+     * 'transform' is called with the values of each column and the index of the column in 'cols'.
+     * It runs on the global thread pool for all columns at once and returns false to leave a
+     * column unchanged. Invalid cells are passed as NaN. If keep_invalid is true, they stay
+     * invalid afterwards, as do the rows in 'invalid'; otherwise all written cells become valid.
+     * The changes are one undo step named 'description'.
+     */
+    void transformColumns(const QList<Column *> &cols, const QString &description,
+                          const std::function<bool(QVector<qreal> &, int)> &transform,
+                          bool keep_invalid = true, const QList<Interval<int>> &invalid = {});
+    //! Add the column transform actions to 'menu'
+    void fillTransformMenu(QMenu *menu);
+    //! Restore the cells of 'values' (rows first, first + 1, ... of column 'col') not selected
+    void keepUnselectedValues(Column *col_ptr, int col, int first, QVector<qreal> *values) const;
     void createActions();
     void connectActions();
     void addActionsToView();
     void translateActionsStrings();
     QMenu *d_plot_menu;
     static bool d_default_comment_visibility;
+    //! Column and row range announced by the last AbstractColumn::rowsChanged()
+    const AbstractColumn *d_changed_column = nullptr;
+    int d_changed_first = 0;
+    int d_changed_last = -1;
 
     //! \name selection related actions
     //@{
@@ -445,6 +505,12 @@ private:
     QAction *action_set_as_yerr;
     QAction *action_set_as_none;
     QAction *action_normalize_columns;
+    QAction *action_normalize_sum;
+    QAction *action_standardize;
+    QAction *action_scale_columns;
+    QAction *action_cumulative_sum;
+    QAction *action_difference;
+    QAction *action_column_arithmetic;
     QAction *action_sort_columns;
     QAction *action_statistics_columns;
     QAction *action_type_format;
@@ -22,7 +22,7 @@ DEFINES       += MANUAL_PATH="\\\"$$replace(manual.path," ","\\ ")\\\""
 !mxe {
      win32:DEFINES += QT_DLL QT_THREAD_SUPPORT
 }
-QT            += opengl network svg xml
+QT            += opengl network svg xml concurrent
 equals(QT_MAJOR_VERSION, 5){
     QT += printsupport
 }
@@ -183,7 +183,11 @@ int main(int argc, char **argv)
             mw->searchForUpdates();
         }
 #endif
-        mw->parseCommandLineArguments(args);
+        const int exit_code = mw->parseCommandLineArguments(args);
+        if (exit_code >= 0) {
+            delete mw;
+            return exit_code;
+        }
     }
     app.connect(&app, SIGNAL(lastWindowClosed()), &app, SLOT(quit()));
     return app.exec();
@@ -1,13 +1,19 @@
 #include "ApplicationWindowTest.h"
 #include "MultiLayer.h"
 #include "Graph3D.h"
+#include "Matrix.h"
+#include "MyParser.h"
 #include "testPaintDevice.h"
 #include "Note.h"
+#include "core/column/Column.h"
 #include <QMdiArea>
+#include <QTemporaryDir>
 
+#include <cmath>
 #include <iostream>
 #include <fstream>
 #include <memory>
+#include <utility>
 #include <stdexcept>
 
 #include "utils.h"
@@ -131,3 +137,150 @@ TEST_F(ApplicationWindowTest, plot3d)
     for (auto i : windows)
         EXPECT_TRUE(!dynamic_cast<Graph3D *>(i));
 }
+
+TEST_F(ApplicationWindowTest, userFunctionSamples)
+{
+    const QString formula = "sin(x)*cos(y) + exp(-10*(x*x+y*y))";
+    Graph3D *plot = newPlot3D(formula, -2, 2, -2, 2, -10, 10);
+    ASSERT_TRUE(plot && plot->userFunction());
+    UserFunction *function = plot->userFunction();
+    const int columns = 81, rows = 61;
+    function->setGrid(columns, rows);
+
+    // the function used to be evaluated point by point with MyParser
+    QVector<double> expected(columns * rows);
+    double x, y;
+    MyParser parser;
+    parser.DefineVar(_T("x"), &x);
+    parser.DefineVar(_T("y"), &y);
+    parser.SetExpr(formula);
+    for (int i = 0; i < columns; ++i)
+        for (int j = 0; j < rows; ++j) {
+            x = -2 + i * (4.0 / (columns - 1));
+            y = -2 + j * (4.0 / (rows - 1));
+            expected[i * rows + j] = parser.Eval();
+        }
+
+    QVector<double> values = function->samples();
+    ASSERT_EQ(values.size(), expected.size());
+    for (int k = 0; k < values.size(); ++k)
+        ASSERT_NEAR(values[k], expected[k], 1e-12) << k;
+
+    // the peak is sampled, the smooth parts are interpolated closely
+    function->setAdaptiveRefinement(true);
+    values = function->samples();
+    ASSERT_EQ(values.size(), expected.size());
+    double error = 0;
+    for (int k = 0; k < values.size(); ++k)
+        error = qMax(error, std::fabs(values[k] - expected[k]));
+    EXPECT_LT(error, 0.05);
+    const int peak = (columns - 1) / 2 * rows + (rows - 1) / 2;
+    EXPECT_NEAR(values[peak], expected[peak], 1e-12);
+
+    // the option is saved with the project
+    function->setAdaptiveRefinement(false);
+    plot->setAdaptiveRefinement(true);
+    EXPECT_TRUE(plot->adaptiveRefinement());
+    QTemporaryDir dir;
+    const QString file = dir.path() + "/adaptive.sciprj";
+    saveFolder(projectFolder(), file);
+    std::unique_ptr<ApplicationWindow> app(open(file));
+    ASSERT_TRUE(app.get());
+    Graph3D *loaded = nullptr;
+    for (auto i : app->windowsList())
+        if ((loaded = dynamic_cast<Graph3D *>(i)))
+            break;
+    ASSERT_TRUE(loaded);
+    EXPECT_EQ(loaded->formula(), formula);
+    EXPECT_TRUE(loaded->adaptiveRefinement());
+}
+
+TEST_F(ApplicationWindowTest, matrixPlotVersion)
+{
+    Matrix *m = newMatrix("surface", 11, 11);
+    m->setCoordinates(0, 10, 0, 10);
+    for (int i = 0; i < 11; i++)
+        for (int j = 0; j < 11; j++)
+            m->setCell(i, j, i + j);
+
+    // only a part of the matrix is shown
+    Graph3D *plot = openMatrixPlot3D("surfacePlot", "matrix<surface>", 2, 5, 3, 7, 0, 100);
+    ASSERT_TRUE(plot);
+    auto xRange = [&]() {
+        const Qwt3D::ParallelEpiped &hull = plot->sp->hull();
+        return std::make_pair(hull.minVertex.x, hull.maxVertex.x);
+    };
+    EXPECT_EQ(xRange(), std::make_pair(2.0, 5.0));
+
+    // an unchanged matrix is not reloaded, which would discard the scales
+    plot->updateMatrixData(m);
+    EXPECT_EQ(xRange(), std::make_pair(2.0, 5.0));
+
+    m->setCell(0, 0, 1);
+    plot->updateMatrixData(m);
+    EXPECT_EQ(xRange(), std::make_pair(0.0, 10.0));
+}
+
+TEST_F(ApplicationWindowTest, pointCloud)
+{
+    const int rows = 20;
+    auto table = newTable("cloud", rows, 3);
+    table->setColPlotDesignation(2, SciDAVis::Z);
+    for (int r = 0; r < rows; ++r) {
+        table->column(0)->setValueAt(r, r);
+        table->column(1)->setValueAt(r, 2 * r);
+        table->column(2)->setValueAt(r, 0.1 * r * r);
+    }
+    // a row is left out if any of its coordinates is invalid
+    table->column(1)->setInvalid(5);
+    table->column(2)->setInvalid(Interval<int>(12, 13));
+
+    Qwt3D::TripleField points = Graph3D::pointCloud(table, 0, 1, 2);
+    ASSERT_EQ(points.size(), size_t(rows - 3));
+    size_t i = 0;
+    for (int r = 0; r < rows; ++r) {
+        if (r == 5 || r == 12 || r == 13)
+            continue;
+        EXPECT_EQ(points[i].x, r);
+        EXPECT_EQ(points[i].y, 2 * r);
+        EXPECT_EQ(points[i].z, 0.1 * r * r);
+        i++;
+    }
+
+    // points outside of the x/y range of the clipping box are dropped, z is clamped
+    const Qwt3D::ParallelEpiped clip(Qwt3D::Triple(2, 0, 0), Qwt3D::Triple(10, 100, 5));
+    points = Graph3D::pointCloud(table, 0, 1, 2, &clip);
+    ASSERT_EQ(points.size(), size_t(8));
+    EXPECT_EQ(points.front().x, 2);
+    EXPECT_EQ(points.back().x, 10);
+    EXPECT_EQ(points.back().z, 5);
+
+    // every plot type shows all valid points, also after saving and loading the project
+    auto expectHull = [&](Graph3D *plot) {
+        const Qwt3D::ParallelEpiped &hull = plot->sp->hull();
+        EXPECT_EQ(hull.minVertex.x, 0);
+        EXPECT_EQ(hull.maxVertex.x, rows - 1);
+        EXPECT_EQ(hull.minVertex.y, 0);
+        EXPECT_EQ(hull.maxVertex.y, 2 * (rows - 1));
+        EXPECT_EQ(hull.minVertex.z, 0);
+        EXPECT_EQ(hull.maxVertex.z, 0.1 * (rows - 1) * (rows - 1));
+    };
+    for (int type : { Graph3D::Scatter, Graph3D::Trajectory, Graph3D::Bars }) {
+        SCOPED_TRACE(type);
+        Graph3D *plot = dataPlotXYZ(table, table->colName(2), type);
+        ASSERT_TRUE(plot);
+        expectHull(plot);
+    }
+    QTemporaryDir dir;
+    const QString file = dir.path() + "/pointCloud.sciprj";
+    saveFolder(projectFolder(), file);
+    std::unique_ptr<ApplicationWindow> app(open(file));
+    ASSERT_TRUE(app.get());
+    int plots = 0;
+    for (auto window : app->windowsList())
+        if (auto plot = dynamic_cast<Graph3D *>(window)) {
+            expectHull(plot);
+            plots++;
+        }
+    EXPECT_EQ(plots, 3);
+}
@@ -0,0 +1,101 @@
+#include "ApplicationWindowTest.h"
+#include "CanvasRenderer.h"
+#include "Graph.h"
+#include "MultiLayer.h"
+#include "Plot.h"
+#include "core/column/Column.h"
+#include "testPaintDevice.h"
+#include <QCoreApplication>
+#include <QImage>
+#include <QPainter>
+#include <qwt_plot_curve.h>
+#include <qwt_plot_printfilter.h>
+#include <qwt_symbol.h>
+
+#include <sstream>
+
+#include "utils.h"
+
+TEST_F(ApplicationWindowTest, canvasRenderer)
+{
+    // enough points to be rendered in the background: a horizontal line at y = 0.5
+    const int rows = 200000;
+    auto table = newTable("render", rows, 2);
+    for (int r = 0; r < rows; ++r) {
+        table->column(0)->setValueAt(r, double(r) / rows);
+        table->column(1)->setValueAt(r, 0.5);
+    }
+    auto plot = multilayerPlot(table, QStringList() << table->colName(1), Graph::Line);
+    ASSERT_TRUE(plot);
+    auto curve = plot->activeGraph()->curve(0);
+    ASSERT_TRUE(curve);
+    curve->setPen(QPen(Qt::red));
+    curve->setRenderHint(QwtPlotItem::RenderAntialiased, false);
+
+    auto renderer = new CanvasRenderer(plot->activeGraph()->plotWidget());
+    const QRect rect(0, 0, 200, 100);
+    QwtScaleMap maps[QwtPlot::axisCnt];
+    for (int axis = 0; axis < QwtPlot::axisCnt; ++axis) {
+        maps[axis].setScaleInterval(0, 1);
+        if (axis == QwtPlot::xBottom || axis == QwtPlot::xTop)
+            maps[axis].setPaintInterval(rect.left(), rect.right());
+        else
+            maps[axis].setPaintInterval(rect.bottom(), rect.top());
+    }
+    QwtPlotPrintFilter filter;
+    filter.setOptions(QwtPlotPrintFilter::PrintAll & ~QwtPlotPrintFilter::PrintGrid);
+
+    auto record = [&]() {
+        std::ostringstream out;
+        TestPaintDevice device(out);
+        QPainter painter(&device);
+        EXPECT_TRUE(renderer->drawItems(&painter, rect, maps, filter));
+        return out.str();
+    };
+    auto render = [&]() {
+        while (renderer->isRendering())
+            QCoreApplication::processEvents();
+        QImage image(rect.size(), QImage::Format_ARGB32);
+        image.fill(Qt::white);
+        QPainter painter(&image);
+        EXPECT_TRUE(renderer->drawItems(&painter, rect, maps, filter));
+        EXPECT_FALSE(renderer->isRendering());
+        return image;
+    };
+
+    // nothing to show until the image has been rendered
+    EXPECT_EQ(record().find("drawImage("), std::string::npos);
+    EXPECT_TRUE(renderer->isRendering());
+    QImage image = render();
+    EXPECT_EQ(image.pixel(100, 50), qRgb(255, 0, 0));
+    EXPECT_EQ(image.pixel(100, 25), qRgb(255, 255, 255));
+    EXPECT_EQ(image.pixel(100, 75), qRgb(255, 255, 255));
+    EXPECT_NE(record().find("drawImage("), std::string::npos);
+    EXPECT_FALSE(renderer->isRendering());
+
+    // changes of the curve are rendered again, even without a replot
+    curve->setPen(QPen(Qt::blue));
+    record();
+    EXPECT_TRUE(renderer->isRendering());
+    image = render();
+    EXPECT_EQ(image.pixel(100, 50), qRgb(0, 0, 255));
+
+    // sticks from the baseline at y = 0
+    curve->setStyle(QwtPlotCurve::Sticks);
+    image = render();
+    EXPECT_EQ(image.pixel(100, 75), qRgb(0, 0, 255));
+    EXPECT_EQ(image.pixel(100, 25), qRgb(255, 255, 255));
+
+    // symbols are drawn by the renderer as well
+    curve->setStyle(QwtPlotCurve::NoCurve);
+    curve->setSymbol(QwtSymbol(QwtSymbol::Rect, QBrush(Qt::green), QPen(Qt::green), QSize(9, 9)));
+    image = render();
+    EXPECT_EQ(image.pixel(100, 47), qRgb(0, 255, 0));
+    EXPECT_EQ(image.pixel(100, 25), qRgb(255, 255, 255));
+
+    // hidden curves are not rendered, and too few points are left to draw in the background
+    curve->setVisible(false);
+    QImage direct(rect.size(), QImage::Format_ARGB32);
+    QPainter painter(&direct);
+    EXPECT_FALSE(renderer->drawItems(&painter, rect, maps, filter));
+}
@@ -0,0 +1,165 @@
+#include "ApplicationWindowTest.h"
+#include "BoxCurve.h"
+#include "ColumnAggregation.h"
+#include "QwtHistogram.h"
+#include "core/column/Column.h"
+#include "lib/DescriptiveStatistics.h"
+#include <QLocale>
+#include <gsl/gsl_histogram.h>
+#include <gsl/gsl_sort.h>
+#include <gsl/gsl_statistics.h>
+#include <algorithm>
+#include <cmath>
+
+#include "utils.h"
+
+namespace {
+//! The valid values of the rows first to last, collected row by row as the plots used to do
+QVector<double> rowValues(Column *column, int first, int last)
+{
+    QVector<double> result;
+    for (int row = first; row <= last && row < column->rowCount(); row++) {
+        if (column->isInvalid(row))
+            continue;
+        if (column->columnMode() == SciDAVis::ColumnMode::Text) {
+            bool valid_data = true;
+            const double value = QLocale().toDouble(column->textAt(row), &valid_data);
+            if (valid_data)
+                result << value;
+        } else
+            result << column->valueAt(row);
+    }
+    return result;
+}
+
+//! Compare the histogram of the rows first to last with the one gsl_histogram gives
+void expectGslHistogram(Table *table, int first, int last, bool autoBin, double size = 0,
+                        double begin = 0, double end = 0)
+{
+    SCOPED_TRACE(QString("rows %1 to %2").arg(first).arg(last).toStdString());
+    const QVector<double> values = rowValues(table->column(1), first, last);
+    ASSERT_GT(values.size(), 2);
+    gsl_histogram *h;
+    if (autoBin) {
+        h = gsl_histogram_alloc(10);
+        gsl_histogram_set_ranges_uniform(
+                h, floor(*std::min_element(values.constBegin(), values.constEnd())),
+                ceil(*std::max_element(values.constBegin(), values.constEnd())));
+    } else {
+        const int n = int((end - begin) / size + 1);
+        h = gsl_histogram_alloc(n);
+        QVector<double> range(n + 1);
+        for (int i = 0; i <= n; i++)
+            range[i] = begin + i * size;
+        gsl_histogram_set_ranges(h, range.constData(), n + 1);
+    }
+    for (double value : values)
+        gsl_histogram_increment(h, value);
+
+    QwtHistogram histogram(table, table->colName(1), first, last);
+    histogram.setBinning(autoBin, size, begin, end);
+    ASSERT_TRUE(histogram.loadData());
+    ASSERT_EQ(histogram.dataSize(), int(gsl_histogram_bins(h)));
+    for (int i = 0; i < histogram.dataSize(); i++) {
+        double lower, upper;
+        gsl_histogram_get_range(h, i, &lower, &upper);
+        EXPECT_EQ(histogram.x(i), lower);
+        EXPECT_EQ(histogram.y(i), gsl_histogram_get(h, i));
+    }
+    EXPECT_NEAR(histogram.mean(), gsl_histogram_mean(h), 1e-12);
+    EXPECT_NEAR(histogram.standardDeviation(), gsl_histogram_sigma(h), 1e-12);
+    EXPECT_EQ(histogram.minimum(), gsl_histogram_min_val(h));
+    EXPECT_EQ(histogram.maximum(), gsl_histogram_max_val(h));
+    gsl_histogram_free(h);
+}
+} // namespace
+
+TEST_F(ApplicationWindowTest, columnAggregationValues)
+{
+    const int rows = 1000;
+    auto table = newTable("aggregation", rows, 3);
+    auto &numbers = *table->column(1), &texts = *table->column(2);
+    texts.setColumnMode(SciDAVis::ColumnMode::Text);
+    for (int r = 0; r < rows; ++r) {
+        numbers.setValueAt(r, 10 * sin(0.37 * r) + 0.01 * r);
+        texts.setTextAt(r, r % 7 == 0 ? QString("x") : QLocale().toString(0.5 * r));
+    }
+    // invalid rows are left out, masked rows are not
+    numbers.setInvalid(Interval<int>(100, 149));
+    numbers.setInvalid(400);
+    numbers.setMasked(Interval<int>(200, 219));
+    texts.setInvalid(Interval<int>(10, 19));
+    texts.setMasked(30);
+
+    for (auto range : { qMakePair(0, rows - 1), qMakePair(120, 420), qMakePair(950, 1200),
+                        qMakePair(160, 180) }) {
+        for (Column *column : { &numbers, &texts }) {
+            SCOPED_TRACE(column->name().toStdString());
+            const QVector<double> expected = rowValues(column, range.first, range.second);
+            EXPECT_EQ(ColumnAggregation::values(column, range.first, range.second), expected);
+        }
+    }
+    // all rows valid: the data is shared with the column
+    EXPECT_EQ(ColumnAggregation::values(&numbers, 0, 99), rowValues(&numbers, 0, 99));
+    EXPECT_TRUE(ColumnAggregation::values(&numbers, 100, 149).isEmpty());
+}
+
+TEST_F(ApplicationWindowTest, columnAggregationHistogram)
+{
+    const int rows = 1000;
+    auto table = newTable("histogram", rows, 2);
+    auto &y = *table->column(1);
+    for (int r = 0; r < rows; ++r) {
+        table->column(0)->setValueAt(r, r);
+        y.setValueAt(r, 10 * sin(0.37 * r) + 0.01 * r);
+    }
+    y.setInvalid(Interval<int>(100, 149));
+    y.setMasked(Interval<int>(200, 219));
+
+    expectGslHistogram(table, 0, rows - 1, true);
+    expectGslHistogram(table, 120, 420, true);
+    expectGslHistogram(table, 0, rows - 1, false, 0.5, -8, 12);
+    // values outside of the bins are not counted
+    expectGslHistogram(table, 90, 700, false, 2, -4, 4);
+
+    // a change of the column is not hidden by the cache
+    y.setInvalid(Interval<int>(0, 99));
+    expectGslHistogram(table, 0, rows - 1, true);
+}
+
+TEST_F(ApplicationWindowTest, columnAggregationQuantiles)
+{
+    const int rows = 1001;
+    auto table = newTable("quantiles", rows, 2);
+    auto &y = *table->column(1);
+    for (int r = 0; r < rows; ++r) {
+        table->column(0)->setValueAt(r, r);
+        y.setValueAt(r, cos(1.3 * r) * r);
+    }
+    y.setInvalid(Interval<int>(500, 519));
+    y.setMasked(7);
+
+    QVector<double> sorted = rowValues(&y, 3, 900);
+    gsl_sort(sorted.data(), 1, sorted.size());
+
+    // the box plot shows the rows, in their original order
+    BoxCurve box(table, table->colName(1), 3, 900);
+    box.setData(QwtSingleArrayData(1, QwtArray<double>(), 0));
+    ASSERT_TRUE(box.loadData());
+    ASSERT_EQ(box.dataSize(), sorted.size());
+    QVector<double> loaded(box.dataSize());
+    for (int i = 0; i < loaded.size(); i++)
+        loaded[i] = box.y(i);
+    EXPECT_EQ(loaded, rowValues(&y, 3, 900));
+
+    // its quantiles are selected from them, instead of sorting
+    const QVector<double> probabilities = QVector<double>() << 0.01 << 0.1 << 0.25 << 0.5 << 0.75
+                                                            << 0.9 << 0.99 << 0 << 1;
+    const QVector<double> quantiles = DescriptiveStatistics::quantiles(loaded, probabilities);
+    ASSERT_EQ(quantiles.size(), probabilities.size());
+    for (int i = 0; i < probabilities.size(); i++)
+        EXPECT_EQ(quantiles.at(i),
+                  gsl_stats_quantile_from_sorted_data(sorted.constData(), 1, sorted.size(),
+                                                      probabilities.at(i)))
+                << "p = " << probabilities.at(i);
+}
@@ -0,0 +1,55 @@
+#include "ApplicationWindowTest.h"
+#include "core/column/Column.h"
+#include <QDateTime>
+#include <cmath>
+
+#include "utils.h"
+
+// large enough to be converted in several blocks
+static const int rows = 40000;
+
+TEST_F(ApplicationWindowTest, convertTextToDateTime)
+{
+    const QDateTime start(QDate(2000, 1, 1), QTime(0, 0));
+    QStringList texts;
+    for (int r = 0; r < rows; ++r)
+        texts << start.addSecs(61 * r).toString("yyyy-MM-dd hh:mm:ss.zzz");
+    texts[5] = "not a date";
+    // not in the selected format, found by the fallback
+    texts[7] = "2000-1-5 8:30";
+    Column column("text", texts, IntervalAttribute<bool>({ Interval<int>(20000, 20001) }));
+
+    column.setColumnMode(SciDAVis::ColumnMode::DateTime);
+    ASSERT_EQ(column.rowCount(), rows);
+    EXPECT_EQ(column.dateTimeAt(0), start);
+    EXPECT_EQ(column.dateTimeAt(rows - 1), start.addSecs(61 * (rows - 1)));
+    EXPECT_TRUE(column.isInvalid(5));
+    EXPECT_FALSE(column.isInvalid(6));
+    EXPECT_EQ(column.dateTimeAt(7), QDateTime(QDate(2000, 1, 5), QTime(8, 30)));
+    EXPECT_TRUE(column.isInvalid(20000));
+    EXPECT_TRUE(column.isInvalid(20001));
+    EXPECT_FALSE(column.isInvalid(20002));
+
+    column.setColumnMode(SciDAVis::ColumnMode::Text);
+    ASSERT_EQ(column.rowCount(), rows);
+    EXPECT_EQ(column.textAt(0), texts.at(0));
+    EXPECT_EQ(column.textAt(rows - 1), texts.at(rows - 1));
+    EXPECT_EQ(column.textAt(7), "2000-01-05 08:30:00.000");
+    EXPECT_TRUE(column.isInvalid(5));
+}
+
+TEST_F(ApplicationWindowTest, convertTextToNumeric)
+{
+    QStringList texts;
+    for (int r = 0; r < rows; ++r)
+        texts << QString::number(r);
+    texts[3] = "x";
+    Column column("text", texts);
+
+    column.setColumnMode(SciDAVis::ColumnMode::Numeric);
+    ASSERT_EQ(column.rowCount(), rows);
+    EXPECT_EQ(column.valueAt(rows - 1), rows - 1);
+    EXPECT_TRUE(column.isInvalid(3));
+    EXPECT_FALSE(column.isInvalid(4));
+    EXPECT_EQ(column.valueAt(4), 4);
+}
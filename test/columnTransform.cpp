@@ -0,0 +1,132 @@
+#include "ApplicationWindowTest.h"
+#include "Table.h"
+#include "core/column/Column.h"
+#include "lib/ColumnTransform.h"
+#include <QUndoStack>
+#include <cmath>
+
+#include "utils.h"
+
+TEST_F(ApplicationWindowTest, transformColumnsInOneUndoStep)
+{
+    auto table = newTable("transform", 4, 2);
+    auto &a = *table->column(0), &b = *table->column(1);
+    for (int r = 0; r < 4; ++r) {
+        a.setValueAt(r, r + 1);
+        b.setValueAt(r, 2 * (r + 1));
+    }
+
+    auto future_table = table->d_future_table;
+    future_table->normalizeColumns(QList<Column *>() << &a << &b, ColumnTransform::NormalizeSum);
+    for (int r = 0; r < 4; ++r) {
+        EXPECT_DOUBLE_EQ(a.valueAt(r), (r + 1) / 10.0);
+        EXPECT_DOUBLE_EQ(b.valueAt(r), (r + 1) / 10.0);
+    }
+
+    // both columns are restored in one step
+    future_table->undoStack()->undo();
+    for (int r = 0; r < 4; ++r) {
+        EXPECT_EQ(a.valueAt(r), r + 1);
+        EXPECT_EQ(b.valueAt(r), 2 * (r + 1));
+    }
+
+    future_table->cumulativeSumColumns(QList<Column *>() << &a);
+    const double sums[] = { 1, 3, 6, 10 };
+    for (int r = 0; r < 4; ++r)
+        EXPECT_EQ(a.valueAt(r), sums[r]);
+    future_table->differenceColumns(QList<Column *>() << &a);
+    EXPECT_TRUE(a.isInvalid(0));
+    for (int r = 1; r < 4; ++r)
+        EXPECT_EQ(a.valueAt(r), r + 1);
+
+    future_table->combineColumns(QList<Column *>() << &b, &b, ColumnTransform::Divide);
+    for (int r = 0; r < 4; ++r)
+        EXPECT_EQ(b.valueAt(r), 1);
+    future_table->scaleColumns(QList<Column *>() << &b, 3, -1);
+    for (int r = 0; r < 4; ++r)
+        EXPECT_EQ(b.valueAt(r), 2);
+}
+
+TEST_F(ApplicationWindowTest, fillColumnsReproducibly)
+{
+    const int rows = 100000;
+    auto table = newTable("fill", rows, 3);
+    auto &a = *table->column(0), &b = *table->column(1), &c = *table->column(2);
+    auto future_table = table->d_future_table;
+
+    future_table->fillColumnsWithSequence(QList<Column *>() << &a, 0.5, 2);
+    EXPECT_EQ(a.rowCount(), rows);
+    for (int r = 0; r < rows; ++r)
+        ASSERT_EQ(a.valueAt(r), 0.5 + 2 * r);
+
+    future_table->fillColumnsWithRandomNumbers(QList<Column *>() << &b << &c, 42);
+    const QVector<qreal> first_b = b.values(), first_c = c.values();
+    for (int r = 0; r < rows; ++r) {
+        ASSERT_GE(b.valueAt(r), 0);
+        ASSERT_LT(b.valueAt(r), 1);
+    }
+    // each column has its own stream
+    EXPECT_NE(first_b, first_c);
+    future_table->fillColumnsWithRandomNumbers(QList<Column *>() << &b << &c, 42);
+    EXPECT_EQ(b.values(), first_b);
+    EXPECT_EQ(c.values(), first_c);
+
+    future_table->normalizeColumns(QList<Column *>() << &b, ColumnTransform::NormalizeZScore);
+    double sum = 0;
+    for (int r = 0; r < rows; ++r)
+        sum += b.valueAt(r);
+    EXPECT_NEAR(sum / rows, 0, 1e-9);
+}
+
+TEST_F(ApplicationWindowTest, transformColumnsKeepsInvalidCells)
+{
+    auto table = newTable("invalid", 5, 3);
+    auto &a = *table->column(0), &b = *table->column(1), &c = *table->column(2);
+    for (int r = 0; r < 5; ++r) {
+        a.setValueAt(r, r + 1);
+        b.setValueAt(r, 10);
+        c.setValueAt(r, 2);
+    }
+    // the stored values of invalid cells must not take part
+    a.setInvalid(Interval<int>(1, 2));
+    c.setInvalid(3);
+    auto future_table = table->d_future_table;
+
+    future_table->scaleColumns(QList<Column *>() << &a, 2, 1);
+    EXPECT_EQ(a.valueAt(0), 3);
+    EXPECT_TRUE(a.isInvalid(1));
+    EXPECT_TRUE(a.isInvalid(2));
+    EXPECT_EQ(a.valueAt(3), 9);
+    future_table->undoStack()->undo();
+
+    future_table->cumulativeSumColumns(QList<Column *>() << &a);
+    EXPECT_EQ(a.valueAt(0), 1);
+    EXPECT_TRUE(a.isInvalid(2));
+    EXPECT_EQ(a.valueAt(3), 5);
+    EXPECT_EQ(a.valueAt(4), 10);
+    future_table->undoStack()->undo();
+
+    future_table->differenceColumns(QList<Column *>() << &a);
+    EXPECT_TRUE(a.isInvalid(0));
+    EXPECT_TRUE(a.isInvalid(1));
+    EXPECT_EQ(a.valueAt(3), 3);
+    EXPECT_EQ(a.valueAt(4), 1);
+    future_table->undoStack()->undo();
+    // in one undo step
+    EXPECT_FALSE(a.isInvalid(0));
+
+    // cells where the operand is invalid become invalid
+    future_table->combineColumns(QList<Column *>() << &b, &c, ColumnTransform::Multiply);
+    EXPECT_EQ(b.valueAt(2), 20);
+    EXPECT_TRUE(b.isInvalid(3));
+    EXPECT_FALSE(b.isInvalid(4));
+    future_table->combineColumns(QList<Column *>() << &a, &b, ColumnTransform::Add);
+    EXPECT_TRUE(a.isInvalid(1));
+    EXPECT_TRUE(a.isInvalid(3));
+    EXPECT_EQ(a.valueAt(4), 25);
+
+    // fills overwrite every cell
+    future_table->fillColumnsWithSequence(QList<Column *>() << &a, 0, 1);
+    for (int r = 0; r < 5; ++r)
+        EXPECT_FALSE(a.isInvalid(r));
+}
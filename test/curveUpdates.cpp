@@ -0,0 +1,129 @@
+#include "ApplicationWindowTest.h"
+#include "Folder.h"
+#include "Graph.h"
+#include "MultiLayer.h"
+#include "PlotCurve.h"
+#include "PolynomialFit.h"
+#include "core/column/Column.h"
+#include <QTemporaryDir>
+#include <qwt_plot_curve.h>
+
+#include "utils.h"
+
+TEST_F(ApplicationWindowTest, curvesUpToDateWithoutEventLoop)
+{
+    auto table = newTable("curves", 10, 2);
+    for (int r = 0; r < 10; ++r) {
+        table->column(0)->setValueAt(r, r);
+        table->column(1)->setValueAt(r, r * r);
+    }
+    auto plot = multilayerPlot(table, QStringList() << table->colName(1), Graph::Line);
+    ASSERT_TRUE(plot);
+    auto curve = plot->activeGraph()->curve(0);
+    ASSERT_TRUE(curve);
+    EXPECT_EQ(curve->y(3), 9);
+
+    // changes are only collected until the event loop runs, but exports and saving bring the
+    // curves up to date first
+    QTemporaryDir dir;
+    table->column(1)->setValueAt(3, -1);
+    ASSERT_TRUE(exportGraphs(dir.path(), "svg", QStringList() << plot->objectName()));
+    EXPECT_EQ(curve->y(3), -1);
+
+    table->column(1)->setValueAt(4, -2);
+    saveFolder(projectFolder(), dir.path() + "/curves.sciprj");
+    EXPECT_EQ(curve->y(4), -2);
+}
+
+TEST_F(ApplicationWindowTest, dataCurvePatchesRows)
+{
+    auto table = newTable("rows", 100, 2);
+    auto &x = *table->column(0), &y = *table->column(1);
+    for (int r = 0; r < 10; ++r) {
+        x.setValueAt(r, r);
+        y.setValueAt(r, r * r);
+    }
+    const QString x_name = table->colName(0), y_name = table->colName(1);
+    DataCurve curve(table, x_name, y_name, 0, 99);
+    ASSERT_TRUE(curve.loadData());
+    ASSERT_EQ(curve.dataSize(), 10);
+
+    // the patched points have to be the same as those of a full reload
+    auto expectReloaded = [&]() {
+        DataCurve reloaded(table, x_name, y_name, 0, 99);
+        reloaded.loadData();
+        ASSERT_EQ(curve.dataSize(), reloaded.dataSize());
+        for (int i = 0; i < curve.dataSize(); ++i) {
+            EXPECT_EQ(curve.x(i), reloaded.x(i));
+            EXPECT_EQ(curve.y(i), reloaded.y(i));
+            EXPECT_EQ(curve.tableRow(i), reloaded.tableRow(i));
+        }
+    };
+
+    // changed rows, one of them becoming invalid
+    y.setValueAt(3, -1);
+    y.setInvalid(5);
+    EXPECT_TRUE(curve.updateRows(table, y_name, Interval<int>(3, 5)));
+    EXPECT_EQ(curve.dataSize(), 9);
+    expectReloaded();
+
+    // appended rows
+    for (int r = 10; r < 13; ++r) {
+        x.setValueAt(r, r);
+        y.setValueAt(r, -r);
+    }
+    EXPECT_TRUE(curve.updateRows(table, x_name, Interval<int>(10, 12)));
+    EXPECT_EQ(curve.dataSize(), 12);
+    expectReloaded();
+
+    // removed rows drop the points of all following rows
+    table->d_future_table->setRowCount(8);
+    EXPECT_TRUE(curve.updateRows(table, y_name, Interval<int>(8, 12)));
+    EXPECT_EQ(curve.dataSize(), 7);
+    expectReloaded();
+
+    // all rows changed, or text data: full reload
+    x.replaceValues(0, QVector<qreal>() << 7 << 6 << 5 << 4 << 3 << 2 << 1 << 0);
+    EXPECT_TRUE(curve.updateRows(table, x_name, Interval<int>()));
+    expectReloaded();
+    y.setColumnMode(SciDAVis::ColumnMode::Text);
+    EXPECT_TRUE(curve.updateRows(table, y_name, Interval<int>(0, 0)));
+    expectReloaded();
+
+    // columns the curve is not plotted from
+    EXPECT_FALSE(curve.updateRows(table, "rows_nope", Interval<int>(0, 0)));
+}
+
+TEST_F(ApplicationWindowTest, filtersSeePendingCurveUpdates)
+{
+    auto table = newTable("filtered", 20, 2);
+    for (int r = 0; r < 20; ++r) {
+        table->column(0)->setValueAt(r, r);
+        table->column(1)->setValueAt(r, 2 * r + 1);
+    }
+    auto plot = multilayerPlot(table, QStringList() << table->colName(1), Graph::Line);
+    ASSERT_TRUE(plot);
+    auto graph = plot->activeGraph();
+    ASSERT_EQ(graph->curvesList().size(), 1);
+    const QString curve = graph->curvesList()[0];
+
+    // data and range changed in the same event loop tick as the fit
+    for (int r = 0; r < 20; ++r) {
+        table->column(0)->setValueAt(r, 10 + r);
+        table->column(1)->setValueAt(r, 3 * r - 2);
+    }
+    LinearFit fit(this, graph, curve);
+    fit.fit();
+    ASSERT_EQ(fit.results().size(), 2u);
+    EXPECT_NEAR(fit.results()[0], -32, 1e-10);
+    EXPECT_NEAR(fit.results()[1], 3, 1e-10);
+
+    // the same with an explicit interval
+    for (int r = 0; r < 20; ++r)
+        table->column(1)->setValueAt(r, -r);
+    LinearFit interval(this, graph, curve, 10, 29);
+    interval.fit();
+    ASSERT_EQ(interval.results().size(), 2u);
+    EXPECT_NEAR(interval.results()[0], 10, 1e-10);
+    EXPECT_NEAR(interval.results()[1], -1, 1e-10);
+}
@@ -0,0 +1,78 @@
+#include "ApplicationWindowTest.h"
+#include "FilteredTable.h"
+#include "RowPredicate.h"
+#include "core/column/Column.h"
+#include <QAction>
+#include <QCoreApplication>
+
+#include "utils.h"
+
+TEST_F(ApplicationWindowTest, filteredTable)
+{
+    auto table = newTable("filter", 6, 3);
+    table->setColName(0, "x");
+    table->setColName(1, "s");
+    table->setColName(2, "z");
+    auto &x = *table->column(0), &s = *table->column(1), &z = *table->column(2);
+    s.setColumnMode(SciDAVis::ColumnMode::Text);
+    const char *texts[] = { "ok", "ok", "bad", "ok", "ok", "bad" };
+    for (int r = 0; r < 6; ++r) {
+        x.setValueAt(r, r);
+        s.setTextAt(r, texts[r]);
+        z.setValueAt(r, -r);
+    }
+    x.setInvalid(4);
+
+    EXPECT_FALSE(RowPredicate("y > 2", table->d_future_table).isValid());
+    EXPECT_FALSE(RowPredicate("s > 2", table->d_future_table).isValid());
+    EXPECT_TRUE(RowPredicate("col(\"x\") > 2 || i == 1", table->d_future_table).isValid());
+
+    auto filtered = newFilteredTable(table, "x >= 1 && s == \"ok\"");
+    ASSERT_TRUE(filtered->predicate().isValid());
+    // the rows are taken from the base table and can't be edited
+    EXPECT_FALSE(filtered->d_future_table->action_column_arithmetic->isEnabled());
+    EXPECT_FALSE(filtered->d_future_table->action_add_rows->isEnabled());
+    // row 4 is invalid, so x >= 1 is false
+    EXPECT_EQ(filtered->baseRows(), QVector<int>() << 1 << 3);
+    ASSERT_EQ(filtered->numCols(), 3);
+    EXPECT_EQ(filtered->numRows(), 2);
+    EXPECT_EQ(filtered->column(0)->valueAt(1), 3);
+    EXPECT_EQ(filtered->column(1)->textAt(0), "ok");
+
+    // a change of a column the condition refers to selects rows again
+    s.setTextAt(5, "ok");
+    QCoreApplication::processEvents();
+    EXPECT_EQ(filtered->baseRows(), QVector<int>() << 1 << 3 << 5);
+    EXPECT_EQ(filtered->column(0)->valueAt(2), 5);
+
+    // changes of x select rows again as well, here keeping the same ones
+    x.setValueAt(3, 10);
+    x.setValueAt(2, 20);
+    QCoreApplication::processEvents();
+    EXPECT_EQ(filtered->baseRows(), QVector<int>() << 1 << 3 << 5);
+    EXPECT_EQ(filtered->column(0)->valueAt(1), 10);
+
+    // changes of a column the condition does not refer to only update the copied cells
+    z.setValueAt(3, 30);
+    z.setValueAt(2, 20);
+    QCoreApplication::processEvents();
+    EXPECT_EQ(filtered->baseRows(), QVector<int>() << 1 << 3 << 5);
+    EXPECT_EQ(filtered->column(2)->valueAt(1), 30);
+    EXPECT_EQ(filtered->column(2)->valueAt(2), -5);
+
+    // a cell becoming valid, and removed rows
+    x.setValueAt(4, 4);
+    QCoreApplication::processEvents();
+    EXPECT_EQ(filtered->baseRows(), QVector<int>() << 1 << 3 << 4 << 5);
+    table->d_future_table->setRowCount(4);
+    QCoreApplication::processEvents();
+    EXPECT_EQ(filtered->baseRows(), QVector<int>() << 1 << 3);
+    EXPECT_EQ(filtered->numRows(), 2);
+}
+
+TEST_F(ApplicationWindowTest, filteredTableWithoutBase)
+{
+    // a project whose base table is missing loads without the filtered table
+    EXPECT_FALSE(openFilteredTable(QStringList() << "filter-Filter\tmissing\t01.01.2024 12:00"
+                                                 << "Condition\tx > 1"));
+}
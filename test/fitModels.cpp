@@ -0,0 +1,207 @@
+#include "ApplicationWindowTest.h"
+#include "CompiledFormula.h"
+#include "ExponentialFit.h"
+#include "Graph.h"
+#include "MultiLayer.h"
+#include "MultiPeakFit.h"
+#include "NonLinearFit.h"
+#include "Script.h"
+#include "ScriptingEnv.h"
+#include "core/column/Column.h"
+#include "fit_models.h"
+#include <gsl/gsl_deriv.h>
+#include <cmath>
+#include <memory>
+
+#include "utils.h"
+
+namespace {
+struct DerivativeData
+{
+    CompiledFormula *formula;
+    int index;
+};
+
+double evaluateAt(double value, void *params)
+{
+    auto data = static_cast<DerivativeData *>(params);
+    data->formula->variables()[data->index] = value;
+    return data->formula->evaluate();
+}
+
+//! Compares the native model with the compiled formula and the scripted evaluation of 'formula'
+template<class Model>
+void compareModel(ScriptingEnv *env, const QString &formula, const QStringList &names,
+                  const std::vector<double> &params)
+{
+    SCOPED_TRACE(formula.toStdString());
+    const size_t n = 50, p = params.size();
+    std::vector<double> X(n), Y(n, 0), sigma(n, 1);
+    for (size_t i = 0; i < n; i++)
+        X[i] = 0.1 + 0.1 * i;
+    FitData data = { n, p, X.data(), Y.data(), sigma.data(), nullptr };
+
+    gsl_vector *x = gsl_vector_alloc(p);
+    for (size_t j = 0; j < p; j++)
+        gsl_vector_set(x, j, params[j]);
+    gsl_vector *f = gsl_vector_alloc(n);
+    gsl_matrix *J = gsl_matrix_alloc(n, p);
+    ASSERT_EQ(FitModel<Model>::f(x, &data, f), GSL_SUCCESS);
+    ASSERT_EQ(FitModel<Model>::df(x, &data, J), GSL_SUCCESS);
+
+    QString error;
+    auto compiled = CompiledFormula::cached(formula, QStringList(names) << "x", &error);
+    ASSERT_TRUE(compiled) << error.toStdString();
+    std::unique_ptr<Script> script(env->newScript(formula, nullptr, "compareModel"));
+    ASSERT_TRUE(script);
+
+    double *variables = compiled->variables();
+    DerivativeData derivative = { compiled.data(), 0 };
+    gsl_function F = { &evaluateAt, &derivative };
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < p; j++) {
+            variables[j] = params[j];
+            script->setDouble(params[j], names[int(j)].toUtf8());
+        }
+        variables[p] = X[i];
+        script->setDouble(X[i], "x");
+        const double expected = compiled->evaluate();
+        bool success;
+        EXPECT_NEAR(script->eval().toDouble(&success), expected, 1e-12 * (1 + fabs(expected)));
+        EXPECT_TRUE(success);
+        EXPECT_NEAR(gsl_vector_get(f, i), expected, 1e-12 * (1 + fabs(expected)));
+
+        for (size_t j = 0; j < p; j++) {
+            derivative.index = int(j);
+            double result, abserr;
+            gsl_deriv_central(&F, params[j], 1e-8, &result, &abserr);
+            variables[j] = params[j];
+            EXPECT_NEAR(gsl_matrix_get(J, i, j), result, 1e-5 * (1 + fabs(result)))
+                    << "parameter " << j << " at x = " << X[i];
+        }
+    }
+    EXPECT_TRUE(compiled->error().isEmpty());
+
+    gsl_matrix_free(J);
+    gsl_vector_free(f);
+    gsl_vector_free(x);
+}
+} // namespace
+
+TEST_F(ApplicationWindowTest, fitModels)
+{
+    using namespace FitModels;
+    compareModel<Exponential>(scriptEnv, "A*exp(-l*x)+b", { "A", "l", "b" }, { 2.5, 0.7, -0.3 });
+    compareModel<MultiExponential<2>>(scriptEnv, "A1*exp(-l1*x)+A2*exp(-l2*x)+y0",
+                                      { "A1", "l1", "A2", "l2", "y0" },
+                                      { 2.5, 0.7, -1.2, 2.1, 0.4 });
+    compareModel<MultiExponential<3>>(scriptEnv, "A1*exp(-l1*x)+A2*exp(-l2*x)+A3*exp(-l3*x)+y0",
+                                      { "A1", "l1", "A2", "l2", "A3", "l3", "y0" },
+                                      { 2.5, 0.7, -1.2, 2.1, 0.3, 0.05, 0.4 });
+    compareModel<Boltzmann>(scriptEnv, "(A1-A2)/(1+exp((x-x0)/dx))+A2", { "A1", "A2", "x0", "dx" },
+                            { 3, -1, 2.4, 0.6 });
+    compareModel<Gauss>(scriptEnv, "Y0+A*exp(-(x-C)^2/(2*w^2))", { "Y0", "A", "C", "w" },
+                        { 0.2, 4, 2.2, 0.8 });
+    // the multi-peak formulas as offered by the fit dialog
+    compareModel<GaussPeaks>(scriptEnv, MultiPeakFit::generateFormula(2, MultiPeakFit::Gauss),
+                             MultiPeakFit::generateParameterList(2),
+                             { 3, 1.5, 0.6, 2, 3.4, 0.9, 0.1 });
+    // the native Lorentz model works with amplitudes scaled by 2/pi
+    compareModel<LorentzPeaks>(scriptEnv, "y0+A1*w1/(4*(x-xc1)^2+w1^2)+A2*w2/(4*(x-xc2)^2+w2^2)",
+                               MultiPeakFit::generateParameterList(2),
+                               { 3, 1.5, 0.6, 2, 3.4, 0.9, 0.1 });
+}
+
+TEST_F(ApplicationWindowTest, compiledFitFormula)
+{
+    const int rows = 100;
+    auto table = newTable("decay", rows, 2);
+    for (int r = 0; r < rows; ++r) {
+        const double x = 0.05 * r;
+        table->column(0)->setValueAt(r, x);
+        table->column(1)->setValueAt(r, 2.5 * exp(-0.7 * x) + 0.3 + 0.01 * sin(7.0 * r));
+    }
+    auto plot = multilayerPlot(table, QStringList() << table->colName(1), Graph::Line);
+    ASSERT_TRUE(plot);
+    auto graph = plot->activeGraph();
+    ASSERT_EQ(graph->curvesList().size(), 1);
+    const QString curve = graph->curvesList()[0];
+
+    ExponentialFit native(this, graph, curve);
+    native.setInitialGuess(0, 2);
+    native.setInitialGuess(1, 1);
+    native.setInitialGuess(2, 0);
+    native.fit();
+
+    NonLinearFit user(this, graph, curve);
+    user.setParametersList(QStringList() << "A"
+                                         << "l"
+                                         << "y0");
+    user.setFormula("A*exp(-l*x)+y0");
+    user.setInitialGuess(0, 2);
+    user.setInitialGuess(1, 1);
+    user.setInitialGuess(2, 0);
+    user.fit();
+
+    // ExponentialFit reports the e-folding time instead of the rate
+    ASSERT_EQ(native.results().size(), 3u);
+    ASSERT_EQ(user.results().size(), 3u);
+    EXPECT_NEAR(user.results()[0], native.results()[0], 1e-6);
+    EXPECT_NEAR(user.results()[1], 1 / native.results()[1], 1e-6);
+    EXPECT_NEAR(user.results()[2], native.results()[2], 1e-6);
+    EXPECT_NEAR(user.chiSquare(), native.chiSquare(), 1e-8);
+
+    // the simplex ends up at the same parameters
+    NonLinearFit simplex(this, graph, curve);
+    simplex.setParametersList(QStringList() << "A"
+                                            << "l"
+                                            << "y0");
+    simplex.setFormula("A*exp(-l*x)+y0");
+    simplex.setAlgorithm(Fit::NelderMeadSimplex);
+    simplex.setInitialGuess(0, 2);
+    simplex.setInitialGuess(1, 1);
+    simplex.setInitialGuess(2, 0);
+    simplex.fit();
+    for (int i = 0; i < 3; i++)
+        EXPECT_NEAR(simplex.results()[i], user.results()[i], 1e-3);
+
+    // a formula undefined for most of the data is reported instead of fitting NaNs
+    for (auto algorithm : { Fit::ScaledLevenbergMarquardt, Fit::NelderMeadSimplex }) {
+        NonLinearFit invalid(this, graph, curve);
+        invalid.setParametersList(QStringList() << "a");
+        invalid.setFormula("sqrt(a-x)");
+        invalid.setAlgorithm(algorithm);
+        EXPECT_THROW(invalid.fit(), std::runtime_error);
+    }
+}
+
+TEST_F(ApplicationWindowTest, fitLogFormula)
+{
+    const int rows = 50;
+    auto table = newTable("logarithm", rows, 2);
+    for (int r = 0; r < rows; ++r) {
+        const double x = 1 + 0.2 * r;
+        table->column(0)->setValueAt(r, x);
+        table->column(1)->setValueAt(r, 3 * log10(x));
+    }
+    auto plot = multilayerPlot(table, QStringList() << table->colName(1), Graph::Line);
+    ASSERT_TRUE(plot);
+    auto graph = plot->activeGraph();
+    ASSERT_EQ(graph->curvesList().size(), 1);
+    const QString curve = graph->curvesList()[0];
+
+    // fit formulas are muParser expressions (where log is the decadic logarithm), whatever the
+    // scripting language of the project
+    for (const QString &language : ScriptingLangManager::languages()) {
+        SCOPED_TRACE(language.toStdString());
+        if (!setScriptingLang(language))
+            continue;
+        NonLinearFit fit(this, graph, curve);
+        fit.setParametersList(QStringList() << "a");
+        fit.setFormula("a*log(x)");
+        fit.fit();
+        ASSERT_EQ(fit.results().size(), 1u);
+        EXPECT_NEAR(fit.results()[0], 3, 1e-6);
+    }
+    setScriptingLang("muParser");
+}
@@ -0,0 +1,67 @@
+#include "ApplicationWindowTest.h"
+#include "Graph.h"
+#include "GraphExporter.h"
+#include "MultiLayer.h"
+#include "core/column/Column.h"
+#include <QDir>
+#include <QFileInfo>
+#include <QImage>
+#include <QTemporaryDir>
+
+#include "utils.h"
+
+TEST_F(ApplicationWindowTest, exportGraphs)
+{
+    auto table = newTable("export", 20, 2);
+    for (int r = 0; r < 20; ++r) {
+        table->column(0)->setValueAt(r, r);
+        table->column(1)->setValueAt(r, r % 5);
+    }
+    auto plot = multilayerPlot(table, QStringList() << table->colName(1), Graph::LineSymbols);
+    ASSERT_TRUE(plot);
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    // recorded windows are written when exportAll() is called, and only then
+    GraphExporter exporter("png");
+    const QString png = dir.path() + "/direct.png";
+    ASSERT_TRUE(exporter.add(plot, png));
+    EXPECT_FALSE(QFileInfo::exists(png));
+    EXPECT_TRUE(exporter.exportAll().isEmpty());
+    QImage image(png);
+    EXPECT_FALSE(image.isNull());
+    EXPECT_GT(image.width(), 0);
+
+    // unwritable files are reported
+    GraphExporter failing("svg");
+    ASSERT_TRUE(failing.add(plot, dir.path() + "/missing/plot.svg"));
+    EXPECT_EQ(failing.exportAll().size(), 1);
+
+    EXPECT_TRUE(exportGraphs(dir.path(), "svg", QStringList()));
+    EXPECT_TRUE(QFileInfo(dir.path() + "/" + plot->objectName() + ".svg").size() > 0);
+    EXPECT_FALSE(exportGraphs(dir.path(), "nope", QStringList()));
+    EXPECT_FALSE(exportGraphs(dir.path(), "png", QStringList() << "no such window"));
+}
+
+TEST_F(ApplicationWindowTest, headlessExportErrors)
+{
+    QTemporaryDir dir;
+    const QString export_dir = "--export=" + dir.path();
+    // errors end with a non-zero exit code instead of showing the project
+    EXPECT_EQ(parseCommandLineArguments(QStringList() << export_dir), 1);
+    EXPECT_EQ(parseCommandLineArguments(QStringList() << export_dir << "no such file.sciprj"), 1);
+    EXPECT_EQ(parseCommandLineArguments(QStringList() << export_dir << dir.path()), 1);
+    EXPECT_EQ(parseCommandLineArguments(QStringList() << export_dir << "--nope"
+                                                      << "testProject.sciprj"),
+              1);
+    // the export directory has to exist
+    for (const QString &bad : { dir.path() + "/missing", QString() })
+        EXPECT_EQ(parseCommandLineArguments(QStringList() << "--export=" + bad
+                                                          << "testProject.sciprj"),
+                  1);
+
+    EXPECT_EQ(parseCommandLineArguments(QStringList() << export_dir << "--export-format=svg"
+                                                      << "testProject.sciprj"),
+              0);
+    EXPECT_FALSE(QDir(dir.path()).entryList(QStringList() << "*.svg").isEmpty());
+}
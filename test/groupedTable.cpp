@@ -0,0 +1,100 @@
+#include "ApplicationWindowTest.h"
+#include "GroupedTable.h"
+#include "core/column/Column.h"
+#include "lib/GroupAggregation.h"
+#include <QAction>
+#include <QCoreApplication>
+#include <cmath>
+
+#include "utils.h"
+
+TEST_F(ApplicationWindowTest, groupAggregation)
+{
+    const int rows = 50000;
+    auto table = newTable("groups", rows, 3);
+    auto &batch = *table->column(0), &site = *table->column(1), &y = *table->column(2);
+    site.setColumnMode(SciDAVis::ColumnMode::Text);
+    QVector<qreal> batches(rows), values(rows);
+    QStringList sites;
+    for (int r = 0; r < rows; ++r) {
+        batches[r] = r % 7;
+        values[r] = r;
+        sites << (r % 2 ? "b" : "a");
+    }
+    batch.replaceValues(0, batches);
+    site.replaceTexts(0, sites);
+    y.replaceValues(0, values);
+    y.setInvalid(Interval<int>(0, 6));
+
+    GroupAggregation grouping(rows);
+    grouping.addKey(&batch);
+    grouping.addKey(&site);
+    grouping.group();
+    // 7 batches times 2 sites, numbered by first appearance
+    ASSERT_EQ(grouping.groupCount(), 14);
+    for (int g = 0; g < 14; ++g)
+        EXPECT_EQ(grouping.firstRows().at(g), g);
+
+    auto results = grouping.aggregate(
+            &y,
+            QVector<GroupAggregation::Aggregate>()
+                    << GroupAggregation::Aggregate { GroupAggregation::Count, 0 }
+                    << GroupAggregation::Aggregate { GroupAggregation::Mean, 0 }
+                    << GroupAggregation::Aggregate { GroupAggregation::Minimum, 0 }
+                    << GroupAggregation::Aggregate { GroupAggregation::Quantile, 0.5 });
+    for (int g = 0; g < 14; ++g) {
+        std::vector<double> group;
+        for (int r = 7; r < rows; ++r)
+            if (r % 14 == g)
+                group.push_back(r);
+        EXPECT_EQ(results[0][g], double(group.size()));
+        double sum = 0;
+        for (double v : group)
+            sum += v;
+        EXPECT_NEAR(results[1][g], sum / group.size(), 1e-9);
+        EXPECT_EQ(results[2][g], group.front());
+        const size_t n = group.size();
+        EXPECT_NEAR(results[3][g], n % 2 ? group[n / 2] : (group[n / 2 - 1] + group[n / 2]) / 2,
+                    1e-9);
+    }
+}
+
+TEST_F(ApplicationWindowTest, groupedTable)
+{
+    auto table = newTable("base", 6, 2);
+    table->setColName(0, "batch");
+    table->setColName(1, "y");
+    for (int r = 0; r < 6; ++r) {
+        table->column(0)->setValueAt(r, r / 2);
+        table->column(1)->setValueAt(r, r);
+    }
+
+    QString error;
+    EXPECT_FALSE(newGroupedTable(table, "nope", "count()", false, QString(), &error));
+    EXPECT_FALSE(error.isEmpty());
+    EXPECT_FALSE(newGroupedTable(table, "batch", "median(y, 2)", false, QString(), &error));
+
+    auto groups = dynamic_cast<GroupedTable *>(
+            newGroupedTable(table, "batch", "count(), sum(y), std(y), quantile(y, 0.25)", true));
+    ASSERT_TRUE(groups);
+    EXPECT_FALSE(groups->d_future_table->action_cumulative_sum->isEnabled());
+    EXPECT_FALSE(groups->d_future_table->action_set_formula->isEnabled());
+    ASSERT_EQ(groups->numCols(), 5);
+    EXPECT_EQ(groups->numRows(), 3);
+    EXPECT_EQ(groups->colLabel(0), "batch");
+    EXPECT_EQ(groups->colLabel(2), "y_sum");
+    EXPECT_EQ(groups->colLabel(4), "y_q25");
+    EXPECT_EQ(groups->cell(1, 0), 1);
+    EXPECT_EQ(groups->cell(1, 1), 2);
+    EXPECT_EQ(groups->cell(1, 2), 5);
+    EXPECT_NEAR(groups->cell(1, 3), std::sqrt(0.5), 1e-12);
+    EXPECT_EQ(groups->cell(1, 4), 2.25);
+
+    // live tables follow changes of the columns they depend on
+    table->column(0)->setValueAt(5, 3);
+    QCoreApplication::processEvents();
+    EXPECT_EQ(groups->numRows(), 4);
+    EXPECT_EQ(groups->cell(2, 1), 1);
+    // a group with a single value has no standard deviation
+    EXPECT_TRUE(groups->column(3)->isInvalid(3));
+}
@@ -0,0 +1,120 @@
+#include "ApplicationWindowTest.h"
+#include "core/column/Column.h"
+#include "lib/TableJoin.h"
+#include <QDateTime>
+
+#include "utils.h"
+
+TEST_F(ApplicationWindowTest, tableJoin)
+{
+    const int rows = 40000;
+    Column left_key("k", SciDAVis::ColumnMode::Numeric);
+    Column right_key("k", SciDAVis::ColumnMode::Numeric);
+    QVector<qreal> left_values(rows), right_values(rows / 2);
+    for (int r = 0; r < rows; ++r)
+        left_values[r] = r;
+    // every even key twice in the right table, odd keys not at all
+    for (int r = 0; r < rows / 2; ++r)
+        right_values[r] = 2 * (r % (rows / 4));
+    left_key.replaceValues(0, left_values);
+    right_key.replaceValues(0, right_values);
+    left_key.setInvalid(Interval<int>(0, 1));
+
+    TableJoin inner(rows, rows / 2, TableJoin::Inner);
+    inner.addKey(&left_key, &right_key);
+    inner.join();
+    // keys 0 to rows/2 - 2 in steps of 2, except 0 (invalid on the left)
+    ASSERT_EQ(inner.leftRows().size(), 2 * (rows / 4 - 1));
+    for (int pair = 0; pair < inner.leftRows().size(); ++pair) {
+        const int row = inner.leftRows().at(pair);
+        EXPECT_EQ(row, 2 * (pair / 2 + 1));
+        EXPECT_EQ(right_values.at(inner.rightRows().at(pair)), left_values.at(row));
+    }
+    // the right rows of a left row keep their order
+    EXPECT_LT(inner.rightRows().at(0), inner.rightRows().at(1));
+
+    TableJoin outer(rows, rows / 2, TableJoin::Outer);
+    outer.addKey(&left_key, &right_key);
+    outer.join();
+    // every left row, the even ones twice, and the two right rows with key 0
+    ASSERT_EQ(outer.leftRows().size(), rows + rows / 4 - 1 + 2);
+    EXPECT_EQ(outer.rightRows().at(0), -1);
+    EXPECT_EQ(outer.leftRows().at(outer.leftRows().size() - 2), -1);
+    EXPECT_EQ(outer.rightRows().last(), rows / 4);
+}
+
+TEST_F(ApplicationWindowTest, joinTables)
+{
+    auto samples = newTable("samples", 4, 3);
+    samples->setColName(0, "site");
+    samples->setColName(1, "t");
+    samples->setColName(2, "y");
+    samples->column(0)->setColumnMode(SciDAVis::ColumnMode::Text);
+    samples->column(0)->replaceTexts(0, QStringList() << "a" << "b" << "a" << "c");
+    samples->column(1)->replaceValues(0, QVector<qreal>() << 1 << 2 << 3 << 4);
+    samples->column(2)->replaceValues(0, QVector<qreal>() << 10 << 20 << 30 << 40);
+
+    auto sites = newTable("sites", 3, 3);
+    sites->setColName(0, "name");
+    sites->setColName(1, "y");
+    sites->setColName(2, "t");
+    sites->column(0)->setColumnMode(SciDAVis::ColumnMode::Text);
+    sites->column(0)->replaceTexts(0, QStringList() << "a" << "b" << "d");
+    sites->column(1)->replaceValues(0, QVector<qreal>() << 1 << 2 << 4);
+    sites->column(2)->replaceValues(0, QVector<qreal>() << 2.5 << 0 << 8);
+
+    QString error;
+    EXPECT_FALSE(newJoinedTable(samples, sites, "site", "nope", TableJoin::Inner, -1, QString(),
+                                &error));
+    EXPECT_FALSE(error.isEmpty());
+    EXPECT_FALSE(newJoinedTable(samples, sites, "site", "y", TableJoin::Inner, -1, QString(),
+                                &error));
+    EXPECT_FALSE(newJoinedTable(samples, sites, "site", "name", TableJoin::Nearest, -1,
+                                QString(), &error));
+
+    auto inner = newJoinedTable(samples, sites, "site", "name", TableJoin::Inner);
+    ASSERT_TRUE(inner);
+    ASSERT_EQ(inner->numCols(), 5);
+    EXPECT_EQ(inner->numRows(), 3);
+    EXPECT_EQ(inner->colLabel(3), "y_sites");
+    EXPECT_EQ(inner->colLabel(4), "t_sites");
+    EXPECT_EQ(inner->column(0)->textAt(2), "a");
+    EXPECT_EQ(inner->cell(2, 2), 30);
+    EXPECT_EQ(inner->cell(2, 3), 1);
+
+    auto left = newJoinedTable(samples, sites, "site", "name", TableJoin::Left);
+    ASSERT_EQ(left->numRows(), 4);
+    EXPECT_TRUE(left->column(3)->isInvalid(3));
+
+    // the unmatched row of sites provides the key
+    auto outer = newJoinedTable(samples, sites, "site", "name", TableJoin::Outer);
+    ASSERT_EQ(outer->numRows(), 5);
+    EXPECT_EQ(outer->column(0)->textAt(4), "d");
+    EXPECT_TRUE(outer->column(2)->isInvalid(4));
+    EXPECT_EQ(outer->cell(4, 3), 4);
+
+    // as of: the same site and the nearest time, at most 1.5 apart
+    auto nearest = newJoinedTable(samples, sites, "site, t", "name, t", TableJoin::Nearest, 1.5);
+    ASSERT_EQ(nearest->numRows(), 4);
+    ASSERT_EQ(nearest->numCols(), 4);
+    EXPECT_EQ(nearest->cell(0, 3), 1);
+    EXPECT_TRUE(nearest->column(3)->isInvalid(1));
+    EXPECT_EQ(nearest->cell(2, 3), 1);
+    EXPECT_TRUE(nearest->column(3)->isInvalid(3));
+
+    // dates and times, with the tolerance in seconds
+    auto times = newTable("times", 2, 1);
+    times->column(0)->setColumnMode(SciDAVis::ColumnMode::DateTime);
+    const QDateTime start(QDate(2024, 1, 1), QTime(12, 0));
+    times->column(0)->replaceDateTimes(0, QList<QDateTime>() << start << start.addSecs(100));
+    auto readings = newTable("readings", 2, 2);
+    readings->column(0)->setColumnMode(SciDAVis::ColumnMode::DateTime);
+    readings->column(0)->replaceDateTimes(0, QList<QDateTime>() << start.addSecs(-30)
+                                                                 << start.addSecs(40));
+    readings->column(1)->replaceValues(0, QVector<qreal>() << 1 << 2);
+    auto asof = newJoinedTable(times, readings, times->colLabel(0), readings->colLabel(0),
+                               TableJoin::Nearest, 45);
+    ASSERT_EQ(asof->numRows(), 2);
+    EXPECT_EQ(asof->cell(0, 1), 1);
+    EXPECT_TRUE(asof->column(1)->isInvalid(1));
+}
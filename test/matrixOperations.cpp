@@ -0,0 +1,159 @@
+#include "ApplicationWindowTest.h"
+#include "Matrix.h"
+#include "matrix/MatrixOperations.h"
+#include <QUndoStack>
+#include <cmath>
+#include <initializer_list>
+#include <stdexcept>
+
+#include "utils.h"
+
+namespace {
+typedef MatrixOperations::Cells Cells;
+
+//! Return the cells of a matrix given row by row
+Cells fromRows(std::initializer_list<std::initializer_list<double>> rows)
+{
+    Cells cells(int(rows.begin()->size()));
+    for (auto &row : rows) {
+        int col = 0;
+        for (double value : row)
+            cells[col++].append(value);
+    }
+    return cells;
+}
+
+//! Return a diagonally dominant (and thus regular) n x n matrix
+Cells regular(int n)
+{
+    Cells cells(n, QVector<qreal>(n));
+    for (int col = 0; col < n; col++)
+        for (int row = 0; row < n; row++)
+            cells[col][row] = row == col ? 2 * n : sin(row + 3.0 * col);
+    return cells;
+}
+
+void expectNear(const Cells &actual, const Cells &expected, double tolerance)
+{
+    ASSERT_EQ(actual.size(), expected.size());
+    for (int col = 0; col < expected.size(); col++) {
+        ASSERT_EQ(actual[col].size(), expected[col].size());
+        for (int row = 0; row < expected[col].size(); row++)
+            EXPECT_NEAR(actual[col][row], expected[col][row], tolerance)
+                    << "row " << row << ", column " << col;
+    }
+}
+
+Cells identity(int n)
+{
+    Cells cells(n, QVector<qreal>(n, 0));
+    for (int i = 0; i < n; i++)
+        cells[i][i] = 1;
+    return cells;
+}
+} // namespace
+
+TEST_F(ApplicationWindowTest, matrixOperations)
+{
+    const Cells a = fromRows({ { 4, -2, 1 }, { 3, 6, -4 }, { 2, 1, 8 } });
+    EXPECT_NEAR(MatrixOperations::determinant(a), 263, 1e-10);
+
+    Cells inverse, product;
+    ASSERT_TRUE(MatrixOperations::inverse(a, &inverse));
+    ASSERT_TRUE(MatrixOperations::product(a, inverse, &product));
+    expectNear(product, identity(3), 1e-12);
+
+    // two right hand sides
+    const Cells x = fromRows({ { 1, -1 }, { 2, 0.5 }, { 3, 4 } });
+    Cells b, solution;
+    ASSERT_TRUE(MatrixOperations::product(a, x, &b));
+    expectNear(b, fromRows({ { 3, -1 }, { 3, -16 }, { 28, 30.5 } }), 1e-12);
+    ASSERT_TRUE(MatrixOperations::solve(a, b, &solution));
+    expectNear(solution, x, 1e-12);
+
+    Cells sum;
+    ASSERT_TRUE(MatrixOperations::elementwise(a, a, MatrixOperations::Subtract, &sum));
+    expectNear(sum, Cells(3, QVector<qreal>(3, 0)), 0);
+
+    // invalid operands
+    const Cells singular = fromRows({ { 1, 2 }, { 2, 4 } });
+    EXPECT_EQ(MatrixOperations::determinant(singular), 0);
+    EXPECT_FALSE(MatrixOperations::inverse(singular, &inverse));
+    EXPECT_FALSE(MatrixOperations::solve(singular, fromRows({ { 1 }, { 1 } }), &solution));
+    EXPECT_FALSE(MatrixOperations::solve(a, fromRows({ { 1 }, { 1 } }), &solution));
+    EXPECT_FALSE(MatrixOperations::product(a, singular, &product));
+    EXPECT_FALSE(MatrixOperations::elementwise(a, singular, MatrixOperations::Add, &sum));
+}
+
+TEST_F(ApplicationWindowTest, largeMatrixOperations)
+{
+    // large enough to be split into blocks of columns
+    const int n = 300;
+    const Cells a = regular(n);
+    Cells inverse, product;
+    ASSERT_TRUE(MatrixOperations::inverse(a, &inverse));
+    ASSERT_TRUE(MatrixOperations::product(inverse, a, &product));
+    expectNear(product, identity(n), 1e-12);
+
+    // compare the product with the naive one
+    ASSERT_TRUE(MatrixOperations::product(a, inverse, &product));
+    for (int col = 0; col < n; col += 37)
+        for (int row = 0; row < n; row += 41) {
+            double expected = 0;
+            for (int k = 0; k < n; k++)
+                expected += a[k][row] * inverse[col][k];
+            EXPECT_NEAR(product[col][row], expected, 1e-12);
+        }
+
+    Cells solution;
+    ASSERT_TRUE(MatrixOperations::solve(a, a, &solution));
+    expectNear(solution, identity(n), 1e-12);
+}
+
+TEST_F(ApplicationWindowTest, matrixInvertUndo)
+{
+    Matrix *m = newMatrix("invert", 3, 3);
+    const double rows[3][3] = { { 4, -2, 1 }, { 3, 6, -4 }, { 2, 1, 8 } };
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 3; j++)
+            m->setCell(i, j, rows[i][j]);
+    const Cells original = m->d_future_matrix->columns();
+    Cells inverse;
+    ASSERT_TRUE(MatrixOperations::inverse(original, &inverse));
+
+    // the inversion is a single undo step
+    QUndoStack *stack = m->d_future_matrix->undoStack();
+    ASSERT_TRUE(stack);
+    const int index = stack->index();
+    m->invert();
+    EXPECT_EQ(stack->index(), index + 1);
+    expectNear(m->d_future_matrix->columns(), inverse, 0);
+    stack->undo();
+    EXPECT_EQ(m->d_future_matrix->columns(), original);
+    stack->redo();
+    expectNear(m->d_future_matrix->columns(), inverse, 0);
+
+    // as is a product with another matrix
+    Matrix *other = newMatrix("other", 3, 3);
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 3; j++)
+            other->setCell(i, j, rows[i][j]);
+    const int productIndex = stack->index();
+    ASSERT_TRUE(m->d_future_matrix->multiply(other->d_future_matrix));
+    EXPECT_EQ(stack->index(), productIndex + 1);
+    expectNear(m->d_future_matrix->columns(), identity(3), 1e-12);
+    stack->undo();
+    expectNear(m->d_future_matrix->columns(), inverse, 0);
+
+    // a singular matrix is reported and left unchanged
+    Matrix *singular = newMatrix("singular", 2, 2);
+    singular->setCell(0, 0, 1);
+    singular->setCell(0, 1, 2);
+    singular->setCell(1, 0, 2);
+    singular->setCell(1, 1, 4);
+    QUndoStack *singularStack = singular->d_future_matrix->undoStack();
+    const int singularIndex = singularStack->index();
+    EXPECT_THROW(singular->invert(), std::runtime_error);
+    EXPECT_EQ(singularStack->index(), singularIndex);
+    EXPECT_EQ(singular->cell(1, 1), 4);
+}
@@ -0,0 +1,103 @@
+#include "ApplicationWindowTest.h"
+#include "Matrix.h"
+#include "MatrixRaster.h"
+#include <QMap>
+#include <qwt_color_map.h>
+#include <qwt_scale_map.h>
+#include <cmath>
+
+#include "utils.h"
+
+TEST_F(ApplicationWindowTest, matrixRasterContourLines)
+{
+    // a single peak on a flat field, one plot unit per cell
+    Matrix *m = newMatrix("contours", 5, 5);
+    m->setCoordinates(0, 5, 0, 5);
+    for (int i = 0; i < 5; i++)
+        for (int j = 0; j < 5; j++)
+            m->setCell(i, j, 0);
+    m->setCell(2, 2, 1);
+    auto raster = MatrixRaster::snapshot(m);
+    // the isolines follow the values displayed at the cell centers, see MatrixRaster::value()
+    const QPointF peak(2.5, 3.5);
+    ASSERT_EQ(raster->value(peak.x(), peak.y()), 1);
+
+    // the level halfway up crosses the edges from the peak halfway: a closed diamond
+    QwtRasterData::ContourLines lines = raster->contourLines(QwtValueList() << 0.5 << 2);
+    ASSERT_EQ(lines.size(), 1);
+    const QPolygonF &segments = lines.value(0.5);
+    ASSERT_EQ(segments.size(), 8);
+    QMap<QPair<double, double>, int> ends;
+    for (const QPointF &point : segments)
+        ends[qMakePair(point.x(), point.y())]++;
+    // in the order of QMap
+    const QList<QPair<double, double>> corners = QList<QPair<double, double>>()
+            << qMakePair(peak.x() - 0.5, peak.y()) << qMakePair(peak.x(), peak.y() - 0.5)
+            << qMakePair(peak.x(), peak.y() + 0.5) << qMakePair(peak.x() + 0.5, peak.y());
+    ASSERT_EQ(ends.keys(), corners);
+    // every corner ends two segments
+    for (int count : ends)
+        EXPECT_EQ(count, 2);
+}
+
+namespace {
+//! Expect the pixels of 'image' to show the cells at the centers of blocks of step x step cells
+void expectDirectColors(const QImage &image, const MatrixRaster &raster,
+                        const QwtColorMap &colorMap, const QwtScaleMap &xMap,
+                        const QwtScaleMap &yMap, int step)
+{
+    for (int px = 0; px < image.width(); px += 7)
+        for (int py = 0; py < image.height(); py += 5) {
+            const double x = xMap.invTransform(px + 0.5), y = yMap.invTransform(py + 0.5);
+            const double cx = (floor(x / step) + 0.5) * step, cy = (floor(y / step) + 0.5) * step;
+            ASSERT_EQ(image.pixel(px, py), colorMap.rgb(raster.range(), raster.value(cx, cy)))
+                    << "pixel " << px << ", " << py;
+        }
+}
+} // namespace
+
+TEST_F(ApplicationWindowTest, matrixRasterTiles)
+{
+    // more cells than fit on one tile in both directions, one plot unit per cell
+    const int n = 300;
+    Matrix *m = newMatrix("tiles", n, n);
+    m->setCoordinates(0, n, 0, n);
+    QVector<qreal> cells(n * n);
+    for (int i = 0; i < cells.size(); i++)
+        cells[i] = sin(0.1 * (i / n)) * cos(0.07 * (i % n));
+    m->setCells(cells);
+    const QwtLinearColorMap colorMap(Qt::blue, Qt::red);
+
+    // two screen pixels per cell, and three cells per screen pixel
+    QwtScaleMap xMap, yMap;
+    xMap.setScaleInterval(0, n);
+    yMap.setScaleInterval(0, n);
+    MatrixRasterTiles tiles;
+    auto raster = MatrixRaster::snapshot(m);
+    for (int size : { 2 * n, n / 3 }) {
+        SCOPED_TRACE(size);
+        xMap.setPaintInterval(0, size);
+        yMap.setPaintInterval(size, 0);
+        const QImage image = tiles.render(*raster, colorMap, xMap, yMap, QRect(0, 0, size, size));
+        ASSERT_EQ(image.size(), QSize(size, size));
+        expectDirectColors(image, *raster, colorMap, xMap, yMap, size > n ? 1 : 2);
+        // the second time from the cached tiles
+        EXPECT_TRUE(tiles.render(*raster, colorMap, xMap, yMap, QRect(0, 0, size, size))
+                    == image);
+    }
+
+    // an edit of the matrix gives a new snapshot, whose tiles are rendered anew
+    xMap.setPaintInterval(0, 2 * n);
+    yMap.setPaintInterval(2 * n, 0);
+    const QImage before = tiles.render(*raster, colorMap, xMap, yMap, QRect(0, 0, 2 * n, 2 * n));
+    m->setCell(150, 0, 0.5);
+    auto edited = MatrixRaster::snapshot(m);
+    ASSERT_NE(edited->version(), raster->version());
+    ASSERT_EQ(edited->range().minValue(), raster->range().minValue());
+    ASSERT_EQ(edited->range().maxValue(), raster->range().maxValue());
+    const QImage after = tiles.render(*edited, colorMap, xMap, yMap, QRect(0, 0, 2 * n, 2 * n));
+    expectDirectColors(after, *edited, colorMap, xMap, yMap, 1);
+    // the cell is shown at (0.5, 151.5), see MatrixRaster::value()
+    EXPECT_EQ(after.pixel(1, 297), colorMap.rgb(edited->range(), 0.5));
+    EXPECT_NE(after.pixel(1, 297), before.pixel(1, 297));
+}
@@ -0,0 +1,120 @@
+#include "ApplicationWindowTest.h"
+#include "Graph.h"
+#include "MultiLayer.h"
+#include "MultiPeakFit.h"
+#include "core/column/Column.h"
+#include "lib/PeakDetection.h"
+#include <cmath>
+#include <vector>
+
+#include "utils.h"
+
+namespace {
+//! Area, center and width (as used by the Gauss fit) of the synthetic peaks
+const double areas[] = { 10, 12, 9 };
+const double centers[] = { 20, 50, 80 };
+const double widths[] = { 1.5, 3, 2.5 };
+const double offset = 0.5;
+
+//! Three Gauss peaks on an offset, with a little deterministic noise
+double signal(double x)
+{
+    double y = offset + 0.01 * sin(37.1 * x);
+    for (int i = 0; i < 3; i++)
+        y += sqrt(2 / M_PI) * areas[i] / widths[i]
+                * exp(-2 * (x - centers[i]) * (x - centers[i]) / (widths[i] * widths[i]));
+    return y;
+}
+} // namespace
+
+TEST_F(ApplicationWindowTest, peakDetection)
+{
+    const int n = 1001;
+    std::vector<double> x(n), y(n);
+    for (int i = 0; i < n; i++) {
+        x[i] = 0.1 * i;
+        y[i] = signal(x[i]);
+    }
+
+    const QVector<PeakDetection::Peak> peaks = PeakDetection::find(x.data(), y.data(), n);
+    ASSERT_EQ(peaks.size(), 3);
+    for (int i = 0; i < 3; i++) {
+        EXPECT_NEAR(peaks[i].position, centers[i], 0.15);
+        EXPECT_EQ(x[peaks[i].index], peaks[i].position);
+        EXPECT_NEAR(peaks[i].height, signal(centers[i]), 0.1 * signal(centers[i]));
+        // the full width at half maximum of the profile
+        EXPECT_NEAR(peaks[i].width, widths[i] * sqrt(2 * M_LN2), 0.2 * widths[i]);
+    }
+
+    // the noise does not produce any peaks of its own
+    PeakDetection::Options options;
+    options.smoothingPoints = 1;
+    EXPECT_EQ(PeakDetection::find(x.data(), y.data(), n, options).size(), 3);
+
+    // the most prominent peaks are kept
+    options = PeakDetection::Options();
+    options.maxPeaks = 2;
+    const QVector<PeakDetection::Peak> highest =
+            PeakDetection::find(x.data(), y.data(), n, options);
+    ASSERT_EQ(highest.size(), 2);
+    EXPECT_NEAR(highest[0].position, centers[0], 0.15);
+    EXPECT_NEAR(highest[1].position, centers[1], 0.15);
+
+    options = PeakDetection::Options();
+    options.minWidth = 2.5;
+    const QVector<PeakDetection::Peak> wide = PeakDetection::find(x.data(), y.data(), n, options);
+    ASSERT_EQ(wide.size(), 2);
+    EXPECT_NEAR(wide[0].position, centers[1], 0.15);
+    EXPECT_NEAR(wide[1].position, centers[2], 0.15);
+
+    // overlapping ranges end up in one region, the regions cover all points
+    const QVector<PeakDetection::Region> regions = PeakDetection::regions(
+            x.data(), n, QVector<double>() << 80 << 20 << 26, QVector<double>() << 5 << 5 << 5);
+    ASSERT_EQ(regions.size(), 2);
+    EXPECT_EQ(regions[0].peaks, QVector<int>() << 1 << 2);
+    EXPECT_EQ(regions[1].peaks, QVector<int>() << 0);
+    EXPECT_EQ(regions[0].points.start(), 0);
+    EXPECT_EQ(regions[0].points.end() + 1, regions[1].points.start());
+    EXPECT_EQ(regions[1].points.end(), n - 1);
+    // halfway between 31 and 75
+    EXPECT_LT(x[regions[0].points.end()], 53);
+    EXPECT_GE(x[regions[1].points.start()], 53);
+}
+
+TEST_F(ApplicationWindowTest, multiPeakRegionFit)
+{
+    const int n = 1001;
+    auto table = newTable("peaks", n, 2);
+    for (int r = 0; r < n; ++r) {
+        table->column(0)->setValueAt(r, 0.1 * r);
+        table->column(1)->setValueAt(r, signal(0.1 * r));
+    }
+    auto plot = multilayerPlot(table, QStringList() << table->colName(1), Graph::Line);
+    ASSERT_TRUE(plot);
+    auto graph = plot->activeGraph();
+    ASSERT_EQ(graph->curvesList().size(), 1);
+    const QString curve = graph->curvesList()[0];
+
+    // the peaks are fitted separately first, then all together
+    GaussFit regional(this, graph, curve);
+    ASSERT_EQ(regional.findPeaks(), 3);
+    ASSERT_EQ(regional.peaks(), 3);
+    regional.enableIndependentRegions(true);
+    regional.fit();
+    const std::vector<double> &results = regional.results();
+    ASSERT_EQ(results.size(), 10u);
+    for (int i = 0; i < 3; i++) {
+        EXPECT_NEAR(results[3 * i], areas[i], 0.01 * areas[i]);
+        EXPECT_NEAR(results[3 * i + 1], centers[i], 0.01);
+        EXPECT_NEAR(results[3 * i + 2], widths[i], 0.01 * widths[i]);
+    }
+    EXPECT_NEAR(results[9], offset, 0.01);
+
+    // the same minimum is reached without the separate fits
+    GaussFit direct(this, graph, curve);
+    ASSERT_EQ(direct.findPeaks(), 3);
+    direct.fit();
+    ASSERT_EQ(direct.results().size(), 10u);
+    for (int i = 0; i < 10; i++)
+        EXPECT_NEAR(direct.results()[i], results[i], 1e-3 * (1 + fabs(results[i])));
+}
@@ -0,0 +1,100 @@
+#include "ApplicationWindowTest.h"
+#include "lib/PolynomialLeastSquares.h"
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_multifit.h>
+#include <cmath>
+#include <vector>
+
+#include "utils.h"
+
+TEST_F(ApplicationWindowTest, polynomialLeastSquaresExact)
+{
+    // far from the origin, where powers of x are badly conditioned
+    const int n = 100;
+    std::vector<double> x(n), y(n);
+    for (int i = 0; i < n; i++) {
+        x[i] = 1000 + 0.1 * i;
+        const double t = x[i] - 1000;
+        y[i] = 2 - 3 * t + 0.5 * t * t * t;
+    }
+    // the same cubic in powers of x
+    const double expected[] = { 2 + 3000 - 0.5e9, -3 + 1.5e6, -1500, 0.5 };
+
+    auto result = PolynomialLeastSquares::fit(x.data(), y.data(), nullptr, n, 3);
+    ASSERT_EQ(result.coefficients.size(), 4);
+    for (int k = 0; k < 4; k++)
+        EXPECT_NEAR(result.coefficients[k], expected[k], 1e-6 * fabs(expected[k]));
+    EXPECT_NEAR(result.chiSquare, 0, 1e-10);
+    EXPECT_EQ(result.iterations, 0);
+
+    // too few points
+    result = PolynomialLeastSquares::fit(x.data(), y.data(), nullptr, 3, 3);
+    EXPECT_TRUE(result.coefficients.isEmpty());
+}
+
+TEST_F(ApplicationWindowTest, polynomialLeastSquaresWeighted)
+{
+    // more than one block of points, compared with GSL's dense solver
+    const int n = 40000, p = 3;
+    std::vector<double> x(n), y(n), w(n);
+    gsl_matrix *X = gsl_matrix_alloc(n, p);
+    gsl_vector_view yv = gsl_vector_view_array(y.data(), n);
+    gsl_vector_view wv = gsl_vector_view_array(w.data(), n);
+    for (int i = 0; i < n; i++) {
+        x[i] = -2 + 4.0 * i / n;
+        y[i] = 0.3 + 1.2 * x[i] - 0.7 * x[i] * x[i] + 0.05 * sin(13.7 * i);
+        w[i] = 1 + 0.5 * cos(0.01 * i);
+        for (int k = 0; k < p; k++)
+            gsl_matrix_set(X, i, k, pow(x[i], k));
+    }
+    gsl_vector *c = gsl_vector_alloc(p);
+    gsl_matrix *cov = gsl_matrix_alloc(p, p);
+    double chi_square;
+    gsl_multifit_linear_workspace *work = gsl_multifit_linear_alloc(n, p);
+    ASSERT_EQ(gsl_multifit_wlinear(X, &wv.vector, &yv.vector, c, cov, &chi_square, work),
+              GSL_SUCCESS);
+
+    auto result = PolynomialLeastSquares::fit(x.data(), y.data(), w.data(), n, p - 1);
+    ASSERT_EQ(result.coefficients.size(), p);
+    ASSERT_EQ(result.covariance.size(), p * p);
+    for (int k = 0; k < p; k++) {
+        EXPECT_NEAR(result.coefficients[k], gsl_vector_get(c, k), 1e-10);
+        for (int l = 0; l < p; l++)
+            EXPECT_NEAR(result.covariance[k * p + l], gsl_matrix_get(cov, k, l),
+                        1e-8 * fabs(gsl_matrix_get(cov, k, k)));
+    }
+    EXPECT_NEAR(result.chiSquare, chi_square, 1e-8 * chi_square);
+    EXPECT_NEAR(result.weightedChiSquare, chi_square, 1e-8 * chi_square);
+
+    gsl_multifit_linear_free(work);
+    gsl_matrix_free(cov);
+    gsl_vector_free(c);
+    gsl_matrix_free(X);
+}
+
+TEST_F(ApplicationWindowTest, polynomialLeastSquaresRobust)
+{
+    // a straight line with a little noise and every tenth point far off
+    const int n = 1000;
+    std::vector<double> x(n), y(n);
+    for (int i = 0; i < n; i++) {
+        x[i] = 0.01 * i;
+        y[i] = 1 + 2 * x[i] + 0.01 * sin(7.3 * i) + (i % 10 == 0 ? 5 : 0);
+    }
+
+    auto ordinary = PolynomialLeastSquares::fit(x.data(), y.data(), nullptr, n, 1);
+    ASSERT_EQ(ordinary.coefficients.size(), 2);
+    EXPECT_GT(fabs(ordinary.coefficients[0] - 1), 0.4);
+
+    for (auto robustness : { PolynomialLeastSquares::Huber, PolynomialLeastSquares::Bisquare }) {
+        auto robust = PolynomialLeastSquares::fit(x.data(), y.data(), nullptr, n, 1, robustness);
+        ASSERT_EQ(robust.coefficients.size(), 2);
+        EXPECT_GT(robust.iterations, 0);
+        EXPECT_LT(robust.weightedChiSquare, robust.chiSquare);
+    }
+    // the bisquare weights ignore the outliers completely
+    auto bisquare = PolynomialLeastSquares::fit(x.data(), y.data(), nullptr, n, 1,
+                                                PolynomialLeastSquares::Bisquare);
+    EXPECT_NEAR(bisquare.coefficients[0], 1, 0.01);
+    EXPECT_NEAR(bisquare.coefficients[1], 2, 0.01);
+}
@@ -0,0 +1,104 @@
+#include "ApplicationWindowTest.h"
+#include "Matrix.h"
+#include "Note.h"
+#include "ProjectSearch.h"
+#include "Table.h"
+#include "core/column/Column.h"
+#include <QEventLoop>
+#include <QUndoStack>
+
+#include "utils.h"
+
+TEST_F(ApplicationWindowTest, searchProjectContents)
+{
+    auto table = newTable("search", 5, 2);
+    auto &x = *table->column(0), &text = *table->column(1);
+    text.setColumnMode(SciDAVis::ColumnMode::Text);
+    const char *texts[] = { "alpha", "beta", "Alphabet", "gamma", "alp" };
+    for (int r = 0; r < 5; ++r) {
+        x.setValueAt(r, r);
+        text.setTextAt(r, texts[r]);
+    }
+    x.setInvalid(3);
+    auto matrix = newMatrix("searchMatrix", 2, 2);
+    matrix->d_future_matrix->setCell(1, 0, 3.5);
+    auto note = newNote("searchNote");
+    note->setText("first alpha\nsecond line");
+
+    QList<MyWidget *> windows = QList<MyWidget *>() << table << matrix << note;
+    QList<ProjectSearch::Hit> hits;
+    ProjectSearch search;
+    QObject::connect(&search, &ProjectSearch::hitsFound,
+                     [&](const QList<ProjectSearch::Hit> &found) { hits << found; });
+    auto find = [&](const ProjectSearch::Query &query) {
+        hits.clear();
+        QEventLoop loop;
+        QObject::connect(&search, &ProjectSearch::finished, &loop, &QEventLoop::quit);
+        search.start(windows, query);
+        loop.exec();
+    };
+
+    ProjectSearch::Query query;
+    query.text = "alp";
+    find(query);
+    // three cells in the text column and one passage of the note
+    EXPECT_EQ(hits.size(), 4);
+    int note_hits = 0;
+    for (auto &hit : hits)
+        if (hit.window == note) {
+            note_hits++;
+            EXPECT_EQ(hit.row, 6);
+            EXPECT_EQ(hit.column, 3);
+            EXPECT_EQ(hit.text, "first alpha");
+        }
+    EXPECT_EQ(note_hits, 1);
+
+    query.whole_cell = true;
+    query.notes = false;
+    find(query);
+    ASSERT_EQ(hits.size(), 1);
+    EXPECT_EQ(hits.first().row, 4);
+
+    query.mode = ProjectSearch::NumberRange;
+    query.min = 2;
+    query.max = 4;
+    find(query);
+    // rows 2 and 4 of the table (row 3 is invalid) and one matrix cell
+    EXPECT_EQ(hits.size(), 3);
+
+    EXPECT_EQ(ProjectSearch::replace(windows, query, "-1"), 3);
+    EXPECT_EQ(x.valueAt(2), -1);
+    EXPECT_EQ(x.valueAt(4), -1);
+    EXPECT_TRUE(x.isInvalid(3));
+    EXPECT_EQ(matrix->d_future_matrix->cell(1, 0), -1);
+    // the table is changed in one undo step
+    table->d_future_table->undoStack()->undo();
+    EXPECT_EQ(x.valueAt(2), 2);
+    EXPECT_EQ(x.valueAt(4), 4);
+
+    query.mode = ProjectSearch::Text;
+    query.text = "(al)p";
+    query.regexp = true;
+    query.whole_cell = false;
+    query.notes = true;
+    EXPECT_EQ(ProjectSearch::replace(windows, query, "\\1P"), 4);
+    EXPECT_EQ(text.textAt(0), "alPha");
+    EXPECT_EQ(text.textAt(2), "AlPhabet");
+    EXPECT_EQ(note->text(), "first alPha\nsecond line");
+
+    // patterns like z* match the empty string everywhere, which is not reported or replaced
+    query.text = "z*";
+    find(query);
+    EXPECT_TRUE(hits.isEmpty());
+    EXPECT_EQ(ProjectSearch::replace(windows, query, "-"), 0);
+    EXPECT_EQ(text.textAt(1), "beta");
+    EXPECT_EQ(note->text(), "first alPha\nsecond line");
+    query.text = "t*";
+    query.notes = false;
+    find(query);
+    EXPECT_EQ(hits.size(), 2);
+    EXPECT_EQ(ProjectSearch::replace(windows, query, "T"), 2);
+    EXPECT_EQ(text.textAt(1), "beTa");
+    EXPECT_EQ(text.textAt(2), "AlPhabeT");
+    EXPECT_EQ(text.textAt(3), "gamma");
+}
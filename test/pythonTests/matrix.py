@@ -24,6 +24,20 @@ for i in range(2):
             s+=m.cell(i+1,k+1)*m1.cell(k+1,j+1)
         assert s == (i==j),str(s)+" == ("+str(i)+"=="+str(j)+")"
 
+m1.multiply(m)
+for i in range(2):
+    for j in range(2):
+        assert abs(m1.cell(i+1,j+1) - (i==j)) < 1e-12,"m1.multiply(m)"
+
+b=newMatrix("b",2,1)
+b.confirmClose(False)
+b.setColumn(0,0,[5,4])
+assert b.solve(m),"b.solve(m)"
+assert abs(b.cell(1,1)-1) < 1e-12 and abs(b.cell(2,1)-1) < 1e-12,"b.solve(m)"
+
+m1.combine(m,0)
+assert m1.cell(1,1) == 3 and m1.cell(1,2) == 3,"m1.combine(m,0)"
+
 M=newMatrix() #use defaults
 M.confirmClose(False)
 assert M.numRows() == M.numCols() == 32
@@ -0,0 +1,43 @@
+#include "ApplicationWindowTest.h"
+#include "core/column/Column.h"
+#include "core/datatypes/Double2StringFilter.h"
+#include "table/TableModel.h"
+#include "table/future_Table.h"
+#include <QLocale>
+
+#include "utils.h"
+
+TEST_F(ApplicationWindowTest, tableModelTextCache)
+{
+    auto table = newTable("cache", 1000, 1);
+    auto &x = *table->column(0);
+    x.replaceValues(0, QVector<qreal>(1000, 1.5));
+    auto filter = static_cast<Double2StringFilter *>(x.outputFilter());
+    filter->setNumericFormat('f');
+    filter->setNumDigits(2);
+
+    TableModel model(table->d_future_table);
+    auto text = [&](int row) {
+        return model.data(model.index(row, 0), Qt::DisplayRole).toString();
+    };
+    model.prefetch(0, 999, 0, 0);
+    EXPECT_EQ(text(0), "1.50");
+    EXPECT_EQ(text(999), "1.50");
+
+    // content
+    x.setValueAt(700, 2.34);
+    EXPECT_EQ(text(700), "2.34");
+    // display format
+    filter->setNumDigits(1);
+    EXPECT_EQ(text(0), "1.5");
+    EXPECT_EQ(text(700), "2.3");
+
+    // locale, also without the LocaleChange event views get
+    const QLocale locale;
+    QLocale::setDefault(QLocale(QLocale::German, QLocale::Germany));
+    EXPECT_EQ(text(0), "1,5");
+    EXPECT_EQ(text(700), "2,3");
+    QLocale::setDefault(locale);
+    model.clearCache();
+    EXPECT_EQ(text(999), "1.5");
+}
@@ -0,0 +1,72 @@
+#include "ApplicationWindowTest.h"
+#include "Table.h"
+#include "core/column/Column.h"
+#include "lib/RowSorter.h"
+#include <QUndoStack>
+#include <cmath>
+
+#include "utils.h"
+
+TEST_F(ApplicationWindowTest, sortByTwoKeys)
+{
+    auto table = newTable("sort", 6, 3);
+    auto &a = *table->column(0), &b = *table->column(1), &c = *table->column(2);
+    const double av[] = { 2, 1, NAN, 1, 2, 1 };
+    const double bv[] = { 5, 3, 0, 1, 4, 2 };
+    for (int r = 0; r < 6; ++r) {
+        a.setValueAt(r, av[r]);
+        b.setValueAt(r, bv[r]);
+        c.setValueAt(r, r);
+    }
+    b.setInvalid(3);
+    c.setMasked(1);
+    c.setFormula(Interval<int>(0, 1), "i");
+
+    auto future_table = table->d_future_table;
+    future_table->sortColumns(QList<Column *>() << &a << &b, QList<Column *>() << &a << &b << &c,
+                              true);
+
+    // rows with equal a are sorted by b, invalid b last; NaN in a is sorted last
+    const int expected[] = { 5, 1, 3, 4, 0, 2 };
+    for (int r = 0; r < 6; ++r)
+        EXPECT_EQ(c.valueAt(r), expected[r]);
+    EXPECT_TRUE(b.isInvalid(2));
+    EXPECT_TRUE(c.isMasked(1));
+    EXPECT_FALSE(c.isMasked(5));
+    EXPECT_EQ(c.formula(1), "i");
+    EXPECT_EQ(c.formula(4), "i");
+    EXPECT_EQ(c.formula(0), "");
+
+    // the sort is undone in one step
+    future_table->undoStack()->undo();
+    for (int r = 0; r < 6; ++r)
+        EXPECT_EQ(c.valueAt(r), r);
+    EXPECT_TRUE(b.isInvalid(3));
+    EXPECT_TRUE(c.isMasked(1));
+    EXPECT_EQ(c.formula(0), "i");
+    EXPECT_EQ(c.formula(4), "");
+}
+
+TEST_F(ApplicationWindowTest, sortLargeColumnDescending)
+{
+    const int rows = 200000;
+    auto table = newTable("sort", rows, 2);
+    auto &x = *table->column(0), &y = *table->column(1);
+    QVector<qreal> values(rows), positions(rows);
+    for (int r = 0; r < rows; ++r) {
+        values[r] = std::fmod(r * 7919.0, 1000.0) - 500;
+        positions[r] = r;
+    }
+    x.replaceValues(0, values);
+    y.replaceValues(0, positions);
+
+    table->d_future_table->sortColumns(&x, QList<Column *>() << &x << &y, false);
+
+    for (int r = 1; r < rows; ++r) {
+        ASSERT_GE(x.valueAt(r - 1), x.valueAt(r));
+        // stable: equal values keep their order
+        if (x.valueAt(r - 1) == x.valueAt(r))
+            ASSERT_LT(y.valueAt(r - 1), y.valueAt(r));
+        ASSERT_EQ(values[int(y.valueAt(r))], x.valueAt(r));
+    }
+}
@@ -0,0 +1,82 @@
+#include "ApplicationWindowTest.h"
+#include "TableStatistics.h"
+#include "core/column/Column.h"
+#include <QAction>
+#include <gsl/gsl_statistics.h>
+#include <cmath>
+#include <vector>
+
+#include "utils.h"
+
+TEST_F(ApplicationWindowTest, columnStatistics)
+{
+    const int rows = 100000;
+    auto table = newTable("stats", rows, 2);
+    auto &col = *table->column(1);
+    QVector<qreal> values(rows);
+    for (int r = 0; r < rows; ++r)
+        values[r] = 1e6 + sin(r);
+    col.replaceValues(0, values);
+    col.setInvalid(Interval<int>(10, 20));
+
+    auto stats = newTableStatistics(table, TableStatistics::StatColumn, QList<int>() << 1);
+    EXPECT_FALSE(stats->d_future_table->action_difference->isEnabled());
+    EXPECT_FALSE(stats->d_future_table->action_statistics_columns->isEnabled());
+
+    auto check = [&]() {
+        std::vector<double> valid;
+        int iMax = -1;
+        for (int r = 0; r < rows; ++r)
+            if (!col.isInvalid(r)) {
+                if (iMax < 0 || col.valueAt(r) > col.valueAt(iMax))
+                    iMax = r;
+                valid.push_back(col.valueAt(r));
+            }
+        EXPECT_NEAR(stats->cell(0, 2), gsl_stats_mean(valid.data(), 1, valid.size()), 1e-9);
+        EXPECT_NEAR(stats->cell(0, 4), gsl_stats_variance(valid.data(), 1, valid.size()), 1e-9);
+        EXPECT_EQ(stats->cell(0, 6), iMax + 1);
+        EXPECT_EQ(stats->cell(0, 7), col.valueAt(iMax));
+        EXPECT_EQ(stats->cell(0, 10), double(valid.size()));
+    };
+    check();
+
+    // a single changed row only updates the block containing it
+    col.setValueAt(50000, -1);
+    check();
+    EXPECT_EQ(stats->cell(0, 8), 50001);
+    EXPECT_EQ(stats->cell(0, 9), -1);
+}
+
+TEST_F(ApplicationWindowTest, rowStatistics)
+{
+    auto table = newTable("stats", 10, 3);
+    for (int c = 0; c < 3; ++c)
+        for (int r = 0; r < 10; ++r)
+            table->column(c)->setValueAt(r, r * (c + 1));
+    table->column(2)->setInvalid(4);
+
+    QList<int> targets;
+    for (int r = 0; r < 10; ++r)
+        targets << r;
+    auto stats = newTableStatistics(table, TableStatistics::StatRow, targets);
+
+    EXPECT_EQ(stats->cell(3, 2), 6);
+    EXPECT_EQ(stats->cell(3, 8), 3);
+    EXPECT_EQ(stats->cell(4, 2), 6);
+    EXPECT_EQ(stats->cell(4, 8), 2);
+
+    table->column(1)->setValueAt(3, 0);
+    EXPECT_EQ(stats->cell(3, 2), 4);
+    EXPECT_EQ(stats->cell(3, 7), 0);
+
+    // the counts of the unchanged rows follow the columns of the base table
+    table->column(1)->setValueAt(5, 1);
+    table->column(2)->setColumnMode(SciDAVis::ColumnMode::Text);
+    for (int r = 0; r < 10; ++r) {
+        EXPECT_EQ(stats->cell(r, 1), 3);
+        EXPECT_EQ(stats->cell(r, 8), 2);
+    }
+    table->addColumns(1);
+    for (int r = 0; r < 10; ++r)
+        EXPECT_EQ(stats->cell(r, 1), 4);
+}
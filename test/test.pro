@@ -16,7 +16,7 @@ LIBS += -L ../libscidavis -lscidavis -lUnitTest++ -lboost_regex
 POST_TARGETDEPS=../libscidavis/libscidavis.a
 
 CONFIG        += qt warn_on exceptions opengl thread zlib
-QT            += opengl network svg xml
+QT            += opengl network svg xml concurrent
 equals(QT_MAJOR_VERSION, 5) { QT += printsupport }
 MOC_DIR        = ../tmp/scidavis
 OBJECTS_DIR    = ../tmp/test
@@ -50,7 +50,7 @@ liborigin {
 
 # Input
 #HEADERS += unittests.h
-SOURCES += main.cpp applicationWindow.cpp readWriteProject.cpp fft.cpp testPaintDevice.cpp 3dplot.cpp menus.cpp arrowMarker.cpp
+SOURCES += main.cpp applicationWindow.cpp readWriteProject.cpp fft.cpp testPaintDevice.cpp 3dplot.cpp menus.cpp arrowMarker.cpp tableStatistics.cpp tableSort.cpp undoStorage.cpp columnConversion.cpp columnTransform.cpp projectSearch.cpp filteredTable.cpp groupedTable.cpp joinTables.cpp tableModel.cpp curveUpdates.cpp graphExport.cpp canvasRenderer.cpp fitModels.cpp vectorCurve.cpp matrixOperations.cpp peakDetection.cpp polynomialLeastSquares.cpp matrixRaster.cpp columnAggregation.cpp
 
 ########### Future code backported from the aspect framework ##################
 DEFINES += LEGACY_CODE_0_2_x
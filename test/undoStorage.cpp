@@ -0,0 +1,111 @@
+#include "ApplicationWindowTest.h"
+#include "Table.h"
+#include "core/column/Column.h"
+#include "core/UndoStorage.h"
+#include <QUndoStack>
+#include <cmath>
+
+#include "utils.h"
+
+TEST_F(ApplicationWindowTest, replaceValuesUndoRedo)
+{
+    const int rows = 5000;
+    auto table = newTable("undo", rows, 1);
+    auto &x = *table->column(0);
+    QVector<qreal> original(rows), changed(rows + 100);
+    for (int r = 0; r < rows; ++r)
+        original[r] = r;
+    x.replaceValues(0, original);
+    // only a few blocks change, and the column grows
+    changed = original;
+    changed.resize(rows + 100);
+    changed[10] = -1;
+    changed[3000] = NAN;
+    for (int r = rows; r < rows + 100; ++r)
+        changed[r] = 2 * r;
+    x.replaceValues(0, changed);
+
+    auto stack = table->d_future_table->undoStack();
+    for (int i = 0; i < 2; ++i) {
+        stack->undo();
+        ASSERT_EQ(x.rowCount(), rows);
+        for (int r = 0; r < rows; ++r)
+            ASSERT_EQ(x.valueAt(r), r);
+        stack->redo();
+        ASSERT_EQ(x.rowCount(), rows + 100);
+        EXPECT_EQ(x.valueAt(10), -1);
+        EXPECT_TRUE(std::isnan(x.valueAt(3000)));
+        EXPECT_EQ(x.valueAt(2999), 2999);
+        EXPECT_EQ(x.valueAt(rows + 99), 2 * (rows + 99));
+    }
+}
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 9, 0)
+TEST_F(ApplicationWindowTest, undoMemoryBudget)
+{
+    auto table = newTable("undo", 100000, 1);
+    auto &x = *table->column(0);
+    auto stack = table->d_future_table->undoStack();
+    for (int i = 1; i <= 3; ++i)
+        x.replaceValues(0, QVector<qreal>(100000, i));
+
+    // a budget below the size of one backup keeps only the command executed last
+    const qint64 budget = UndoStorage::instance()->budget();
+    UndoStorage::instance()->setBudget(1);
+    QCoreApplication::processEvents();
+    UndoStorage::instance()->setBudget(budget);
+
+    // the discarded commands are labeled and not offered for undo
+    const int index = stack->index();
+    EXPECT_TRUE(stack->command(index - 2)->text().endsWith("(discarded)"));
+    EXPECT_FALSE(stack->command(index - 1)->text().endsWith("(discarded)"));
+    EXPECT_TRUE(UndoStorage::canUndo(stack));
+    undo();
+    EXPECT_EQ(x.valueAt(0), 2);
+    EXPECT_FALSE(UndoStorage::canUndo(stack));
+    undo();
+    EXPECT_EQ(x.valueAt(0), 2);
+    EXPECT_EQ(stack->index(), index - 1);
+
+    while (stack->canUndo())
+        stack->undo();
+    EXPECT_EQ(x.valueAt(0), 2);
+}
+
+TEST_F(ApplicationWindowTest, undoSpillFileCompaction)
+{
+    auto table = newTable("undo", 100000, 1);
+    auto &x = *table->column(0);
+    auto stack = table->d_future_table->undoStack();
+    for (int i = 1; i <= 5; ++i)
+        x.replaceValues(0, QVector<qreal>(100000, i));
+
+    // everything goes to the file
+    const qint64 budget = UndoStorage::instance()->budget();
+    const bool spilling = UndoStorage::instance()->isSpillingEnabled();
+    UndoStorage::instance()->setSpillingEnabled(true);
+    UndoStorage::instance()->setBudget(1);
+    QCoreApplication::processEvents();
+    UndoStorage::instance()->setBudget(0);
+    const qint64 size = UndoStorage::instance()->spillFileSize();
+    EXPECT_GT(size, 0);
+
+    // data loaded back is released from the file, which shrinks once mostly unused
+    for (int i = 0; i < 3; ++i)
+        stack->undo();
+    EXPECT_EQ(x.valueAt(0), 2);
+    QCoreApplication::processEvents();
+    EXPECT_LT(UndoStorage::instance()->spillFileSize(), size);
+    EXPECT_GT(UndoStorage::instance()->spillFileSize(), 0);
+
+    // the remaining data has been moved correctly
+    stack->undo();
+    EXPECT_EQ(x.valueAt(0), 1);
+    for (int i = 0; i < 4; ++i)
+        stack->redo();
+    EXPECT_EQ(x.valueAt(0), 5);
+
+    UndoStorage::instance()->setBudget(budget);
+    UndoStorage::instance()->setSpillingEnabled(spilling);
+}
+#endif
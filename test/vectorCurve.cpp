@@ -0,0 +1,85 @@
+#include "ApplicationWindowTest.h"
+#include "Graph.h"
+#include "MultiLayer.h"
+#include "VectorCurve.h"
+#include "core/column/Column.h"
+#include <QImage>
+#include <QPainter>
+#include <qwt_scale_map.h>
+
+#include "utils.h"
+
+namespace {
+//! Plot the arrows (x, y) -> (x + 0.05, y) and return the vector curve
+VectorCurve *plotArrows(ApplicationWindow *app, const QString &name,
+                        const QVector<QPointF> &arrows)
+{
+    auto table = app->newTable(name, arrows.size(), 4);
+    for (int r = 0; r < arrows.size(); ++r) {
+        table->column(0)->setValueAt(r, arrows[r].x());
+        table->column(1)->setValueAt(r, arrows[r].y());
+        table->column(2)->setValueAt(r, arrows[r].x() + 0.05);
+        table->column(3)->setValueAt(r, arrows[r].y());
+    }
+    auto plot = app->multilayerPlot(1, 1, Graph::Line);
+    if (!plot || !plot->activeGraph())
+        return nullptr;
+    Graph *graph = plot->activeGraph();
+    graph->plotVectorCurve(table,
+                           QStringList() << table->colName(0) << table->colName(1)
+                                         << table->colName(2) << table->colName(3),
+                           Graph::VectXYXY);
+    graph->updateVectorsLayout(0, Qt::red, 2, 4, 45, true, VectorCurve::Tail);
+    return dynamic_cast<VectorCurve *>(graph->curve(0));
+}
+
+//! Draw the curve on a 100x100 image, mapping [0, 1] to [0, 200] and scaling by 'scale'
+QImage render(VectorCurve *curve, double scale)
+{
+    QwtScaleMap xMap, yMap;
+    xMap.setScaleInterval(0, 1);
+    xMap.setPaintInterval(0, 200);
+    yMap.setScaleInterval(0, 1);
+    yMap.setPaintInterval(200, 0);
+    QImage image(100, 100, QImage::Format_ARGB32);
+    image.fill(Qt::white);
+    QPainter painter(&image);
+    painter.scale(scale, scale);
+    curve->draw(&painter, xMap, yMap, 0, -1);
+    return image;
+}
+
+bool hasRed(const QImage &image, const QRect &rect)
+{
+    for (int x = rect.left(); x <= rect.right(); ++x)
+        for (int y = rect.top(); y <= rect.bottom(); ++y)
+            if (image.pixel(x, y) == qRgb(255, 0, 0))
+                return true;
+    return false;
+}
+} // namespace
+
+TEST_F(ApplicationWindowTest, vectorCurveScaledPainter)
+{
+    // the arrow lies beyond the size of the image in logical coordinates, but on it once scaled
+    auto curve = plotArrows(this, "scaled", QVector<QPointF>() << QPointF(0.6, 0.5));
+    ASSERT_TRUE(curve);
+    EXPECT_TRUE(hasRed(render(curve, 0.5), QRect(60, 45, 5, 10)));
+}
+
+TEST_F(ApplicationWindowTest, vectorCurveThinning)
+{
+    // a dense field repeating the same arrows looks the same as the arrows drawn once
+    QVector<QPointF> distinct, dense;
+    for (int i = 0; i < 10; ++i)
+        for (int j = 0; j < 10; ++j)
+            distinct << QPointF(0.02 + 0.04 * i, 0.02 + 0.04 * j);
+    while (dense.size() <= 20000)
+        dense << distinct;
+    auto sparseCurve = plotArrows(this, "distinct", distinct);
+    auto denseCurve = plotArrows(this, "dense", dense);
+    ASSERT_TRUE(sparseCurve && denseCurve);
+    const QImage expected = render(sparseCurve, 0.5);
+    EXPECT_TRUE(hasRed(expected, QRect(0, 0, 100, 100)));
+    EXPECT_TRUE(render(denseCurve, 0.5) == expected);
+}